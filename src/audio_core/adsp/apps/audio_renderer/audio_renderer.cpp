@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 
@@ -10,6 +11,7 @@
 #include "audio_core/sink/sink.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -178,6 +180,8 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                         command_list_processor.Initialize(system, *command_buffer.process,
                                                           command_buffer.buffer,
                                                           command_buffer.size, streams[index]);
+                        command_list_processor.voice_executor = GetVoiceExecutor();
+                        CaptureCommandList(index);
                     }
 
                     if (command_buffer.reset_buffer && !buffers_reset[index]) {
@@ -212,6 +216,9 @@ void AudioRenderer::Main(std::stop_token stop_token) {
 
                     command_buffer.remaining_command_count =
                         command_list_processor.GetRemainingCommandCount();
+                    if (captures[index] && command_buffer.remaining_command_count == 0) {
+                        captures[index]->EndCommandList();
+                    }
                     command_buffer.render_time_taken_us = end_time - start_time;
                 }
             }
@@ -227,4 +234,28 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     }
 }
 
+void AudioRenderer::CaptureCommandList(u32 session_id) {
+    auto& capture{captures[session_id]};
+    if (!Settings::values.capture_audio_commands) {
+        capture.reset();
+        return;
+    }
+    if (!capture) {
+        capture = std::make_unique<CommandCapture>(NewCapturePath(session_id));
+    }
+    capture->BeginCommandList(command_list_processors[session_id]);
+}
+
+VoiceExecutor* AudioRenderer::GetVoiceExecutor() {
+    if (!Settings::values.parallel_voice_processing) {
+        return nullptr;
+    }
+    if (!voice_executor) {
+        // A few threads are enough, most games play a few dozen voices at most
+        const u32 num_threads{std::clamp(std::thread::hardware_concurrency() / 4, 1U, 3U)};
+        voice_executor = std::make_unique<VoiceExecutor>(num_threads);
+    }
+    return voice_executor.get();
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
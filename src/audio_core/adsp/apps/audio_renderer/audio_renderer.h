@@ -8,7 +8,9 @@
 #include <thread>
 
 #include "audio_core/adsp/apps/audio_renderer/command_buffer.h"
+#include "audio_core/adsp/apps/audio_renderer/command_capture.h"
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_executor.h"
 #include "audio_core/adsp/mailbox.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
@@ -92,6 +94,20 @@ private:
 
     void PostDSPClearCommandBuffer() noexcept;
 
+    /**
+     * Start capturing a newly initialized command list, if capture_audio_commands is enabled.
+     *
+     * @param session_id - Session of the command list.
+     */
+    void CaptureCommandList(u32 session_id);
+
+    /**
+     * Get the executor for the voice commands, if parallel_voice_processing is enabled.
+     *
+     * @return The executor, or nullptr to process the voices on the AudioRenderer thread.
+     */
+    VoiceExecutor* GetVoiceExecutor();
+
     /// Core system
     Core::System& system;
     /// The output sink the AudioRenderer will send samples to
@@ -108,6 +124,10 @@ private:
     std::array<CommandListProcessor, MaxRendererSessions> command_list_processors{};
     /// The streams which will receive the processed samples
     std::array<Sink::SinkStream*, MaxRendererSessions> streams{};
+    /// Command list captures of each session, while capture_audio_commands is enabled
+    std::array<std::unique_ptr<CommandCapture>, MaxRendererSessions> captures{};
+    /// Worker threads for the voice commands, created once parallel_voice_processing is used
+    std::unique_ptr<VoiceExecutor> voice_executor{};
     /// CPU Tick when the DSP was signalled to process, uses time rather than tick
     u64 signalled_tick{0};
 };
@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "audio_core/adsp/apps/audio_renderer/command_capture.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 't', 'r', 'n', 'a', 'c', 'a', 'p'};
+constexpr u32 CAPTURE_VERSION = 1;
+
+/// Upper bound of the sizes accepted from a file, above any work buffer a game can give
+constexpr u64 MAX_CAPTURED_SIZE = 1ULL << 30;
+constexpr u32 MAX_CAPTURED_READS = 1U << 20;
+
+/// Work buffers are mostly empty, the fastest level keeps the DSP thread on time
+constexpr s32 COMPRESSION_LEVEL = 1;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct ListHeader {
+    u64 workbuffer_address;
+    u64 workbuffer_size;
+    u64 compressed_size;
+    u64 commands_offset;
+    u64 commands_size;
+    u32 num_reads;
+    u32 reserved;
+};
+static_assert(sizeof(ListHeader) == 48);
+
+struct ReadHeader {
+    u64 address;
+    u64 size;
+};
+static_assert(sizeof(ReadHeader) == 16);
+
+/// Sorts the reads by address and merges the overlapping and adjacent ones
+void MergeReads(std::vector<CapturedRead>& reads) {
+    std::ranges::stable_sort(reads, {}, &CapturedRead::address);
+    std::vector<CapturedRead> merged;
+    for (CapturedRead& read : reads) {
+        if (!merged.empty()) {
+            CapturedRead& last = merged.back();
+            const CpuAddr last_end = last.address + last.data.size();
+            if (read.address <= last_end) {
+                const CpuAddr read_end = read.address + read.data.size();
+                if (read_end > last_end) {
+                    const auto tail{static_cast<std::ptrdiff_t>(read_end - last_end)};
+                    last.data.insert(last.data.end(), read.data.end() - tail, read.data.end());
+                }
+                continue;
+            }
+        }
+        merged.push_back(std::move(read));
+    }
+    reads = std::move(merged);
+}
+} // Anonymous namespace
+
+CommandCapture::CommandCapture(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Write} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(Audio_DSP, "Unable to create audio command capture at {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = CAPTURE_VERSION,
+        .reserved = 0,
+    };
+    if (!file.WriteObject(header)) {
+        file.Close();
+        return;
+    }
+    LOG_INFO(Audio_DSP, "Capturing audio commands to {}", Common::FS::PathToUTF8String(path));
+}
+
+CommandCapture::~CommandCapture() = default;
+
+void CommandCapture::BeginCommandList(CommandListProcessor& processor) {
+    in_list = false;
+    current.reads.clear();
+    if (!file.IsOpen()) {
+        return;
+    }
+    const std::span<u8> workbuffer{processor.header->workbuffer};
+    const auto header_address{reinterpret_cast<CpuAddr>(processor.header)};
+    const auto workbuffer_address{reinterpret_cast<CpuAddr>(workbuffer.data())};
+    if (header_address < workbuffer_address ||
+        header_address - workbuffer_address >= workbuffer.size()) {
+        LOG_ERROR(Audio_DSP, "Command list is not in the renderer work buffer, not capturing it");
+        return;
+    }
+
+    current.workbuffer_address = workbuffer_address;
+    current.workbuffer_size = workbuffer.size();
+    current.compressed_workbuffer =
+        Common::Compression::CompressDataZSTD(workbuffer.data(), workbuffer.size(),
+                                             COMPRESSION_LEVEL);
+    current.commands_offset = header_address - workbuffer_address;
+    current.commands_size = processor.commands_buffer_size;
+
+    process_memory = processor.memory;
+    processor.memory = this;
+    in_list = true;
+}
+
+void CommandCapture::EndCommandList() {
+    if (!in_list || !file.IsOpen()) {
+        return;
+    }
+    in_list = false;
+    MergeReads(current.reads);
+
+    const ListHeader header{
+        .workbuffer_address = current.workbuffer_address,
+        .workbuffer_size = current.workbuffer_size,
+        .compressed_size = current.compressed_workbuffer.size(),
+        .commands_offset = current.commands_offset,
+        .commands_size = current.commands_size,
+        .num_reads = static_cast<u32>(current.reads.size()),
+        .reserved = 0,
+    };
+    bool success = file.WriteObject(header);
+    success &= file.WriteSpan(std::span<const u8>(current.compressed_workbuffer)) ==
+               current.compressed_workbuffer.size();
+    for (const CapturedRead& read : current.reads) {
+        success &= file.WriteObject(ReadHeader{read.address, read.data.size()});
+        success &= file.WriteSpan(std::span<const u8>(read.data)) == read.data.size();
+    }
+    if (!success) {
+        LOG_ERROR(Audio_DSP, "Failed to write audio command capture, stopping");
+        file.Close();
+    }
+}
+
+void CommandCapture::ReadBlock(CpuAddr address, void* data, u64 size) {
+    process_memory->ReadBlock(address, data, size);
+    if (in_list && size != 0) {
+        const u8* const bytes{static_cast<const u8*>(data)};
+        std::scoped_lock lock{reads_mutex};
+        current.reads.push_back({address, std::vector<u8>(bytes, bytes + size)});
+    }
+}
+
+void CommandCapture::WriteBlock(CpuAddr address, const void* data, u64 size) {
+    process_memory->WriteBlock(address, data, size);
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Read} {
+    FileHeader header{};
+    is_valid = file.IsOpen() && file.ReadObject(header) && header.magic == MAGIC_NUMBER &&
+               header.version == CAPTURE_VERSION;
+}
+
+CaptureReader::~CaptureReader() = default;
+
+bool CaptureReader::Next(CapturedCommandList& list) {
+    ListHeader header{};
+    if (!is_valid || !file.ReadObject(header) || header.workbuffer_size > MAX_CAPTURED_SIZE ||
+        header.compressed_size > MAX_CAPTURED_SIZE || header.num_reads > MAX_CAPTURED_READS ||
+        header.commands_offset >= header.workbuffer_size ||
+        header.commands_size > header.workbuffer_size - header.commands_offset) {
+        return false;
+    }
+    list.workbuffer_address = header.workbuffer_address;
+    list.workbuffer_size = header.workbuffer_size;
+    list.commands_offset = header.commands_offset;
+    list.commands_size = header.commands_size;
+    list.compressed_workbuffer.resize(header.compressed_size);
+    if (file.ReadSpan(std::span(list.compressed_workbuffer)) != header.compressed_size) {
+        return false;
+    }
+    list.reads.resize(header.num_reads);
+    for (CapturedRead& read : list.reads) {
+        ReadHeader read_header{};
+        if (!file.ReadObject(read_header) || read_header.size > MAX_CAPTURED_SIZE) {
+            return false;
+        }
+        read.address = read_header.address;
+        read.data.resize(read_header.size);
+        if (file.ReadSpan(std::span(read.data)) != read.data.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CapturedDspMemory::SetCommandList(const CapturedCommandList& list) {
+    blocks.clear();
+    for (const CapturedRead& read : list.reads) {
+        blocks.emplace(read.address, &read);
+    }
+}
+
+void CapturedDspMemory::ReadBlock(CpuAddr address, void* data, u64 size) {
+    u8* const out{static_cast<u8*>(data)};
+    std::memset(out, 0, size);
+
+    // Blocks are disjoint, start from the last one beginning at or before the address
+    auto it{blocks.upper_bound(address)};
+    if (it != blocks.begin()) {
+        --it;
+    }
+    const CpuAddr end{address + size};
+    for (; it != blocks.end() && it->first < end; ++it) {
+        const CapturedRead& block{*it->second};
+        const CpuAddr block_end{block.address + block.data.size()};
+        const CpuAddr copy_start{std::max(address, block.address)};
+        const CpuAddr copy_end{std::min(end, block_end)};
+        if (copy_start < copy_end) {
+            std::memcpy(out + (copy_start - address),
+                        block.data.data() + (copy_start - block.address), copy_end - copy_start);
+        }
+    }
+}
+
+void CapturedDspMemory::WriteBlock([[maybe_unused]] CpuAddr address,
+                                   [[maybe_unused]] const void* data, [[maybe_unused]] u64 size) {}
+
+std::filesystem::path NewCapturePath(u32 session_id) {
+    const auto dump_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::DumpDir)};
+    const auto capture_dir{dump_dir / "audio_captures"};
+    if (!Common::FS::CreateDir(dump_dir) || !Common::FS::CreateDir(capture_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create audio capture directories");
+    }
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return capture_dir /
+           fmt::format("{}_{}.audcap",
+                       std::chrono::duration_cast<std::chrono::seconds>(now).count(), session_id);
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
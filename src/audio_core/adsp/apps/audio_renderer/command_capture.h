@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/dsp_memory.h"
+#include "audio_core/common/common.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+class CommandListProcessor;
+
+/// Block of guest memory read by the commands of a captured list
+struct CapturedRead {
+    CpuAddr address{};
+    std::vector<u8> data;
+};
+
+/// Command list as the DSP received it, with the renderer state it works on
+struct CapturedCommandList {
+    /// Host address of the renderer work buffer when it was captured, commands point into it
+    CpuAddr workbuffer_address{};
+    u64 workbuffer_size{};
+    /// Contents of the work buffer before the list was processed, zstd compressed
+    std::vector<u8> compressed_workbuffer;
+    /// Offset of the command list header in the work buffer
+    u64 commands_offset{};
+    /// Size of the command list, including its header
+    u64 commands_size{};
+    std::vector<CapturedRead> reads;
+};
+
+/**
+ * Records the command lists processed for a renderer session to a file, so they can be run again
+ * without a guest by citron_audio_render_bench. The renderer work buffer holds the command list
+ * and all the state its commands point to (mix buffers, voice, effect and depop states...), it is
+ * stored before each list is processed, together with the guest memory the commands read while
+ * processing it.
+ *
+ * While capturing, the processor reads guest memory through the capture which forwards to the
+ * process memory.
+ */
+class CommandCapture final : public DspMemory {
+public:
+    explicit CommandCapture(const std::filesystem::path& path);
+    ~CommandCapture() override;
+
+    [[nodiscard]] bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /**
+     * Snapshot the work buffer of a newly initialized command list, and route the guest memory
+     * accesses of the processor through the capture.
+     *
+     * @param processor - Processor initialized with the list to capture.
+     */
+    void BeginCommandList(CommandListProcessor& processor);
+
+    /**
+     * Write the current command list to the file, once all of its commands were processed.
+     */
+    void EndCommandList();
+
+    void ReadBlock(CpuAddr address, void* data, u64 size) override;
+    void WriteBlock(CpuAddr address, const void* data, u64 size) override;
+
+private:
+    Common::FS::IOFile file;
+    DspMemory* process_memory{};
+    /// Voices are processed on several threads, see VoiceExecutor
+    std::mutex reads_mutex;
+    CapturedCommandList current{};
+    bool in_list{};
+};
+
+/// Reads back a file written by CommandCapture
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::filesystem::path& path);
+    ~CaptureReader();
+
+    /// Returns false if the file can't be opened or is not a capture of a supported version
+    [[nodiscard]] bool IsValid() const {
+        return is_valid;
+    }
+
+    /// Reads the next command list, returns false at the end of the file or on truncated data
+    [[nodiscard]] bool Next(CapturedCommandList& list);
+
+private:
+    Common::FS::IOFile file;
+    bool is_valid{};
+};
+
+/**
+ * Guest memory of a captured command list. Reads are served from the captured blocks, memory
+ * which wasn't captured reads as zero, writes are dropped.
+ */
+class CapturedDspMemory final : public DspMemory {
+public:
+    void SetCommandList(const CapturedCommandList& list);
+
+    void ReadBlock(CpuAddr address, void* data, u64 size) override;
+    void WriteBlock(CpuAddr address, const void* data, u64 size) override;
+
+private:
+    /// Captured blocks by guest address
+    std::map<CpuAddr, const CapturedRead*> blocks;
+};
+
+/// Path of a new capture file in the dump directory, for the given renderer session
+[[nodiscard]] std::filesystem::path NewCapturePath(u32 session_id);
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -1,23 +1,30 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <string>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_executor.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/command/commands.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_process.h"
-#include "core/memory.h"
 
 namespace AudioCore::ADSP::AudioRenderer {
 
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
                                       CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
+    process_memory.SetMemory(process.GetMemory());
+    Initialize(system_, process_memory, buffer, size, stream_);
+}
+
+void CommandListProcessor::Initialize(Core::System& system_, DspMemory& memory_, CpuAddr buffer,
+                                      u64 size, Sink::SinkStream* stream_) {
     system = &system_;
-    memory = &process.GetMemory();
+    memory = &memory_;
     stream = stream_;
     header = reinterpret_cast<Renderer::CommandListHeader*>(buffer);
     commands = reinterpret_cast<u8*>(buffer + sizeof(Renderer::CommandListHeader));
@@ -56,6 +63,15 @@ u64 CommandListProcessor::Process(u32 session_id) {
     std::string dump{fmt::format("\nSession {}\n", session_id)};
 
     for (u32 index = 0; index < command_count; index++) {
+        if (voice_executor != nullptr) {
+            const u32 voice_command_count{
+                voice_executor->Process(*this, command_count - index, dump)};
+            if (voice_command_count > 0) {
+                index += voice_command_count - 1;
+                continue;
+            }
+        }
+
         auto& command{*reinterpret_cast<Renderer::ICommand*>(commands)};
 
         if (command.magic != 0xCAFEBABE) {
@@ -83,7 +99,7 @@ u64 CommandListProcessor::Process(u32 session_id) {
         }
 
         if (command.enabled) {
-            command.Process(*this);
+            ProcessCommand(command);
         } else {
             dump += fmt::format("\tDisabled!\n");
         }
@@ -101,4 +117,17 @@ u64 CommandListProcessor::Process(u32 session_id) {
     return end_time - start_time_;
 }
 
+void CommandListProcessor::ProcessCommand(Renderer::ICommand& command) {
+    if (command_timings != nullptr) [[unlikely]] {
+        const auto command_start{std::chrono::steady_clock::now()};
+        command.Process(*this);
+        auto& timing{(*command_timings)[static_cast<size_t>(command.type) % CommandIdCount]};
+        timing.host_time += std::chrono::steady_clock::now() - command_start;
+        timing.estimated_time += command.estimated_process_time;
+        timing.count++;
+    } else {
+        command.Process(*this);
+    }
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
@@ -3,16 +3,17 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <span>
 
+#include "audio_core/adsp/apps/audio_renderer/dsp_memory.h"
 #include "audio_core/common/common.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/icommand.h"
 #include "common/common_types.h"
 
 namespace Core {
-namespace Memory {
-class Memory;
-}
 class System;
 } // namespace Core
 
@@ -30,6 +31,21 @@ struct CommandListHeader;
 }
 
 namespace ADSP::AudioRenderer {
+class VoiceExecutor;
+
+/// Host time spent processing one type of command, next to the time the renderer estimated
+struct CommandTiming {
+    u64 count{};
+    std::chrono::nanoseconds host_time{};
+    /// Sum of ICommand::estimated_process_time, in ADSP ticks
+    u64 estimated_time{};
+};
+
+/// Number of command types, see Renderer::CommandId
+constexpr size_t CommandIdCount{
+    static_cast<size_t>(Renderer::CommandId::MultiTapBiquadFilterAndMix) + 1};
+
+using CommandTimings = std::array<CommandTiming, CommandIdCount>;
 
 /**
  * A processor for command lists given to the AudioRenderer.
@@ -39,12 +55,26 @@ public:
     /**
      * Initialize the processor.
      *
+     * @param system  - The core system.
+     * @param process - The process which sent the command list, its memory is used by the
+     *                  commands.
+     * @param buffer  - The command buffer to process.
+     * @param size    - The size of the buffer.
+     * @param stream  - The stream to be used for sending the samples.
+     */
+    void Initialize(Core::System& system, Kernel::KProcess& process, CpuAddr buffer, u64 size,
+                    Sink::SinkStream* stream);
+
+    /**
+     * Initialize the processor with the given guest memory.
+     *
      * @param system - The core system.
+     * @param memory - Guest memory used by the commands.
      * @param buffer - The command buffer to process.
      * @param size   - The size of the buffer.
      * @param stream - The stream to be used for sending the samples.
      */
-    void Initialize(Core::System& system, Kernel::KProcess& process, CpuAddr buffer, u64 size,
+    void Initialize(Core::System& system, DspMemory& memory, CpuAddr buffer, u64 size,
                     Sink::SinkStream* stream);
 
     /**
@@ -77,10 +107,19 @@ public:
      */
     u64 Process(u32 session_id);
 
+    /**
+     * Process a single command of the list, accumulating its time into command_timings if set.
+     *
+     * @param command - The command to process.
+     */
+    void ProcessCommand(Renderer::ICommand& command);
+
     /// Core system
     Core::System* system{};
-    /// Core memory
-    Core::Memory::Memory* memory{};
+    /// Guest memory used by the commands
+    DspMemory* memory{};
+    /// Memory of the process which sent the command list
+    ProcessDspMemory process_memory{};
     /// Stream for the processed samples
     Sink::SinkStream* stream{};
     /// Header info for this command list
@@ -111,6 +150,10 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+    /// If set, host time of each command is accumulated here, used by citron_audio_render_bench
+    CommandTimings* command_timings{};
+    /// If set, the voice commands are fanned out to its worker threads
+    VoiceExecutor* voice_executor{};
 };
 
 } // namespace ADSP::AudioRenderer
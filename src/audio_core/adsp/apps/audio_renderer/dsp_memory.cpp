@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_core/adsp/apps/audio_renderer/dsp_memory.h"
+#include "core/memory.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+void ProcessDspMemory::ReadBlock(CpuAddr address, void* data, u64 size) {
+    memory->ReadBlockUnsafe(address, data, size);
+}
+
+void ProcessDspMemory::WriteBlock(CpuAddr address, const void* data, u64 size) {
+    memory->WriteBlockUnsafe(address, data, size);
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
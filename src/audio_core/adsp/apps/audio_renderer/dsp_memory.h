@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "audio_core/common/common.h"
+#include "common/common_types.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+/**
+ * Guest memory as seen by the commands, for the wave buffers, aux and capture buffers.
+ * Backed by the memory of the process which sent the command list while a game runs, and by
+ * captured memory when command lists are replayed without a guest.
+ */
+class DspMemory {
+public:
+    virtual ~DspMemory() = default;
+
+    /**
+     * Read a block of guest memory.
+     *
+     * @param address - Guest address to read from.
+     * @param data    - Output buffer.
+     * @param size    - Number of bytes to read.
+     */
+    virtual void ReadBlock(CpuAddr address, void* data, u64 size) = 0;
+
+    /**
+     * Write a block of guest memory.
+     *
+     * @param address - Guest address to write to.
+     * @param data    - Input buffer.
+     * @param size    - Number of bytes to write.
+     */
+    virtual void WriteBlock(CpuAddr address, const void* data, u64 size) = 0;
+
+    void Write32(CpuAddr address, u32 value) {
+        WriteBlock(address, &value, sizeof(value));
+    }
+};
+
+/**
+ * Memory of the process which sent the command list.
+ */
+class ProcessDspMemory final : public DspMemory {
+public:
+    void SetMemory(Core::Memory::Memory& memory_) {
+        memory = &memory_;
+    }
+
+    void ReadBlock(CpuAddr address, void* data, u64 size) override;
+    void WriteBlock(CpuAddr address, const void* data, u64 size) override;
+
+private:
+    Core::Memory::Memory* memory{};
+};
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <mutex>
+
+#include "audio_core/adsp/apps/audio_renderer/voice_executor.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "audio_core/renderer/command/performance/performance.h"
+#include "common/settings.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+namespace {
+/// Below this many voices in a row, the voices run on the calling thread
+constexpr size_t MinParallelVoices = 4;
+
+enum class VoiceCommandKind {
+    /// Not a voice command, ends the voices
+    None,
+    /// Runs before the voices
+    Pre,
+    /// Runs on the chain of the voice it measures
+    Performance,
+    /// Starts the chain of a voice channel
+    Start,
+    /// Part of the chain started by the previous Start command
+    Chain,
+};
+
+VoiceCommandKind GetVoiceCommandKind(Renderer::CommandId type) {
+    using Renderer::CommandId;
+    switch (type) {
+    case CommandId::DepopPrepare:
+        return VoiceCommandKind::Pre;
+    case CommandId::Performance:
+        return VoiceCommandKind::Performance;
+    case CommandId::DataSourcePcmInt16Version1:
+    case CommandId::DataSourcePcmInt16Version2:
+    case CommandId::DataSourcePcmFloatVersion1:
+    case CommandId::DataSourcePcmFloatVersion2:
+    case CommandId::DataSourceAdpcmVersion1:
+    case CommandId::DataSourceAdpcmVersion2:
+        return VoiceCommandKind::Start;
+    case CommandId::Volume:
+    case CommandId::VolumeRamp:
+    case CommandId::BiquadFilter:
+    case CommandId::MultiTapBiquadFilter:
+    case CommandId::Mix:
+    case CommandId::MixRamp:
+    case CommandId::MixRampGrouped:
+        return VoiceCommandKind::Chain;
+    default:
+        return VoiceCommandKind::None;
+    }
+}
+} // Anonymous namespace
+
+VoiceExecutor::VoiceExecutor(size_t num_threads)
+    : slots(num_threads + 1), workers{num_threads, "DSP_AudioRenderer_Voice"} {}
+
+VoiceExecutor::~VoiceExecutor() = default;
+
+u32 VoiceExecutor::Process(CommandListProcessor& processor, u32 max_commands,
+                           std::string& dump) {
+    commands.clear();
+    pre_commands.clear();
+    post_commands.clear();
+    voice_commands.clear();
+    voice_starts.clear();
+
+    // Commands are only taken while they are valid, the processor reports the invalid ones
+    const u8* const list_end{reinterpret_cast<u8*>(processor.header) +
+                             processor.commands_buffer_size};
+    u8* position{processor.commands};
+    u32 node_id{};
+    bool in_voice{};
+    u32 count{};
+    for (; count < max_commands; count++) {
+        if (position + sizeof(Renderer::ICommand) > list_end) {
+            break;
+        }
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(position)};
+        const auto size{static_cast<size_t>(std::max<s16>(command.size, 0))};
+        if (command.magic != Renderer::CommandMagic || size < sizeof(Renderer::ICommand) ||
+            position + size > list_end) {
+            break;
+        }
+
+        const auto kind{GetVoiceCommandKind(command.type)};
+        if (kind == VoiceCommandKind::None ||
+            (kind == VoiceCommandKind::Chain && (!in_voice || command.node_id != node_id))) {
+            break;
+        }
+        if (!command.Verify(processor)) {
+            break;
+        }
+
+        if (Settings::values.dump_audio_commands) {
+            command.Dump(processor, dump);
+            if (!command.enabled) {
+                dump += "\tDisabled!\n";
+            }
+        }
+
+        if (kind == VoiceCommandKind::Start) {
+            in_voice = true;
+            node_id = command.node_id;
+            voice_starts.push_back(voice_commands.size());
+        }
+        if (command.enabled) {
+            commands.push_back(&command);
+            if (kind == VoiceCommandKind::Pre) {
+                pre_commands.push_back(&command);
+            } else if (kind == VoiceCommandKind::Performance) {
+                // Stops of the current voice end its chain. The other ones wait in the post
+                // commands for the voice command they measure, which moves them to its chain, and
+                // run after the voices if none follows
+                const auto& performance{static_cast<Renderer::PerformanceCommand&>(command)};
+                if (in_voice && command.node_id == node_id && post_commands.empty() &&
+                    performance.state == Renderer::PerformanceState::Stop) {
+                    voice_commands.push_back(&command);
+                } else {
+                    post_commands.push_back(&command);
+                }
+            } else {
+                voice_commands.insert(voice_commands.end(), post_commands.begin(),
+                                      post_commands.end());
+                post_commands.clear();
+                voice_commands.push_back(&command);
+            }
+        }
+        position += size;
+    }
+
+    if (voice_starts.size() < MinParallelVoices || slots.size() == 1) {
+        for (auto* command : commands) {
+            processor.ProcessCommand(*command);
+        }
+    } else {
+        for (auto* command : pre_commands) {
+            processor.ProcessCommand(*command);
+        }
+
+        const size_t buffers_size{static_cast<size_t>(processor.buffer_count) *
+                                  processor.sample_count};
+        for (Slot& slot : slots) {
+            slot.samples.resize(buffers_size);
+            slot.used = false;
+
+            auto& slot_processor{slot.processor};
+            slot_processor.system = processor.system;
+            slot_processor.memory = processor.memory;
+            slot_processor.header = processor.header;
+            slot_processor.sample_count = processor.sample_count;
+            slot_processor.target_sample_rate = processor.target_sample_rate;
+            slot_processor.mix_buffers = slot.samples;
+            slot_processor.buffer_count = processor.buffer_count;
+            slot_processor.start_time = processor.start_time;
+            slot_processor.current_processing_time = processor.current_processing_time;
+            slot_processor.command_timings =
+                processor.command_timings != nullptr ? &slot.timings : nullptr;
+        }
+
+        voice_starts.push_back(voice_commands.size());
+        next_voice = 0;
+        for (size_t index = 1; index < slots.size(); index++) {
+            workers.QueueWork([this, index] { RunVoices(slots[index]); });
+        }
+        RunVoices(slots[0]);
+        workers.WaitForRequests();
+
+        // The voice channel buffers are after the mix buffers, see Renderer::System::Initialize
+        const u32 mix_buffer_count{
+            processor.buffer_count > MaxChannels ? processor.buffer_count - MaxChannels : 0};
+        const size_t mix_size{static_cast<size_t>(mix_buffer_count) * processor.sample_count};
+        const auto output{processor.mix_buffers.first(mix_size)};
+        for (Slot& slot : slots) {
+            if (!slot.used) {
+                continue;
+            }
+            for (size_t i = 0; i < mix_size; i++) {
+                output[i] += slot.samples[i];
+            }
+            if (processor.command_timings != nullptr) {
+                for (size_t type = 0; type < CommandIdCount; type++) {
+                    auto& timing{(*processor.command_timings)[type]};
+                    timing.count += slot.timings[type].count;
+                    timing.host_time += slot.timings[type].host_time;
+                    timing.estimated_time += slot.timings[type].estimated_time;
+                }
+                slot.timings = {};
+            }
+        }
+
+        for (auto* command : post_commands) {
+            processor.ProcessCommand(*command);
+        }
+    }
+
+    processor.commands = position;
+    processor.processed_command_count += count;
+    return count;
+}
+
+void VoiceExecutor::RunVoices(Slot& slot) {
+    for (size_t voice = next_voice++; voice + 1 < voice_starts.size(); voice = next_voice++) {
+        if (!slot.used) {
+            std::ranges::fill(slot.samples, 0);
+            slot.used = true;
+        }
+        for (size_t index = voice_starts[voice]; index < voice_starts[voice + 1]; index++) {
+            auto& command{*voice_commands[index]};
+            if (command.type == Renderer::CommandId::Performance) {
+                std::scoped_lock lock{performance_mutex};
+                slot.processor.ProcessCommand(command);
+            } else {
+                slot.processor.ProcessCommand(command);
+            }
+        }
+    }
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
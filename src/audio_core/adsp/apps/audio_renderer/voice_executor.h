@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+/**
+ * Runs the voice commands of a command list on a pool of worker threads.
+ *
+ * The commands of a voice channel, from its data source command to its mix commands, don't depend
+ * on the other voices, each of these chains runs on one thread. All voices decode into the same
+ * voice channel buffers placed after the mix buffers though, so each thread works on its own copy
+ * of the sample buffers, and the mix buffers it accumulated into are added to the ones of the list
+ * once all voices are done. Mixing is integer addition, so the result doesn't depend on the order
+ * the voices ran in.
+ *
+ * DepopPrepare commands read the previous samples the mix commands of their voice overwrite and
+ * accumulate into the shared depop buffer, they run first on the calling thread. Performance
+ * commands stay on the chain of the commands they bracket, so they measure the voice on the thread
+ * which ran it. They increment an entry count shared by all voices, only one of them runs at a
+ * time. The ones not followed by a voice command run last.
+ */
+class VoiceExecutor {
+public:
+    /**
+     * @param num_threads - Number of worker threads, the thread calling Process also runs voices.
+     */
+    explicit VoiceExecutor(size_t num_threads);
+    ~VoiceExecutor();
+
+    /**
+     * Process the voice commands at the current position of a command list, if any.
+     *
+     * @param processor    - Processor of the list, its commands point to the next command.
+     * @param max_commands - Number of commands left in the list.
+     * @param dump         - Dump of the list, appended to if dump_audio_commands is enabled.
+     *
+     * @return The number of commands processed, 0 if the next command doesn't start a voice.
+     */
+    u32 Process(CommandListProcessor& processor, u32 max_commands, std::string& dump);
+
+private:
+    /// State of a thread running voices
+    struct Slot {
+        /// Processor of the list, with the sample buffers of the slot
+        CommandListProcessor processor{};
+        std::vector<s32> samples;
+        CommandTimings timings{};
+        bool used{};
+    };
+
+    /**
+     * Run voices until there are none left.
+     *
+     * @param slot - State of the calling thread.
+     */
+    void RunVoices(Slot& slot);
+
+    /// Slot 0 is used by the thread calling Process, the others by the workers
+    std::vector<Slot> slots;
+    /// Enabled commands of the current voices, in list order
+    std::vector<Renderer::ICommand*> commands;
+    /// Commands which run on the calling thread before the voices
+    std::vector<Renderer::ICommand*> pre_commands;
+    /// Commands which run on the calling thread after the voices
+    std::vector<Renderer::ICommand*> post_commands;
+    /// Commands of the voice chains, chain i is [voice_starts[i], voice_starts[i + 1])
+    std::vector<Renderer::ICommand*> voice_commands;
+    std::vector<size_t> voice_starts;
+    /// Next chain to run
+    std::atomic<size_t> next_voice{};
+    /// Serializes the performance commands of the chains
+    std::mutex performance_mutex;
+    Common::ThreadWorker workers;
+};
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_core/common/simd_level.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace AudioCore {
+
+bool IsSimdLevelSupported(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+#if defined(ARCHITECTURE_x86_64)
+    case SimdLevel::SSE41:
+        return Common::GetCPUCaps().sse4_1;
+    case SimdLevel::AVX2:
+        return Common::GetCPUCaps().avx2;
+#elif defined(ARCHITECTURE_arm64)
+    case SimdLevel::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+SimdLevel GetHostSimdLevel() {
+    static const SimdLevel host_level = [] {
+        for (const SimdLevel level : {SimdLevel::AVX2, SimdLevel::SSE41, SimdLevel::NEON}) {
+            if (IsSimdLevelSupported(level)) {
+                return level;
+            }
+        }
+        return SimdLevel::Scalar;
+    }();
+    return host_level;
+}
+
+} // namespace AudioCore
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace AudioCore {
+
+/// Instruction sets the vectorized DSP loops of the audio renderer are written for
+enum class SimdLevel {
+    Scalar,
+    SSE41,
+    AVX2,
+    NEON,
+};
+
+/// Returns true when the host can run code of the given level
+[[nodiscard]] bool IsSimdLevelSupported(SimdLevel level);
+
+/// Best level supported by the host, detected once
+[[nodiscard]] SimdLevel GetHostSimdLevel();
+
+} // namespace AudioCore
@@ -17,6 +17,8 @@ struct CommandListHeader {
     s16 buffer_count;
     u32 sample_count;
     u32 sample_rate;
+    /// Renderer work buffer holding this list and all the state its commands point to
+    std::span<u8> workbuffer;
 };
 
 } // namespace AudioCore::Renderer
@@ -4,34 +4,33 @@
 #include <array>
 #include <vector>
 
+#include "audio_core/adsp/apps/audio_renderer/dsp_memory.h"
 #include "audio_core/renderer/command/data_source/decode.h"
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
 #include "audio_core/renderer/command/resample/resample.h"
 #include "common/fixed_point.h"
 #include "common/logging/log.h"
 #include "common/scratch_buffer.h"
-#include "core/guest_memory.h"
-#include "core/memory.h"
 
 namespace AudioCore::Renderer {
 
 constexpr u32 TempBufferSize = 0x3F00;
+/// Samples past the decoded ones kept at zero, covering the furthest the resampler reads ahead
+constexpr u32 TempBufferMargin = 0x10;
 constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 
 /**
  * Decode PCM data. Only s16 or f32 is supported.
  *
  * @tparam T         - Type to decode. Only s16 and f32 are supported.
- * @param memory     - Core memory for reading samples.
+ * @param memory     - Guest memory for reading samples.
  * @param out_buffer - Output mix buffer to receive the samples.
  * @param req        - Information for how to decode.
  * @return Number of samples decoded.
  */
 template <typename T>
-static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
+static u32 DecodePcm(ADSP::AudioRenderer::DspMemory& memory, std::span<s16> out_buffer,
                      const DecodeArg& req) {
-    constexpr s32 min{std::numeric_limits<s16>::min()};
-    constexpr s32 max{std::numeric_limits<s16>::max()};
-
     if (req.buffer == 0 || req.buffer_size == 0) {
         return 0;
     }
@@ -40,52 +39,32 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         return 0;
     }
 
+    const u32 channel_count{static_cast<u32>(req.channel_count)};
+    const u32 target_channel{static_cast<u32>(req.target_channel)};
+    if (target_channel >= channel_count) {
+        LOG_ERROR(Service_Audio, "Invalid target channel, expected below {}, got {}",
+                  channel_count, target_channel);
+        return 0;
+    }
+
     auto samples_to_decode{
         std::min(req.samples_to_read, req.end_offset - req.start_offset - req.offset)};
-    u32 channel_count{static_cast<u32>(req.channel_count)};
-
-    switch (req.channel_count) {
-    default: {
-        const VAddr source{req.buffer +
-                           (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
-        const u64 size{channel_count * samples_to_decode};
-
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, size);
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                out_buffer[i] = samples[i * channel_count + req.target_channel];
-            }
-        }
-    } break;
-
-    case 1:
-        if (req.target_channel != 0) {
-            LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}",
-                      req.target_channel);
-            return 0;
-        }
-
-        const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, samples_to_decode);
-
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
-        }
-        break;
+    static thread_local Common::ScratchBuffer<T> samples;
+
+    // Every channel of the span is read at once, the target one is picked while converting.
+    const VAddr source{req.buffer +
+                       (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
+    const u64 size{channel_count * samples_to_decode};
+    samples.resize_destructive(size);
+    memory.ReadBlock(source, samples.data(), size * sizeof(T));
+
+    const auto& kernels{DecodeKernels::GetTable()};
+    if constexpr (std::is_floating_point_v<T>) {
+        kernels.pcm_float(out_buffer.data(), samples.data(), channel_count, target_channel,
+                          samples_to_decode);
+    } else {
+        kernels.pcm_int16(out_buffer.data(), samples.data(), channel_count, target_channel,
+                          samples_to_decode);
     }
 
     return samples_to_decode;
@@ -94,14 +73,14 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
 /**
  * Decode ADPCM data.
  *
- * @param memory     - Core memory for reading samples.
+ * @param memory     - Guest memory for reading samples.
  * @param out_buffer - Output mix buffer to receive the samples.
  * @param req        - Information for how to decode.
  * @return Number of samples decoded.
  */
-static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
+static u32 DecodeAdpcm(ADSP::AudioRenderer::DspMemory& memory, std::span<s16> out_buffer,
                        const DecodeArg& req) {
-    constexpr u32 SamplesPerFrame{14};
+    constexpr u32 SamplesPerFrame{DecodeKernels::AdpcmSamplesPerFrame};
     constexpr u32 NibblesPerFrame{16};
 
     if (req.buffer == 0 || req.buffer_size == 0) {
@@ -139,19 +118,23 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         position_in_frame += 2;
     }
 
-    const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
-        memory, req.buffer + position_in_frame / 2, size);
+    // Read every byte the samples span at once, up to the one holding the last sample.
+    const auto last_sample{start_pos + samples_to_process - 1};
+    const auto last_position{(last_sample / SamplesPerFrame) * NibblesPerFrame + 2 +
+                             last_sample % SamplesPerFrame};
+    const auto size{last_position / 2 - position_in_frame / 2 + 1};
+    static thread_local Common::ScratchBuffer<u8> wavebuffer;
+    wavebuffer.resize_destructive(size);
+    memory.ReadBlock(req.buffer + position_in_frame / 2, wavebuffer.data(), size);
 
     auto context{req.adpcm_context};
     auto header{context->header};
-    u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
-    u8 scale{static_cast<u8>(header & 0xFU)};
-    s32 coeff0{req.coefficients[coeff_index * 2 + 0]};
-    s32 coeff1{req.coefficients[coeff_index * 2 + 1]};
+    u32 coeff_index{DecodeKernels::AdpcmCoefficientIndex(header)};
+    u32 scale{DecodeKernels::AdpcmScale(header)};
+    s32 coeff0{req.coefficients[coeff_index + 0]};
+    s32 coeff1{req.coefficients[coeff_index + 1]};
 
-    auto yn0{context->yn0};
-    auto yn1{context->yn1};
+    std::array<s16, 2> history{context->yn0, context->yn1};
 
     static constexpr std::array<s32, 16> Steps{
         0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
@@ -159,43 +142,40 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
 
     const auto decode_sample = [&](const s32 code) -> s16 {
         const auto xn = code * (1 << scale);
-        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
+        const auto prediction = coeff0 * history[0] + coeff1 * history[1];
         const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
         const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
-        yn1 = yn0;
-        yn0 = static_cast<s16>(saturated);
-        return yn0;
+        history[1] = history[0];
+        history[0] = static_cast<s16>(saturated);
+        return history[0];
     };
 
+    const auto& kernels{DecodeKernels::GetTable()};
     u32 read_index{0};
     u32 write_index{0};
 
     while (samples_to_read > 0) {
         // Are we at a new frame?
         if ((position_in_frame % NibblesPerFrame) == 0) {
-            header = wavebuffer[read_index++];
-            coeff_index = (header >> 4) & 0xF;
-            scale = header & 0xF;
-            coeff0 = req.coefficients[coeff_index * 2 + 0];
-            coeff1 = req.coefficients[coeff_index * 2 + 1];
-            position_in_frame += 2;
-
-            // Can we consume all of this frame's samples?
-            if (samples_to_read >= SamplesPerFrame) {
-                // Can grab all samples until the next header
-                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
-                    auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
-                    auto code1{Steps[wavebuffer[read_index] & 0xF]};
-                    read_index++;
-
-                    out_buffer[write_index++] = decode_sample(code0);
-                    out_buffer[write_index++] = decode_sample(code1);
-                }
-
-                position_in_frame += SamplesPerFrame;
-                samples_to_read -= SamplesPerFrame;
+            // Decode all the frames we can consume entirely at once
+            const u32 frame_count{samples_to_read / SamplesPerFrame};
+            if (frame_count > 0) {
+                kernels.adpcm(&out_buffer[write_index], &wavebuffer[read_index], frame_count,
+                              req.coefficients, history);
+                read_index += frame_count * DecodeKernels::AdpcmFrameSize;
+                header = wavebuffer[read_index - DecodeKernels::AdpcmFrameSize];
+                write_index += frame_count * SamplesPerFrame;
+                position_in_frame += frame_count * NibblesPerFrame;
+                samples_to_read -= frame_count * SamplesPerFrame;
                 continue;
             }
+
+            header = wavebuffer[read_index++];
+            coeff_index = DecodeKernels::AdpcmCoefficientIndex(header);
+            scale = DecodeKernels::AdpcmScale(header);
+            coeff0 = req.coefficients[coeff_index + 0];
+            coeff1 = req.coefficients[coeff_index + 1];
+            position_in_frame += 2;
         }
 
         // Decode a single sample
@@ -214,8 +194,8 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
     }
 
     context->header = header;
-    context->yn0 = yn0;
-    context->yn1 = yn1;
+    context->yn0 = history[0];
+    context->yn1 = history[1];
 
     return samples_to_process;
 }
@@ -224,10 +204,11 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
  * Decode implementation.
  * Decode wavebuffers according to the given args.
  *
- * @param memory - Core memory to read data from.
+ * @param memory - Guest memory to read data from.
  * @param args   - The wavebuffer data, and information for how to decode it.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args) {
+void DecodeFromWaveBuffers(ADSP::AudioRenderer::DspMemory& memory,
+                           const DecodeFromWaveBuffersArgs& args) {
     static constexpr auto EndWaveBuffer = [](auto& voice_state, auto& wavebuffer, auto& index,
                                              auto& played_samples, auto& consumed) -> void {
         voice_state.wave_buffer_valid[index] = false;
@@ -270,7 +251,15 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     u32 offset{voice_state.offset};
 
     auto output_buffer{args.output};
-    std::array<s16, TempBufferSize> temp_buffer{};
+    // Only the samples the resampler reads are cleared, not the whole buffer, on every call
+    static thread_local std::array<s16, TempBufferSize + TempBufferMargin> temp_buffer;
+
+    // The coefficients can't change while the voice is decoded, read them once
+    DecodeKernels::AdpcmCoefficients coefficients{};
+    if (args.sample_format == SampleFormat::Adpcm) {
+        memory.ReadBlock(args.data_address, coefficients.data(),
+                         std::min<u64>(args.data_size, sizeof(coefficients)));
+    }
 
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
@@ -304,8 +293,8 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
 
             if (offset == 0 && args.sample_format == SampleFormat::Adpcm &&
                 wavebuffer.context != 0) {
-                memory.ReadBlockUnsafe(wavebuffer.context, &voice_state.adpcm_context,
-                                       wavebuffer.context_size);
+                memory.ReadBlock(wavebuffer.context, &voice_state.adpcm_context,
+                                 wavebuffer.context_size);
             }
 
             auto start_offset{wavebuffer.start_offset};
@@ -347,7 +336,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
 
             case SampleFormat::Adpcm: {
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
-                memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
+                decode_arg.coefficients = coefficients;
                 samples_decoded = DecodeAdpcm(
                     memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
                     decode_arg);
@@ -401,7 +390,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
             }
         } else {
             std::memset(&temp_buffer[temp_buffer_pos], 0,
-                        (samples_to_read - samples_read) * sizeof(s16));
+                        (samples_to_read - samples_read + TempBufferMargin) * sizeof(s16));
 
             Resample(output_buffer, temp_buffer, sample_rate_ratio, fraction, samples_to_write,
                      args.src_quality);
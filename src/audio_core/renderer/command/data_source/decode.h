@@ -11,8 +11,8 @@
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/common_types.h"
 
-namespace Core::Memory {
-class Memory;
+namespace AudioCore::ADSP::AudioRenderer {
+class DspMemory;
 }
 
 namespace AudioCore::Renderer {
@@ -51,9 +51,10 @@ struct DecodeArg {
 /**
  * Decode wavebuffers according to the given args.
  *
- * @param memory - Core memory to read data from.
+ * @param memory - Guest memory to read data from.
  * @param args - The wavebuffer data, and information for how to decode it.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args);
+void DecodeFromWaveBuffers(ADSP::AudioRenderer::DspMemory& memory,
+                           const DecodeFromWaveBuffersArgs& args);
 
 } // namespace AudioCore::Renderer
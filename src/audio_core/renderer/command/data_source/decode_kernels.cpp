@@ -0,0 +1,286 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
+#include "common/assert.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCore::Renderer::DecodeKernels {
+namespace {
+
+s16 FloatToSample(f32 sample) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    return static_cast<s16>(
+        std::clamp(static_cast<s32>(sample * std::numeric_limits<s16>::max()), min, max));
+}
+
+void PcmInt16Scalar(s16* output, const s16* input, u32 channel_count, u32 channel,
+                    u32 sample_count) {
+    if (channel_count == 1) {
+        std::copy_n(input, sample_count, output);
+        return;
+    }
+    for (u32 i = 0; i < sample_count; i++) {
+        output[i] = input[i * channel_count + channel];
+    }
+}
+
+void PcmFloatScalar(s16* output, const f32* input, u32 channel_count, u32 channel,
+                    u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        output[i] = FloatToSample(input[i * channel_count + channel]);
+    }
+}
+
+/**
+ * Run the predictor over the samples of a frame.
+ *
+ * @param output    - Output samples.
+ * @param residuals - Scaled nibbles of the frame, shifted left by 11 with the rounding term added.
+ * @param coeff0    - Coefficient of the previous sample.
+ * @param coeff1    - Coefficient of the sample before it.
+ * @param history   - Last two samples {yn0, yn1}, updated.
+ */
+void PredictFrame(s16* output, const s32* residuals, s32 coeff0, s32 coeff1,
+                  std::array<s16, 2>& history) {
+    s16 yn0{history[0]};
+    s16 yn1{history[1]};
+    for (u32 i = 0; i < AdpcmSamplesPerFrame; i++) {
+        const s32 prediction{coeff0 * yn0 + coeff1 * yn1};
+        const s32 sample{(residuals[i] + prediction) >> 11};
+        yn1 = yn0;
+        yn0 = static_cast<s16>(std::clamp<s32>(sample, -0x8000, 0x7FFF));
+        output[i] = yn0;
+    }
+    history = {yn0, yn1};
+}
+
+using UnpackAdpcmFrameFunction = void (*)(s32* residuals, const u8* data);
+
+/// Unpacks the nibbles of a frame into residuals, the header nibbles included
+void UnpackAdpcmFrameScalar(s32* residuals, const u8* data) {
+    const u32 shift{AdpcmScale(data[0]) + 11};
+    for (u32 i = 1; i < AdpcmFrameSize; i++) {
+        const auto byte{static_cast<s8>(data[i])};
+        const s32 high{byte >> 4};
+        const s32 low{static_cast<s8>(byte << 4) >> 4};
+        residuals[i * 2] = (high << shift) + 0x400;
+        residuals[i * 2 + 1] = (low << shift) + 0x400;
+    }
+}
+
+/// Unpacks and predicts whole frames
+template <UnpackAdpcmFrameFunction Unpack>
+void DecodeAdpcmFrames(s16* output, const u8* input, u32 frame_count,
+                       const AdpcmCoefficients& coefficients, std::array<s16, 2>& history) {
+    // Unpacked residuals of the whole frame, the samples start after the two header nibbles
+    alignas(16) std::array<s32, 16> residuals;
+    for (u32 frame = 0; frame < frame_count; frame++) {
+        const u8* const data{input + frame * AdpcmFrameSize};
+        Unpack(residuals.data(), data);
+        const u32 index{AdpcmCoefficientIndex(data[0])};
+        PredictFrame(output + frame * AdpcmSamplesPerFrame, residuals.data() + 2,
+                     coefficients[index], coefficients[index + 1], history);
+    }
+}
+
+void AdpcmScalar(s16* output, const u8* input, u32 frame_count,
+                 const AdpcmCoefficients& coefficients, std::array<s16, 2>& history) {
+    DecodeAdpcmFrames<UnpackAdpcmFrameScalar>(output, input, frame_count, coefficients, history);
+}
+
+#if defined(ARCHITECTURE_x86_64)
+
+CITRON_TARGET_SSE41 void PcmInt16SSE41(s16* output, const s16* input, u32 channel_count,
+                                       u32 channel, u32 sample_count) {
+    if (channel_count != 2) {
+        PcmInt16Scalar(output, input, channel_count, channel, sample_count);
+        return;
+    }
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2 + 8));
+        // Sign extend the wanted channel of each frame to 32 bits, packing can't saturate
+        if (channel == 0) {
+            low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+            high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+        } else {
+            low = _mm_srai_epi32(low, 16);
+            high = _mm_srai_epi32(high, 16);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+    }
+    PcmInt16Scalar(output + i, input + i * 2, channel_count, channel, sample_count - i);
+}
+
+/// Loads the samples of a channel from 4 frames of a mono or stereo buffer
+CITRON_TARGET_SSE41 __m128 LoadChannelSSE41(const f32* input, u32 channel_count, u32 channel) {
+    if (channel_count == 1) {
+        return _mm_loadu_ps(input);
+    }
+    const __m128 low = _mm_loadu_ps(input);
+    const __m128 high = _mm_loadu_ps(input + 4);
+    return channel == 0 ? _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))
+                        : _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+CITRON_TARGET_SSE41 void PcmFloatSSE41(s16* output, const f32* input, u32 channel_count,
+                                       u32 channel, u32 sample_count) {
+    if (channel_count > 2) {
+        PcmFloatScalar(output, input, channel_count, channel, sample_count);
+        return;
+    }
+    // Truncation gives INT_MIN for out of range values like the scalar conversion on x86, and
+    // packing saturates like the clamp.
+    const __m128 scale = _mm_set1_ps(std::numeric_limits<s16>::max());
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m128 low = LoadChannelSSE41(input + i * channel_count, channel_count, channel);
+        const __m128 high =
+            LoadChannelSSE41(input + (i + 4) * channel_count, channel_count, channel);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(low, scale)),
+                                         _mm_cvttps_epi32(_mm_mul_ps(high, scale))));
+    }
+    PcmFloatScalar(output + i, input + i * channel_count, channel_count, channel,
+                   sample_count - i);
+}
+
+/// Scales the low 4 nibbles of a vector into residuals
+CITRON_TARGET_SSE41 void StoreResidualsSSE41(s32* residuals, __m128i nibbles, __m128i shift) {
+    const __m128i scaled = _mm_sll_epi32(_mm_cvtepi16_epi32(nibbles), shift);
+    _mm_store_si128(reinterpret_cast<__m128i*>(residuals),
+                    _mm_add_epi32(scaled, _mm_set1_epi32(0x400)));
+}
+
+CITRON_TARGET_SSE41 void UnpackAdpcmFrameSSE41(s32* residuals, const u8* data) {
+    // Header and sample bytes widened to 16 bits, then each byte's nibbles sign extended
+    const __m128i bytes =
+        _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data)));
+    const __m128i high = _mm_srai_epi16(_mm_slli_epi16(bytes, 8), 12);
+    const __m128i low = _mm_srai_epi16(_mm_slli_epi16(bytes, 12), 12);
+    const __m128i first = _mm_unpacklo_epi16(high, low);
+    const __m128i second = _mm_unpackhi_epi16(high, low);
+
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(AdpcmScale(data[0]) + 11));
+    StoreResidualsSSE41(residuals, first, shift);
+    StoreResidualsSSE41(residuals + 4, _mm_srli_si128(first, 8), shift);
+    StoreResidualsSSE41(residuals + 8, second, shift);
+    StoreResidualsSSE41(residuals + 12, _mm_srli_si128(second, 8), shift);
+}
+
+void AdpcmSSE41(s16* output, const u8* input, u32 frame_count,
+                const AdpcmCoefficients& coefficients, std::array<s16, 2>& history) {
+    DecodeAdpcmFrames<UnpackAdpcmFrameSSE41>(output, input, frame_count, coefficients, history);
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+void PcmInt16NEON(s16* output, const s16* input, u32 channel_count, u32 channel,
+                  u32 sample_count) {
+    if (channel_count != 2) {
+        PcmInt16Scalar(output, input, channel_count, channel, sample_count);
+        return;
+    }
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const int16x8x2_t frames = vld2q_s16(input + i * 2);
+        vst1q_s16(output + i, channel == 0 ? frames.val[0] : frames.val[1]);
+    }
+    PcmInt16Scalar(output + i, input + i * 2, channel_count, channel, sample_count - i);
+}
+
+void PcmFloatNEON(s16* output, const f32* input, u32 channel_count, u32 channel,
+                  u32 sample_count) {
+    if (channel_count > 2) {
+        PcmFloatScalar(output, input, channel_count, channel, sample_count);
+        return;
+    }
+    // The conversion saturates and turns NaN into 0 like the scalar conversion on arm64, and
+    // narrowing saturates like the clamp.
+    const float32x4_t scale = vdupq_n_f32(std::numeric_limits<s16>::max());
+    const auto load = [&](u32 index) {
+        if (channel_count == 1) {
+            return vld1q_f32(input + index);
+        }
+        const float32x4x2_t frames = vld2q_f32(input + index * 2);
+        return channel == 0 ? frames.val[0] : frames.val[1];
+    };
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const int32x4_t low = vcvtq_s32_f32(vmulq_f32(load(i), scale));
+        const int32x4_t high = vcvtq_s32_f32(vmulq_f32(load(i + 4), scale));
+        vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+    PcmFloatScalar(output + i, input + i * channel_count, channel_count, channel,
+                   sample_count - i);
+}
+
+void UnpackAdpcmFrameNEON(s32* residuals, const u8* data) {
+    const int16x8_t bytes = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(data)));
+    const int16x8_t high = vshrq_n_s16(vshlq_n_s16(bytes, 8), 12);
+    const int16x8_t low = vshrq_n_s16(vshlq_n_s16(bytes, 12), 12);
+    const int16x8_t first = vzip1q_s16(high, low);
+    const int16x8_t second = vzip2q_s16(high, low);
+
+    const int32x4_t shift = vdupq_n_s32(static_cast<s32>(AdpcmScale(data[0]) + 11));
+    const int32x4_t rounding = vdupq_n_s32(0x400);
+    const auto store = [&](u32 offset, int16x4_t nibbles) {
+        vst1q_s32(residuals + offset, vaddq_s32(vshlq_s32(vmovl_s16(nibbles), shift), rounding));
+    };
+    store(0, vget_low_s16(first));
+    store(4, vget_high_s16(first));
+    store(8, vget_low_s16(second));
+    store(12, vget_high_s16(second));
+}
+
+void AdpcmNEON(s16* output, const u8* input, u32 frame_count,
+               const AdpcmCoefficients& coefficients, std::array<s16, 2>& history) {
+    DecodeAdpcmFrames<UnpackAdpcmFrameNEON>(output, input, frame_count, coefficients, history);
+}
+
+#endif
+
+constexpr Table ScalarTable{PcmInt16Scalar, PcmFloatScalar, AdpcmScalar};
+#if defined(ARCHITECTURE_x86_64)
+constexpr Table SSE41Table{PcmInt16SSE41, PcmFloatSSE41, AdpcmSSE41};
+#elif defined(ARCHITECTURE_arm64)
+constexpr Table NEONTable{PcmInt16NEON, PcmFloatNEON, AdpcmNEON};
+#endif
+
+} // Anonymous namespace
+
+const Table& GetTable(SimdLevel level) {
+    ASSERT(IsSimdLevelSupported(level));
+    switch (level) {
+#if defined(ARCHITECTURE_x86_64)
+    // Frames are 14 samples and a voice decodes a few hundred samples per list, wider vectors
+    // don't pay off.
+    case SimdLevel::SSE41:
+    case SimdLevel::AVX2:
+        return SSE41Table;
+#elif defined(ARCHITECTURE_arm64)
+    case SimdLevel::NEON:
+        return NEONTable;
+#endif
+    default:
+        return ScalarTable;
+    }
+}
+
+const Table& GetTable() {
+    static const Table& table = GetTable(GetHostSimdLevel());
+    return table;
+}
+
+} // namespace AudioCore::Renderer::DecodeKernels
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "audio_core/common/simd_level.h"
+#include "common/common_types.h"
+
+// Sample loops of the data source commands, vectorized with SSE4.1 on x86-64 and NEON on arm64.
+//
+// PCM conversions handle mono and stereo buffers with vectors, other channel counts go through
+// the scalar path. ADPCM is a recursive filter with saturation after every sample, so only the
+// nibble unpacking and scaling of a frame is vectorized; the prediction stays scalar. Every kernel
+// gives the same samples as the scalar path.
+namespace AudioCore::Renderer::DecodeKernels {
+
+/// Size in bytes of an ADPCM frame, a header byte followed by 7 bytes of samples
+constexpr u32 AdpcmFrameSize = 8;
+/// Number of samples in an ADPCM frame
+constexpr u32 AdpcmSamplesPerFrame = 14;
+
+using AdpcmCoefficients = std::array<s16, 16>;
+
+/// output[i] = input[i * channel_count + channel]
+using PcmInt16Function = void (*)(s16* output, const s16* input, u32 channel_count, u32 channel,
+                                  u32 sample_count);
+/// output[i] = clamp(input[i * channel_count + channel] * 0x7FFF)
+using PcmFloatFunction = void (*)(s16* output, const f32* input, u32 channel_count, u32 channel,
+                                  u32 sample_count);
+/// Decodes whole ADPCM frames, history holds the last two samples {yn0, yn1} and is updated
+using AdpcmFunction = void (*)(s16* output, const u8* input, u32 frame_count,
+                               const AdpcmCoefficients& coefficients, std::array<s16, 2>& history);
+
+struct Table {
+    PcmInt16Function pcm_int16;
+    PcmFloatFunction pcm_float;
+    AdpcmFunction adpcm;
+};
+
+/// Kernels of the given level, which must be supported by the host
+[[nodiscard]] const Table& GetTable(SimdLevel level);
+
+/// Kernels of the best level supported by the host
+[[nodiscard]] const Table& GetTable();
+
+/// Predictor coefficients selected by an ADPCM frame header
+[[nodiscard]] constexpr u32 AdpcmCoefficientIndex(u32 header) {
+    // Only 8 coefficient pairs exist, keep malformed headers inside the table
+    return ((header >> 4) & 0x7) * 2;
+}
+
+/// Scale of the nibbles of an ADPCM frame
+[[nodiscard]] constexpr u32 AdpcmScale(u32 header) {
+    return header & 0xF;
+}
+
+} // namespace AudioCore::Renderer::DecodeKernels
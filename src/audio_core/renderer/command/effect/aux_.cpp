@@ -5,36 +5,35 @@
 #include "audio_core/renderer/command/effect/aux_.h"
 #include "audio_core/renderer/effect/aux_.h"
 #include "core/core.h"
-#include "core/memory.h"
 
 namespace AudioCore::Renderer {
 /**
  * Reset an AuxBuffer.
  *
- * @param memory   - Core memory for writing.
+ * @param memory   - Guest memory for writing.
  * @param aux_info - Memory address pointing to the AuxInfo to reset.
  */
-static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_info) {
+static void ResetAuxBufferDsp(AudioRenderer::DspMemory& memory, const CpuAddr aux_info) {
     if (aux_info == 0) {
         LOG_ERROR(Service_Audio, "Aux info is 0!");
         return;
     }
 
     AuxInfo::AuxInfoDsp info{};
-    memory.ReadBlockUnsafe(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.ReadBlock(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
 
     info.read_offset = 0;
     info.write_offset = 0;
     info.total_sample_count = 0;
 
-    memory.WriteBlockUnsafe(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.WriteBlock(aux_info, &info, sizeof(AuxInfo::AuxInfoDsp));
 }
 
 /**
  * Write the given input mix buffer to the memory at send_buffer, and update send_info_ if
  * update_count is set, to notify the game that an update happened.
  *
- * @param memory       - Core memory for writing.
+ * @param memory       - Guest memory for writing.
  * @param send_info_   - Meta information for where to write the mix buffer.
  * @param sample_count - Unused.
  * @param send_buffer  - Memory address to write the mix buffer to.
@@ -45,7 +44,7 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * @param update_count - If non-zero, send_info_ will be updated.
  * @return Number of samples written.
  */
-static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
+static u32 WriteAuxBufferDsp(AudioRenderer::DspMemory& memory, CpuAddr send_info_,
                              [[maybe_unused]] u32 sample_count, CpuAddr send_buffer, u32 count_max,
                              std::span<const s32> input, u32 write_count_, u32 write_offset,
                              u32 update_count) {
@@ -76,7 +75,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
     }
 
     AuxInfo::AuxInfoDsp send_info{};
-    memory.ReadBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.ReadBlock(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
 
     u32 target_write_offset{send_info.write_offset + write_offset};
     if (target_write_offset > count_max) {
@@ -89,7 +88,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
         u32 to_write{std::min(count_max - target_write_offset, write_count)};
         if (to_write > 0) {
             const auto write_addr = send_buffer + target_write_offset * sizeof(s32);
-            memory.WriteBlockUnsafe(write_addr, &input[read_pos], to_write * sizeof(s32));
+            memory.WriteBlock(write_addr, &input[read_pos], to_write * sizeof(s32));
         }
         target_write_offset = (target_write_offset + to_write) % count_max;
         write_count -= to_write;
@@ -100,7 +99,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
         send_info.write_offset = (send_info.write_offset + update_count) % count_max;
     }
 
-    memory.WriteBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.WriteBlock(send_info_, &send_info, sizeof(AuxInfo::AuxInfoDsp));
     return write_count_;
 }
 
@@ -108,7 +107,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
  * Read the given memory at return_buffer into the output mix buffer, and update return_info_ if
  * update_count is set, to notify the game that an update happened.
  *
- * @param memory        - Core memory for reading.
+ * @param memory        - Guest memory for reading.
  * @param return_info_  - Meta information for where to read the mix buffer.
  * @param return_buffer - Memory address to read the samples from.
  * @param count_max     - Maximum number of samples in the receiving buffer.
@@ -118,7 +117,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr send_info_,
  * @param update_count  - If non-zero, send_info_ will be updated.
  * @return Number of samples read.
  */
-static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
+static u32 ReadAuxBufferDsp(AudioRenderer::DspMemory& memory, CpuAddr return_info_,
                             CpuAddr return_buffer, u32 count_max, std::span<s32> output,
                             u32 read_count_, u32 read_offset, u32 update_count) {
     if (count_max == 0) {
@@ -147,7 +146,7 @@ static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
     }
 
     AuxInfo::AuxInfoDsp return_info{};
-    memory.ReadBlockUnsafe(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.ReadBlock(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
 
     u32 target_read_offset{return_info.read_offset + read_offset};
     if (target_read_offset > count_max) {
@@ -160,7 +159,7 @@ static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
         u32 to_read{std::min(count_max - target_read_offset, read_count)};
         if (to_read > 0) {
             const auto read_addr = return_buffer + target_read_offset * sizeof(s32);
-            memory.ReadBlockUnsafe(read_addr, &output[write_pos], to_read * sizeof(s32));
+            memory.ReadBlock(read_addr, &output[write_pos], to_read * sizeof(s32));
         }
         target_read_offset = (target_read_offset + to_read) % count_max;
         read_count -= to_read;
@@ -171,7 +170,7 @@ static u32 ReadAuxBufferDsp(Core::Memory::Memory& memory, CpuAddr return_info_,
         return_info.read_offset = (return_info.read_offset + update_count) % count_max;
     }
 
-    memory.WriteBlockUnsafe(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
+    memory.WriteBlock(return_info_, &return_info, sizeof(AuxInfo::AuxInfoDsp));
     return read_count_;
 }
 
@@ -4,31 +4,30 @@
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/effect/capture.h"
 #include "audio_core/renderer/effect/aux_.h"
-#include "core/memory.h"
 
 namespace AudioCore::Renderer {
 /**
  * Reset an AuxBuffer.
  *
- * @param memory   - Core memory for writing.
+ * @param memory   - Guest memory for writing.
  * @param aux_info - Memory address pointing to the AuxInfo to reset.
  */
-static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_info) {
+static void ResetAuxBufferDsp(AudioRenderer::DspMemory& memory, const CpuAddr aux_info) {
     if (aux_info == 0) {
         LOG_ERROR(Service_Audio, "Aux info is 0!");
         return;
     }
 
-    memory.Write32(VAddr(aux_info + offsetof(AuxInfo::AuxInfoDsp, read_offset)), 0);
-    memory.Write32(VAddr(aux_info + offsetof(AuxInfo::AuxInfoDsp, write_offset)), 0);
-    memory.Write32(VAddr(aux_info + offsetof(AuxInfo::AuxInfoDsp, total_sample_count)), 0);
+    memory.Write32(aux_info + offsetof(AuxInfo::AuxInfoDsp, read_offset), 0);
+    memory.Write32(aux_info + offsetof(AuxInfo::AuxInfoDsp, write_offset), 0);
+    memory.Write32(aux_info + offsetof(AuxInfo::AuxInfoDsp, total_sample_count), 0);
 }
 
 /**
  * Write the given input mix buffer to the memory at send_buffer, and update send_info_ if
  * update_count is set, to notify the game that an update happened.
  *
- * @param memory       - Core memory for writing.
+ * @param memory       - Guest memory for writing.
  * @param send_info_   - Header information for where to write the mix buffer.
  * @param send_buffer  - Memory address to write the mix buffer to.
  * @param count_max    - Maximum number of samples in the receiving buffer.
@@ -38,7 +37,7 @@ static void ResetAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr aux_in
  * @param update_count - If non-zero, send_info_ will be updated.
  * @return Number of samples written.
  */
-static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_info_,
+static u32 WriteAuxBufferDsp(AudioRenderer::DspMemory& memory, const CpuAddr send_info_,
                              const CpuAddr send_buffer, u32 count_max, std::span<const s32> input,
                              const u32 write_count_, const u32 write_offset,
                              const u32 update_count) {
@@ -69,7 +68,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_in
     }
 
     AuxInfo::AuxBufferInfo send_info{};
-    memory.ReadBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
+    memory.ReadBlock(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
 
     u32 target_write_offset{send_info.dsp_info.write_offset + write_offset};
     if (target_write_offset > count_max || write_count_ == 0) {
@@ -82,8 +81,8 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_in
         u32 to_write{std::min(count_max - target_write_offset, write_count)};
 
         if (to_write > 0) {
-            memory.WriteBlockUnsafe(send_buffer + target_write_offset * sizeof(s32),
-                                    &input[write_pos], to_write * sizeof(s32));
+            memory.WriteBlock(send_buffer + target_write_offset * sizeof(s32), &input[write_pos],
+                              to_write * sizeof(s32));
         }
 
         target_write_offset = (target_write_offset + to_write) % count_max;
@@ -113,7 +112,7 @@ static u32 WriteAuxBufferDsp(Core::Memory::Memory& memory, const CpuAddr send_in
         send_info.dsp_info.total_sample_count = new_sample_count;
     }
 
-    memory.WriteBlockUnsafe(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
+    memory.WriteBlock(send_info_, &send_info, sizeof(AuxInfo::AuxBufferInfo));
 
     return write_count_;
 }
@@ -8,7 +8,7 @@
 namespace AudioCore::Renderer {
 /**
  * Apply depopping. Add the depopped sample to each incoming new sample, decaying it each time
- * according to decay.
+ * according to decay. Once the decayed sample reaches 0 it stays there, so the loop stops early.
  *
  * @param output - Output buffer to be depopped.
  * @param depop_sample - Depopped sample to apply to output samples.
@@ -22,13 +22,13 @@ static s32 ApplyDepopMix(std::span<s32> output, const s32 depop_sample,
     auto decay{decay_.to_raw()};
 
     if (depop_sample <= 0) {
-        for (u32 i = 0; i < sample_count; i++) {
+        for (u32 i = 0; i < sample_count && sample != 0; i++) {
             sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
             output[i] -= sample;
         }
         return -sample;
     } else {
-        for (u32 i = 0; i < sample_count; i++) {
+        for (u32 i = 0; i < sample_count && sample != 0; i++) {
             sample = static_cast<s32>((static_cast<s64>(sample) * decay) >> 15);
             output[i] += sample;
         }
@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/assert.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCore::Renderer::MixKernels {
+namespace {
+
+// Scalar helpers, wrapping like the 64-bit arithmetic of FixedPoint does.
+
+s64 Multiply(s32 sample, s64 volume) {
+    return static_cast<s64>(static_cast<u64>(s64{sample}) * static_cast<u64>(volume));
+}
+
+s64 Widen(s32 sample, u32 q) {
+    return static_cast<s64>(static_cast<u64>(s64{sample}) << q);
+}
+
+s64 Add(s64 lhs, s64 rhs) {
+    return static_cast<s64>(static_cast<u64>(lhs) + static_cast<u64>(rhs));
+}
+
+s64 VolumeAt(s64 volume, s64 ramp, u32 index) {
+    return Add(volume, static_cast<s64>(static_cast<u64>(ramp) * index));
+}
+
+/// FixedPoint::to_int, which rounds up when the fraction is at least two thirds
+s32 RoundToInt(s64 value, u32 q) {
+    const u64 fraction = static_cast<u64>(value) & ((u64{1} << q) - 1);
+    return static_cast<s32>(Add(value, static_cast<s64>(fraction >> 1)) >> q);
+}
+
+template <bool Accumulate>
+void ProcessScalar(s32* output, const s32* input, s64 volume, s64 ramp, u32 sample_count,
+                   u32 q) {
+    for (u32 i = 0; i < sample_count; i++) {
+        s64 sample = Multiply(input[i], volume);
+        if constexpr (Accumulate) {
+            sample = Add(Widen(output[i], q), sample);
+        }
+        output[i] = RoundToInt(sample, q);
+        volume = Add(volume, ramp);
+    }
+}
+
+/// Whether every volume of the ramp fits in 32 bits, as the vector multiplies require
+bool FitsVector(s64 volume, s64 ramp, u32 sample_count) {
+    constexpr s64 min = std::numeric_limits<s32>::min();
+    constexpr s64 max = std::numeric_limits<s32>::max();
+    if (volume < min || volume > max || ramp < min || ramp > max) {
+        return false;
+    }
+    // The ramp is monotonic, so checking the last volume is enough. This can't overflow with
+    // both terms limited to 32 bits.
+    const s64 last = volume + ramp * static_cast<s64>(sample_count == 0 ? 0 : sample_count - 1);
+    return last >= min && last <= max;
+}
+
+#if defined(ARCHITECTURE_x86_64)
+
+/// Rounds the 64-bit products of the even and odd samples back into one vector of samples
+CITRON_TARGET_SSE41 __m128i RoundToIntSSE41(__m128i even, __m128i odd, __m128i fraction_mask,
+                                            __m128i shift) {
+    even = _mm_add_epi64(even, _mm_srli_epi64(_mm_and_si128(even, fraction_mask), 1));
+    odd = _mm_add_epi64(odd, _mm_srli_epi64(_mm_and_si128(odd, fraction_mask), 1));
+    // Only the low 32 bits are kept, so a logical shift gives the same result as FixedPoint.
+    even = _mm_srl_epi64(even, shift);
+    odd = _mm_slli_epi64(_mm_srl_epi64(odd, shift), 32);
+    return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+template <bool Accumulate>
+CITRON_TARGET_SSE41 void ProcessSSE41(s32* output, const s32* input, s64 volume, s64 ramp,
+                                      u32 sample_count, u32 q) {
+    if (!FitsVector(volume, ramp, sample_count)) {
+        ProcessScalar<Accumulate>(output, input, volume, ramp, sample_count, q);
+        return;
+    }
+
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(q));
+    const __m128i fraction_mask = _mm_set1_epi64x((s64{1} << q) - 1);
+    const __m128i one = _mm_set1_epi64x(s64{1} << q);
+    const __m128i step = _mm_set1_epi64x(ramp * 4);
+    __m128i volume_even = _mm_set_epi64x(volume + ramp * 2, volume);
+    __m128i volume_odd = _mm_set_epi64x(volume + ramp * 3, volume + ramp);
+
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i even = _mm_mul_epi32(samples, volume_even);
+        __m128i odd = _mm_mul_epi32(_mm_srli_epi64(samples, 32), volume_odd);
+        if constexpr (Accumulate) {
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<__m128i*>(output + i));
+            even = _mm_add_epi64(even, _mm_mul_epi32(current, one));
+            odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(current, 32), one));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         RoundToIntSSE41(even, odd, fraction_mask, shift));
+        volume_even = _mm_add_epi64(volume_even, step);
+        volume_odd = _mm_add_epi64(volume_odd, step);
+    }
+    ProcessScalar<Accumulate>(output + i, input + i, VolumeAt(volume, ramp, i), ramp,
+                              sample_count - i, q);
+}
+
+CITRON_TARGET_AVX2 __m256i RoundToIntAVX2(__m256i even, __m256i odd, __m256i fraction_mask,
+                                          __m128i shift) {
+    even = _mm256_add_epi64(even, _mm256_srli_epi64(_mm256_and_si256(even, fraction_mask), 1));
+    odd = _mm256_add_epi64(odd, _mm256_srli_epi64(_mm256_and_si256(odd, fraction_mask), 1));
+    even = _mm256_srl_epi64(even, shift);
+    odd = _mm256_slli_epi64(_mm256_srl_epi64(odd, shift), 32);
+    return _mm256_blend_epi16(even, odd, 0xCC);
+}
+
+template <bool Accumulate>
+CITRON_TARGET_AVX2 void ProcessAVX2(s32* output, const s32* input, s64 volume, s64 ramp,
+                                    u32 sample_count, u32 q) {
+    if (!FitsVector(volume, ramp, sample_count)) {
+        ProcessScalar<Accumulate>(output, input, volume, ramp, sample_count, q);
+        return;
+    }
+
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(q));
+    const __m256i fraction_mask = _mm256_set1_epi64x((s64{1} << q) - 1);
+    const __m256i one = _mm256_set1_epi64x(s64{1} << q);
+    const __m256i step = _mm256_set1_epi64x(ramp * 8);
+    __m256i volume_even =
+        _mm256_set_epi64x(volume + ramp * 6, volume + ramp * 4, volume + ramp * 2, volume);
+    __m256i volume_odd = _mm256_set_epi64x(volume + ramp * 7, volume + ramp * 5,
+                                           volume + ramp * 3, volume + ramp);
+
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i even = _mm256_mul_epi32(samples, volume_even);
+        __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), volume_odd);
+        if constexpr (Accumulate) {
+            const __m256i current = _mm256_loadu_si256(reinterpret_cast<__m256i*>(output + i));
+            even = _mm256_add_epi64(even, _mm256_mul_epi32(current, one));
+            odd = _mm256_add_epi64(odd, _mm256_mul_epi32(_mm256_srli_epi64(current, 32), one));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            RoundToIntAVX2(even, odd, fraction_mask, shift));
+        volume_even = _mm256_add_epi64(volume_even, step);
+        volume_odd = _mm256_add_epi64(volume_odd, step);
+    }
+    ProcessScalar<Accumulate>(output + i, input + i, VolumeAt(volume, ramp, i), ramp,
+                              sample_count - i, q);
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+int64x2_t RoundToIntNEON(int64x2_t value, int64x2_t fraction_mask, int64x2_t shift) {
+    const uint64x2_t fraction = vreinterpretq_u64_s64(vandq_s64(value, fraction_mask));
+    value = vaddq_s64(value, vreinterpretq_s64_u64(vshrq_n_u64(fraction, 1)));
+    return vshlq_s64(value, shift);
+}
+
+template <bool Accumulate>
+void ProcessNEON(s32* output, const s32* input, s64 volume, s64 ramp, u32 sample_count, u32 q) {
+    if (!FitsVector(volume, ramp, sample_count)) {
+        ProcessScalar<Accumulate>(output, input, volume, ramp, sample_count, q);
+        return;
+    }
+
+    // Negative shift counts shift right, arithmetically for signed lanes.
+    const int64x2_t shift = vdupq_n_s64(-static_cast<s64>(q));
+    const int64x2_t widen = vdupq_n_s64(static_cast<s64>(q));
+    const int64x2_t fraction_mask = vdupq_n_s64((s64{1} << q) - 1);
+    const int64x2_t step = vdupq_n_s64(ramp * 4);
+    int64x2_t volume_low = vcombine_s64(vdup_n_s64(volume), vdup_n_s64(volume + ramp));
+    int64x2_t volume_high =
+        vcombine_s64(vdup_n_s64(volume + ramp * 2), vdup_n_s64(volume + ramp * 3));
+
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const int32x4_t samples = vld1q_s32(input + i);
+        int64x2_t low = vmull_s32(vget_low_s32(samples), vmovn_s64(volume_low));
+        int64x2_t high = vmull_s32(vget_high_s32(samples), vmovn_s64(volume_high));
+        if constexpr (Accumulate) {
+            const int32x4_t current = vld1q_s32(output + i);
+            low = vaddq_s64(low, vshlq_s64(vmovl_s32(vget_low_s32(current)), widen));
+            high = vaddq_s64(high, vshlq_s64(vmovl_s32(vget_high_s32(current)), widen));
+        }
+        low = RoundToIntNEON(low, fraction_mask, shift);
+        high = RoundToIntNEON(high, fraction_mask, shift);
+        vst1q_s32(output + i, vcombine_s32(vmovn_s64(low), vmovn_s64(high)));
+        volume_low = vaddq_s64(volume_low, step);
+        volume_high = vaddq_s64(volume_high, step);
+    }
+    ProcessScalar<Accumulate>(output + i, input + i, VolumeAt(volume, ramp, i), ramp,
+                              sample_count - i, q);
+}
+
+#endif
+
+template <auto Process>
+void MixImpl(s32* output, const s32* input, s64 volume, u32 sample_count, u32 q) {
+    Process(output, input, volume, 0, sample_count, q);
+}
+
+template <auto Process>
+s32 MixRampImpl(s32* output, const s32* input, s64 volume, s64 ramp, u32 sample_count, u32 q) {
+    if (sample_count == 0) {
+        return 0;
+    }
+    // Read the last sample first, the output may be the same buffer as the input.
+    const s64 last_sample =
+        Multiply(input[sample_count - 1], VolumeAt(volume, ramp, sample_count - 1));
+    Process(output, input, volume, ramp, sample_count, q);
+    return RoundToInt(last_sample, q);
+}
+
+template <auto Accumulating, auto Replacing>
+constexpr Table MakeTable() {
+    return Table{
+        .mix = MixImpl<Accumulating>,
+        .mix_ramp = MixRampImpl<Accumulating>,
+        .gain_ramp = Replacing,
+    };
+}
+
+constexpr Table ScalarTable = MakeTable<ProcessScalar<true>, ProcessScalar<false>>();
+#if defined(ARCHITECTURE_x86_64)
+constexpr Table SSE41Table = MakeTable<ProcessSSE41<true>, ProcessSSE41<false>>();
+constexpr Table AVX2Table = MakeTable<ProcessAVX2<true>, ProcessAVX2<false>>();
+#elif defined(ARCHITECTURE_arm64)
+constexpr Table NEONTable = MakeTable<ProcessNEON<true>, ProcessNEON<false>>();
+#endif
+
+} // Anonymous namespace
+
+const Table& GetTable(SimdLevel level) {
+    ASSERT(IsSimdLevelSupported(level));
+    switch (level) {
+#if defined(ARCHITECTURE_x86_64)
+    case SimdLevel::SSE41:
+        return SSE41Table;
+    case SimdLevel::AVX2:
+        return AVX2Table;
+#elif defined(ARCHITECTURE_arm64)
+    case SimdLevel::NEON:
+        return NEONTable;
+#endif
+    default:
+        return ScalarTable;
+    }
+}
+
+const Table& GetTable() {
+    static const Table& table = GetTable(GetHostSimdLevel());
+    return table;
+}
+
+} // namespace AudioCore::Renderer::MixKernels
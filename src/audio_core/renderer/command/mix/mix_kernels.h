@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "audio_core/common/simd_level.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+// Sample loops of the mix commands, vectorized with SSE4.1/AVX2 on x86-64 and NEON on arm64.
+//
+// Volumes are Q fixed point values as produced by Common::FixedPoint<64 - Q, Q>. Every kernel
+// reproduces the arithmetic of FixedPoint exactly: a sample multiplied by a volume is kept at
+// 64 bits, and converting back to an integer adds half of the fractional part before truncating
+// (FixedPoint::to_int). Vector paths are taken when the volumes fit in 32 bits, which covers any
+// volume the guest can sensibly set, the rest goes through the scalar path.
+namespace AudioCore::Renderer::MixKernels {
+
+/// output[i] += input[i] * volume
+using MixFunction = void (*)(s32* output, const s32* input, s64 volume, u32 sample_count,
+                             u32 q);
+/// output[i] += input[i] * volume, volume += ramp, returns the last gained input sample
+using MixRampFunction = s32 (*)(s32* output, const s32* input, s64 volume, s64 ramp,
+                                u32 sample_count, u32 q);
+/// output[i] = input[i] * volume, volume += ramp
+using GainRampFunction = void (*)(s32* output, const s32* input, s64 volume, s64 ramp,
+                                  u32 sample_count, u32 q);
+
+struct Table {
+    MixFunction mix;
+    MixRampFunction mix_ramp;
+    GainRampFunction gain_ramp;
+};
+
+/// Kernels of the given level, which must be supported by the host
+[[nodiscard]] const Table& GetTable(SimdLevel level);
+
+/// Kernels of the best level supported by the host
+[[nodiscard]] const Table& GetTable();
+
+/// Raw Q fixed point representation of a float, as Common::FixedPoint<64 - Q, Q> stores it
+template <size_t Q>
+[[nodiscard]] s64 ToFixed(f32 value) {
+    return Common::FixedPoint<64 - Q, Q>{value}.to_raw();
+}
+
+template <size_t Q>
+void Mix(std::span<s32> output, std::span<const s32> input, f32 volume, u32 sample_count) {
+    GetTable().mix(output.data(), input.data(), ToFixed<Q>(volume), sample_count, Q);
+}
+
+template <size_t Q>
+s32 MixRamp(std::span<s32> output, std::span<const s32> input, f32 volume, f32 ramp,
+            u32 sample_count) {
+    return GetTable().mix_ramp(output.data(), input.data(), ToFixed<Q>(volume), ToFixed<Q>(ramp),
+                               sample_count, Q);
+}
+
+template <size_t Q>
+void GainRamp(std::span<s32> output, std::span<const s32> input, f32 volume, f32 ramp,
+              u32 sample_count) {
+    GetTable().gain_ramp(output.data(), input.data(), ToFixed<Q>(volume), ToFixed<Q>(ramp),
+                         sample_count, Q);
+}
+
+} // namespace AudioCore::Renderer::MixKernels
@@ -1,9 +1,196 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
 #include "audio_core/renderer/command/resample/resample.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::Renderer {
+namespace {
+
+/// Read position of the polyphase filters, stepped exactly like the scalar loops step it
+struct ResamplePosition {
+    s64 fraction;
+    s64 sample_rate_ratio;
+    u32 read_index{0};
+
+    struct Tap {
+        u32 read_index;
+        u32 phase;
+    };
+
+    /// Returns where the next output sample is filtered from, and moves past it
+    Tap Step() {
+        const Tap tap{read_index, static_cast<u32>((fraction & 0x7FFF) >> 8)};
+        fraction += sample_rate_ratio;
+        read_index += static_cast<u32>(static_cast<s32>(fraction >> 15));
+        fraction &= 0x7FFF;
+        return tap;
+    }
+};
+
+/// One output sample of a Taps long filter, with the arithmetic of the scalar loops
+template <size_t Taps>
+s32 FilterScalar(const s16* input, const f32* lut) {
+    Common::FixedPoint<56, 8> sum{0};
+    for (size_t i = 0; i < Taps; i++) {
+        sum += Common::FixedPoint<56, 8>{input[i] * lut[i]};
+    }
+    return sum.to_int_floor();
+}
+
+// The vector filters multiply in single precision and truncate each product to 24.8 fixed point
+// before summing, like the scalar loops, so their output is bit exact. A product fits in 32 bits
+// as the coefficients stay well below 2.0.
+
+#if defined(ARCHITECTURE_x86_64)
+
+template <size_t Taps>
+CITRON_TARGET_SSE41 __m128i FilterSSE41(const s16* input, const f32* lut) {
+    const __m128 scale = _mm_set1_ps(256.0f);
+    if constexpr (Taps == 4) {
+        const __m128 samples = _mm_cvtepi32_ps(
+            _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input))));
+        return _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(samples, _mm_loadu_ps(lut)), scale));
+    } else {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        const __m128 low = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(packed));
+        const __m128 high = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(packed, 8)));
+        return _mm_add_epi32(
+            _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(low, _mm_loadu_ps(lut)), scale)),
+            _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(high, _mm_loadu_ps(lut + 4)), scale)));
+    }
+}
+
+template <size_t Taps>
+CITRON_TARGET_SSE41 void ResampleSSE41(s32* output, const s16* input, const f32* lut,
+                                       ResamplePosition& position, u32 samples_to_write) {
+    u32 i = 0;
+    for (; i + 4 <= samples_to_write; i += 4) {
+        __m128i products[4];
+        for (__m128i& product : products) {
+            const auto [read_index, phase] = position.Step();
+            product = FilterSSE41<Taps>(input + read_index, lut + phase * Taps);
+        }
+        const __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(products[0], products[1]),
+                                            _mm_hadd_epi32(products[2], products[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_srai_epi32(sums, 8));
+    }
+    for (; i < samples_to_write; i++) {
+        const auto [read_index, phase] = position.Step();
+        output[i] = FilterScalar<Taps>(input + read_index, lut + phase * Taps);
+    }
+}
+
+CITRON_TARGET_AVX2 __m256i Filter8AVX2(const s16* input, const f32* lut) {
+    const __m256 samples = _mm256_cvtepi32_ps(
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input))));
+    return _mm256_cvttps_epi32(
+        _mm256_mul_ps(_mm256_mul_ps(samples, _mm256_loadu_ps(lut)), _mm256_set1_ps(256.0f)));
+}
+
+CITRON_TARGET_AVX2 void Resample8AVX2(s32* output, const s16* input, const f32* lut,
+                                      ResamplePosition& position, u32 samples_to_write) {
+    u32 i = 0;
+    for (; i + 8 <= samples_to_write; i += 8) {
+        __m256i products[8];
+        for (__m256i& product : products) {
+            const auto [read_index, phase] = position.Step();
+            product = Filter8AVX2(input + read_index, lut + phase * 8);
+        }
+        // Each 128-bit lane ends up with four partial sums, the low and high halves of the taps.
+        const __m256i low = _mm256_hadd_epi32(_mm256_hadd_epi32(products[0], products[1]),
+                                              _mm256_hadd_epi32(products[2], products[3]));
+        const __m256i high = _mm256_hadd_epi32(_mm256_hadd_epi32(products[4], products[5]),
+                                               _mm256_hadd_epi32(products[6], products[7]));
+        const __m256i sums = _mm256_add_epi32(_mm256_permute2x128_si256(low, high, 0x20),
+                                              _mm256_permute2x128_si256(low, high, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_srai_epi32(sums, 8));
+    }
+    ResampleSSE41<8>(output + i, input, lut, position, samples_to_write - i);
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+template <size_t Taps>
+int32x4_t FilterNEON(const s16* input, const f32* lut) {
+    const float32x4_t scale = vdupq_n_f32(256.0f);
+    if constexpr (Taps == 4) {
+        const float32x4_t samples = vcvtq_f32_s32(vmovl_s16(vld1_s16(input)));
+        return vcvtq_s32_f32(vmulq_f32(vmulq_f32(samples, vld1q_f32(lut)), scale));
+    } else {
+        const int16x8_t packed = vld1q_s16(input);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(packed)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(packed)));
+        return vaddq_s32(vcvtq_s32_f32(vmulq_f32(vmulq_f32(low, vld1q_f32(lut)), scale)),
+                         vcvtq_s32_f32(vmulq_f32(vmulq_f32(high, vld1q_f32(lut + 4)), scale)));
+    }
+}
+
+template <size_t Taps>
+void ResampleNEON(s32* output, const s16* input, const f32* lut, ResamplePosition& position,
+                  u32 samples_to_write) {
+    u32 i = 0;
+    for (; i + 4 <= samples_to_write; i += 4) {
+        int32x4_t products[4];
+        for (int32x4_t& product : products) {
+            const auto [read_index, phase] = position.Step();
+            product = FilterNEON<Taps>(input + read_index, lut + phase * Taps);
+        }
+        const int32x4_t sums = vpaddq_s32(vpaddq_s32(products[0], products[1]),
+                                          vpaddq_s32(products[2], products[3]));
+        vst1q_s32(output + i, vshrq_n_s32(sums, 8));
+    }
+    for (; i < samples_to_write; i++) {
+        const auto [read_index, phase] = position.Step();
+        output[i] = FilterScalar<Taps>(input + read_index, lut + phase * Taps);
+    }
+}
+
+#endif
+
+/**
+ * Runs a polyphase filter with the vector instructions of the given level.
+ *
+ * @return False if the level has no vector path, and the scalar loop has to run instead.
+ */
+template <size_t Taps>
+bool ResampleVectorized(std::span<s32> output, std::span<const s16> input,
+                        std::span<const f32> lut,
+                        const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                        Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                        const SimdLevel level) {
+    ResamplePosition position{fraction.to_raw(), sample_rate_ratio.to_raw()};
+    switch (level) {
+#if defined(ARCHITECTURE_x86_64)
+    case SimdLevel::AVX2:
+        if constexpr (Taps == 8) {
+            Resample8AVX2(output.data(), input.data(), lut.data(), position, samples_to_write);
+            break;
+        }
+        [[fallthrough]];
+    case SimdLevel::SSE41:
+        ResampleSSE41<Taps>(output.data(), input.data(), lut.data(), position, samples_to_write);
+        break;
+#elif defined(ARCHITECTURE_arm64)
+    case SimdLevel::NEON:
+        ResampleNEON<Taps>(output.data(), input.data(), lut.data(), position, samples_to_write);
+        break;
+#endif
+    default:
+        return false;
+    }
+    fraction = Common::FixedPoint<49, 15>::from_base(position.fraction);
+    return true;
+}
+
+} // Anonymous namespace
 
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
@@ -25,8 +212,8 @@ static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input
 
 static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> input,
                                   const Common::FixedPoint<49, 15>& sample_rate_ratio,
-                                  Common::FixedPoint<49, 15>& fraction,
-                                  const u32 samples_to_write) {
+                                  Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                                  const SimdLevel level) {
     static constexpr std::array<f32, 512> lut0 = {
         0.20141602f, 0.59283447f, 0.20513916f, 0.00009155f, 0.19772339f, 0.59277344f, 0.20889282f,
         0.00027466f, 0.19406128f, 0.59262085f, 0.21264648f, 0.00045776f, 0.19039917f, 0.59240723f,
@@ -293,6 +480,11 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
     };
 
     auto lut{get_lut()};
+    if (ResampleVectorized<4>(output, input, lut, sample_rate_ratio, fraction, samples_to_write,
+                              level)) {
+        return;
+    }
+
     u32 read_index{0};
     for (u32 i = 0; i < samples_to_write; i++) {
         const auto lut_index{(fraction.get_frac() >> 8) * 4};
@@ -309,7 +501,8 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
                                 const Common::FixedPoint<49, 15>& sample_rate_ratio,
-                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                                const SimdLevel level) {
     static constexpr std::array<f32, 1024> lut0 = {
         -0.01776123f, -0.00070190f, 0.26672363f,  0.50006104f,  0.26956177f,  0.00024414f,
         -0.01800537f, 0.00000000f,  -0.01748657f, -0.00164795f, 0.26388550f,  0.50003052f,
@@ -843,6 +1036,11 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
     };
 
     auto lut{get_lut()};
+    if (ResampleVectorized<8>(output, input, lut, sample_rate_ratio, fraction, samples_to_write,
+                              level)) {
+        return;
+    }
+
     u32 read_index{0};
     for (u32 i = 0; i < samples_to_write; i++) {
         const auto lut_index{(fraction.get_frac() >> 8) * 8};
@@ -866,16 +1064,25 @@ void Resample(std::span<s32> output, std::span<const s16> input,
               const Common::FixedPoint<49, 15>& sample_rate_ratio,
               Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
               const SrcQuality src_quality) {
+    Resample(output, input, sample_rate_ratio, fraction, samples_to_write, src_quality,
+             GetHostSimdLevel());
+}
+
+void Resample(std::span<s32> output, std::span<const s16> input,
+              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+              const SrcQuality src_quality, const SimdLevel level) {
 
     switch (src_quality) {
     case SrcQuality::Low:
         ResampleLowQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
         break;
     case SrcQuality::Medium:
-        ResampleNormalQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleNormalQuality(output, input, sample_rate_ratio, fraction, samples_to_write,
+                              level);
         break;
     case SrcQuality::High:
-        ResampleHighQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleHighQuality(output, input, sample_rate_ratio, fraction, samples_to_write, level);
         break;
     }
 }
@@ -6,6 +6,7 @@
 #include <span>
 
 #include "audio_core/common/common.h"
+#include "audio_core/common/simd_level.h"
 #include "common/common_types.h"
 #include "common/fixed_point.h"
 
@@ -26,4 +27,15 @@ void Resample(std::span<s32> output, std::span<const s16> input,
               const Common::FixedPoint<49, 15>& sample_rate_ratio,
               Common::FixedPoint<49, 15>& fraction, u32 samples_to_write, SrcQuality src_quality);
 
+/**
+ * Resample with the instructions of the given level rather than the best ones of the host. All
+ * levels produce the same output.
+ *
+ * @param level - Instruction set to filter with, must be supported by the host.
+ */
+void Resample(std::span<s32> output, std::span<const s16> input,
+              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+              Common::FixedPoint<49, 15>& fraction, u32 samples_to_write, SrcQuality src_quality,
+              SimdLevel level);
+
 } // namespace AudioCore::Renderer
@@ -5,7 +5,6 @@
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/sink/circular_buffer.h"
-#include "core/memory.h"
 
 namespace AudioCore::Renderer {
 
@@ -32,8 +31,8 @@ void CircularBufferSinkCommand::Process(const AudioRenderer::CommandListProcesso
             output[sample_index] = static_cast<s16>(std::clamp(input[sample_index], min, max));
         }
 
-        processor.memory->WriteBlockUnsafe(address + pos, output.data(),
-                                           processor.sample_count * sizeof(s16));
+        processor.memory->WriteBlock(address + pos, output.data(),
+                                     processor.sample_count * sizeof(s16));
         pos += static_cast<u32>(processor.sample_count * sizeof(s16));
         if (pos >= size) {
             pos = 0;
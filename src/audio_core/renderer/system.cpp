@@ -667,6 +667,7 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
     command_list_header->sample_count = sample_count;
     command_list_header->sample_rate = sample_rate;
     command_list_header->samples_buffer = samples_workbuffer;
+    command_list_header->workbuffer = {workbuffer.get(), workbuffer_size};
 
     const auto performance_initialized{performance_manager.IsInitialized()};
     if (performance_initialized) {
@@ -0,0 +1,562 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs the audio renderer command lists recorded with the capture_audio_commands setting through
+// CommandListProcessor, without a guest, and sends the output to a null sink. Each list starts
+// from the renderer work buffer as it was captured, so the commands see the same voices, mix
+// buffers and effects as in the game. Host time of each command type is reported next to the
+// time estimated by CommandProcessingTimeEstimator when the lists were generated.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "audio_core/adsp/apps/audio_renderer/command_capture.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_executor.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/commands.h"
+#include "audio_core/sink/null_sink.h"
+#include "common/alignment.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/core.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace AudioCore::ADSP::AudioRenderer;
+using AudioCore::CpuAddr;
+using AudioCore::Renderer::CommandListHeader;
+using AudioCore::Renderer::ICommand;
+
+/// Estimates are in ADSP ticks, the renderer budgets 2,880,000 of them per 5ms frame
+constexpr double ESTIMATE_TICKS_PER_US = 2'880'000.0 / 5'000.0;
+
+/// Reservations are aligned to the allocation granularity of Windows, which covers the page size
+constexpr u64 MAPPING_ALIGNMENT = 0x10000;
+
+constexpr std::array<std::string_view, CommandIdCount> COMMAND_NAMES{
+    "Invalid",
+    "DataSourcePcmInt16Version1",
+    "DataSourcePcmInt16Version2",
+    "DataSourcePcmFloatVersion1",
+    "DataSourcePcmFloatVersion2",
+    "DataSourceAdpcmVersion1",
+    "DataSourceAdpcmVersion2",
+    "Volume",
+    "VolumeRamp",
+    "BiquadFilter",
+    "Mix",
+    "MixRamp",
+    "MixRampGrouped",
+    "DepopPrepare",
+    "DepopForMixBuffers",
+    "Delay",
+    "Upsample",
+    "DownMix6chTo2ch",
+    "Aux",
+    "DeviceSink",
+    "CircularBufferSink",
+    "Reverb",
+    "I3dl2Reverb",
+    "Performance",
+    "ClearMixBuffer",
+    "CopyMixBuffer",
+    "LightLimiterVersion1",
+    "LightLimiterVersion2",
+    "MultiTapBiquadFilter",
+    "Capture",
+    "Compressor",
+    "BiquadFilterAndMix",
+    "MultiTapBiquadFilterAndMix",
+};
+
+/**
+ * Memory for the renderer work buffer of a capture. Commands hold host pointers into the work
+ * buffer of the captured process, the mapping is requested at the same address so they can
+ * usually run as they are. That address is only a hint, wherever the mapping lands the pointers
+ * are rebased to it. The offset within MAPPING_ALIGNMENT is kept, so the buffers the commands
+ * point to keep the alignment they had.
+ */
+class WorkBufferMapping {
+public:
+    WorkBufferMapping() = default;
+    ~WorkBufferMapping() {
+        Unmap();
+    }
+
+    WorkBufferMapping(const WorkBufferMapping&) = delete;
+    WorkBufferMapping& operator=(const WorkBufferMapping&) = delete;
+
+    [[nodiscard]] bool IsMapped(CpuAddr captured_address_, u64 size_) const {
+        return base != nullptr && captured_address == captured_address_ && size == size_;
+    }
+
+    [[nodiscard]] bool Map(CpuAddr captured_address_, u64 size_) {
+        Unmap();
+        const u64 start = Common::AlignDown(captured_address_, MAPPING_ALIGNMENT);
+        const u64 length = Common::AlignUp(captured_address_ + size_, MAPPING_ALIGNMENT) - start;
+        void* const hint = reinterpret_cast<void*>(start);
+#ifdef _WIN32
+        // Reserving at an address in use fails instead of picking another one, reservations are
+        // always aligned to the allocation granularity
+        void* pointer = VirtualAlloc(hint, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (pointer == nullptr) {
+            pointer = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        }
+        if (pointer == nullptr) {
+            return false;
+        }
+        u64 reserved_length = length;
+#else
+        void* pointer =
+            mmap(hint, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pointer == MAP_FAILED) {
+            return false;
+        }
+        u64 reserved_length = length;
+        if (pointer != hint) {
+            // The address is used by something else in this process, the kernel only aligns the
+            // mapping it picked to the page size
+            munmap(pointer, length);
+            reserved_length = length + MAPPING_ALIGNMENT;
+            pointer = mmap(nullptr, reserved_length, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (pointer == MAP_FAILED) {
+                return false;
+            }
+        }
+#endif
+        base = pointer;
+        mapped_length = reserved_length;
+        const u64 aligned_start =
+            Common::AlignUp(reinterpret_cast<uintptr_t>(pointer), MAPPING_ALIGNMENT);
+        captured_address = captured_address_;
+        size = size_;
+        address = aligned_start + (captured_address_ - start);
+        return true;
+    }
+
+    [[nodiscard]] u8* Data() const {
+        return reinterpret_cast<u8*>(address);
+    }
+
+    /// Host address of the work buffer in this process
+    [[nodiscard]] CpuAddr Address() const {
+        return address;
+    }
+
+    /// Whether the pointers of the capture have to be rebased
+    [[nodiscard]] bool IsRelocated() const {
+        return address != captured_address;
+    }
+
+    /**
+     * Rebases the pointers to the captured work buffer held by an object in the mapping. Every
+     * naturally aligned 64-bit word within the captured buffer is taken as a pointer, guest
+     * addresses and the other fields of the commands don't fall in the host range of the buffer.
+     */
+    void Relocate(u8* object, u64 object_size) const {
+        if (!IsRelocated()) {
+            return;
+        }
+        const u64 first = Common::AlignUp(reinterpret_cast<uintptr_t>(object), sizeof(u64)) -
+                          reinterpret_cast<uintptr_t>(object);
+        for (u64 offset = first; offset + sizeof(u64) <= object_size; offset += sizeof(u64)) {
+            u64 value;
+            std::memcpy(&value, object + offset, sizeof(value));
+            // The end of the buffer is included for spans and ranges ending with it
+            if (value < captured_address || value > captured_address + size) {
+                continue;
+            }
+            value = value - captured_address + address;
+            std::memcpy(object + offset, &value, sizeof(value));
+        }
+    }
+
+private:
+    void Unmap() {
+        if (base == nullptr) {
+            return;
+        }
+#ifdef _WIN32
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        munmap(base, mapped_length);
+#endif
+        base = nullptr;
+        mapped_length = 0;
+        captured_address = 0;
+        address = 0;
+        size = 0;
+    }
+
+    void* base{};
+    u64 mapped_length{};
+    CpuAddr captured_address{};
+    CpuAddr address{};
+    u64 size{};
+};
+
+/**
+ * Effect states holding host allocations (delay lines, look-ahead buffers) can't be restored from
+ * the captured bytes, their pointers belonged to the captured process. The bench gives each of
+ * them a state of its own, initialized by the first command using it, and keeps it across lists
+ * by saving its bytes before a work buffer is restored and putting them back afterwards.
+ */
+class EffectStates {
+public:
+    /// Moves the live states out of the work buffer before it is overwritten
+    void Save() {
+        for (auto& [address, bytes] : states) {
+            std::memcpy(bytes.data(), reinterpret_cast<void*>(address), bytes.size());
+        }
+    }
+
+    /// Forgets the states of a work buffer which was unmapped
+    void Clear() {
+        states.clear();
+    }
+
+    /// Puts the live state of an effect command back in the restored work buffer
+    template <typename Info, typename Command>
+    void Restore(Command& command) {
+        using State = typename Info::State;
+        void* const state = reinterpret_cast<void*>(command.state);
+        const auto [it, inserted] = states.try_emplace(command.state);
+        if (inserted) {
+            it->second.resize(sizeof(State));
+            new (state) State{};
+            command.parameter.state = Info::ParameterState::Initialized;
+        } else {
+            std::memcpy(state, it->second.data(), sizeof(State));
+        }
+    }
+
+private:
+    std::unordered_map<CpuAddr, std::vector<u8>> states;
+};
+
+/**
+ * Commands were constructed by the captured process and point to its vtables. Copy constructing
+ * them in place gives them the vtables of the bench, their fields are kept as they are.
+ */
+template <typename Command>
+Command& Rebind(ICommand& command) {
+    auto& captured = static_cast<Command&>(command);
+    const Command copy{captured};
+    return *std::construct_at(&captured, copy);
+}
+
+/// Makes the commands of a restored list runnable in this process
+void PrepareCommands(u8* commands, u32 command_count, u64 commands_size,
+                     const WorkBufferMapping& mapping, EffectStates& effect_states) {
+    using namespace AudioCore::Renderer;
+    const u8* const end = commands + commands_size;
+    for (u32 index = 0; index < command_count; ++index) {
+        if (commands + sizeof(ICommand) > end) {
+            break;
+        }
+        auto& command = *reinterpret_cast<ICommand*>(commands);
+        if (command.magic != CommandMagic || command.size <= 0 || commands + command.size > end) {
+            break;
+        }
+        mapping.Relocate(commands, static_cast<u64>(command.size));
+        switch (command.type) {
+        case CommandId::DataSourcePcmInt16Version1:
+            Rebind<PcmInt16DataSourceVersion1Command>(command);
+            break;
+        case CommandId::DataSourcePcmInt16Version2:
+            Rebind<PcmInt16DataSourceVersion2Command>(command);
+            break;
+        case CommandId::DataSourcePcmFloatVersion1:
+            Rebind<PcmFloatDataSourceVersion1Command>(command);
+            break;
+        case CommandId::DataSourcePcmFloatVersion2:
+            Rebind<PcmFloatDataSourceVersion2Command>(command);
+            break;
+        case CommandId::DataSourceAdpcmVersion1:
+            Rebind<AdpcmDataSourceVersion1Command>(command);
+            break;
+        case CommandId::DataSourceAdpcmVersion2:
+            Rebind<AdpcmDataSourceVersion2Command>(command);
+            break;
+        case CommandId::Volume:
+            Rebind<VolumeCommand>(command);
+            break;
+        case CommandId::VolumeRamp:
+            Rebind<VolumeRampCommand>(command);
+            break;
+        case CommandId::BiquadFilter:
+            Rebind<BiquadFilterCommand>(command);
+            break;
+        case CommandId::Mix:
+            Rebind<MixCommand>(command);
+            break;
+        case CommandId::MixRamp:
+            Rebind<MixRampCommand>(command);
+            break;
+        case CommandId::MixRampGrouped:
+            Rebind<MixRampGroupedCommand>(command);
+            break;
+        case CommandId::DepopPrepare:
+            Rebind<DepopPrepareCommand>(command);
+            break;
+        case CommandId::DepopForMixBuffers:
+            Rebind<DepopForMixBuffersCommand>(command);
+            break;
+        case CommandId::Delay:
+            effect_states.Restore<DelayInfo>(Rebind<DelayCommand>(command));
+            break;
+        case CommandId::Upsample:
+            Rebind<UpsampleCommand>(command);
+            break;
+        case CommandId::DownMix6chTo2ch:
+            Rebind<DownMix6chTo2chCommand>(command);
+            break;
+        case CommandId::Aux:
+            Rebind<AuxCommand>(command);
+            break;
+        case CommandId::DeviceSink:
+            Rebind<DeviceSinkCommand>(command);
+            break;
+        case CommandId::CircularBufferSink:
+            Rebind<CircularBufferSinkCommand>(command);
+            break;
+        case CommandId::Reverb:
+            effect_states.Restore<ReverbInfo>(Rebind<ReverbCommand>(command));
+            break;
+        case CommandId::I3dl2Reverb:
+            effect_states.Restore<I3dl2ReverbInfo>(Rebind<I3dl2ReverbCommand>(command));
+            break;
+        case CommandId::Performance:
+            Rebind<PerformanceCommand>(command);
+            break;
+        case CommandId::ClearMixBuffer:
+            Rebind<ClearMixBufferCommand>(command);
+            break;
+        case CommandId::CopyMixBuffer:
+            Rebind<CopyMixBufferCommand>(command);
+            break;
+        case CommandId::LightLimiterVersion1:
+            effect_states.Restore<LightLimiterInfo>(Rebind<LightLimiterVersion1Command>(command));
+            break;
+        case CommandId::LightLimiterVersion2:
+            effect_states.Restore<LightLimiterInfo>(Rebind<LightLimiterVersion2Command>(command));
+            break;
+        case CommandId::MultiTapBiquadFilter:
+            Rebind<MultiTapBiquadFilterCommand>(command);
+            break;
+        case CommandId::Capture:
+            Rebind<CaptureCommand>(command);
+            break;
+        case CommandId::Compressor:
+            Rebind<CompressorCommand>(command);
+            break;
+        case CommandId::BiquadFilterAndMix:
+            Rebind<BiquadFilterAndMixCommand>(command);
+            break;
+        case CommandId::MultiTapBiquadFilterAndMix:
+            Rebind<MultiTapBiquadFilterAndMixCommand>(command);
+            break;
+        default:
+            // Unknown commands stop the processor on their magic, like a corrupted list
+            command.magic = 0;
+            return;
+        }
+        commands += command.size;
+    }
+}
+
+[[nodiscard]] double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void PrintUsage(const char* argv0) {
+    fmt::print(stderr,
+               "Usage: {} [options] <capture.audcap>\n"
+               "  -i, --iterations <n>  Replay the capture n times, default 1\n"
+               "  -t, --threads <n>     Run the voices on n worker threads too, default 0\n"
+               "  -h, --help            Show this help\n",
+               argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    u32 iterations = 1;
+    u32 voice_threads = 0;
+    std::string capture_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if ((arg == "-i" || arg == "--iterations") && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+            voice_threads = static_cast<u32>(std::clamp(std::atoi(argv[++i]), 0, 64));
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else if (capture_path.empty() && !arg.starts_with('-')) {
+            capture_path = arg;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (capture_path.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    const auto load_start = Clock::now();
+    CaptureReader reader{capture_path};
+    if (!reader.IsValid()) {
+        fmt::print(stderr, "{} is not a supported audio command capture\n", capture_path);
+        return 1;
+    }
+    std::vector<CapturedCommandList> lists;
+    for (CapturedCommandList list; reader.Next(list);) {
+        lists.push_back(std::move(list));
+    }
+    const Clock::duration load_time = Clock::now() - load_start;
+    if (lists.empty()) {
+        fmt::print(stderr, "{} holds no command list\n", capture_path);
+        return 1;
+    }
+
+    Core::System system;
+    AudioCore::Sink::NullSink sink{""};
+    AudioCore::Sink::SinkStream* const stream =
+        sink.AcquireSinkStream(system, 2, "AudioRenderBench", AudioCore::Sink::StreamType::Render);
+
+    WorkBufferMapping mapping;
+    EffectStates effect_states;
+    CapturedDspMemory memory;
+    CommandTimings timings{};
+    CommandListProcessor processor;
+    processor.command_timings = &timings;
+    // Timings of the voice commands add up the time of all threads
+    std::unique_ptr<VoiceExecutor> voice_executor;
+    if (voice_threads > 0) {
+        voice_executor = std::make_unique<VoiceExecutor>(voice_threads);
+    }
+
+    Clock::duration best = Clock::duration::max();
+    Clock::duration total{};
+    u64 frame_us = 0;
+    u64 processed_lists = 0;
+    for (u32 iteration = 0; iteration < iterations; ++iteration) {
+        Clock::duration iteration_time{};
+        for (const CapturedCommandList& list : lists) {
+            if (!mapping.IsMapped(list.workbuffer_address, list.workbuffer_size)) {
+                effect_states.Clear();
+                if (!mapping.Map(list.workbuffer_address, list.workbuffer_size)) {
+                    fmt::print(stderr, "Unable to map a work buffer of size {:X}\n",
+                               list.workbuffer_size);
+                    return 1;
+                }
+                if (mapping.IsRelocated()) {
+                    LOG_INFO(Audio, "Work buffer captured at {:016X} mapped at {:016X}",
+                             list.workbuffer_address, mapping.Address());
+                }
+            }
+            effect_states.Save();
+            const std::vector<u8> workbuffer =
+                Common::Compression::DecompressDataZSTD(list.compressed_workbuffer);
+            if (workbuffer.size() != list.workbuffer_size) {
+                fmt::print(stderr, "Corrupted work buffer in the capture\n");
+                return 1;
+            }
+            std::memcpy(mapping.Data(), workbuffer.data(), workbuffer.size());
+
+            if (list.commands_size < sizeof(CommandListHeader) ||
+                list.commands_offset + list.commands_size > list.workbuffer_size) {
+                fmt::print(stderr, "Command list out of the work buffer in the capture\n");
+                return 1;
+            }
+            const CpuAddr buffer = mapping.Address() + list.commands_offset;
+            mapping.Relocate(mapping.Data() + list.commands_offset, sizeof(CommandListHeader));
+            const auto& header = *reinterpret_cast<const CommandListHeader*>(buffer);
+            const u64 commands_size = list.commands_size - sizeof(CommandListHeader);
+            PrepareCommands(mapping.Data() + list.commands_offset + sizeof(CommandListHeader),
+                            header.command_count, commands_size, mapping, effect_states);
+            memory.SetCommandList(list);
+            processor.Initialize(system, memory, buffer, list.commands_size, stream);
+            processor.voice_executor = voice_executor.get();
+            if (header.sample_rate != 0) {
+                frame_us = u64{header.sample_count} * 1'000'000 / header.sample_rate;
+            }
+
+            const auto start = Clock::now();
+            processor.Process(0);
+            iteration_time += Clock::now() - start;
+            ++processed_lists;
+        }
+        best = std::min(best, iteration_time);
+        total += iteration_time;
+    }
+
+    fmt::print("Capture: {}\n", capture_path);
+    fmt::print("  command lists {}, load {:.3f} ms\n", lists.size(), ToMilliseconds(load_time));
+    const double average_list_us =
+        processed_lists != 0 ? std::chrono::duration<double, std::micro>(total).count() /
+                                   static_cast<double>(processed_lists)
+                             : 0.0;
+    fmt::print("Timings over {} iteration(s)\n", iterations);
+    fmt::print("  all lists, best / average in ms {:10.3f} / {:10.3f}\n", ToMilliseconds(best),
+               ToMilliseconds(total) / static_cast<double>(iterations));
+    fmt::print("  per list {:.2f} us", average_list_us);
+    if (frame_us != 0 && average_list_us > 0.0) {
+        fmt::print(", {:.1f}x real time for {} us frames",
+                   static_cast<double>(frame_us) / average_list_us, frame_us);
+    }
+    fmt::print("\n\n");
+
+    fmt::print("{:<28} {:>10} {:>12} {:>12} {:>10}\n", "Command", "Count", "Host ns", "Est. ns",
+               "Host/Est.");
+    for (size_t type = 0; type < timings.size(); ++type) {
+        const CommandTiming& timing = timings[type];
+        if (timing.count == 0) {
+            continue;
+        }
+        const double count = static_cast<double>(timing.count);
+        const double host_ns =
+            std::chrono::duration<double, std::nano>(timing.host_time).count() / count;
+        const double estimated_ns =
+            static_cast<double>(timing.estimated_time) / ESTIMATE_TICKS_PER_US * 1000.0 / count;
+        fmt::print("{:<28} {:>10} {:>12.1f} {:>12.1f}", COMMAND_NAMES[type], timing.count,
+                   host_ns, estimated_ns);
+        if (estimated_ns > 0.0) {
+            fmt::print(" {:>10.3f}", host_ns / estimated_ns);
+        }
+        fmt::print("\n");
+    }
+    fmt::print("Host and estimated times are averages per command, estimates are converted from "
+               "ADSP ticks at {} ticks/us\n",
+               ESTIMATE_TICKS_PER_US);
+
+    Common::Log::Stop();
+    return 0;
+}
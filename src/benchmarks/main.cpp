@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_session.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#if __has_include(<catch2/benchmark/detail/catch_benchmark_stats.hpp>)
+// Newer Catch2 versions only forward declare the statistics in the reporter interface
+#include <catch2/benchmark/detail/catch_benchmark_stats.hpp>
+#endif
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace {
+std::string json_output_path;
+
+struct BenchmarkResult {
+    std::string test_case;
+    std::string name;
+    u64 samples;
+    u64 iterations;
+    double mean_ns;
+    double mean_lower_ns;
+    double mean_upper_ns;
+    double standard_deviation_ns;
+};
+
+std::string EscapeJson(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+template <typename Duration>
+double ToNanoseconds(Duration duration) {
+    return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+/// Collects benchmark statistics and writes them out as JSON once the run ends
+class JsonBenchmarkListener : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testCaseStarting(const Catch::TestCaseInfo& test_info) override {
+        current_test_case = test_info.name;
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+        results.push_back(BenchmarkResult{
+            .test_case = current_test_case,
+            .name = stats.info.name,
+            .samples = static_cast<u64>(stats.info.samples),
+            .iterations = static_cast<u64>(stats.info.iterations),
+            .mean_ns = ToNanoseconds(stats.mean.point),
+            .mean_lower_ns = ToNanoseconds(stats.mean.lower_bound),
+            .mean_upper_ns = ToNanoseconds(stats.mean.upper_bound),
+            .standard_deviation_ns = ToNanoseconds(stats.standardDeviation.point),
+        });
+    }
+
+    void testRunEnded(const Catch::TestRunStats&) override {
+        if (json_output_path.empty()) {
+            return;
+        }
+        std::string json = "{\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& result = results[i];
+            json += fmt::format(
+                "{}\n    {{\"test_case\": \"{}\", \"name\": \"{}\", \"samples\": {}, "
+                "\"iterations\": {}, \"mean_ns\": {:.3f}, \"mean_lower_ns\": {:.3f}, "
+                "\"mean_upper_ns\": {:.3f}, \"standard_deviation_ns\": {:.3f}}}",
+                i == 0 ? "" : ",", EscapeJson(result.test_case), EscapeJson(result.name),
+                result.samples, result.iterations, result.mean_ns, result.mean_lower_ns,
+                result.mean_upper_ns, result.standard_deviation_ns);
+        }
+        json += "\n  ]\n}\n";
+
+        const Common::FS::IOFile file{json_output_path, Common::FS::FileAccessMode::Write,
+                                      Common::FS::FileType::TextFile};
+        if (!file.IsOpen() || file.WriteString(json) != json.size()) {
+            std::fprintf(stderr, "Failed to write benchmark results to %s\n",
+                         json_output_path.c_str());
+        }
+    }
+
+private:
+    std::string current_test_case;
+    std::vector<BenchmarkResult> results;
+};
+} // Anonymous namespace
+
+CATCH_REGISTER_LISTENER(JsonBenchmarkListener)
+
+int main(int argc, char* argv[]) {
+    Catch::Session session;
+
+    using Catch::Clara::Opt;
+    session.cli(session.cli() | Opt(json_output_path, "path")["--json-out"](
+                                    "write the benchmark results as JSON to the given path"));
+    if (const int result = session.applyCommandLine(argc, argv); result != 0) {
+        return result;
+    }
+    return session.run();
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "tests/video_core/astc_block_generator.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+constexpr u32 WIDTH = 1024;
+constexpr u32 HEIGHT = 1024;
+} // Anonymous namespace
+
+TEST_CASE("ASTC[Decompress]", "[video_core][astc]") {
+    Tests::ASTC::BlockGenerator generator{0xA57C};
+    for (const Tests::ASTC::BlockSize& size : Tests::ASTC::BLOCK_SIZES) {
+        const u32 num_blocks =
+            Common::DivCeil(WIDTH, size.width) * Common::DivCeil(HEIGHT, size.height);
+        std::vector<u8> input(num_blocks * 16);
+        for (u32 i = 0; i < num_blocks; ++i) {
+            const std::array<u8, 16> block = generator.Generate(size);
+            std::memcpy(input.data() + i * 16, block.data(), block.size());
+        }
+        std::vector<u8> output(WIDTH * HEIGHT * 4);
+        BENCHMARK(fmt::format("{}x{}", size.width, size.height)) {
+            Tegra::Texture::ASTC::Decompress(input, WIDTH, HEIGHT, 1, size.width, size.height,
+                                             output);
+            return output[0];
+        };
+    }
+}
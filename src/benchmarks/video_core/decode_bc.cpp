@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/decode_bc.h"
+#include "video_core/texture_cache/types.h"
+
+namespace {
+using VideoCore::Surface::PixelFormat;
+
+constexpr u32 WIDTH = 1024;
+constexpr u32 HEIGHT = 1024;
+
+struct BCnFormat {
+    const char* name;
+    PixelFormat format;
+    u32 block_size;
+};
+
+constexpr std::array<BCnFormat, 7> FORMATS{{
+    {"BC1", PixelFormat::BC1_RGBA_UNORM, 8},
+    {"BC2", PixelFormat::BC2_UNORM, 16},
+    {"BC3", PixelFormat::BC3_UNORM, 16},
+    {"BC4", PixelFormat::BC4_UNORM, 8},
+    {"BC5", PixelFormat::BC5_UNORM, 16},
+    {"BC6H", PixelFormat::BC6H_UFLOAT, 16},
+    {"BC7", PixelFormat::BC7_UNORM, 16},
+}};
+
+// Mode prefixes of BC6H blocks, random bytes would otherwise hit reserved modes that decode to
+// black without doing any work
+constexpr std::array<u8, 14> BC6H_MODES{0x00, 0x01, 0x02, 0x06, 0x0A, 0x0E, 0x12,
+                                        0x16, 0x1A, 0x1E, 0x03, 0x07, 0x0B, 0x0F};
+
+/// Builds random blocks, with BC6H and BC7 blocks spread evenly over their valid modes
+std::vector<u8> MakeBlocks(const BCnFormat& format, u32 num_blocks) {
+    std::mt19937 rng{0xBC17};
+    std::vector<u8> data(num_blocks * format.block_size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    for (u32 i = 0; i < num_blocks; ++i) {
+        u8& mode_byte = data[i * format.block_size];
+        if (format.format == PixelFormat::BC7_UNORM) {
+            // The mode is the index of the lowest set bit
+            const u32 mode = i % 8;
+            mode_byte = static_cast<u8>((mode_byte & ~((2U << mode) - 1)) | (1U << mode));
+        } else if (format.format == PixelFormat::BC6H_UFLOAT) {
+            const u8 mode = BC6H_MODES[i % BC6H_MODES.size()];
+            const u8 mode_mask = mode < 2 ? 0x03 : 0x1F;
+            mode_byte = static_cast<u8>((mode_byte & ~mode_mask) | mode);
+        }
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("BCn[DecompressBCn]", "[video_core][bcn]") {
+    for (const BCnFormat& format : FORMATS) {
+        const std::vector<u8> input = MakeBlocks(format, (WIDTH / 4) * (HEIGHT / 4));
+        std::vector<u8> output(WIDTH * HEIGHT * VideoCommon::ConvertedBytesPerBlock(format.format));
+        BENCHMARK(format.name) {
+            VideoCommon::BufferImageCopy copy{
+                .buffer_offset = 0,
+                .buffer_size = input.size(),
+                .buffer_row_length = WIDTH,
+                .buffer_image_height = HEIGHT,
+                .image_subresource =
+                    {
+                        .base_level = 0,
+                        .base_layer = 0,
+                        .num_layers = 1,
+                    },
+                .image_offset = {0, 0, 0},
+                .image_extent = {WIDTH, HEIGHT, 1},
+            };
+            VideoCommon::DecompressBCn(input, output, copy, format.format);
+            return output[0];
+        };
+    }
+}
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/engines/sw_blitter/converter.h"
+#include "video_core/gpu.h"
+#include "video_core/surface.h"
+
+namespace {
+using Tegra::RenderTargetFormat;
+
+constexpr u32 NUM_PIXELS = 256 * 256;
+
+struct NamedFormat {
+    const char* name;
+    RenderTargetFormat format;
+};
+
+#define FORMAT(name)                                                                               \
+    NamedFormat {                                                                                  \
+        #name, RenderTargetFormat::name                                                            \
+    }
+constexpr std::array FORMATS{
+    FORMAT(R32G32B32A32_FLOAT), FORMAT(R32G32B32A32_SINT), FORMAT(R32G32B32A32_UINT),
+    FORMAT(R32G32B32X32_FLOAT), FORMAT(R32G32B32X32_SINT), FORMAT(R32G32B32X32_UINT),
+    FORMAT(R16G16B16A16_UNORM), FORMAT(R16G16B16A16_SNORM), FORMAT(R16G16B16A16_SINT),
+    FORMAT(R16G16B16A16_UINT),  FORMAT(R16G16B16A16_FLOAT), FORMAT(R32G32_FLOAT),
+    FORMAT(R32G32_SINT),        FORMAT(R32G32_UINT),        FORMAT(R16G16B16X16_FLOAT),
+    FORMAT(A8R8G8B8_UNORM),     FORMAT(A8R8G8B8_SRGB),      FORMAT(A2B10G10R10_UNORM),
+    FORMAT(A2B10G10R10_UINT),   FORMAT(A8B8G8R8_UNORM),     FORMAT(A8B8G8R8_SRGB),
+    FORMAT(A8B8G8R8_SNORM),     FORMAT(A8B8G8R8_SINT),      FORMAT(A8B8G8R8_UINT),
+    FORMAT(R16G16_UNORM),       FORMAT(R16G16_SNORM),       FORMAT(R16G16_SINT),
+    FORMAT(R16G16_UINT),        FORMAT(R16G16_FLOAT),       FORMAT(A2R10G10B10_UNORM),
+    FORMAT(B10G11R11_FLOAT),    FORMAT(R32_SINT),           FORMAT(R32_UINT),
+    FORMAT(R32_FLOAT),          FORMAT(X8R8G8B8_UNORM),     FORMAT(X8R8G8B8_SRGB),
+    FORMAT(R5G6B5_UNORM),       FORMAT(A1R5G5B5_UNORM),     FORMAT(R8G8_UNORM),
+    FORMAT(R8G8_SNORM),         FORMAT(R8G8_SINT),          FORMAT(R8G8_UINT),
+    FORMAT(R16_UNORM),          FORMAT(R16_SNORM),          FORMAT(R16_SINT),
+    FORMAT(R16_UINT),           FORMAT(R16_FLOAT),          FORMAT(R8_UNORM),
+    FORMAT(R8_SNORM),           FORMAT(R8_SINT),            FORMAT(R8_UINT),
+    FORMAT(X1R5G5B5_UNORM),     FORMAT(X8B8G8R8_UNORM),     FORMAT(X8B8G8R8_SRGB),
+};
+#undef FORMAT
+
+u32 BytesPerPixel(RenderTargetFormat format) {
+    return VideoCore::Surface::BytesPerBlock(
+        VideoCore::Surface::PixelFormatFromRenderTargetFormat(format));
+}
+} // Anonymous namespace
+
+TEST_CASE("SwBlitter[ConvertTo]", "[video_core][sw_blitter]") {
+    Tegra::Engines::Blitter::ConverterFactory factory;
+    std::mt19937 rng{0xB117};
+    for (const NamedFormat& format : FORMATS) {
+        std::vector<u8> input(NUM_PIXELS * BytesPerPixel(format.format));
+        for (u8& byte : input) {
+            byte = static_cast<u8>(rng());
+        }
+        std::vector<f32> output(NUM_PIXELS * 4);
+        auto* const converter = factory.GetFormatConverter(format.format);
+        BENCHMARK(format.name) {
+            converter->ConvertTo(input, output);
+            return output[0];
+        };
+    }
+}
+
+TEST_CASE("SwBlitter[ConvertFrom]", "[video_core][sw_blitter]") {
+    Tegra::Engines::Blitter::ConverterFactory factory;
+    std::mt19937 rng{0xB117};
+    std::uniform_real_distribution<f32> distribution{0.0f, 1.0f};
+    for (const NamedFormat& format : FORMATS) {
+        std::vector<f32> input(NUM_PIXELS * 4);
+        for (f32& component : input) {
+            component = distribution(rng);
+        }
+        std::vector<u8> output(NUM_PIXELS * BytesPerPixel(format.format));
+        auto* const converter = factory.GetFormatConverter(format.format);
+        BENCHMARK(format.name) {
+            converter->ConvertFrom(input, output);
+            return output[0];
+        };
+    }
+}
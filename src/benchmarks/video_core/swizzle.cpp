@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+constexpr u32 WIDTH = 512;
+constexpr u32 HEIGHT = 512;
+constexpr std::array<u32, 8> BYTES_PER_PIXEL{1, 2, 3, 4, 6, 8, 12, 16};
+constexpr u32 MAX_BLOCK_HEIGHT = 5;
+
+std::vector<u8> RandomBytes(size_t size) {
+    std::mt19937 rng{0x5A17};
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("Swizzle[UnswizzleTexture]", "[video_core][swizzle]") {
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (u32 block_height = 0; block_height <= MAX_BLOCK_HEIGHT; ++block_height) {
+            const std::vector<u8> input = RandomBytes(Tegra::Texture::CalculateSize(
+                true, bytes_per_pixel, WIDTH, HEIGHT, 1, block_height, 0));
+            std::vector<u8> output(WIDTH * HEIGHT * bytes_per_pixel);
+            BENCHMARK(fmt::format("bpp={} block_height={}", bytes_per_pixel, block_height)) {
+                Tegra::Texture::UnswizzleTexture(output, input, bytes_per_pixel, WIDTH, HEIGHT, 1,
+                                                 block_height, 0);
+                return output[0];
+            };
+        }
+    }
+}
+
+TEST_CASE("Swizzle[SwizzleTexture]", "[video_core][swizzle]") {
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (u32 block_height = 0; block_height <= MAX_BLOCK_HEIGHT; ++block_height) {
+            const std::vector<u8> input = RandomBytes(WIDTH * HEIGHT * bytes_per_pixel);
+            std::vector<u8> output(Tegra::Texture::CalculateSize(true, bytes_per_pixel, WIDTH,
+                                                                 HEIGHT, 1, block_height, 0));
+            BENCHMARK(fmt::format("bpp={} block_height={}", bytes_per_pixel, block_height)) {
+                Tegra::Texture::SwizzleTexture(output, input, bytes_per_pixel, WIDTH, HEIGHT, 1,
+                                               block_height, 0);
+                return output[0];
+            };
+        }
+    }
+}
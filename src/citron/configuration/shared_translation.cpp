@@ -56,6 +56,9 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, audio_muted, tr("Mute audio"), QStringLiteral());
     INSERT(Settings, volume, tr("Volume:"), QStringLiteral());
     INSERT(Settings, dump_audio_commands, QStringLiteral(), QStringLiteral());
+    INSERT(Settings, parallel_voice_processing, tr("Process voices on multiple threads"),
+           tr("Decodes and mixes the voices of the audio renderer on worker threads.\n"
+              "Lowers the audio load of games playing many sounds at once."));
     INSERT(UISettings, mute_when_in_background, tr("Mute audio when in background"),
            QStringLiteral());
 
@@ -215,6 +218,13 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, sparse_texture_priority_eviction, tr("Sparse Texture Priority Eviction"),
            tr("Prioritize evicting large sparse textures when VRAM pressure is high. "
               "This helps prevent VRAM exhaustion in games with large texture atlases."));
+    INSERT(Settings, use_disk_texture_cache, tr("Use disk texture transcode cache"),
+           tr("Saves textures decoded or recompressed on the CPU (ASTC, BCn) to storage, so they "
+              "don't have to be transcoded again on following game boots.\nRequires the disk "
+              "pipeline cache."));
+    INSERT(Settings, disk_texture_cache_size_mb, tr("Disk Texture Cache Size (MB):"),
+           tr("Maximum size of the texture transcode cache of each game. The least recently "
+              "used textures are removed when it is full."));
     INSERT(Settings, log_vram_usage, tr("Log VRAM Usage"),
            tr("Enable logging of VRAM usage statistics for debugging purposes. "
               "Check the log for 'VRAM GC' and 'VRAM Status' messages."));
@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#include "common/fs/async_reader.h"
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+
+// Android apps aren't allowed to use io_uring, the syscalls are killed by the seccomp filter
+#if defined(__linux__) && !defined(ANDROID) && __has_include(<linux/io_uring.h>)
+#define CITRON_HAS_IO_URING
+#endif
+
+#ifdef CITRON_HAS_IO_URING
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "common/assert.h"
+#include "common/thread.h"
+#endif
+
+namespace Common::FS {
+
+namespace {
+
+struct ReadRequest {
+    std::shared_ptr<IOFile> file;
+    std::span<u8> data;
+    s64 offset;
+    AsyncReader::Callback callback;
+#ifdef CITRON_HAS_IO_URING
+    iovec vector;
+#endif
+
+    /// Reads what the asynchronous read left out, if anything, and reports the result
+    void Complete(size_t bytes_read) {
+        if (bytes_read < data.size()) {
+            bytes_read +=
+                file->ReadAt(data.subspan(bytes_read), offset + static_cast<s64>(bytes_read));
+        }
+        callback(std::move(bytes_read));
+    }
+};
+
+} // Anonymous namespace
+
+#ifdef CITRON_HAS_IO_URING
+
+// Minimal io_uring driver on top of the raw syscalls. Submissions are serialized by a mutex, a
+// dedicated thread reaps the completions and submits the reads waiting for a free slot.
+class AsyncReader::IoUring {
+public:
+    static std::unique_ptr<IoUring> Create() {
+        auto ring = std::unique_ptr<IoUring>(new IoUring);
+        if (!ring->Initialize()) {
+            return nullptr;
+        }
+        ring->completion_thread = std::jthread([ring = ring.get()] { ring->CompletionLoop(); });
+        return ring;
+    }
+
+    ~IoUring() {
+        if (completion_thread.joinable()) {
+            {
+                std::scoped_lock lk{mutex};
+                stopping = true;
+                // Reads in flight wake the completion thread when they complete. Without any it
+                // may sleep for good, but then none of them takes up a slot of the ring either.
+                if (in_flight == 0) {
+                    this->SubmitLocked(nullptr);
+                }
+            }
+            completion_thread.join();
+        }
+        if (sqes != nullptr) {
+            munmap(sqes, sqes_size);
+        }
+        if (cq_ring != nullptr && cq_ring != sq_ring) {
+            munmap(cq_ring, cq_ring_size);
+        }
+        if (sq_ring != nullptr) {
+            munmap(sq_ring, sq_ring_size);
+        }
+        if (ring_fd >= 0) {
+            close(ring_fd);
+        }
+    }
+
+    void Submit(std::unique_ptr<ReadRequest> request) {
+        std::scoped_lock lk{mutex};
+        if (in_flight >= capacity) {
+            pending.push_back(std::move(request));
+            return;
+        }
+        this->SubmitLocked(request.release());
+    }
+
+private:
+    IoUring() = default;
+
+    bool Initialize() {
+        io_uring_params params{};
+        ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, MaxInFlightReads, &params));
+        if (ring_fd < 0) {
+            return false;
+        }
+
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+        sq_ring = this->MapRing(sq_ring_size, IORING_OFF_SQ_RING);
+        if (sq_ring == nullptr) {
+            return false;
+        }
+        cq_ring = single_mmap ? sq_ring : this->MapRing(cq_ring_size, IORING_OFF_CQ_RING);
+        if (cq_ring == nullptr) {
+            return false;
+        }
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(this->MapRing(sqes_size, IORING_OFF_SQES));
+        if (sqes == nullptr) {
+            return false;
+        }
+
+        sq_head = this->RingField(sq_ring, params.sq_off.head);
+        sq_tail = this->RingField(sq_ring, params.sq_off.tail);
+        sq_mask = *this->RingField(sq_ring, params.sq_off.ring_mask);
+        sq_array = this->RingField(sq_ring, params.sq_off.array);
+        cq_head = this->RingField(cq_ring, params.cq_off.head);
+        cq_tail = this->RingField(cq_ring, params.cq_off.tail);
+        cq_mask = *this->RingField(cq_ring, params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(static_cast<u8*>(cq_ring) + params.cq_off.cqes);
+        capacity = params.sq_entries;
+        return true;
+    }
+
+    void* MapRing(size_t size, off_t offset) const {
+        void* const pointer =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+        return pointer == MAP_FAILED ? nullptr : pointer;
+    }
+
+    static u32* RingField(void* ring, u32 offset) {
+        return reinterpret_cast<u32*>(static_cast<u8*>(ring) + offset);
+    }
+
+    long Enter(u32 to_submit, u32 min_complete, u32 flags) const {
+        long result;
+        do {
+            result = syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr,
+                             0);
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    /// Queues a read, or a no-op waking the completion thread when request is null
+    void SubmitLocked(ReadRequest* request) {
+        const u32 tail = std::atomic_ref{*sq_tail}.load(std::memory_order_relaxed);
+        const u32 head = std::atomic_ref{*sq_head}.load(std::memory_order_acquire);
+        ASSERT_MSG(tail - head < capacity, "Submitting to a full io_uring");
+        const u32 index = tail & sq_mask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        if (request != nullptr) {
+            request->vector = {request->data.data(), request->data.size()};
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = request->file->GetFileDescriptor();
+            sqe.addr = reinterpret_cast<u64>(&request->vector);
+            sqe.len = 1;
+            sqe.off = static_cast<u64>(request->offset);
+            sqe.user_data = reinterpret_cast<u64>(request);
+            ++in_flight;
+        } else {
+            sqe.opcode = IORING_OP_NOP;
+        }
+        sq_array[index] = index;
+        std::atomic_ref{*sq_tail}.store(tail + 1, std::memory_order_release);
+
+        if (this->Enter(1, 0, 0) < 0) {
+            // The entry stays in the ring and goes out with the next submission
+            LOG_ERROR(Common_Filesystem, "io_uring_enter failed: {}", strerror(errno));
+        }
+    }
+
+    void CompletionLoop() {
+        Common::SetCurrentThreadName("FsIoUring");
+        std::vector<std::pair<ReadRequest*, s32>> completed;
+        while (true) {
+            u32 head = std::atomic_ref{*cq_head}.load(std::memory_order_relaxed);
+            const u32 tail = std::atomic_ref{*cq_tail}.load(std::memory_order_acquire);
+            if (head == tail) {
+                {
+                    std::scoped_lock lk{mutex};
+                    if (stopping && in_flight == 0 && pending.empty()) {
+                        return;
+                    }
+                }
+                this->Enter(0, 1, IORING_ENTER_GETEVENTS);
+                continue;
+            }
+
+            completed.clear();
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes[head & cq_mask];
+                if (cqe.user_data != 0) {
+                    completed.emplace_back(reinterpret_cast<ReadRequest*>(cqe.user_data), cqe.res);
+                }
+            }
+            std::atomic_ref{*cq_head}.store(head, std::memory_order_release);
+
+            // Refill the ring before running the callbacks, they may queue more reads.
+            {
+                std::scoped_lock lk{mutex};
+                in_flight -= static_cast<u32>(completed.size());
+                while (in_flight < capacity && !pending.empty()) {
+                    this->SubmitLocked(pending.front().release());
+                    pending.pop_front();
+                }
+            }
+
+            // Failed and short reads are finished with a positional read
+            for (const auto& [pointer, result] : completed) {
+                std::unique_ptr<ReadRequest> request{pointer};
+                request->Complete(result > 0 ? static_cast<size_t>(result) : 0);
+            }
+        }
+    }
+
+    int ring_fd{-1};
+    void* sq_ring{};
+    void* cq_ring{};
+    io_uring_sqe* sqes{};
+    size_t sq_ring_size{};
+    size_t cq_ring_size{};
+    size_t sqes_size{};
+
+    u32* sq_head{};
+    u32* sq_tail{};
+    u32* sq_array{};
+    u32 sq_mask{};
+    u32* cq_head{};
+    u32* cq_tail{};
+    u32 cq_mask{};
+    io_uring_cqe* cqes{};
+
+    std::mutex mutex;
+    std::deque<std::unique_ptr<ReadRequest>> pending;
+    u32 capacity{};
+    u32 in_flight{};
+    bool stopping{};
+    std::jthread completion_thread;
+};
+
+#else
+
+class AsyncReader::IoUring {};
+
+#endif
+
+AsyncReader::AsyncReader([[maybe_unused]] bool allow_io_uring)
+    : workers{NumWorkers, "FsAsyncRead"} {
+#ifdef CITRON_HAS_IO_URING
+    if (!allow_io_uring) {
+        return;
+    }
+    io_uring = IoUring::Create();
+    if (io_uring == nullptr) {
+        LOG_INFO(Common_Filesystem, "io_uring is unavailable, reading files on a thread pool");
+    }
+#endif
+}
+
+AsyncReader::~AsyncReader() = default;
+
+AsyncReader& AsyncReader::GetInstance() {
+    static AsyncReader reader;
+    return reader;
+}
+
+void AsyncReader::Read(std::shared_ptr<IOFile> file, std::span<u8> data, s64 offset,
+                       Callback callback) {
+    auto request = std::make_unique<ReadRequest>();
+    request->file = std::move(file);
+    request->data = data;
+    request->offset = offset;
+    request->callback = std::move(callback);
+
+#ifdef CITRON_HAS_IO_URING
+    if (io_uring != nullptr) {
+        io_uring->Submit(std::move(request));
+        return;
+    }
+#endif
+    workers.QueueWork([request = std::move(request)] { request->Complete(0); });
+}
+
+void AsyncReader::QueueWork(Common::UniqueFunction<void> work) {
+    workers.QueueWork(std::move(work));
+}
+
+} // namespace Common::FS
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "common/unique_function.h"
+
+namespace Common::FS {
+
+class IOFile;
+
+/**
+ * Performs file reads in the background so many of them can be in flight at once.
+ * On Linux the reads are submitted to an io_uring and completed by a single thread, elsewhere or
+ * when the kernel refuses to create the ring a pool of threads performs positional reads.
+ * Completion callbacks run on the reader threads and should return quickly.
+ */
+class AsyncReader final {
+public:
+    using Callback = Common::UniqueFunction<void, size_t>;
+
+    /// Reads kept in flight at once by the io_uring, further ones wait for a slot
+    static constexpr u32 MaxInFlightReads = 64;
+
+    /// Threads of the fallback pool, also running the work queued with QueueWork
+    static constexpr size_t NumWorkers = 4;
+
+    /**
+     * Creates a reader with threads of its own, most users should share the one of GetInstance.
+     *
+     * @param allow_io_uring Whether reads may be submitted to an io_uring, the thread pool is
+     *                       used otherwise
+     */
+    explicit AsyncReader(bool allow_io_uring = true);
+    ~AsyncReader();
+
+    AsyncReader(const AsyncReader&) = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+
+    static AsyncReader& GetInstance();
+
+    /**
+     * Reads data.size() bytes at offset of file, then calls callback with the count of bytes
+     * successfully read. The file is kept open until the read completes, data has to stay valid.
+     *
+     * @param file File to read from
+     * @param data Span of bytes to read into
+     * @param offset Offset from the start of the file
+     * @param callback Called with the count of bytes read once the read completes
+     */
+    void Read(std::shared_ptr<IOFile> file, std::span<u8> data, s64 offset, Callback callback);
+
+    /// Runs work on the reader threads, for reads which don't map to a single host file read.
+    void QueueWork(Common::UniqueFunction<void> work);
+
+    /**
+     * Checks whether reads are submitted to an io_uring.
+     *
+     * @returns True if the io_uring backend is in use, false if reads go through the thread pool.
+     */
+    [[nodiscard]] bool IsUsingIoUring() const {
+        return io_uring != nullptr;
+    }
+
+private:
+    class IoUring;
+
+    Common::ThreadWorker workers;
+    std::unique_ptr<IoUring> io_uring;
+};
+
+} // namespace Common::FS
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <vector>
 
 #include "common/fs/file.h"
@@ -13,6 +14,7 @@
 #ifdef _WIN32
 #include <io.h>
 #include <share.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #endif
@@ -452,4 +454,52 @@ s64 IOFile::Tell() const {
     return ftello(file);
 }
 
+size_t IOFile::ReadAt(std::span<u8> data, s64 offset) const {
+    if (!IsOpen()) {
+        return 0;
+    }
+
+    size_t total_read = 0;
+    while (total_read < data.size()) {
+        const s64 current_offset = offset + static_cast<s64>(total_read);
+        const size_t remaining = data.size() - total_read;
+#ifdef _WIN32
+        // ReadFile reads at the offset of the OVERLAPPED structure. The handle is synchronous, so
+        // it also moves the file pointer to the end of the read, the CRT doesn't know about it
+        const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fileno(file)));
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(current_offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(current_offset >> 32);
+        DWORD bytes_read = 0;
+        const DWORD request_size = static_cast<DWORD>(std::min<size_t>(remaining, 1U << 30));
+        if (!ReadFile(handle, data.data() + total_read, request_size, &bytes_read, &overlapped)) {
+            break;
+        }
+#else
+        const ssize_t bytes_read =
+            pread(fileno(file), data.data() + total_read, remaining, current_offset);
+        if (bytes_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_read < 0) {
+            const auto ec = std::error_code{errno, std::generic_category()};
+            LOG_ERROR(Common_Filesystem, "Failed to read the file at path={}, ec_message={}",
+                      PathToUTF8String(file_path), ec.message());
+            break;
+        }
+#endif
+        if (bytes_read == 0) {
+            break;
+        }
+        total_read += static_cast<size_t>(bytes_read);
+    }
+    return total_read;
+}
+
+#ifndef _WIN32
+int IOFile::GetFileDescriptor() const {
+    return IsOpen() ? fileno(file) : -1;
+}
+#endif
+
 } // namespace Common::FS
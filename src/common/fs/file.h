@@ -457,6 +457,34 @@ public:
      */
     [[nodiscard]] s64 Tell() const;
 
+    /**
+     * Reads bytes at the specified offset without going through the buffer of the file, so
+     * several threads can read the same file at once.
+     * Data written through the buffer of the file may not be visible before a Flush().
+     * On Windows the read moves the file pointer of the handle behind the buffer of the file, so
+     * files read with ReadAt shouldn't be read or written through Seek() and Tell() as well.
+     *
+     * Failures occur when:
+     * - The file is not open
+     * - The opened file lacks read permissions
+     * - Attempting to read beyond the end-of-file
+     *
+     * @param data Span of bytes to read into
+     * @param offset Offset from the start of the file
+     *
+     * @returns Count of bytes successfully read.
+     */
+    [[nodiscard]] size_t ReadAt(std::span<u8> data, s64 offset) const;
+
+#ifndef _WIN32
+    /**
+     * Gets the descriptor of the opened file.
+     *
+     * @returns The file descriptor, -1 if the file is not open.
+     */
+    [[nodiscard]] int GetFileDescriptor() const;
+#endif
+
 private:
     std::filesystem::path file_path;
     FileAccessMode file_access_mode{};
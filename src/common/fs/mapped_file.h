@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * A read-only memory mapping of a whole file.
+ * The contents are paged in on demand by the host and shared with the host page cache, so reads
+ * through Data() don't copy anything until the caller does.
+ * Automatically unmaps the file on the destruction of a MappedFile object.
+ *
+ * Accessing pages which are no longer backed by the file raises SIGBUS on POSIX hosts and an
+ * in-page error on Windows, for example after the file was truncated or the removable medium
+ * holding it was ejected. Only map files which are expected to stay unchanged while mapped.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path, unmapping any previously mapped file.
+     * Empty files can't be mapped and leave the object closed.
+     *
+     * @param path Filesystem path
+     *
+     * @returns True if the file was mapped, false otherwise.
+     */
+    bool Open(const std::filesystem::path& path);
+
+    /// Unmaps the file if it is mapped.
+    void Close();
+
+    /**
+     * Checks whether a file is mapped.
+     *
+     * @returns True if a file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /**
+     * Gets the mapped contents of the file.
+     *
+     * @returns Span over the whole file, empty if no file is mapped.
+     */
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {data, size};
+    }
+
+    /**
+     * Gets the size of the mapped file.
+     *
+     * @returns The size of the file in bytes, 0 if no file is mapped.
+     */
+    [[nodiscard]] size_t Size() const {
+        return size;
+    }
+
+private:
+    const u8* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* mapping_handle = nullptr;
+#endif
+};
+
+} // namespace Common::FS
@@ -196,6 +196,12 @@ struct Values {
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    // Records the audio renderer command lists for citron_audio_render_bench
+    Setting<bool, false> capture_audio_commands{
+        linkage, false, "capture_audio_commands", Category::Audio, Specialization::Default, false};
+    // Runs the voices of the audio renderer on worker threads
+    Setting<bool> parallel_voice_processing{linkage, true, "parallel_voice_processing",
+                                            Category::Audio};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
@@ -556,6 +562,21 @@ struct Values {
                                                               "sparse_texture_priority_eviction",
                                                               Category::RendererAdvanced};
 
+    // Persist CPU transcoded ASTC/BCn textures next to the pipeline cache
+    SwitchableSetting<bool> use_disk_texture_cache{linkage, true, "use_disk_texture_cache",
+                                                   Category::RendererAdvanced};
+
+    // Size budget of the transcoded texture cache of each title, in MiB
+    SwitchableSetting<u32, true> disk_texture_cache_size_mb{linkage,
+                                                             1024,  // default: 1GB
+                                                             64,    // min: 64MB
+                                                             16384, // max: 16GB
+                                                             "disk_texture_cache_size_mb",
+                                                             Category::RendererAdvanced,
+                                                             Specialization::Default,
+                                                             true,
+                                                             true};
+
     // Enable VRAM usage logging for debugging
     SwitchableSetting<bool> log_vram_usage{linkage, false, "log_vram_usage",
                                             Category::RendererAdvanced};
@@ -759,6 +780,10 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    // Checks the RomFS blocks read from NCAs against their hash tree, blocks that fail are cleared.
+    // Off by default so that dumps with a modified or damaged block keep loading.
+    Setting<bool> verify_romfs_integrity{linkage, false, "verify_romfs_integrity",
+                                         Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -772,6 +797,9 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    // Records the GPU command lists of the session for citron_gpu_replay
+    Setting<bool> capture_gpu_commands{linkage, false, "capture_gpu_commands",
+                                       Category::DebuggingGraphics};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+
+namespace Common {
+
+/**
+ * Fixed capacity single producer, single consumer ring.
+ *
+ * Elements are constructed in preallocated slots and consumed in place, the consumer releases a
+ * slot once it is done with it. Neither side takes a lock: sleeping goes through futex backed
+ * atomic waits and a side only issues a wake up when the other one is actually asleep, so a burst
+ * of pushes against a busy consumer doesn't make a single system call.
+ *
+ * Callers with several producers have to serialize them themselves.
+ */
+template <typename T, size_t Capacity>
+class SPSCRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    SPSCRing() : slots{std::make_unique<T[]>(Capacity)} {}
+
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    /**
+     * Pushes a new element, waits for the consumer if the ring is full.
+     * Returns false without pushing when the stop token is triggered while waiting.
+     */
+    template <typename... Args>
+    bool EmplaceWait(std::stop_token stop_token, Args&&... args) {
+        const size_t write = producer.index.load(std::memory_order_relaxed);
+        if (write - consumer.index.load(std::memory_order_acquire) == Capacity &&
+            !WaitWritable(write, stop_token)) {
+            return false;
+        }
+        slots[write % Capacity] = T(std::forward<Args>(args)...);
+
+        producer.index.store(write + 1, std::memory_order_seq_cst);
+        if (consumer.sleeping.load(std::memory_order_seq_cst)) {
+            producer.epoch.fetch_add(1, std::memory_order_release);
+            producer.epoch.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * Waits until there is something to read and returns the number of readable elements.
+     * Returns zero when the stop token is triggered.
+     */
+    [[nodiscard]] size_t WaitReadable(std::stop_token stop_token) {
+        const size_t read = consumer.index.load(std::memory_order_relaxed);
+        size_t write = producer.index.load(std::memory_order_acquire);
+        if (write != read) {
+            return write - read;
+        }
+        std::stop_callback callback{stop_token, [this] {
+                                        producer.epoch.fetch_add(1, std::memory_order_release);
+                                        producer.epoch.notify_all();
+                                    }};
+        while (true) {
+            const u32 epoch = producer.epoch.load(std::memory_order_acquire);
+            consumer.sleeping.store(true, std::memory_order_seq_cst);
+            write = producer.index.load(std::memory_order_seq_cst);
+            if (write != read || stop_token.stop_requested()) {
+                consumer.sleeping.store(false, std::memory_order_relaxed);
+                return write - read;
+            }
+            producer.epoch.wait(epoch, std::memory_order_acquire);
+            consumer.sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /// Oldest readable element, only valid after WaitReadable returned a non zero count
+    [[nodiscard]] T& Front() noexcept {
+        return slots[consumer.index.load(std::memory_order_relaxed) % Capacity];
+    }
+
+    /// Resets the oldest element and hands its slot back to the producer
+    void PopFront() {
+        const size_t read = consumer.index.load(std::memory_order_relaxed);
+        slots[read % Capacity] = T{};
+
+        consumer.index.store(read + 1, std::memory_order_seq_cst);
+        if (producer.sleeping.load(std::memory_order_seq_cst)) {
+            consumer.epoch.fetch_add(1, std::memory_order_release);
+            consumer.epoch.notify_one();
+        }
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return producer.index.load(std::memory_order_acquire) ==
+               consumer.index.load(std::memory_order_acquire);
+    }
+
+private:
+    /// Waits until the consumer frees a slot, returns false when the stop token is triggered
+    bool WaitWritable(size_t write, std::stop_token stop_token) {
+        std::stop_callback callback{stop_token, [this] {
+                                        consumer.epoch.fetch_add(1, std::memory_order_release);
+                                        consumer.epoch.notify_all();
+                                    }};
+        bool writable{};
+        while (true) {
+            const u32 epoch = consumer.epoch.load(std::memory_order_acquire);
+            producer.sleeping.store(true, std::memory_order_seq_cst);
+            writable = write - consumer.index.load(std::memory_order_seq_cst) < Capacity;
+            if (writable || stop_token.stop_requested()) {
+                break;
+            }
+            consumer.epoch.wait(epoch, std::memory_order_acquire);
+        }
+        producer.sleeping.store(false, std::memory_order_relaxed);
+        return writable;
+    }
+
+    /// State written by a single side, kept on its own cache lines
+    struct alignas(128) Side {
+        std::atomic_size_t index{};
+        std::atomic<u32> epoch{};   ///< Bumped to wake up the other side
+        std::atomic_bool sleeping{}; ///< Set while this side waits for the other one
+    };
+
+    Side producer;
+    Side consumer;
+    std::unique_ptr<T[]> slots;
+};
+
+} // namespace Common
@@ -139,6 +139,7 @@ static CPUCaps Detect() {
                 caps.avx512vl = Common::Bit<31>(cpu_id[1]);
                 caps.avx512vbmi = Common::Bit<1>(cpu_id[2]);
                 caps.avx512bitalg = Common::Bit<12>(cpu_id[2]);
+                caps.vaes = Common::Bit<9>(cpu_id[2]);
             }
 
             caps.bmi1 = Common::Bit<3>(cpu_id[1]);
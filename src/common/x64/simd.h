@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// Functions using instruction set extensions above the x86-64 baseline have to be compiled for
+// that extension explicitly on GCC and Clang, as the translation units themselves are built for
+// the baseline. MSVC allows any intrinsic to be used anywhere, so the attributes are empty there.
+// Callers are responsible for checking Common::GetCPUCaps() before calling into such functions.
+#ifdef _MSC_VER
+#define CITRON_TARGET_SSE41
+#define CITRON_TARGET_AVX2
+#define CITRON_TARGET_BMI2
+#define CITRON_TARGET_AES
+#define CITRON_TARGET_VAES
+#define CITRON_TARGET_SHA
+#else
+#define CITRON_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CITRON_TARGET_AVX2 __attribute__((target("avx2")))
+#define CITRON_TARGET_BMI2 __attribute__((target("bmi2")))
+#define CITRON_TARGET_AES __attribute__((target("aes,sse4.1")))
+#define CITRON_TARGET_VAES __attribute__((target("vaes,aes,avx2")))
+#define CITRON_TARGET_SHA __attribute__((target("sha,sse4.1")))
+#endif
@@ -325,6 +325,20 @@ struct System::Impl {
         cpu_manager.Initialize();
     }
 
+    SystemResultStatus SetupForGPUReplay(System& system, Frontend::EmuWindow& emu_window) {
+        // There is no process to load, but replays still back their pages with kernel memory
+        InitializeKernel(system);
+
+        host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
+        gpu_core = VideoCore::CreateGPU(emu_window, system);
+        if (!gpu_core) {
+            return SystemResultStatus::ErrorVideoCore;
+        }
+
+        is_powered_on = true;
+        return SystemResultStatus::Success;
+    }
+
     SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
         telemetry_session = std::make_unique<Core::TelemetrySession>();
 
@@ -709,6 +723,10 @@ SystemResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::stri
     return impl->Load(*this, emu_window, filepath, params);
 }
 
+SystemResultStatus System::SetupForGPUReplay(Frontend::EmuWindow& emu_window) {
+    return impl->SetupForGPUReplay(*this, emu_window);
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on.load(std::memory_order::relaxed);
 }
@@ -858,7 +876,8 @@ const Core::SpeedLimiter& System::SpeedLimiter() const {
 }
 
 u64 System::GetApplicationProcessProgramID() const {
-    return impl->kernel.ApplicationProcess()->GetProgramId();
+    const auto* const process = impl->kernel.ApplicationProcess();
+    return process != nullptr ? process->GetProgramId() : 0;
 }
 
 Loader::ResultStatus System::GetGameName(std::string& out) const {
@@ -212,6 +212,15 @@ public:
                                           const std::string& filepath,
                                           Service::AM::FrontendAppletParameters& params);
 
+    /**
+     * Initializes the kernel and creates Host1x and the GPU of the configured renderer without
+     * loading an application, for tools that replay recorded GPU work. The system reports being
+     * powered on afterwards.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns SystemResultStatus code, indicating if the operation succeeded.
+     */
+    [[nodiscard]] SystemResultStatus SetupForGPUReplay(Frontend::EmuWindow& emu_window);
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
@@ -327,6 +336,7 @@ public:
     /// Provides a constant reference to the speed limiter
     [[nodiscard]] const Core::SpeedLimiter& SpeedLimiter() const;
 
+    /// Gets the program ID of the application process, or 0 when no application is loaded
     [[nodiscard]] u64 GetApplicationProcessProgramID() const;
 
     /// Gets the name of the current game
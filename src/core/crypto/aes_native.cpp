@@ -0,0 +1,693 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "common/swap.h"
+#include "core/crypto/aes_native.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+#if defined(ARCHITECTURE_arm64)
+#if defined(_MSC_VER)
+#define CITRON_TARGET_ARM_CRYPTO
+#elif defined(__clang__)
+#define CITRON_TARGET_ARM_CRYPTO __attribute__((target("crypto")))
+#else
+#define CITRON_TARGET_ARM_CRYPTO __attribute__((target("+crypto")))
+#endif
+#endif
+
+namespace Core::Crypto::AesNative {
+namespace {
+
+constexpr std::size_t NUM_ROUND_KEYS = NUM_ROUNDS + 1;
+
+/// Blocks kept in flight by the 128-bit kernels, enough to cover the latency of a round
+constexpr std::size_t LANES = 8;
+
+constexpr u8 XTime(u8 value) {
+    return static_cast<u8>((value << 1) ^ ((value & 0x80) != 0 ? 0x1B : 0));
+}
+
+constexpr u8 GfMultiply(u8 a, u8 b) {
+    u8 product = 0;
+    for (; b != 0; b >>= 1) {
+        if ((b & 1) != 0) {
+            product ^= a;
+        }
+        a = XTime(a);
+    }
+    return product;
+}
+
+constexpr u8 RotateLeft(u8 value, int shift) {
+    return static_cast<u8>((value << shift) | (value >> (8 - shift)));
+}
+
+/// Walks the multiplicative group with the generator 3 to pair every element with its inverse
+constexpr std::array<u8, 256> SBOX = [] {
+    std::array<u8, 256> sbox{};
+    u8 p = 1;
+    u8 q = 1;
+    do {
+        p = static_cast<u8>(p ^ XTime(p));
+        q ^= static_cast<u8>(q << 1);
+        q ^= static_cast<u8>(q << 2);
+        q ^= static_cast<u8>(q << 4);
+        if ((q & 0x80) != 0) {
+            q ^= 0x09;
+        }
+        sbox[p] = static_cast<u8>(q ^ RotateLeft(q, 1) ^ RotateLeft(q, 2) ^ RotateLeft(q, 3) ^
+                                  RotateLeft(q, 4) ^ 0x63);
+    } while (p != 1);
+    sbox[0] = 0x63;
+    return sbox;
+}();
+
+Block InverseMixColumns(const Block& block) {
+    Block result;
+    for (std::size_t column = 0; column < BLOCK_SIZE; column += 4) {
+        const u8* const a = &block[column];
+        result[column + 0] = GfMultiply(a[0], 14) ^ GfMultiply(a[1], 11) ^ GfMultiply(a[2], 13) ^
+                             GfMultiply(a[3], 9);
+        result[column + 1] = GfMultiply(a[0], 9) ^ GfMultiply(a[1], 14) ^ GfMultiply(a[2], 11) ^
+                             GfMultiply(a[3], 13);
+        result[column + 2] = GfMultiply(a[0], 13) ^ GfMultiply(a[1], 9) ^ GfMultiply(a[2], 14) ^
+                             GfMultiply(a[3], 11);
+        result[column + 3] = GfMultiply(a[0], 11) ^ GfMultiply(a[1], 13) ^ GfMultiply(a[2], 9) ^
+                             GfMultiply(a[3], 14);
+    }
+    return result;
+}
+
+/// Multiplies a little endian XTS tweak by x in GF(2^128), used outside of the kernels
+Block MultiplyTweak(const Block& tweak) {
+    u64 low;
+    u64 high;
+    std::memcpy(&low, tweak.data(), sizeof(low));
+    std::memcpy(&high, tweak.data() + sizeof(low), sizeof(high));
+    const u64 carry = high >> 63;
+    high = (high << 1) | (low >> 63);
+    low = (low << 1) ^ (carry * 0x87);
+    Block result;
+    std::memcpy(result.data(), &low, sizeof(low));
+    std::memcpy(result.data() + sizeof(low), &high, sizeof(high));
+    return result;
+}
+
+void XorBlock(u8* dest, const u8* a, const u8* b) {
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        dest[i] = a[i] ^ b[i];
+    }
+}
+
+/// Block kernels of an instruction set, the XTS ones take an already encrypted tweak
+struct Kernels {
+    void (*encrypt)(const KeySchedule& keys, const u8* src, u8* dest, std::size_t num_blocks);
+    void (*decrypt)(const KeySchedule& keys, const u8* src, u8* dest, std::size_t num_blocks);
+    void (*ctr)(const KeySchedule& keys, Block& counter, const u8* src, u8* dest,
+                std::size_t num_blocks);
+    void (*xts_encrypt)(const KeySchedule& keys, Block& tweak, const u8* src, u8* dest,
+                        std::size_t num_blocks);
+    void (*xts_decrypt)(const KeySchedule& keys, Block& tweak, const u8* src, u8* dest,
+                        std::size_t num_blocks);
+};
+
+#if defined(ARCHITECTURE_x86_64)
+
+CITRON_TARGET_AES inline void LoadRoundKeys(const KeySchedule& keys, __m128i* round_keys) {
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        round_keys[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(keys.round_keys[i].data()));
+    }
+}
+
+template <bool decrypt, std::size_t N>
+CITRON_TARGET_AES inline void CipherAESNI(const __m128i* round_keys, __m128i* blocks) {
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], round_keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = decrypt ? _mm_aesdec_si128(blocks[i], round_keys[round])
+                                : _mm_aesenc_si128(blocks[i], round_keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = decrypt ? _mm_aesdeclast_si128(blocks[i], round_keys[NUM_ROUNDS])
+                            : _mm_aesenclast_si128(blocks[i], round_keys[NUM_ROUNDS]);
+    }
+}
+
+CITRON_TARGET_AES inline __m128i Load(const u8* src) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+CITRON_TARGET_AES inline void Store(u8* dest, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), value);
+}
+
+/// Byte shuffle between the big endian counter block and a little endian 128-bit integer
+CITRON_TARGET_AES inline __m128i ByteSwap128(__m128i value) {
+    return _mm_shuffle_epi8(value,
+                            _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/// Returns the counter block of a little endian counter and increments it
+CITRON_TARGET_AES inline __m128i NextCounter(__m128i& counter) {
+    const __m128i block = ByteSwap128(counter);
+    counter = _mm_add_epi64(counter, _mm_set_epi64x(0, 1));
+    // Carry into the high half when the low half wrapped around
+    const __m128i wrapped = _mm_and_si128(_mm_cmpeq_epi64(counter, _mm_setzero_si128()),
+                                          _mm_set_epi64x(0, -1));
+    counter = _mm_sub_epi64(counter, _mm_slli_si128(wrapped, 8));
+    return block;
+}
+
+CITRON_TARGET_AES inline __m128i MultiplyTweakSSE(__m128i tweak) {
+    const __m128i carry = _mm_and_si128(_mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x93),
+                                        _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_add_epi32(tweak, tweak), carry);
+}
+
+template <bool decrypt>
+CITRON_TARGET_AES void EcbAESNI(const KeySchedule& keys, const u8* src, u8* dest,
+                                std::size_t num_blocks) {
+    __m128i round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        __m128i blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            blocks[i] = Load(src + i * BLOCK_SIZE);
+        }
+        CipherAESNI<decrypt, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            Store(dest + i * BLOCK_SIZE, blocks[i]);
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        __m128i block = Load(src);
+        CipherAESNI<decrypt, 1>(round_keys, &block);
+        Store(dest, block);
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+}
+
+CITRON_TARGET_AES void CtrAESNI(const KeySchedule& keys, Block& counter_block, const u8* src,
+                                u8* dest, std::size_t num_blocks) {
+    __m128i round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    __m128i counter = ByteSwap128(Load(counter_block.data()));
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        __m128i blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            blocks[i] = NextCounter(counter);
+        }
+        CipherAESNI<false, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            Store(dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], Load(src + i * BLOCK_SIZE)));
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        __m128i block = NextCounter(counter);
+        CipherAESNI<false, 1>(round_keys, &block);
+        Store(dest, _mm_xor_si128(block, Load(src)));
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+    Store(counter_block.data(), ByteSwap128(counter));
+}
+
+template <bool decrypt>
+CITRON_TARGET_AES void XtsAESNI(const KeySchedule& keys, Block& tweak_block, const u8* src,
+                                u8* dest, std::size_t num_blocks) {
+    __m128i round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    __m128i tweak = Load(tweak_block.data());
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        __m128i tweaks[LANES];
+        __m128i blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            tweaks[i] = tweak;
+            tweak = MultiplyTweakSSE(tweak);
+            blocks[i] = _mm_xor_si128(Load(src + i * BLOCK_SIZE), tweaks[i]);
+        }
+        CipherAESNI<decrypt, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            Store(dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], tweaks[i]));
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        __m128i block = _mm_xor_si128(Load(src), tweak);
+        CipherAESNI<decrypt, 1>(round_keys, &block);
+        Store(dest, _mm_xor_si128(block, tweak));
+        tweak = MultiplyTweakSSE(tweak);
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+    Store(tweak_block.data(), tweak);
+}
+
+// The VAES kernels process two blocks per register, partial batches go through AES-NI
+
+/// Blocks kept in flight by the 256-bit kernels
+constexpr std::size_t WIDE_LANES = 16;
+
+template <bool decrypt>
+CITRON_TARGET_VAES inline void CipherVAES(const __m256i* round_keys, __m256i* blocks) {
+    constexpr std::size_t N = WIDE_LANES / 2;
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm256_xor_si256(blocks[i], round_keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = decrypt ? _mm256_aesdec_epi128(blocks[i], round_keys[round])
+                                : _mm256_aesenc_epi128(blocks[i], round_keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = decrypt ? _mm256_aesdeclast_epi128(blocks[i], round_keys[NUM_ROUNDS])
+                            : _mm256_aesenclast_epi128(blocks[i], round_keys[NUM_ROUNDS]);
+    }
+}
+
+CITRON_TARGET_VAES inline void LoadWideRoundKeys(const KeySchedule& keys, __m256i* round_keys) {
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        round_keys[i] = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(keys.round_keys[i].data())));
+    }
+}
+
+CITRON_TARGET_VAES inline __m256i LoadWide(const u8* src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+
+CITRON_TARGET_VAES inline void StoreWide(u8* dest, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), value);
+}
+
+template <bool decrypt>
+CITRON_TARGET_VAES void EcbVAES(const KeySchedule& keys, const u8* src, u8* dest,
+                                std::size_t num_blocks) {
+    constexpr std::size_t N = WIDE_LANES / 2;
+    __m256i round_keys[NUM_ROUND_KEYS];
+    LoadWideRoundKeys(keys, round_keys);
+    for (; num_blocks >= WIDE_LANES; num_blocks -= WIDE_LANES) {
+        __m256i blocks[N];
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = LoadWide(src + i * 2 * BLOCK_SIZE);
+        }
+        CipherVAES<decrypt>(round_keys, blocks);
+        for (std::size_t i = 0; i < N; ++i) {
+            StoreWide(dest + i * 2 * BLOCK_SIZE, blocks[i]);
+        }
+        src += WIDE_LANES * BLOCK_SIZE;
+        dest += WIDE_LANES * BLOCK_SIZE;
+    }
+    EcbAESNI<decrypt>(keys, src, dest, num_blocks);
+}
+
+CITRON_TARGET_VAES void CtrVAES(const KeySchedule& keys, Block& counter_block, const u8* src,
+                                u8* dest, std::size_t num_blocks) {
+    constexpr std::size_t N = WIDE_LANES / 2;
+    __m256i round_keys[NUM_ROUND_KEYS];
+    LoadWideRoundKeys(keys, round_keys);
+    __m128i counter = ByteSwap128(Load(counter_block.data()));
+    for (; num_blocks >= WIDE_LANES; num_blocks -= WIDE_LANES) {
+        __m256i blocks[N];
+        for (std::size_t i = 0; i < N; ++i) {
+            const __m128i first = NextCounter(counter);
+            const __m128i second = NextCounter(counter);
+            blocks[i] = _mm256_set_m128i(second, first);
+        }
+        CipherVAES<false>(round_keys, blocks);
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::size_t offset = i * 2 * BLOCK_SIZE;
+            StoreWide(dest + offset, _mm256_xor_si256(blocks[i], LoadWide(src + offset)));
+        }
+        src += WIDE_LANES * BLOCK_SIZE;
+        dest += WIDE_LANES * BLOCK_SIZE;
+    }
+    Store(counter_block.data(), ByteSwap128(counter));
+    CtrAESNI(keys, counter_block, src, dest, num_blocks);
+}
+
+template <bool decrypt>
+CITRON_TARGET_VAES void XtsVAES(const KeySchedule& keys, Block& tweak_block, const u8* src,
+                                u8* dest, std::size_t num_blocks) {
+    constexpr std::size_t N = WIDE_LANES / 2;
+    __m256i round_keys[NUM_ROUND_KEYS];
+    LoadWideRoundKeys(keys, round_keys);
+    __m128i tweak = Load(tweak_block.data());
+    for (; num_blocks >= WIDE_LANES; num_blocks -= WIDE_LANES) {
+        __m256i tweaks[N];
+        __m256i blocks[N];
+        for (std::size_t i = 0; i < N; ++i) {
+            const __m128i first = tweak;
+            const __m128i second = MultiplyTweakSSE(first);
+            tweak = MultiplyTweakSSE(second);
+            tweaks[i] = _mm256_set_m128i(second, first);
+            blocks[i] = _mm256_xor_si256(LoadWide(src + i * 2 * BLOCK_SIZE), tweaks[i]);
+        }
+        CipherVAES<decrypt>(round_keys, blocks);
+        for (std::size_t i = 0; i < N; ++i) {
+            StoreWide(dest + i * 2 * BLOCK_SIZE, _mm256_xor_si256(blocks[i], tweaks[i]));
+        }
+        src += WIDE_LANES * BLOCK_SIZE;
+        dest += WIDE_LANES * BLOCK_SIZE;
+    }
+    Store(tweak_block.data(), tweak);
+    XtsAESNI<decrypt>(keys, tweak_block, src, dest, num_blocks);
+}
+
+constexpr Kernels KERNELS_AESNI{
+    .encrypt = EcbAESNI<false>,
+    .decrypt = EcbAESNI<true>,
+    .ctr = CtrAESNI,
+    .xts_encrypt = XtsAESNI<false>,
+    .xts_decrypt = XtsAESNI<true>,
+};
+
+constexpr Kernels KERNELS_VAES{
+    .encrypt = EcbVAES<false>,
+    .decrypt = EcbVAES<true>,
+    .ctr = CtrVAES,
+    .xts_encrypt = XtsVAES<false>,
+    .xts_decrypt = XtsVAES<true>,
+};
+
+#elif defined(ARCHITECTURE_arm64)
+
+CITRON_TARGET_ARM_CRYPTO inline void LoadRoundKeys(const KeySchedule& keys,
+                                                   uint8x16_t* round_keys) {
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        round_keys[i] = vld1q_u8(keys.round_keys[i].data());
+    }
+}
+
+// AESE and AESD add the round key before substituting, so the last key is added separately
+template <bool decrypt, std::size_t N>
+CITRON_TARGET_ARM_CRYPTO inline void CipherARM(const uint8x16_t* round_keys, uint8x16_t* blocks) {
+    for (std::size_t round = 0; round < NUM_ROUNDS - 1; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = decrypt ? vaesimcq_u8(vaesdq_u8(blocks[i], round_keys[round]))
+                                : vaesmcq_u8(vaeseq_u8(blocks[i], round_keys[round]));
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = decrypt ? vaesdq_u8(blocks[i], round_keys[NUM_ROUNDS - 1])
+                            : vaeseq_u8(blocks[i], round_keys[NUM_ROUNDS - 1]);
+        blocks[i] = veorq_u8(blocks[i], round_keys[NUM_ROUNDS]);
+    }
+}
+
+/// Counter held as a 128-bit integer in general purpose registers
+struct Counter {
+    u64 high;
+    u64 low;
+};
+
+CITRON_TARGET_ARM_CRYPTO inline uint8x16_t NextCounter(Counter& counter) {
+    const uint8x16_t block = vcombine_u8(vcreate_u8(Common::swap64(counter.high)),
+                                         vcreate_u8(Common::swap64(counter.low)));
+    if (++counter.low == 0) {
+        ++counter.high;
+    }
+    return block;
+}
+
+CITRON_TARGET_ARM_CRYPTO inline uint8x16_t MultiplyTweakNEON(uint8x16_t tweak) {
+    const uint64x2_t value = vreinterpretq_u64_u8(tweak);
+    // Shift both halves left, carry the top bit of each half into the bottom of the other one
+    const int64x2_t top_bits = vshrq_n_s64(vreinterpretq_s64_u64(value), 63);
+    const uint64x2_t carry = vandq_u64(vreinterpretq_u64_s64(vextq_s64(top_bits, top_bits, 1)),
+                                       vcombine_u64(vcreate_u64(0x87), vcreate_u64(1)));
+    return vreinterpretq_u8_u64(veorq_u64(vshlq_n_u64(value, 1), carry));
+}
+
+template <bool decrypt>
+CITRON_TARGET_ARM_CRYPTO void EcbARM(const KeySchedule& keys, const u8* src, u8* dest,
+                                     std::size_t num_blocks) {
+    uint8x16_t round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        uint8x16_t blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            blocks[i] = vld1q_u8(src + i * BLOCK_SIZE);
+        }
+        CipherARM<decrypt, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            vst1q_u8(dest + i * BLOCK_SIZE, blocks[i]);
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        uint8x16_t block = vld1q_u8(src);
+        CipherARM<decrypt, 1>(round_keys, &block);
+        vst1q_u8(dest, block);
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+}
+
+CITRON_TARGET_ARM_CRYPTO void CtrARM(const KeySchedule& keys, Block& counter_block,
+                                     const u8* src, u8* dest, std::size_t num_blocks) {
+    uint8x16_t round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    Counter counter;
+    std::memcpy(&counter.high, counter_block.data(), sizeof(u64));
+    std::memcpy(&counter.low, counter_block.data() + sizeof(u64), sizeof(u64));
+    counter.high = Common::swap64(counter.high);
+    counter.low = Common::swap64(counter.low);
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        uint8x16_t blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            blocks[i] = NextCounter(counter);
+        }
+        CipherARM<false, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            const std::size_t offset = i * BLOCK_SIZE;
+            vst1q_u8(dest + offset, veorq_u8(blocks[i], vld1q_u8(src + offset)));
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        uint8x16_t block = NextCounter(counter);
+        CipherARM<false, 1>(round_keys, &block);
+        vst1q_u8(dest, veorq_u8(block, vld1q_u8(src)));
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+    counter.high = Common::swap64(counter.high);
+    counter.low = Common::swap64(counter.low);
+    std::memcpy(counter_block.data(), &counter.high, sizeof(u64));
+    std::memcpy(counter_block.data() + sizeof(u64), &counter.low, sizeof(u64));
+}
+
+template <bool decrypt>
+CITRON_TARGET_ARM_CRYPTO void XtsARM(const KeySchedule& keys, Block& tweak_block, const u8* src,
+                                     u8* dest, std::size_t num_blocks) {
+    uint8x16_t round_keys[NUM_ROUND_KEYS];
+    LoadRoundKeys(keys, round_keys);
+    uint8x16_t tweak = vld1q_u8(tweak_block.data());
+    for (; num_blocks >= LANES; num_blocks -= LANES) {
+        uint8x16_t tweaks[LANES];
+        uint8x16_t blocks[LANES];
+        for (std::size_t i = 0; i < LANES; ++i) {
+            tweaks[i] = tweak;
+            tweak = MultiplyTweakNEON(tweak);
+            blocks[i] = veorq_u8(vld1q_u8(src + i * BLOCK_SIZE), tweaks[i]);
+        }
+        CipherARM<decrypt, LANES>(round_keys, blocks);
+        for (std::size_t i = 0; i < LANES; ++i) {
+            vst1q_u8(dest + i * BLOCK_SIZE, veorq_u8(blocks[i], tweaks[i]));
+        }
+        src += LANES * BLOCK_SIZE;
+        dest += LANES * BLOCK_SIZE;
+    }
+    for (; num_blocks > 0; --num_blocks) {
+        uint8x16_t block = veorq_u8(vld1q_u8(src), tweak);
+        CipherARM<decrypt, 1>(round_keys, &block);
+        vst1q_u8(dest, veorq_u8(block, tweak));
+        tweak = MultiplyTweakNEON(tweak);
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+    vst1q_u8(tweak_block.data(), tweak);
+}
+
+constexpr Kernels KERNELS_ARM{
+    .encrypt = EcbARM<false>,
+    .decrypt = EcbARM<true>,
+    .ctr = CtrARM,
+    .xts_encrypt = XtsARM<false>,
+    .xts_decrypt = XtsARM<true>,
+};
+
+bool HasArmCrypto() {
+#if defined(__APPLE__)
+    return true;
+#elif defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
+/// Kernels of the best instruction set of the host, null when it has no AES instructions
+const Kernels* GetKernels() {
+    static const Kernels* const kernels = []() -> const Kernels* {
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.aes && caps.vaes && caps.avx2) {
+            return &KERNELS_VAES;
+        }
+        if (caps.aes && caps.sse4_1) {
+            return &KERNELS_AESNI;
+        }
+#elif defined(ARCHITECTURE_arm64)
+        if (HasArmCrypto()) {
+            return &KERNELS_ARM;
+        }
+#endif
+        return nullptr;
+    }();
+    return kernels;
+}
+
+} // Anonymous namespace
+
+bool IsSupported() {
+    return GetKernels() != nullptr;
+}
+
+void ExpandKey(std::span<const u8, BLOCK_SIZE> key, Key& out) {
+    std::array<u8, NUM_ROUND_KEYS * BLOCK_SIZE> words;
+    std::memcpy(words.data(), key.data(), BLOCK_SIZE);
+    u8 round_constant = 1;
+    for (std::size_t i = BLOCK_SIZE; i < words.size(); i += 4) {
+        std::array<u8, 4> temp{words[i - 4], words[i - 3], words[i - 2], words[i - 1]};
+        if (i % BLOCK_SIZE == 0) {
+            temp = {static_cast<u8>(SBOX[temp[1]] ^ round_constant), SBOX[temp[2]], SBOX[temp[3]],
+                    SBOX[temp[0]]};
+            round_constant = XTime(round_constant);
+        }
+        for (std::size_t j = 0; j < 4; ++j) {
+            words[i + j] = words[i + j - BLOCK_SIZE] ^ temp[j];
+        }
+    }
+    for (std::size_t round = 0; round < NUM_ROUND_KEYS; ++round) {
+        std::memcpy(out.encrypt.round_keys[round].data(), words.data() + round * BLOCK_SIZE,
+                    BLOCK_SIZE);
+    }
+    out.decrypt.round_keys[0] = out.encrypt.round_keys[NUM_ROUNDS];
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        out.decrypt.round_keys[round] =
+            InverseMixColumns(out.encrypt.round_keys[NUM_ROUNDS - round]);
+    }
+    out.decrypt.round_keys[NUM_ROUNDS] = out.encrypt.round_keys[0];
+}
+
+void EcbCrypt(const Key& key, const u8* src, u8* dest, std::size_t size, Op op) {
+    const Kernels& kernels = *GetKernels();
+    const auto crypt = op == Op::Encrypt ? kernels.encrypt : kernels.decrypt;
+    const KeySchedule& schedule = op == Op::Encrypt ? key.encrypt : key.decrypt;
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    crypt(schedule, src, dest, num_blocks);
+
+    const std::size_t leftover = size % BLOCK_SIZE;
+    if (leftover != 0) {
+        Block block{};
+        std::memcpy(block.data(), src + num_blocks * BLOCK_SIZE, leftover);
+        crypt(schedule, block.data(), block.data(), 1);
+        std::memcpy(dest + num_blocks * BLOCK_SIZE, block.data(), leftover);
+    }
+}
+
+void CtrCrypt(const Key& key, Block& counter, const u8* src, u8* dest, std::size_t size) {
+    const Kernels& kernels = *GetKernels();
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    kernels.ctr(key.encrypt, counter, src, dest, num_blocks);
+
+    const std::size_t leftover = size % BLOCK_SIZE;
+    if (leftover != 0) {
+        Block block{};
+        std::memcpy(block.data(), src + num_blocks * BLOCK_SIZE, leftover);
+        kernels.ctr(key.encrypt, counter, block.data(), block.data(), 1);
+        std::memcpy(dest + num_blocks * BLOCK_SIZE, block.data(), leftover);
+    }
+}
+
+bool XtsCrypt(const Key& data_key, const Key& tweak_key, const Block& data_unit, const u8* src,
+              u8* dest, std::size_t size, Op op) {
+    if (size < BLOCK_SIZE) {
+        return false;
+    }
+    const Kernels& kernels = *GetKernels();
+    const bool decrypt = op == Op::Decrypt;
+    const auto crypt = decrypt ? kernels.xts_decrypt : kernels.xts_encrypt;
+    const KeySchedule& schedule = decrypt ? data_key.decrypt : data_key.encrypt;
+
+    Block tweak;
+    kernels.encrypt(tweak_key.encrypt, data_unit.data(), tweak.data(), 1);
+
+    const std::size_t leftover = size % BLOCK_SIZE;
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    if (leftover == 0) {
+        crypt(schedule, tweak, src, dest, num_blocks);
+        return true;
+    }
+
+    // Ciphertext stealing, decryption swaps the tweaks of the last full block and the partial one
+    Block stealing_tweak;
+    if (decrypt) {
+        crypt(schedule, tweak, src, dest, num_blocks - 1);
+        stealing_tweak = tweak;
+        Block last_tweak = MultiplyTweak(tweak);
+        const std::size_t offset = (num_blocks - 1) * BLOCK_SIZE;
+        crypt(schedule, last_tweak, src + offset, dest + offset, 1);
+    } else {
+        crypt(schedule, tweak, src, dest, num_blocks);
+        stealing_tweak = tweak;
+    }
+
+    const u8* const partial_src = src + num_blocks * BLOCK_SIZE;
+    u8* const partial_dest = dest + num_blocks * BLOCK_SIZE;
+    u8* const previous = partial_dest - BLOCK_SIZE;
+    Block block;
+    std::memcpy(block.data(), partial_src, leftover);
+    std::memcpy(block.data() + leftover, previous + leftover, BLOCK_SIZE - leftover);
+    std::memcpy(partial_dest, previous, leftover);
+
+    // Plain ECB of the combined block with the stealing tweak applied around it
+    XorBlock(block.data(), block.data(), stealing_tweak.data());
+    (decrypt ? kernels.decrypt : kernels.encrypt)(schedule, block.data(), block.data(), 1);
+    XorBlock(previous, block.data(), stealing_tweak.data());
+    return true;
+}
+
+} // namespace Core::Crypto::AesNative
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+// AES-128 implemented with the AES instructions of the host (AES-NI and VAES on x86-64, the ARMv8
+// cryptography extensions on arm64). Several blocks are kept in flight at once to hide the latency
+// of the round instructions, CTR counters and XTS tweaks are advanced in registers.
+namespace Core::Crypto::AesNative {
+
+constexpr std::size_t BLOCK_SIZE = 0x10;
+constexpr std::size_t NUM_ROUNDS = 10;
+
+using Block = std::array<u8, BLOCK_SIZE>;
+
+struct KeySchedule {
+    alignas(16) std::array<Block, NUM_ROUNDS + 1> round_keys;
+};
+
+/// Round keys of an AES-128 key, for the cipher and the equivalent inverse cipher
+struct Key {
+    KeySchedule encrypt;
+    KeySchedule decrypt;
+};
+
+/// Returns true when the host has the instructions used by this module
+[[nodiscard]] bool IsSupported();
+
+void ExpandKey(std::span<const u8, BLOCK_SIZE> key, Key& out);
+
+/// ECB on size bytes, a trailing partial block is processed zero padded
+void EcbCrypt(const Key& key, const u8* src, u8* dest, std::size_t size, Op op);
+
+/**
+ * CTR on size bytes, the big endian counter is advanced once per block. A trailing partial block
+ * consumes a whole counter value.
+ */
+void CtrCrypt(const Key& key, Block& counter, const u8* src, u8* dest, std::size_t size);
+
+/**
+ * XTS on a single data unit of size bytes with ciphertext stealing for a trailing partial block.
+ * Returns false without writing anything when the data unit is smaller than a block.
+ */
+[[nodiscard]] bool XtsCrypt(const Key& data_key, const Key& tweak_key, const Block& data_unit,
+                            const u8* src, u8* dest, std::size_t size, Op op);
+
+} // namespace Core::Crypto::AesNative
@@ -5,6 +5,7 @@
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_native.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -36,6 +37,15 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // AES-128 CTR, ECB and XTS run on the AES instructions of the host when it has them, the
+    // mbedtls contexts are left unused in that case
+    bool native{};
+    Mode mode{};
+    AesNative::Key key;
+    AesNative::Key tweak_key;
+    AesNative::Block encryption_iv{};
+    AesNative::Block decryption_iv{};
 };
 
 template <typename Key, std::size_t KeySize>
@@ -44,6 +54,19 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     mbedtls_cipher_init(&ctx->encryption_context);
     mbedtls_cipher_init(&ctx->decryption_context);
 
+    const bool native_mode = KeySize == 0x10 ? mode == Mode::CTR || mode == Mode::ECB
+                                             : mode == Mode::XTS;
+    if (native_mode && AesNative::IsSupported()) {
+        ctx->native = true;
+        ctx->mode = mode;
+        AesNative::ExpandKey(std::span<const u8, 0x10>(key.data(), 0x10), ctx->key);
+        if (mode == Mode::XTS) {
+            AesNative::ExpandKey(std::span<const u8, 0x10>(key.data() + 0x10, 0x10),
+                                 ctx->tweak_key);
+        }
+        return;
+    }
+
     ASSERT_MSG((mbedtls_cipher_setup(
                     &ctx->encryption_context,
                     mbedtls_cipher_info_from_type(static_cast<mbedtls_cipher_type_t>(mode))) ||
@@ -67,6 +90,25 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->native) {
+        auto& iv = op == Op::Encrypt ? ctx->encryption_iv : ctx->decryption_iv;
+        switch (ctx->mode) {
+        case Mode::CTR:
+            AesNative::CtrCrypt(ctx->key, iv, src, dest, size);
+            break;
+        case Mode::ECB:
+            AesNative::EcbCrypt(ctx->key, src, dest, size, op);
+            break;
+        case Mode::XTS:
+            if (!AesNative::XtsCrypt(ctx->key, ctx->tweak_key, iv, src, dest, size, op)) {
+                LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
+                            size, 0);
+            }
+            break;
+        }
+        return;
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -111,6 +153,21 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    if (ctx->native) {
+        auto& iv = op == Op::Encrypt ? ctx->encryption_iv : ctx->decryption_iv;
+        for (std::size_t i = 0; i < size; i += sector_size) {
+            iv = CalculateNintendoTweak(sector_id++);
+            if (!AesNative::XtsCrypt(ctx->key, ctx->tweak_key, iv, src + i, dest + i, sector_size,
+                                     op)) {
+                LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
+                            sector_size, 0);
+            }
+        }
+        // Leave the last tweak set like SetIV would have
+        (op == Op::Encrypt ? ctx->decryption_iv : ctx->encryption_iv) = iv;
+        return;
+    }
+
     for (std::size_t i = 0; i < size; i += sector_size) {
         SetIV(CalculateNintendoTweak(sector_id++));
         Transcode(src + i, sector_size, dest + i, op);
@@ -119,6 +176,13 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    if (ctx->native) {
+        ctx->encryption_iv = {};
+        std::memcpy(ctx->encryption_iv.data(), data.data(),
+                    std::min(data.size(), ctx->encryption_iv.size()));
+        ctx->decryption_iv = ctx->encryption_iv;
+        return;
+    }
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
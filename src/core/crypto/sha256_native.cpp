@@ -0,0 +1,300 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include "core/crypto/sha256_native.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+#if defined(ARCHITECTURE_arm64)
+#if defined(_MSC_VER)
+#define CITRON_TARGET_ARM_CRYPTO
+#elif defined(__clang__)
+#define CITRON_TARGET_ARM_CRYPTO __attribute__((target("crypto")))
+#else
+#define CITRON_TARGET_ARM_CRYPTO __attribute__((target("+crypto")))
+#endif
+#endif
+
+namespace Core::Crypto::Sha256Native {
+namespace {
+
+constexpr std::array<u32, 8> INITIAL_STATE{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+alignas(16) constexpr std::array<u32, 64> ROUND_CONSTANTS{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/// Runs the compression function over num_blocks consecutive 64-byte blocks
+using CompressFunction = void (*)(std::array<u32, 8>& state, const u8* data,
+                                  std::size_t num_blocks);
+
+u32 LoadBigEndian(const u8* data) {
+    return (u32{data[0]} << 24) | (u32{data[1]} << 16) | (u32{data[2]} << 8) | u32{data[3]};
+}
+
+void CompressPortable(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    for (; num_blocks > 0; --num_blocks, data += BLOCK_SIZE) {
+        std::array<u32, 64> w;
+        for (std::size_t i = 0; i < 16; ++i) {
+            w[i] = LoadBigEndian(data + i * 4);
+        }
+        for (std::size_t i = 16; i < 64; ++i) {
+            const u32 s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const u32 s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        auto [a, b, c, d, e, f, g, h] = state;
+        for (std::size_t i = 0; i < 64; ++i) {
+            const u32 s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+            const u32 choice = (e & f) ^ (~e & g);
+            const u32 temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+            const u32 s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+            const u32 majority = (a & b) ^ (a & c) ^ (b & c);
+            const u32 temp2 = s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64)
+
+template <std::size_t group>
+CITRON_TARGET_SHA inline void RoundsSHANI(__m128i& abef, __m128i& cdgh, __m128i* msg) {
+    __m128i words = _mm_add_epi32(
+        msg[group % 4],
+        _mm_load_si128(reinterpret_cast<const __m128i*>(&ROUND_CONSTANTS[group * 4])));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+    words = _mm_shuffle_epi32(words, 0x0E);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, words);
+
+    // Schedule the words of the following groups while the rounds are in flight. The words of
+    // group n are msg2(msg1(W[n - 4], W[n - 3]) + W[n - 2..n - 1], W[n - 1]).
+    if constexpr (group >= 3 && group <= 14) {
+        __m128i& next = msg[(group + 1) % 4];
+        const __m128i current = msg[group % 4];
+        const __m128i previous = msg[(group + 3) % 4];
+        next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4)),
+                                    current);
+    }
+    if constexpr (group >= 1 && group <= 12) {
+        msg[(group - 1) % 4] = _mm_sha256msg1_epu32(msg[(group - 1) % 4], msg[group % 4]);
+    }
+}
+
+template <std::size_t... groups>
+CITRON_TARGET_SHA inline void AllRoundsSHANI(__m128i& abef, __m128i& cdgh, __m128i* msg,
+                                             std::index_sequence<groups...>) {
+    (RoundsSHANI<groups>(abef, cdgh, msg), ...);
+}
+
+CITRON_TARGET_SHA void CompressSHANI(std::array<u32, 8>& state, const u8* data,
+                                     std::size_t num_blocks) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The instructions work on the state as ABEF and CDGH
+    __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    const __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (; num_blocks > 0; --num_blocks, data += BLOCK_SIZE) {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+        __m128i msg[4];
+        for (std::size_t i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byte_swap);
+        }
+        AllRoundsSHANI(abef, cdgh, msg, std::make_index_sequence<16>{});
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    dcba = _mm_blend_epi16(feba, dchg, 0xF0);
+    hgfe = _mm_alignr_epi8(dchg, feba, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), dcba);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), hgfe);
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+CITRON_TARGET_ARM_CRYPTO void CompressARM(std::array<u32, 8>& state, const u8* data,
+                                          std::size_t num_blocks) {
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+
+    for (; num_blocks > 0; --num_blocks, data += BLOCK_SIZE) {
+        const uint32x4_t abcd_save = abcd;
+        const uint32x4_t efgh_save = efgh;
+        uint32x4_t msg[4];
+        for (std::size_t i = 0; i < 4; ++i) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+        }
+        for (std::size_t group = 0; group < 16; ++group) {
+            if (group >= 4) {
+                msg[group % 4] =
+                    vsha256su1q_u32(vsha256su0q_u32(msg[group % 4], msg[(group + 1) % 4]),
+                                    msg[(group + 2) % 4], msg[(group + 3) % 4]);
+            }
+            const uint32x4_t words =
+                vaddq_u32(msg[group % 4], vld1q_u32(&ROUND_CONSTANTS[group * 4]));
+            const uint32x4_t abcd_previous = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, words);
+            efgh = vsha256h2q_u32(efgh, abcd_previous, words);
+        }
+        abcd = vaddq_u32(abcd, abcd_save);
+        efgh = vaddq_u32(efgh, efgh_save);
+    }
+
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+
+bool HasArmSha2() {
+#if defined(__APPLE__)
+    return true;
+#elif defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
+/// Compression function of the best instruction set of the host, null for the portable one
+CompressFunction GetAcceleratedCompress() {
+    static const CompressFunction compress = []() -> CompressFunction {
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.sha && caps.sse4_1) {
+            return CompressSHANI;
+        }
+#elif defined(ARCHITECTURE_arm64)
+        if (HasArmSha2()) {
+            return CompressARM;
+        }
+#endif
+        return nullptr;
+    }();
+    return compress;
+}
+
+void Compress(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    if (num_blocks == 0) {
+        return;
+    }
+    if (const CompressFunction compress = GetAcceleratedCompress()) {
+        compress(state, data, num_blocks);
+    } else {
+        CompressPortable(state, data, num_blocks);
+    }
+}
+
+} // Anonymous namespace
+
+bool IsAccelerated() {
+    return GetAcceleratedCompress() != nullptr;
+}
+
+Context::Context() : state{INITIAL_STATE} {}
+
+void Context::Update(const u8* data, std::size_t size) {
+    total_size += size;
+    if (buffered != 0) {
+        const std::size_t copy_size = std::min(size, BLOCK_SIZE - buffered);
+        std::memcpy(buffer.data() + buffered, data, copy_size);
+        buffered += copy_size;
+        data += copy_size;
+        size -= copy_size;
+        if (buffered < BLOCK_SIZE) {
+            return;
+        }
+        Compress(state, buffer.data(), 1);
+        buffered = 0;
+    }
+
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+    Compress(state, data, num_blocks);
+    buffered = size % BLOCK_SIZE;
+    std::memcpy(buffer.data(), data + num_blocks * BLOCK_SIZE, buffered);
+}
+
+void Context::Finish(Digest& out) {
+    // Pad with a single set bit, zeroes and the big endian size in bits
+    const u64 size_in_bits = total_size * 8;
+    buffer[buffered++] = 0x80;
+    if (buffered > BLOCK_SIZE - sizeof(u64)) {
+        std::memset(buffer.data() + buffered, 0, BLOCK_SIZE - buffered);
+        Compress(state, buffer.data(), 1);
+        buffered = 0;
+    }
+    std::memset(buffer.data() + buffered, 0, BLOCK_SIZE - sizeof(u64) - buffered);
+    for (std::size_t i = 0; i < sizeof(u64); ++i) {
+        buffer[BLOCK_SIZE - 1 - i] = static_cast<u8>(size_in_bits >> (i * 8));
+    }
+    Compress(state, buffer.data(), 1);
+
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        out[i * 4 + 0] = static_cast<u8>(state[i] >> 24);
+        out[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+        out[i * 4 + 2] = static_cast<u8>(state[i] >> 8);
+        out[i * 4 + 3] = static_cast<u8>(state[i]);
+    }
+    *this = Context{};
+}
+
+void Hash(const u8* data, std::size_t size, Digest& out) {
+    Context context;
+    context.Update(data, size);
+    context.Finish(out);
+}
+
+} // namespace Core::Crypto::Sha256Native
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+// SHA-256 implemented with the SHA instructions of the host (SHA-NI on x86-64, the ARMv8 SHA2
+// extension on arm64), with a portable fallback for hosts lacking them.
+namespace Core::Crypto::Sha256Native {
+
+constexpr std::size_t BLOCK_SIZE = 0x40;
+constexpr std::size_t DIGEST_SIZE = 0x20;
+
+using Digest = std::array<u8, DIGEST_SIZE>;
+
+/// Returns true when hashing runs on the SHA instructions of the host
+[[nodiscard]] bool IsAccelerated();
+
+class Context {
+public:
+    Context();
+
+    void Update(const u8* data, std::size_t size);
+    void Finish(Digest& out);
+
+private:
+    std::array<u32, 8> state;
+    std::array<u8, BLOCK_SIZE> buffer;
+    std::size_t buffered{};
+    u64 total_size{};
+};
+
+/// Hashes size bytes in one go
+void Hash(const u8* data, std::size_t size, Digest& out);
+
+} // namespace Core::Crypto::Sha256Native
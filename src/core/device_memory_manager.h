@@ -52,6 +52,10 @@ public:
 
     void Map(DAddr address, VAddr virtual_address, size_t size, Asid asid, bool track = false);
 
+    /// Maps device pages straight to device memory, without a process backing them.
+    /// raw_physical_address is an offset into the device memory buffer.
+    void MapPhysical(DAddr address, PAddr raw_physical_address, size_t size);
+
     void Unmap(DAddr address, size_t size);
 
     void TrackContinuityImpl(DAddr address, VAddr virtual_address, size_t size, Asid asid);
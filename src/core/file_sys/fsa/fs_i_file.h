@@ -130,7 +130,7 @@ private:
             return ResultPathNotFound;
         }
 
-        const auto read_size = backend->Read(static_cast<u8*>(buffer), size, offset);
+        const auto read_size = backend->ReadSplit(static_cast<u8*>(buffer), size, offset);
         *out = read_size;
         R_SUCCEED();
     }
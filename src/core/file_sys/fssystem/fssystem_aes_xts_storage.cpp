@@ -54,6 +54,9 @@ size_t AesXtsStorage::Read(u8* buffer, size_t size, size_t offset) const {
     // Read the data.
     m_base_storage->Read(buffer, size, offset);
 
+    // The cipher is shared, serialize decryption of concurrent reads.
+    std::scoped_lock lk{m_mutex};
+
     // Setup the counter.
     std::array<u8, IvSize> ctr;
     std::memcpy(ctr.data(), m_iv.data(), IvSize);
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
+
+namespace FileSys {
+
+BlockCache::BlockCache(size_t capacity)
+    : m_shard_capacity(capacity / NumShards), m_read_ahead_worker(1, "FsReadAhead") {}
+
+BlockCache::~BlockCache() = default;
+
+BlockCache& BlockCache::GetInstance() {
+    static BlockCache cache(DefaultCapacity);
+    return cache;
+}
+
+u64 BlockCache::RegisterStorage() {
+    return m_next_storage_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+BlockCache::Block BlockCache::Find(u64 storage_id, u64 block_index) {
+    const Key key{storage_id, block_index};
+    Shard& shard = this->GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+    const auto it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
+        return nullptr;
+    }
+
+    // Move the block to the front of the recently used list.
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_it);
+    return it->second.block;
+}
+
+bool BlockCache::Contains(u64 storage_id, u64 block_index) {
+    const Key key{storage_id, block_index};
+    Shard& shard = this->GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+    return shard.entries.contains(key);
+}
+
+void BlockCache::Insert(u64 storage_id, u64 block_index, Block block) {
+    const Key key{storage_id, block_index};
+    const size_t block_size = block->size();
+    Shard& shard = this->GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+    if (shard.entries.contains(key)) {
+        return;
+    }
+
+    // Evict the least recently used blocks until the new one fits.
+    while (!shard.lru.empty() && shard.used_size + block_size > m_shard_capacity) {
+        const auto it = shard.entries.find(shard.lru.back());
+        ASSERT(it != shard.entries.end());
+        shard.used_size -= it->second.block->size();
+        shard.entries.erase(it);
+        shard.lru.pop_back();
+    }
+
+    shard.lru.push_front(key);
+    shard.entries.emplace(key, Entry{std::move(block), shard.lru.begin()});
+    shard.used_size += block_size;
+}
+
+void BlockCache::Purge(u64 storage_id) {
+    for (Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+            if (it->storage_id != storage_id) {
+                ++it;
+                continue;
+            }
+            const auto entry = shard.entries.find(*it);
+            shard.used_size -= entry->second.block->size();
+            shard.entries.erase(entry);
+            it = shard.lru.erase(it);
+        }
+    }
+}
+
+void BlockCache::QueueReadAhead(Common::UniqueFunction<void> work) {
+    m_read_ahead_worker.QueueWork(std::move(work));
+}
+
+size_t BlockCache::GetUsedSize() {
+    size_t used_size = 0;
+    for (Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        used_size += shard.used_size;
+    }
+    return used_size;
+}
+
+BlockCacheStorage::BlockCacheStorage(VirtualFile base, size_t block_size, BlockCache& cache) {
+    ASSERT(base != nullptr);
+    ASSERT(MinBlockSize <= block_size && block_size <= MaxBlockSize);
+
+    const size_t size = base->GetSize();
+    m_state = std::shared_ptr<SharedState>(new SharedState{
+        .cache = cache,
+        .base = std::move(base),
+        .id = cache.RegisterStorage(),
+        .block_size = block_size,
+        .size = size,
+        .num_blocks = (size + block_size - 1) / block_size,
+    });
+}
+
+BlockCacheStorage::~BlockCacheStorage() {
+    // Pending read-ahead work keeps the state alive, stop it from filling the cache further.
+    m_state->alive = false;
+    m_state->cache.Purge(m_state->id);
+}
+
+bool BlockCacheStorage::SharedState::LoadBlocks(u64 first, u64 count,
+                                                std::vector<BlockCache::Block>* out) const {
+    const size_t offset = first * block_size;
+    const size_t read_size = std::min<size_t>(count * block_size, size - offset);
+    std::vector<u8> data(read_size);
+    if (base->Read(data.data(), read_size, offset) != read_size) {
+        return false;
+    }
+
+    for (u64 i = 0; i < count; ++i) {
+        const size_t block_offset = i * block_size;
+        const size_t current_size = std::min(block_size, read_size - block_offset);
+        auto block = std::make_shared<const std::vector<u8>>(
+            data.begin() + block_offset, data.begin() + block_offset + current_size);
+        if (out != nullptr) {
+            out->push_back(block);
+        }
+        cache.Insert(id, first + i, std::move(block));
+    }
+    return true;
+}
+
+size_t BlockCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    // Clamp the read to our size.
+    if (offset >= m_state->size) {
+        return 0;
+    }
+    size = std::min(size, m_state->size - offset);
+    if (size == 0) {
+        return 0;
+    }
+
+    this->UpdateReadAhead(offset, size);
+    if (size >= UncachedReadSize) {
+        return m_state->base->Read(buffer, size, offset);
+    }
+
+    const size_t block_size = m_state->block_size;
+    const u64 last_block = (offset + size - 1) / block_size;
+    std::vector<BlockCache::Block> blocks;
+    size_t processed = 0;
+    for (u64 block_index = offset / block_size; block_index <= last_block;) {
+        // Gather the blocks we have, load each run of missing ones with a single read.
+        blocks.clear();
+        if (auto block = m_state->cache.Find(m_state->id, block_index)) {
+            blocks.push_back(std::move(block));
+        } else {
+            u64 missing_end = block_index + 1;
+            while (missing_end <= last_block &&
+                   !m_state->cache.Contains(m_state->id, missing_end)) {
+                ++missing_end;
+            }
+            if (!m_state->LoadBlocks(block_index, missing_end - block_index, &blocks)) {
+                return m_state->base->Read(buffer, size, offset);
+            }
+        }
+
+        for (const BlockCache::Block& block : blocks) {
+            const size_t block_offset = (offset + processed) - block_index * block_size;
+            const size_t copy_size = std::min(size - processed, block->size() - block_offset);
+            std::memcpy(buffer + processed, block->data() + block_offset, copy_size);
+            processed += copy_size;
+            ++block_index;
+        }
+    }
+
+    return size;
+}
+
+size_t BlockCacheStorage::GetSize() const {
+    return m_state->size;
+}
+
+void BlockCacheStorage::UpdateReadAhead(size_t offset, size_t size) const {
+    const size_t block_size = m_state->block_size;
+    u64 first;
+    u64 last;
+    {
+        std::scoped_lock lk{m_pattern_mutex};
+
+        // Reads starting where the last one ended, or shortly after it, count as sequential.
+        const bool sequential = offset >= m_last_read_end && offset - m_last_read_end < block_size;
+        m_sequential_reads = sequential ? m_sequential_reads + 1 : 0;
+        m_last_read_end = offset + size;
+        if (!sequential) {
+            m_read_ahead_end = 0;
+        }
+        if (m_sequential_reads < SequentialReadThreshold) {
+            return;
+        }
+
+        // Only queue the blocks that weren't already requested by a previous read.
+        const u64 read_end_block = (offset + size + block_size - 1) / block_size;
+        first = std::max<u64>(read_end_block, m_read_ahead_end);
+        last = std::min<u64>(read_end_block + ReadAheadBlocks, m_state->num_blocks);
+        if (first >= last) {
+            return;
+        }
+        m_read_ahead_end = last;
+    }
+
+    m_state->cache.QueueReadAhead([state = m_state, first, last] {
+        for (u64 block_index = first; block_index < last && state->alive; ++block_index) {
+            if (state->cache.Contains(state->id, block_index)) {
+                continue;
+            }
+            u64 missing_end = block_index + 1;
+            while (missing_end < last && !state->cache.Contains(state->id, missing_end)) {
+                ++missing_end;
+            }
+            if (!state->LoadBlocks(block_index, missing_end - block_index, nullptr)) {
+                return;
+            }
+            block_index = missing_end - 1;
+        }
+    });
+}
+
+} // namespace FileSys
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/literals.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fssystem/fs_i_storage.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+// Size bounded cache of storage blocks shared by every BlockCacheStorage. Blocks are keyed by the
+// storage they belong to and evicted least recently used first, the entries are split between
+// shards so concurrent readers rarely wait on each other.
+class BlockCache {
+    CITRON_NON_COPYABLE(BlockCache);
+    CITRON_NON_MOVEABLE(BlockCache);
+
+public:
+    using Block = std::shared_ptr<const std::vector<u8>>;
+
+    static constexpr size_t NumShards = 16;
+    static constexpr size_t DefaultCapacity = 64_MiB;
+
+public:
+    explicit BlockCache(size_t capacity);
+    ~BlockCache();
+
+    static BlockCache& GetInstance();
+
+    u64 RegisterStorage();
+
+    Block Find(u64 storage_id, u64 block_index);
+    void Insert(u64 storage_id, u64 block_index, Block block);
+    bool Contains(u64 storage_id, u64 block_index);
+
+    /// Drops every block of a storage
+    void Purge(u64 storage_id);
+
+    /// Runs work on the read-ahead thread
+    void QueueReadAhead(Common::UniqueFunction<void> work);
+
+    size_t GetUsedSize();
+
+private:
+    struct Key {
+        u64 storage_id;
+        u64 block_index;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>((key.storage_id * 0x9E3779B97F4A7C15ULL) ^ key.block_index);
+        }
+    };
+
+    struct Entry {
+        Block block;
+        std::list<Key>::iterator lru_it;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Key> lru; ///< Most recently used first
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        size_t used_size{};
+    };
+
+    Shard& GetShard(const Key& key) {
+        return m_shards[(key.storage_id + key.block_index) % NumShards];
+    }
+
+private:
+    std::array<Shard, NumShards> m_shards;
+    const size_t m_shard_capacity;
+    std::atomic<u64> m_next_storage_id{1};
+    Common::ThreadWorker m_read_ahead_worker;
+};
+
+// Caches the blocks read from its base storage, meant to sit on top of the layers that decrypt,
+// verify or decompress data so hits skip all of them. Reads continuing the previous one make the
+// following blocks load on the read-ahead thread.
+class BlockCacheStorage : public IReadOnlyStorage {
+    CITRON_NON_COPYABLE(BlockCacheStorage);
+    CITRON_NON_MOVEABLE(BlockCacheStorage);
+
+public:
+    static constexpr size_t DefaultBlockSize = 64_KiB;
+    static constexpr size_t MinBlockSize = 16_KiB;
+    static constexpr size_t MaxBlockSize = 256_KiB;
+
+    /// Reads this large go straight to the base storage, caching them would only evict others
+    static constexpr size_t UncachedReadSize = 1_MiB;
+
+    /// Sequential reads in a row needed before reading ahead, and how far ahead to read
+    static constexpr u32 SequentialReadThreshold = 2;
+    static constexpr size_t ReadAheadBlocks = 4;
+
+public:
+    explicit BlockCacheStorage(VirtualFile base, size_t block_size = DefaultBlockSize,
+                               BlockCache& cache = BlockCache::GetInstance());
+    ~BlockCacheStorage() override;
+
+    virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
+    virtual size_t GetSize() const override;
+
+private:
+    /// Shared with the queued read-ahead work, which can outlive the storage
+    struct SharedState {
+        BlockCache& cache;
+        VirtualFile base;
+        u64 id;
+        size_t block_size;
+        size_t size;
+        u64 num_blocks;
+        std::atomic_bool alive{true};
+
+        /// Reads blocks [first, first + count) from the base storage and caches them
+        bool LoadBlocks(u64 first, u64 count, std::vector<BlockCache::Block>* out) const;
+    };
+
+    void UpdateReadAhead(size_t offset, size_t size) const;
+
+private:
+    std::shared_ptr<SharedState> m_state;
+    mutable std::mutex m_pattern_mutex;
+    mutable size_t m_last_read_end{};
+    mutable u32 m_sequential_reads{};
+    mutable u64 m_read_ahead_end{};
+};
+
+} // namespace FileSys
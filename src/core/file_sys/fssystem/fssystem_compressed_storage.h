@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "common/literals.h"
 
 #include "core/file_sys/errors.h"
@@ -948,6 +950,7 @@ public:
     }
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        std::scoped_lock lk{m_mutex};
         if (R_SUCCEEDED(m_cache_manager.Read(m_core, offset, buffer, size))) {
             return size;
         } else {
@@ -958,6 +961,7 @@ public:
 private:
     mutable CompressedStorageCore m_core;
     mutable CacheManager m_cache_manager;
+    mutable std::mutex m_mutex;
 };
 
 } // namespace FileSys
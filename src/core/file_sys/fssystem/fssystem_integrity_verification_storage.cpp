@@ -1,11 +1,87 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "common/alignment.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/thread_worker.h"
+#include "core/crypto/sha256_native.h"
 #include "core/file_sys/fssystem/fssystem_integrity_verification_storage.h"
 
 namespace FileSys {
 
+namespace {
+
+// Workers hashing the blocks of large reads alongside the reading thread. Every storage shares
+// them, the reading thread claims work too so a busy pool never stalls a read for long.
+class VerificationPool {
+public:
+    static VerificationPool& GetInstance() {
+        static VerificationPool pool;
+        return pool;
+    }
+
+    /// Calls work for every index in [0, count) and returns once all of them ran
+    void Run(size_t count, std::function<void(size_t)> work) {
+        auto job = std::make_shared<Job>(count, std::move(work));
+        const size_t num_helpers = std::min(m_num_workers, count - 1);
+        for (size_t i = 0; i < num_helpers; ++i) {
+            m_workers.QueueWork([job] { job->Process(); });
+        }
+        job->Process();
+
+        std::unique_lock lk{job->mutex};
+        job->done_cv.wait(lk, [&] { return job->completed == job->count; });
+    }
+
+private:
+    struct Job {
+        Job(size_t count_, std::function<void(size_t)> work_)
+            : count{count_}, work{std::move(work_)} {}
+
+        /// Workers starting after every index was claimed return without touching work
+        void Process() {
+            size_t processed = 0;
+            for (size_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+                work(index);
+                ++processed;
+            }
+            if (processed == 0) {
+                return;
+            }
+            std::scoped_lock lk{mutex};
+            completed += processed;
+            if (completed == count) {
+                done_cv.notify_all();
+            }
+        }
+
+        const size_t count;
+        const std::function<void(size_t)> work;
+        std::atomic<size_t> next{};
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        size_t completed{};
+    };
+
+    VerificationPool()
+        : m_num_workers{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4)},
+          m_workers{m_num_workers, "FsVerify"} {}
+
+    const size_t m_num_workers;
+    Common::ThreadWorker m_workers;
+};
+
+} // Anonymous namespace
+
 constexpr inline u32 ILog2(u32 val) {
     ASSERT(val > 0);
     return static_cast<u32>((sizeof(u32) * 8) - 1 - std::countl_zero<u32>(val));
@@ -40,11 +116,20 @@ void IntegrityVerificationStorage::Initialize(VirtualFile hs, VirtualFile ds, s6
 
     // Set data.
     m_is_real_data = is_real_data;
+
+    // Set up the record of verified blocks.
+    m_verify_hashes = Settings::values.verify_romfs_integrity.GetValue();
+    if (m_verify_hashes) {
+        const size_t num_blocks = Common::DivideUp(m_data_storage->GetSize(),
+                                                   static_cast<size_t>(m_verification_block_size));
+        m_verified_blocks = std::make_unique<std::atomic<u64>[]>(Common::DivideUp(num_blocks, 64));
+    }
 }
 
 void IntegrityVerificationStorage::Finalize() {
     m_hash_storage = VirtualFile();
     m_data_storage = VirtualFile();
+    m_verified_blocks.reset();
 }
 
 size_t IntegrityVerificationStorage::Read(u8* buffer, size_t size, size_t offset) const {
@@ -81,7 +166,89 @@ size_t IntegrityVerificationStorage::Read(u8* buffer, size_t size, size_t offset
     }
 
     // Perform the read.
-    return m_data_storage->Read(buffer, read_size, offset);
+    const size_t result = m_data_storage->Read(buffer, read_size, offset);
+    if (m_verify_hashes && result == read_size) {
+        this->VerifyBlocks(buffer, size, offset);
+    }
+    return result;
+}
+
+void IntegrityVerificationStorage::VerifyBlocks(u8* buffer, size_t size, size_t offset) const {
+    using Core::Crypto::Sha256Native::Digest;
+
+    // Determine the blocks which still need to be verified.
+    const s64 block_size = m_verification_block_size;
+    const s64 first_block = static_cast<s64>(offset) >> m_verification_block_order;
+    const s64 end_block = static_cast<s64>(Common::AlignUp(offset + size, block_size)) >>
+                          m_verification_block_order;
+    std::vector<s64> pending;
+    for (s64 block = first_block; block < end_block; ++block) {
+        if (!this->IsVerified(block)) {
+            pending.push_back(block);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    // Read the expected hashes, this verifies them against the layer above.
+    const s64 first_pending = pending.front();
+    const size_t num_hashes = static_cast<size_t>(pending.back() - first_pending + 1);
+    std::vector<BlockHash> hashes(num_hashes);
+    const size_t hashes_size = num_hashes * HashSize;
+    if (m_hash_storage->Read(reinterpret_cast<u8*>(hashes.data()), hashes_size,
+                             first_pending * HashSize) != hashes_size) {
+        LOG_ERROR(Common_Filesystem, "Failed to read the hashes of blocks {}-{}", first_pending,
+                  pending.back());
+        return;
+    }
+
+    // Hash the blocks, the ones only partially covered by the read are read in full.
+    const s64 data_size = m_data_storage->GetSize();
+    std::vector<u8> failed(pending.size());
+    const auto verify = [&](size_t index) {
+        const s64 block = pending[index];
+        const s64 block_offset = block * block_size;
+        const u8* data = buffer + (block_offset - static_cast<s64>(offset));
+        std::vector<u8> block_buffer;
+        if (block_offset < static_cast<s64>(offset) ||
+            block_offset + block_size > static_cast<s64>(offset + size)) {
+            const size_t block_read_size =
+                static_cast<size_t>(std::min(block_size, data_size - block_offset));
+            block_buffer.resize(block_size);
+            m_data_storage->Read(block_buffer.data(), block_read_size, block_offset);
+            data = block_buffer.data();
+        }
+
+        Digest hash;
+        Core::Crypto::Sha256Native::Hash(data, block_size, hash);
+        if (std::memcmp(hash.data(), hashes[block - first_pending].hash.data(), HashSize) != 0) {
+            failed[index] = true;
+            return;
+        }
+        this->SetVerified(block);
+    };
+    if (pending.size() >= ParallelVerificationBlockCount) {
+        VerificationPool::GetInstance().Run(pending.size(), verify);
+    } else {
+        for (size_t i = 0; i < pending.size(); ++i) {
+            verify(i);
+        }
+    }
+
+    // Clear the parts of the buffer belonging to corrupted blocks.
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (!failed[i]) {
+            continue;
+        }
+        const s64 block_offset = pending[i] * block_size;
+        const s64 clear_begin = std::max(block_offset, static_cast<s64>(offset));
+        const s64 clear_end = std::min(block_offset + block_size, static_cast<s64>(offset + size));
+        LOG_ERROR(Common_Filesystem, "Hash mismatch in {} block {}",
+                  m_is_real_data ? "data" : "hash", pending[i]);
+        std::memset(buffer + (clear_begin - static_cast<s64>(offset)), 0,
+                    static_cast<size_t>(clear_end - clear_begin));
+    }
 }
 
 size_t IntegrityVerificationStorage::GetSize() const {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <optional>
 
 #include "core/file_sys/fssystem/fs_i_storage.h"
@@ -17,6 +19,9 @@ class IntegrityVerificationStorage : public IReadOnlyStorage {
 public:
     static constexpr s64 HashSize = 256 / 8;
 
+    /// Reads with at least this many blocks to verify hash them on the verification workers
+    static constexpr size_t ParallelVerificationBlockCount = 4;
+
     struct BlockHash {
         std::array<u8, HashSize> hash;
     };
@@ -52,6 +57,20 @@ private:
         return (hash->hash[HashSize - 1] & 0x80) != 0;
     }
 
+    /// Hashes the blocks overlapping [offset, offset + size) that weren't verified yet, buffer
+    /// holds that range. Blocks failing verification are cleared in the buffer.
+    void VerifyBlocks(u8* buffer, size_t size, size_t offset) const;
+
+    bool IsVerified(s64 block_index) const {
+        const u64 word = m_verified_blocks[block_index / 64].load(std::memory_order_acquire);
+        return (word & (1ULL << (block_index % 64))) != 0;
+    }
+
+    void SetVerified(s64 block_index) const {
+        m_verified_blocks[block_index / 64].fetch_or(1ULL << (block_index % 64),
+                                                     std::memory_order_release);
+    }
+
 private:
     VirtualFile m_hash_storage;
     VirtualFile m_data_storage;
@@ -60,6 +79,8 @@ private:
     s64 m_upper_layer_verification_block_size;
     s64 m_upper_layer_verification_block_order;
     bool m_is_real_data;
+    bool m_verify_hashes{};
+    std::unique_ptr<std::atomic<u64>[]> m_verified_blocks; ///< One bit per verification block
 };
 
 } // namespace FileSys
@@ -6,6 +6,7 @@
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_alignment_matching_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
 #include "core/file_sys/fssystem/fssystem_compressed_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_integrity_verification_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -323,6 +324,9 @@ Result NcaFileSystemDriver::CreateStorageByRawStorage(VirtualFile* out,
             std::move(storage), header_reader->GetCompressionInfo()));
     }
 
+    // Cache the decrypted, verified and decompressed data.
+    storage = std::make_shared<BlockCacheStorage>(std::move(storage));
+
     // Set output storage.
     *out = std::move(storage);
     R_SUCCEED();
@@ -2,8 +2,13 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include "common/alignment.h"
+#include "common/fs/async_reader.h"
+#include "common/literals.h"
 #include "common/fs/path_util.h"
 #include "core/file_sys/vfs/vfs.h"
 
@@ -162,6 +167,43 @@ std::string VfsFile::GetExtension() const {
 
 VfsDirectory::~VfsDirectory() = default;
 
+void VfsFile::ReadAsync(u8* data, std::size_t length, std::size_t offset,
+                        Common::UniqueFunction<void, std::size_t> callback) const {
+    Common::FS::AsyncReader::GetInstance().QueueWork(
+        [this, data, length, offset, callback = std::move(callback)] {
+            callback(Read(data, length, offset));
+        });
+}
+
+std::size_t VfsFile::ReadSplit(u8* data, std::size_t length, std::size_t offset) const {
+    using namespace Common::Literals;
+    // Large reads are split into pieces read concurrently, which keeps slow disks and network
+    // shares busy and decrypts and verifies the pieces on several threads.
+    constexpr std::size_t SplitReadThreshold = 4_MiB;
+    constexpr std::size_t SplitReadSize = 1_MiB;
+    if (length < SplitReadThreshold) {
+        return Read(data, length, offset);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t remaining = Common::DivideUp(length, SplitReadSize);
+    std::size_t total_read = 0;
+    for (std::size_t position = 0; position < length; position += SplitReadSize) {
+        ReadAsync(data + position, std::min(SplitReadSize, length - position), offset + position,
+                  [&](std::size_t read) {
+                      std::scoped_lock lk{mutex};
+                      total_read += read;
+                      if (--remaining == 0) {
+                          cv.notify_one();
+                      }
+                  });
+    }
+    std::unique_lock lk{mutex};
+    cv.wait(lk, [&] { return remaining == 0; });
+    return total_read;
+}
+
 std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
     u8 out{};
     const std::size_t size = Read(&out, sizeof(u8), offset);
@@ -183,6 +225,10 @@ std::vector<u8> VfsFile::ReadAllBytes() const {
     return ReadBytes(GetSize());
 }
 
+std::span<const u8> VfsFile::ReadView(std::size_t length, std::size_t offset) const {
+    return {};
+}
+
 bool VfsFile::WriteByte(u8 data, std::size_t offset) {
     return Write(&data, 1, offset) == 1;
 }
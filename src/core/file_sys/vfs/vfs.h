@@ -7,12 +7,14 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 #include "common/common_funcs.h"
 #include "common/common_types.h"
+#include "common/unique_function.h"
 #include "core/file_sys/fs_filesystem.h"
 #include "core/file_sys/vfs/vfs_types.h"
 
@@ -106,6 +108,14 @@ public:
     // The primary method of reading from the file. Reads length bytes into data starting at offset
     // into file. Returns number of bytes successfully read.
     virtual std::size_t Read(u8* data, std::size_t length, std::size_t offset = 0) const = 0;
+    // Starts reading length bytes starting at offset into data in the background. callback is
+    // called with the number of bytes successfully read from a reader thread. The file and data
+    // have to stay alive until then.
+    virtual void ReadAsync(u8* data, std::size_t length, std::size_t offset,
+                           Common::UniqueFunction<void, std::size_t> callback) const;
+    // Same as Read, but large reads are split into pieces read concurrently with ReadAsync. Waits
+    // for every piece, returns the total number of bytes successfully read.
+    std::size_t ReadSplit(u8* data, std::size_t length, std::size_t offset = 0) const;
     // The primary method of writing to the file. Writes length bytes from data starting at offset
     // into file. Returns number of bytes successfully written.
     virtual std::size_t Write(const u8* data, std::size_t length, std::size_t offset = 0) = 0;
@@ -117,6 +127,10 @@ public:
     // Reads all the bytes from the file into a vector. Equivalent to 'file->Read(file->GetSize(),
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
+    // Returns the up to length bytes starting at offset in place, without copying them. Returns an
+    // empty span if the file doesn't keep its contents in memory. The view stays valid until the
+    // file is written to or destroyed.
+    virtual std::span<const u8> ReadView(std::size_t length, std::size_t offset = 0) const;
 
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
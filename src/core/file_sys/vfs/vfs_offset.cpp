@@ -52,6 +52,15 @@ std::size_t OffsetVfsFile::Read(u8* data, std::size_t length, std::size_t r_offs
     return file->Read(data, TrimToFit(length, r_offset), offset + r_offset);
 }
 
+void OffsetVfsFile::ReadAsync(u8* data, std::size_t length, std::size_t r_offset,
+                              Common::UniqueFunction<void, std::size_t> callback) const {
+    if (r_offset >= size) {
+        callback(0);
+        return;
+    }
+    file->ReadAsync(data, TrimToFit(length, r_offset), offset + r_offset, std::move(callback));
+}
+
 std::size_t OffsetVfsFile::Write(const u8* data, std::size_t length, std::size_t r_offset) {
     return file->Write(data, TrimToFit(length, r_offset), offset + r_offset);
 }
@@ -72,6 +81,13 @@ std::vector<u8> OffsetVfsFile::ReadAllBytes() const {
     return file->ReadBytes(size, offset);
 }
 
+std::span<const u8> OffsetVfsFile::ReadView(std::size_t r_size, std::size_t r_offset) const {
+    if (r_offset >= size) {
+        return {};
+    }
+    return file->ReadView(TrimToFit(r_size, r_offset), offset + r_offset);
+}
+
 bool OffsetVfsFile::WriteByte(u8 data, std::size_t r_offset) {
     if (r_offset < size)
         return file->WriteByte(data, offset + r_offset);
@@ -26,10 +26,13 @@ public:
     bool IsWritable() const override;
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    void ReadAsync(u8* data, std::size_t length, std::size_t offset,
+                   Common::UniqueFunction<void, std::size_t> callback) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
     std::optional<u8> ReadByte(std::size_t offset) const override;
     std::vector<u8> ReadBytes(std::size_t size, std::size_t offset) const override;
     std::vector<u8> ReadAllBytes() const override;
+    std::span<const u8> ReadView(std::size_t length, std::size_t offset) const override;
     bool WriteByte(u8 data, std::size_t offset) override;
     std::size_t WriteBytes(const std::vector<u8>& data, std::size_t offset) override;
 
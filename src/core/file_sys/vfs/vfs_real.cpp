@@ -2,14 +2,18 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <utility>
 #include "common/assert.h"
+#include "common/fs/async_reader.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
+#include "common/string_util.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/file_sys/vfs/vfs_real.h"
 
@@ -32,6 +36,10 @@ namespace {
 
 constexpr size_t MaxOpenFiles = 512;
 
+// Game images are large, read-only and read at random, so they are mapped rather than read through
+// the file handle. Their contents then come straight from the host page cache.
+constexpr std::array MappedExtensions{"nca", "nsp", "xci"};
+
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     switch (mode) {
     case OpenMode::Read:
@@ -290,6 +298,7 @@ std::size_t RealVfsFile::GetSize() const {
     if (size) {
         return *size;
     }
+    // Only reads map the file, so that a size query doesn't keep the image mapped
     auto lk = base.RefreshReference(path, perms, *reference);
     return reference->file ? reference->file->GetSize() : 0;
 }
@@ -313,6 +322,18 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (this->GetMapping() != nullptr) {
+        const auto view = this->ReadView(length, offset);
+        if (!view.empty()) {
+            std::memcpy(data, view.data(), view.size());
+        }
+        return view.size();
+    }
+    if (perms == OpenMode::Read) {
+        const auto file = this->GetReadOnlyFile();
+        return file ? file->ReadAt(std::span{data, length}, static_cast<s64>(offset)) : 0;
+    }
+
     auto lk = base.RefreshReference(path, perms, *reference);
     if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
         return 0;
@@ -320,6 +341,60 @@ std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset)
     return reference->file->ReadSpan(std::span{data, length});
 }
 
+std::span<const u8> RealVfsFile::ReadView(std::size_t length, std::size_t offset) const {
+    const auto* mapped = this->GetMapping();
+    if (mapped == nullptr || offset >= mapped->Size()) {
+        return {};
+    }
+    return mapped->Data().subspan(offset, std::min(length, mapped->Size() - offset));
+}
+
+void RealVfsFile::ReadAsync(u8* data, std::size_t length, std::size_t offset,
+                            Common::UniqueFunction<void, std::size_t> callback) const {
+    if (perms != OpenMode::Read || this->GetMapping() != nullptr) {
+        VfsFile::ReadAsync(data, length, offset, std::move(callback));
+        return;
+    }
+    auto file = this->GetReadOnlyFile();
+    if (!file) {
+        callback(0);
+        return;
+    }
+    FS::AsyncReader::GetInstance().Read(std::move(file), std::span{data, length},
+                                        static_cast<s64>(offset), std::move(callback));
+}
+
+std::shared_ptr<FS::IOFile> RealVfsFile::GetReadOnlyFile() const {
+    if (perms != OpenMode::Read) {
+        return nullptr;
+    }
+    auto lk = base.RefreshReference(path, perms, *reference);
+    return reference->file;
+}
+
+const FS::MappedFile* RealVfsFile::GetMapping() const {
+    std::call_once(mapping_flag, [this] {
+        if (perms != OpenMode::Read) {
+            return;
+        }
+#ifdef ANDROID
+        // Content URIs can only be opened through the Java side
+        if (path[0] != '/') {
+            return;
+        }
+#endif
+        const auto extension = Common::ToLower(this->GetExtension());
+        if (std::ranges::find(MappedExtensions, extension) == MappedExtensions.end()) {
+            return;
+        }
+        if (!mapping.Open(FS::ToU8String(path))) {
+            LOG_WARNING(Common_Filesystem, "Failed to map {}, reading it through the file instead",
+                        path);
+        }
+    });
+    return mapping.IsOpen() ? &mapping : nullptr;
+}
+
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
     size.reset();
     auto lk = base.RefreshReference(path, perms, *reference);
@@ -7,6 +7,7 @@
 #include <mutex>
 #include <optional>
 #include <string_view>
+#include "common/fs/mapped_file.h"
 #include "common/intrusive_list.h"
 #include "core/file_sys/fs_filesystem.h"
 #include "core/file_sys/vfs/vfs.h"
@@ -85,6 +86,9 @@ public:
     bool IsWritable() const override;
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::span<const u8> ReadView(std::size_t length, std::size_t offset) const override;
+    void ReadAsync(u8* data, std::size_t length, std::size_t offset,
+                   Common::UniqueFunction<void, std::size_t> callback) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
     bool Rename(std::string_view name) override;
 
@@ -93,6 +97,17 @@ private:
                 const std::string& path, OpenMode perms = OpenMode::Read,
                 std::optional<u64> size = {});
 
+    // Maps read-only game images on their first read, returns nullptr for any other file or when
+    // the mapping failed. Reads through the mapping fault instead of failing if the file is
+    // truncated or its medium removed while it is mapped, see Common::FS::MappedFile.
+    const Common::FS::MappedFile* GetMapping() const;
+
+    // Opens the file if it was evicted and returns it for positional reads, which can go on
+    // without holding the filesystem lock. Returns nullptr for files which may have buffered
+    // writes or failed to open. Read-only files are only read through ReadAt, never through
+    // Seek() and ReadSpan(), which would see the file pointer ReadAt moved on Windows.
+    std::shared_ptr<Common::FS::IOFile> GetReadOnlyFile() const;
+
     RealVfsFilesystem& base;
     std::unique_ptr<FileReference> reference;
     std::string path;
@@ -100,6 +115,8 @@ private:
     std::vector<std::string> path_components;
     std::optional<u64> size;
     OpenMode perms;
+    mutable std::once_flag mapping_flag;
+    mutable Common::FS::MappedFile mapping;
 };
 
 // An implementation of VfsDirectory that represents a directory on the user's computer.
@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <utility>
 #include <vector>
 
 #include "common/assert.h"
@@ -108,7 +109,7 @@ public:
             return {};
         }
 
-        if (this->TrySetSpan()) {
+        if (this->TrySetReadSpan()) {
             if constexpr (FLAGS & GuestMemoryFlags::Safe) {
                 m_memory.FlushRegion(m_addr, this->size_bytes());
             }
@@ -151,6 +152,17 @@ public:
     }
 
 protected:
+    bool TrySetReadSpan() noexcept {
+        // Read through the const overload, so the memory can tell reads apart from writes
+        const u8* const ptr = std::as_const(m_memory).GetSpan(m_addr, this->size_bytes());
+        if (ptr) {
+            m_data_span = {reinterpret_cast<T*>(const_cast<u8*>(ptr)), this->size()};
+            m_span_valid = true;
+            return true;
+        }
+        return false;
+    }
+
     bool IsDataCopy() const noexcept {
         return m_is_data_copy;
     }
@@ -29,7 +29,7 @@ Result IStorage::Read(
     R_UNLESS(offset >= 0, FileSys::ResultInvalidOffset);
 
     // Read the data from the Storage backend
-    backend->Read(out_bytes.data(), length, offset);
+    backend->ReadSplit(out_bytes.data(), length, offset);
 
     R_SUCCEED();
 }
@@ -4,8 +4,8 @@
 #include <utility>
 
 #include "common/hex_util.h"
-#include "common/scope_exit.h"
 #include "core/core.h"
+#include "core/crypto/sha256_native.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/registered_cache.h"
@@ -14,7 +14,6 @@
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/deconstructed_rom_directory.h"
 #include "core/loader/nca.h"
-#include "mbedtls/sha256.h"
 
 namespace Loader {
 
@@ -113,14 +112,7 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
     std::vector<u8> buffer(4_MiB);
 
     // Initialize sha256 verification context.
-    mbedtls_sha256_context ctx;
-    mbedtls_sha256_init(&ctx);
-    mbedtls_sha256_starts_ret(&ctx, 0);
-
-    // Ensure we maintain a clean state on exit.
-    SCOPE_EXIT {
-        mbedtls_sha256_free(&ctx);
-    };
+    Core::Crypto::Sha256Native::Context ctx;
 
     // Declare counters.
     const size_t total_size = file->GetSize();
@@ -128,12 +120,17 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
 
     // Begin iterating the file.
     while (processed_size < total_size) {
-        // Refill the buffer.
+        // Refill the buffer, mapped files are hashed in place.
         const size_t intended_read_size = std::min(buffer.size(), total_size - processed_size);
-        const size_t read_size = file->Read(buffer.data(), intended_read_size, processed_size);
+        std::span<const u8> data = file->ReadView(intended_read_size, processed_size);
+        if (data.size() != intended_read_size) {
+            data = std::span{buffer}.first(
+                file->Read(buffer.data(), intended_read_size, processed_size));
+        }
+        const size_t read_size = data.size();
 
         // Update the hash function with the buffer contents.
-        mbedtls_sha256_update_ret(&ctx, buffer.data(), read_size);
+        ctx.Update(data.data(), read_size);
 
         // Update counters.
         processed_size += read_size;
@@ -145,8 +142,8 @@ ResultStatus AppLoader_NCA::VerifyIntegrity(std::function<bool(size_t, size_t)>
     }
 
     // Finalize context and compute the output hash.
-    std::array<u8, NcaSha256HashLength> output_hash;
-    mbedtls_sha256_finish_ret(&ctx, output_hash.data());
+    Core::Crypto::Sha256Native::Digest output_hash;
+    ctx.Finish(output_hash);
 
     // Compare to expected.
     if (std::memcmp(input_hash.data(), output_hash.data(), NcaSha256HalfHashLength) != 0) {
@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replays the command lists recorded with the capture_gpu_commands setting without a guest or a
+// host GPU. The memory each list read is loaded into the GPU address spaces it was read from, at
+// the point of the list that read it, and the list is pushed to the GPU of the null renderer, so
+// the stream goes through the real DmaPusher, engines and macro HLE. The shaders of every draw and
+// dispatch are translated to IR by the recompiler. Host time of the replay and of each step of the
+// recompiler is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "shader_recompiler/translation_timings.h"
+#include "video_core/control/capture_replay.h"
+#include "video_core/control/command_capture.h"
+#include "video_core/gpu.h"
+#include "video_core/renderer_base.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace {
+
+using Tegra::Control::CapturedSubmit;
+using Tegra::Control::CaptureReplayer;
+using Clock = CaptureReplayer::Clock;
+
+/// Window without a surface, the null renderer never presents to it
+class HeadlessWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+[[nodiscard]] double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void PrintUsage(const char* argv0) {
+    fmt::print(stderr,
+               "Usage: {} [options] <capture.gpucap>\n"
+               "  -i, --iterations <n>  Replay the capture n times, default 1\n"
+               "  -s, --no-shaders      Don't translate the shaders of draws and dispatches\n"
+               "  -h, --help            Show this help\n",
+               argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    u32 iterations = 1;
+    bool translate_shaders = true;
+    std::string capture_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if ((arg == "-i" || arg == "--iterations") && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-s" || arg == "--no-shaders") {
+            translate_shaders = false;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else if (capture_path.empty() && !arg.starts_with('-')) {
+            capture_path = arg;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (capture_path.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    const auto load_start = Clock::now();
+    Tegra::Control::CaptureReader reader{capture_path};
+    if (!reader.IsValid()) {
+        fmt::print(stderr, "{} is not a supported GPU command capture\n", capture_path);
+        return 1;
+    }
+    std::vector<CapturedSubmit> submits;
+    for (CapturedSubmit submit; reader.Next(submit);) {
+        submits.push_back(std::move(submit));
+    }
+    const Clock::duration load_time = Clock::now() - load_start;
+
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+    Settings::values.capture_gpu_commands.SetValue(false);
+
+    Core::System system;
+    system.Initialize();
+    HeadlessWindow window;
+    if (system.SetupForGPUReplay(window) != Core::SystemResultStatus::Success) {
+        fmt::print(stderr, "Failed to create the GPU\n");
+        return 1;
+    }
+    auto& rasterizer =
+        static_cast<Null::RasterizerNull&>(*system.GPU().Renderer().ReadRasterizer());
+    rasterizer.EnableShaderTranslation(translate_shaders);
+    system.GPU().Start();
+
+    CaptureReplayer::Stats stats;
+    CaptureReplayer::Stats first;
+    Clock::duration best_load_memory = Clock::duration::max();
+    Clock::duration best_execute = Clock::duration::max();
+    Clock::duration total_load_memory{};
+    Clock::duration total_execute{};
+    bool success = true;
+    {
+        // Engines and caches keep their state between iterations, like a game repeating a frame
+        CaptureReplayer replayer{system};
+        for (u32 iteration = 0; iteration < iterations && success; ++iteration) {
+            stats = {};
+            for (const CapturedSubmit& submit : submits) {
+                if (!replayer.Replay(submit, stats)) {
+                    success = false;
+                    break;
+                }
+            }
+            if (iteration == 0) {
+                first = stats;
+            }
+            best_load_memory = std::min(best_load_memory, stats.load_memory);
+            best_execute = std::min(best_execute, stats.execute);
+            total_load_memory += stats.load_memory;
+            total_execute += stats.execute;
+        }
+    }
+    const Null::ShaderCache::Stats shader_stats = rasterizer.GetShaderStats();
+    system.ShutdownMainProcess();
+    if (!success) {
+        fmt::print(stderr, "Failed to load the memory of the capture\n");
+        Common::Log::Stop();
+        return 1;
+    }
+
+    fmt::print("Capture: {}\n", capture_path);
+    fmt::print("  submits {}, words {}\n", stats.submits, stats.words);
+    fmt::print("  memory: ranges {}, bytes {}\n", stats.memory_ranges, stats.memory_bytes);
+    fmt::print("  pipelines: graphics {}, compute {}, programs {}, failed {}\n",
+               shader_stats.graphics_pipelines, shader_stats.compute_pipelines,
+               shader_stats.programs, shader_stats.failures);
+
+    Clock::duration total_step_time{};
+    for (const auto step_time : shader_stats.timings.steps) {
+        total_step_time += step_time;
+    }
+    fmt::print("Recompiler time, in ms:\n");
+    for (size_t step = 0; step < Shader::NUM_TRANSLATION_STEPS; ++step) {
+        const Clock::duration step_time = shader_stats.timings.steps[step];
+        const double share = total_step_time.count() > 0
+                                 ? 100.0 * static_cast<double>(step_time.count()) /
+                                       static_cast<double>(total_step_time.count())
+                                 : 0.0;
+        fmt::print("  {:28} {:10.3f} {:5.1f}%\n",
+                   Shader::NameOf(static_cast<Shader::TranslationStep>(step)),
+                   ToMilliseconds(step_time), share);
+    }
+    fmt::print("  {:28} {:10.3f}\n", "Total", ToMilliseconds(total_step_time));
+
+    // Shaders are translated in the first iteration, the following ones run on warm caches
+    fmt::print("Timings over {} iteration(s), first / best / average in ms:\n", iterations);
+    fmt::print("  load capture {:10.3f}\n", ToMilliseconds(load_time));
+    fmt::print("  load memory  {:10.3f} / {:10.3f} / {:10.3f}\n",
+               ToMilliseconds(first.load_memory), ToMilliseconds(best_load_memory),
+               ToMilliseconds(total_load_memory) / iterations);
+    fmt::print("  execute      {:10.3f} / {:10.3f} / {:10.3f}\n", ToMilliseconds(first.execute),
+               ToMilliseconds(best_execute), ToMilliseconds(total_execute) / iterations);
+
+    Common::Log::Stop();
+    return shader_stats.failures == 0 ? 0 : 2;
+}
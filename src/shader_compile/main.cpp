@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Translates every shader of a Vulkan pipeline cache file (shader/<title id>/vulkan.bin) to SPIR-V
+// without a GPU, on all cores, and writes the SPIR-V of the pipelines missing it back to the cache
+// so the emulator skips the recompiler on the next boot. The host is described by the
+// vulkan_profile.txt the Vulkan renderer writes to the shader directory. Host time of each step
+// of the recompiler is reported, next to the size of the generated code. Exits with 2 when a
+// pipeline failed to translate.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/shader_cache.h"
+#include "shader_recompiler/translation_timings.h"
+#include "video_core/pipeline_cache_file.h"
+#include "video_core/renderer_vulkan/vk_pipeline_cache.h"
+#include "video_core/shader_environment.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using VideoCommon::FileEnvironment;
+using VideoCommon::PipelineCacheFile;
+
+/// Pipeline loaded from the cache, translated by one of the workers
+struct Job {
+    std::optional<Vulkan::ComputePipelineCacheKey> compute_key;
+    std::optional<Vulkan::GraphicsPipelineCacheKey> graphics_key;
+    std::vector<FileEnvironment> envs;
+    u64 host_shaders_hash{};
+    bool has_host_shaders{};
+
+    /// Serialized host shaders, empty when the translation failed
+    std::vector<u8> host_shaders;
+};
+
+struct Stats {
+    size_t translated{};
+    size_t failed{};
+    size_t shaders{};
+    u64 code_bytes{};
+    u64 host_shader_bytes{};
+};
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/// Translates a pipeline, returning its host shaders or nothing when the recompiler failed
+std::vector<Vulkan::HostShader> Translate(Vulkan::ShaderPools& pools, Job& job,
+                                          const Shader::Profile& profile,
+                                          const Shader::HostTranslateInfo& host_info) try {
+    pools.ReleaseContents();
+    if (job.compute_key) {
+        return Vulkan::TranslateComputeShader(pools, *job.compute_key, job.envs.front(), profile,
+                                              host_info);
+    }
+    std::vector<Shader::Environment*> env_ptrs;
+    for (FileEnvironment& env : job.envs) {
+        env_ptrs.push_back(&env);
+    }
+    return Vulkan::TranslateGraphicsShaders(pools, *job.graphics_key, env_ptrs, profile,
+                                            host_info);
+} catch (const Shader::Exception& exception) {
+    LOG_ERROR(Render_Vulkan, "{}", exception.what());
+    return {};
+}
+
+void PrintUsage(const char* argv0) {
+    fmt::print(stderr,
+               "Usage: {} [options] <vulkan.bin>\n"
+               "  -p, --profile <file>  Recompiler profile written by the Vulkan renderer,\n"
+               "                        default vulkan_profile.txt in the shader directory\n"
+               "  -j, --threads <n>     Number of worker threads, default all cores\n"
+               "  -n, --no-write        Translate without writing the SPIR-V to the cache\n"
+               "  -h, --help            Show this help\n",
+               argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    u32 num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    bool write_cache = true;
+    std::filesystem::path profile_path;
+    std::filesystem::path cache_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if ((arg == "-p" || arg == "--profile") && i + 1 < argc) {
+            profile_path = argv[++i];
+        } else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+            num_threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-n" || arg == "--no-write") {
+            write_cache = false;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else if (cache_path.empty() && !arg.starts_with('-')) {
+            cache_path = arg;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (cache_path.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (profile_path.empty()) {
+        profile_path = cache_path.parent_path().parent_path() / "vulkan_profile.txt";
+    }
+
+    Shader::Profile profile{};
+    Shader::HostTranslateInfo host_info{};
+    const std::string target{
+        Common::FS::ReadStringFromFile(profile_path, Common::FS::FileType::TextFile)};
+    if (target.empty() || !Shader::DeserializeRecompilerTarget(target, profile, host_info)) {
+        fmt::print(stderr, "{} is not a valid recompiler profile\n",
+                   Common::FS::PathToUTF8String(profile_path));
+        return 1;
+    }
+    if (!std::filesystem::is_regular_file(cache_path)) {
+        fmt::print(stderr, "{} is not a pipeline cache file\n",
+                   Common::FS::PathToUTF8String(cache_path));
+        return 1;
+    }
+
+    const auto load_start = Clock::now();
+    PipelineCacheFile cache;
+    cache.Open(cache_path, Vulkan::CACHE_VERSION,
+               Shader::RecompilerFingerprint(profile, host_info));
+    if (!cache.IsOpen()) {
+        fmt::print(stderr, "Failed to open {}\n", Common::FS::PathToUTF8String(cache_path));
+        return 1;
+    }
+    std::vector<Job> jobs;
+    size_t num_compute = 0;
+    cache.LoadPipelines(
+        {},
+        [&](std::istream& file, FileEnvironment env, PipelineCacheFile::HostShaders shaders) {
+            Job& job = jobs.emplace_back();
+            job.compute_key.emplace();
+            file.read(reinterpret_cast<char*>(&*job.compute_key), sizeof(*job.compute_key));
+            job.envs.push_back(std::move(env));
+            job.host_shaders_hash = shaders.hash;
+            job.has_host_shaders = !shaders.data.empty();
+            ++num_compute;
+        },
+        [&](std::istream& file, std::vector<FileEnvironment> envs,
+            PipelineCacheFile::HostShaders shaders) {
+            Job& job = jobs.emplace_back();
+            job.graphics_key.emplace();
+            file.read(reinterpret_cast<char*>(&*job.graphics_key), sizeof(*job.graphics_key));
+            job.envs = std::move(envs);
+            job.host_shaders_hash = shaders.hash;
+            job.has_host_shaders = !shaders.data.empty();
+        });
+    const Clock::duration load_time = Clock::now() - load_start;
+
+    // Workers take the next pipeline until there are none left, each with its own pools
+    std::mutex stats_mutex;
+    Stats stats;
+    Shader::TranslationTimings timings;
+    std::atomic<size_t> next_job{0};
+    const auto translate_start = Clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (u32 thread = 0; thread < num_threads; ++thread) {
+            workers.emplace_back([&] {
+                Vulkan::ShaderPools pools;
+                Shader::TranslationTimings thread_timings;
+                Stats thread_stats;
+                Shader::SetThreadTranslationTimings(&thread_timings);
+                for (size_t index = next_job++; index < jobs.size(); index = next_job++) {
+                    Job& job = jobs[index];
+                    const auto shaders{Translate(pools, job, profile, host_info)};
+                    if (shaders.empty()) {
+                        ++thread_stats.failed;
+                        continue;
+                    }
+                    ++thread_stats.translated;
+                    thread_stats.shaders += shaders.size();
+                    for (const Vulkan::HostShader& shader : shaders) {
+                        thread_stats.code_bytes += shader.code.size() * sizeof(u32);
+                    }
+                    job.host_shaders = Vulkan::SerializeHostShaders(shaders);
+                    thread_stats.host_shader_bytes += job.host_shaders.size();
+                }
+                Shader::SetThreadTranslationTimings(nullptr);
+
+                std::scoped_lock lock{stats_mutex};
+                timings += thread_timings;
+                stats.translated += thread_stats.translated;
+                stats.failed += thread_stats.failed;
+                stats.shaders += thread_stats.shaders;
+                stats.code_bytes += thread_stats.code_bytes;
+                stats.host_shader_bytes += thread_stats.host_shader_bytes;
+            });
+        }
+    }
+    const Clock::duration translate_time = Clock::now() - translate_start;
+
+    const auto write_start = Clock::now();
+    size_t num_written = 0;
+    size_t num_cached = 0;
+    for (const Job& job : jobs) {
+        num_cached += job.has_host_shaders ? 1 : 0;
+        if (write_cache && !job.has_host_shaders && !job.host_shaders.empty()) {
+            cache.SerializeHostShaders(job.host_shaders_hash, job.host_shaders);
+            ++num_written;
+        }
+    }
+    const Clock::duration write_time = Clock::now() - write_start;
+
+    fmt::print("Cache: {}\n", Common::FS::PathToUTF8String(cache_path));
+    fmt::print("  pipelines: compute {}, graphics {}, with SPIR-V already cached {}\n",
+               num_compute, jobs.size() - num_compute, num_cached);
+    fmt::print("  translated {}, failed {}, written to the cache {}\n", stats.translated,
+               stats.failed, num_written);
+    fmt::print("  SPIR-V: {} shaders, {} bytes, {} bytes with shader info\n", stats.shaders,
+               stats.code_bytes, stats.host_shader_bytes);
+
+    Clock::duration total_step_time{};
+    for (const auto step_time : timings.steps) {
+        total_step_time += step_time;
+    }
+    fmt::print("Recompiler time summed over {} thread(s), in ms:\n", num_threads);
+    for (size_t step = 0; step < Shader::NUM_TRANSLATION_STEPS; ++step) {
+        const Clock::duration step_time = timings.steps[step];
+        const double share = total_step_time.count() > 0
+                                 ? 100.0 * static_cast<double>(step_time.count()) /
+                                       static_cast<double>(total_step_time.count())
+                                 : 0.0;
+        fmt::print("  {:28} {:10.3f} {:5.1f}%\n",
+                   Shader::NameOf(static_cast<Shader::TranslationStep>(step)),
+                   ToMilliseconds(step_time), share);
+    }
+    fmt::print("  {:28} {:10.3f}\n", "Total", ToMilliseconds(total_step_time));
+    fmt::print("Wall time in ms:\n");
+    fmt::print("  load      {:10.3f}\n", ToMilliseconds(load_time));
+    fmt::print("  translate {:10.3f}\n", ToMilliseconds(translate_time));
+    fmt::print("  write     {:10.3f}\n", ToMilliseconds(write_time));
+
+    Common::Log::Stop();
+    return stats.failed == 0 ? 0 : 2;
+}
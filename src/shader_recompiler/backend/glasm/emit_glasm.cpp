@@ -15,6 +15,7 @@
 #include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/profile.h"
 #include "shader_recompiler/runtime_info.h"
+#include "shader_recompiler/translation_timings.h"
 
 namespace Shader::Backend::GLASM {
 namespace {
@@ -400,6 +401,7 @@ std::string_view GetTessSpacing(TessSpacing spacing) {
 
 std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, IR::Program& program,
                       Bindings& bindings) {
+    const ScopedTranslationTimer timer{TranslationStep::Emit};
     EmitContext ctx{program, bindings, profile, runtime_info};
     Precolor(program);
     EmitCode(ctx, program);
@@ -12,6 +12,7 @@
 #include "shader_recompiler/backend/glsl/emit_glsl_instructions.h"
 #include "shader_recompiler/backend/glsl/glsl_emit_context.h"
 #include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/translation_timings.h"
 
 namespace Shader::Backend::GLSL {
 namespace {
@@ -216,6 +217,7 @@ void DefineVariables(const EmitContext& ctx, std::string& header) {
 
 std::string EmitGLSL(const Profile& profile, const RuntimeInfo& runtime_info, IR::Program& program,
                      Bindings& bindings) {
+    const ScopedTranslationTimer timer{TranslationStep::Emit};
     EmitContext ctx{program, bindings, profile, runtime_info};
     Precolor(program);
     EmitCode(ctx, program);
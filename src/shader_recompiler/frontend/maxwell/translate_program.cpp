@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 #include <queue>
 
@@ -16,6 +18,7 @@
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/translation_timings.h"
 
 namespace Shader::Maxwell {
 namespace {
@@ -235,10 +238,16 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
     }
 }
 
+template <typename Pass, typename... Args>
+void RunPass(TranslationStep step, Pass&& pass, Args&&... args) {
+    const ScopedTranslationTimer timer{step};
+    pass(std::forward<Args>(args)...);
+}
 } // Anonymous namespace
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
                              Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+    std::optional<ScopedTranslationTimer> decode_timer{std::in_place, TranslationStep::Decode};
     IR::Program program;
     program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
     program.blocks = GenerateBlocks(program.syntax_list);
@@ -278,40 +287,49 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
         break;
     }
     RemoveUnreachableBlocks(program);
+    decode_timer.reset();
 
     // Replace instructions before the SSA rewrite
-    if (!host_info.support_float64) {
-        Optimization::LowerFp64ToFp32(program);
-    }
-    if (!host_info.support_float16) {
-        Optimization::LowerFp16ToFp32(program);
-    }
-    if (!host_info.support_int64) {
-        Optimization::LowerInt64ToInt32(program);
-    }
-    if (!host_info.support_conditional_barrier) {
-        Optimization::ConditionalBarrierPass(program);
+    {
+        const ScopedTranslationTimer timer{TranslationStep::Lowering};
+        if (!host_info.support_float64) {
+            Optimization::LowerFp64ToFp32(program);
+        }
+        if (!host_info.support_float16) {
+            Optimization::LowerFp16ToFp32(program);
+        }
+        if (!host_info.support_int64) {
+            Optimization::LowerInt64ToInt32(program);
+        }
+        if (!host_info.support_conditional_barrier) {
+            Optimization::ConditionalBarrierPass(program);
+        }
     }
-    Optimization::SsaRewritePass(program);
+    RunPass(TranslationStep::SsaRewrite, Optimization::SsaRewritePass, program);
 
-    Optimization::ConstantPropagationPass(env, program);
+    RunPass(TranslationStep::ConstantPropagation, Optimization::ConstantPropagationPass, env,
+            program);
+    RunPass(TranslationStep::GlobalValueNumbering, Optimization::GlobalValueNumberingPass,
+            program);
 
-    Optimization::PositionPass(env, program);
+    RunPass(TranslationStep::Position, Optimization::PositionPass, env, program);
 
-    Optimization::GlobalMemoryToStorageBufferPass(program, host_info);
-    Optimization::TexturePass(env, program, host_info);
+    RunPass(TranslationStep::GlobalMemoryToStorageBuffer,
+            Optimization::GlobalMemoryToStorageBufferPass, program, host_info);
+    RunPass(TranslationStep::Texture, Optimization::TexturePass, env, program, host_info);
 
     if (Settings::values.resolution_info.active) {
-        Optimization::RescalingPass(program);
+        RunPass(TranslationStep::Rescaling, Optimization::RescalingPass, program);
     }
-    Optimization::DeadCodeEliminationPass(program);
+    RunPass(TranslationStep::DeadCodeElimination, Optimization::DeadCodeEliminationPass, program);
     if (Settings::values.renderer_debug) {
-        Optimization::VerificationPass(program);
+        RunPass(TranslationStep::Verification, Optimization::VerificationPass, program);
     }
-    Optimization::CollectShaderInfoPass(env, program);
-    Optimization::LayerPass(program, host_info);
-    Optimization::VendorWorkaroundPass(program);
+    RunPass(TranslationStep::CollectShaderInfo, Optimization::CollectShaderInfoPass, env, program);
+    RunPass(TranslationStep::Layer, Optimization::LayerPass, program, host_info);
+    RunPass(TranslationStep::VendorWorkaround, Optimization::VendorWorkaroundPass, program);
 
+    const ScopedTranslationTimer timer{TranslationStep::CollectShaderInfo};
     CollectInterpolationInfo(env, program);
     AddNVNStorageBuffers(program);
     return program;
@@ -319,6 +337,7 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
 
 IR::Program MergeDualVertexPrograms(IR::Program& vertex_a, IR::Program& vertex_b,
                                     Environment& env_vertex_b) {
+    const ScopedTranslationTimer timer{TranslationStep::DualVertexMerge};
     IR::Program result{};
     Optimization::VertexATransformPass(vertex_a);
     Optimization::VertexBTransformPass(vertex_b);
@@ -7,6 +7,7 @@ namespace Shader {
 
 // Try to keep entries here to a minimum
 // They can accidentally change the cached information in a shader
+// Fields added here have to be hashed in shader_cache.cpp too
 
 /// Misc information about the host
 struct HostTranslateInfo {
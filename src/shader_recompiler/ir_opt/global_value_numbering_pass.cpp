@@ -0,0 +1,360 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/bit_cast.h"
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// How far the value of an instruction can be reused
+enum class Scope {
+    /// Never merged: phis, pseudo-instructions, instructions with side effects...
+    None,
+    /// Reads state that can change during the invocation, like memory, or whose result depends on
+    /// the active invocations, like subgroup and derivative operations. Merged with an identical
+    /// instruction of the same block when no instruction with side effects is between them.
+    Block,
+    /// Result depends only on the arguments and the flags. Merged with an identical instruction
+    /// in a dominating block.
+    Dominator,
+};
+
+Scope ScopeOf(const IR::Inst& inst) {
+    if (inst.MayHaveSideEffects() || inst.IsPseudoInstruction()) {
+        return Scope::None;
+    }
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::Phi:
+    case IR::Opcode::Identity:
+    case IR::Opcode::Void:
+    case IR::Opcode::UndefU1:
+    case IR::Opcode::UndefU8:
+    case IR::Opcode::UndefU16:
+    case IR::Opcode::UndefU32:
+    case IR::Opcode::UndefU64:
+    // Only used before the SSA rewrite
+    case IR::Opcode::GetRegister:
+    case IR::Opcode::SetRegister:
+    case IR::Opcode::GetPred:
+    case IR::Opcode::SetPred:
+    case IR::Opcode::GetGotoVariable:
+    case IR::Opcode::SetGotoVariable:
+    case IR::Opcode::GetIndirectBranchVariable:
+    case IR::Opcode::SetIndirectBranchVariable:
+    case IR::Opcode::GetZFlag:
+    case IR::Opcode::GetSFlag:
+    case IR::Opcode::GetCFlag:
+    case IR::Opcode::GetOFlag:
+    case IR::Opcode::SetZFlag:
+    case IR::Opcode::SetSFlag:
+    case IR::Opcode::SetCFlag:
+    case IR::Opcode::SetOFlag:
+        return Scope::None;
+    case IR::Opcode::GetAttribute:
+    case IR::Opcode::GetAttributeU32:
+    case IR::Opcode::GetAttributeIndexed:
+    case IR::Opcode::GetPatch:
+    case IR::Opcode::IsHelperInvocation:
+    case IR::Opcode::LoadGlobalU8:
+    case IR::Opcode::LoadGlobalS8:
+    case IR::Opcode::LoadGlobalU16:
+    case IR::Opcode::LoadGlobalS16:
+    case IR::Opcode::LoadGlobal32:
+    case IR::Opcode::LoadGlobal64:
+    case IR::Opcode::LoadGlobal128:
+    case IR::Opcode::LoadStorageU8:
+    case IR::Opcode::LoadStorageS8:
+    case IR::Opcode::LoadStorageU16:
+    case IR::Opcode::LoadStorageS16:
+    case IR::Opcode::LoadStorage32:
+    case IR::Opcode::LoadStorage64:
+    case IR::Opcode::LoadStorage128:
+    case IR::Opcode::LoadLocal:
+    case IR::Opcode::LoadSharedU8:
+    case IR::Opcode::LoadSharedS8:
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedS16:
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::LoadSharedU128:
+    case IR::Opcode::BindlessImageSampleImplicitLod:
+    case IR::Opcode::BindlessImageSampleExplicitLod:
+    case IR::Opcode::BindlessImageSampleDrefImplicitLod:
+    case IR::Opcode::BindlessImageSampleDrefExplicitLod:
+    case IR::Opcode::BindlessImageGather:
+    case IR::Opcode::BindlessImageGatherDref:
+    case IR::Opcode::BindlessImageFetch:
+    case IR::Opcode::BindlessImageQueryDimensions:
+    case IR::Opcode::BindlessImageQueryLod:
+    case IR::Opcode::BindlessImageGradient:
+    case IR::Opcode::BindlessImageRead:
+    case IR::Opcode::BoundImageSampleImplicitLod:
+    case IR::Opcode::BoundImageSampleExplicitLod:
+    case IR::Opcode::BoundImageSampleDrefImplicitLod:
+    case IR::Opcode::BoundImageSampleDrefExplicitLod:
+    case IR::Opcode::BoundImageGather:
+    case IR::Opcode::BoundImageGatherDref:
+    case IR::Opcode::BoundImageFetch:
+    case IR::Opcode::BoundImageQueryDimensions:
+    case IR::Opcode::BoundImageQueryLod:
+    case IR::Opcode::BoundImageGradient:
+    case IR::Opcode::BoundImageRead:
+    case IR::Opcode::ImageSampleImplicitLod:
+    case IR::Opcode::ImageSampleExplicitLod:
+    case IR::Opcode::ImageSampleDrefImplicitLod:
+    case IR::Opcode::ImageSampleDrefExplicitLod:
+    case IR::Opcode::ImageGather:
+    case IR::Opcode::ImageGatherDref:
+    case IR::Opcode::ImageFetch:
+    case IR::Opcode::ImageQueryDimensions:
+    case IR::Opcode::ImageQueryLod:
+    case IR::Opcode::ImageGradient:
+    case IR::Opcode::ImageRead:
+    case IR::Opcode::VoteAll:
+    case IR::Opcode::VoteAny:
+    case IR::Opcode::VoteEqual:
+    case IR::Opcode::SubgroupBallot:
+    case IR::Opcode::ShuffleIndex:
+    case IR::Opcode::ShuffleUp:
+    case IR::Opcode::ShuffleDown:
+    case IR::Opcode::ShuffleButterfly:
+    case IR::Opcode::FSwizzleAdd:
+    case IR::Opcode::DPdxFine:
+    case IR::Opcode::DPdyFine:
+    case IR::Opcode::DPdxCoarse:
+    case IR::Opcode::DPdyCoarse:
+        return Scope::Block;
+    default:
+        return Scope::Dominator;
+    }
+}
+
+bool IsCommutative(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+    case IR::Opcode::FPAdd16:
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPMul16:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+u64 HashValue(const IR::Value& value) {
+    if (!value.IsImmediate()) {
+        return reinterpret_cast<u64>(value.Inst());
+    }
+    const IR::Type type{value.Type()};
+    const u64 type_bits{static_cast<u64>(type) << 48};
+    switch (type) {
+    case IR::Type::Reg:
+        return type_bits ^ static_cast<u64>(value.Reg());
+    case IR::Type::Pred:
+        return type_bits ^ static_cast<u64>(value.Pred());
+    case IR::Type::Attribute:
+        return type_bits ^ static_cast<u64>(value.Attribute());
+    case IR::Type::Patch:
+        return type_bits ^ static_cast<u64>(value.Patch());
+    case IR::Type::U1:
+        return type_bits ^ static_cast<u64>(value.U1());
+    case IR::Type::U8:
+        return type_bits ^ value.U8();
+    case IR::Type::U16:
+        return type_bits ^ value.U16();
+    case IR::Type::U32:
+        return type_bits ^ value.U32();
+    case IR::Type::F32:
+        return type_bits ^ Common::BitCast<u32>(value.F32());
+    case IR::Type::U64:
+        return type_bits ^ value.U64();
+    case IR::Type::F64:
+        return type_bits ^ Common::BitCast<u64>(value.F64());
+    default:
+        // Equal values still compare equal, they only share a bucket
+        return type_bits;
+    }
+}
+
+/// Opcode, flags and resolved arguments of an instruction
+struct InstKey {
+    IR::Opcode opcode{};
+    u32 flags{};
+    size_t num_args{};
+    std::array<IR::Value, 5> args{};
+
+    bool operator==(const InstKey& rhs) const {
+        return opcode == rhs.opcode && flags == rhs.flags && num_args == rhs.num_args &&
+               std::equal(args.begin(), args.begin() + num_args, rhs.args.begin());
+    }
+};
+
+struct InstKeyHash {
+    size_t operator()(const InstKey& key) const noexcept {
+        u64 hash{static_cast<u64>(key.opcode) * 0x9E3779B97F4A7C15ULL ^ key.flags};
+        for (size_t index = 0; index < key.num_args; ++index) {
+            hash = (hash ^ HashValue(key.args[index])) * 0x100000001B3ULL;
+        }
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+InstKey MakeKey(const IR::Inst& inst) {
+    InstKey key{
+        .opcode = inst.GetOpcode(),
+        .flags = inst.Flags<u32>(),
+        .num_args = inst.NumArgs(),
+    };
+    for (size_t index = 0; index < key.num_args; ++index) {
+        key.args[index] = inst.Arg(index).Resolve();
+    }
+    if (IsCommutative(key.opcode) && HashValue(key.args[1]) < HashValue(key.args[0])) {
+        std::swap(key.args[0], key.args[1]);
+    }
+    return key;
+}
+
+using ValueTable = std::unordered_map<InstKey, IR::Inst*, InstKeyHash>;
+
+/// Immediate dominators of the blocks in reverse post order, computed with the algorithm of
+/// Cooper, Harvey and Kennedy. The entry block is its own dominator.
+std::vector<size_t> ImmediateDominators(std::span<IR::Block* const> rpo_blocks,
+                                        const std::unordered_map<const IR::Block*, size_t>& rpo) {
+    constexpr size_t UNDEFINED = std::numeric_limits<size_t>::max();
+    std::vector<size_t> idoms(rpo_blocks.size(), UNDEFINED);
+    idoms[0] = 0;
+    const auto intersect{[&idoms](size_t lhs, size_t rhs) {
+        while (lhs != rhs) {
+            while (lhs > rhs) {
+                lhs = idoms[lhs];
+            }
+            while (rhs > lhs) {
+                rhs = idoms[rhs];
+            }
+        }
+        return lhs;
+    }};
+    bool changed{true};
+    while (changed) {
+        changed = false;
+        for (size_t index = 1; index < rpo_blocks.size(); ++index) {
+            size_t new_idom{UNDEFINED};
+            for (const IR::Block* const pred : rpo_blocks[index]->ImmPredecessors()) {
+                const auto it{rpo.find(pred)};
+                if (it == rpo.end() || idoms[it->second] == UNDEFINED) {
+                    continue;
+                }
+                new_idom = new_idom == UNDEFINED ? it->second : intersect(it->second, new_idom);
+            }
+            if (new_idom != UNDEFINED && idoms[index] != new_idom) {
+                idoms[index] = new_idom;
+                changed = true;
+            }
+        }
+    }
+    return idoms;
+}
+
+/// Merges the instructions of a block with the ones available from its dominators, returns the
+/// keys it added to the dominator table
+std::vector<InstKey> VisitBlock(IR::Block& block, ValueTable& dominator_table) {
+    std::vector<InstKey> added_keys;
+    ValueTable block_table;
+    for (IR::Inst& inst : block.Instructions()) {
+        const Scope scope{ScopeOf(inst)};
+        if (scope == Scope::None) {
+            if (inst.MayHaveSideEffects()) {
+                block_table.clear();
+            }
+            continue;
+        }
+        ValueTable& table{scope == Scope::Dominator ? dominator_table : block_table};
+        InstKey key{MakeKey(inst)};
+        const auto [it, is_new]{table.try_emplace(key, &inst)};
+        if (is_new) {
+            if (scope == Scope::Dominator) {
+                added_keys.push_back(std::move(key));
+            }
+            continue;
+        }
+        // The pseudo-operations of the duplicate would be orphaned, keep it
+        if (inst.HasAssociatedPseudoOperation()) {
+            continue;
+        }
+        inst.ReplaceUsesWith(IR::Value{it->second});
+    }
+    return added_keys;
+}
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    if (program.post_order_blocks.empty()) {
+        return;
+    }
+    std::vector<IR::Block*> rpo_blocks(program.post_order_blocks.rbegin(),
+                                       program.post_order_blocks.rend());
+    std::unordered_map<const IR::Block*, size_t> rpo;
+    rpo.reserve(rpo_blocks.size());
+    for (size_t index = 0; index < rpo_blocks.size(); ++index) {
+        rpo.emplace(rpo_blocks[index], index);
+    }
+    const std::vector<size_t> idoms{ImmediateDominators(rpo_blocks, rpo)};
+    std::vector<std::vector<size_t>> children(rpo_blocks.size());
+    for (size_t index = 1; index < rpo_blocks.size(); ++index) {
+        if (idoms[index] < rpo_blocks.size()) {
+            children[idoms[index]].push_back(index);
+        }
+    }
+
+    // Walk the dominator tree, values of a block are available to the blocks it dominates
+    struct Frame {
+        size_t block;
+        size_t next_child;
+        std::vector<InstKey> added_keys;
+    };
+    ValueTable dominator_table;
+    std::vector<Frame> stack;
+    stack.push_back(Frame{0, 0, VisitBlock(*rpo_blocks[0], dominator_table)});
+    while (!stack.empty()) {
+        Frame& frame{stack.back()};
+        if (frame.next_child < children[frame.block].size()) {
+            const size_t child{children[frame.block][frame.next_child++]};
+            stack.push_back(Frame{child, 0, VisitBlock(*rpo_blocks[child], dominator_table)});
+            continue;
+        }
+        for (const InstKey& key : frame.added_keys) {
+            dominator_table.erase(key);
+        }
+        stack.pop_back();
+    }
+}
+
+} // namespace Shader::Optimization
@@ -23,6 +23,7 @@ public:
         return std::construct_at(Memory(), std::forward<Args>(args)...);
     }
 
+    /// Destroys all objects, keeping the allocated memory for the following objects
     void ReleaseContents() {
         if (chunks.empty()) {
             return;
@@ -76,7 +77,11 @@ private:
         }
 
         void Release() {
-            std::destroy_n(storage.get(), used_objects);
+            // Storage does not know which member is alive, destroy the objects explicitly so the
+            // memory they own is freed before the chunk is reused
+            for (size_t index = 0; index < used_objects; ++index) {
+                std::destroy_at(&storage[index].object);
+            }
             used_objects = 0;
         }
 
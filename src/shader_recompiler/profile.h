@@ -7,6 +7,7 @@
 
 namespace Shader {
 
+/// Fields added here have to be hashed in shader_cache.cpp too
 struct Profile {
     u32 supported_spirv{0x00010000};
     bool unified_descriptor_binding{};
@@ -0,0 +1,428 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bitset>
+#include <charconv>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/settings.h"
+#include "common/string_util.h"
+#include "shader_recompiler/shader_cache.h"
+
+namespace Shader {
+
+namespace {
+/// Calls func with every field of info, in the order they are serialized.
+/// New fields of Info have to be added here and RECOMPILER_VERSION increased.
+template <typename InfoType, typename Func>
+void VisitInfo(InfoType& info, Func&& func) {
+    func(info.uses_workgroup_id);
+    func(info.uses_local_invocation_id);
+    func(info.uses_invocation_id);
+    func(info.uses_invocation_info);
+    func(info.uses_sample_id);
+    func(info.uses_is_helper_invocation);
+    func(info.uses_subgroup_invocation_id);
+    func(info.uses_subgroup_shuffles);
+    func(info.uses_patches);
+    func(info.interpolation);
+    func(info.loads.mask);
+    func(info.stores.mask);
+    func(info.passthrough.mask);
+    func(info.legacy_stores_mapping);
+    func(info.loads_indexed_attributes);
+    func(info.stores_frag_color);
+    func(info.stores_sample_mask);
+    func(info.stores_frag_depth);
+    func(info.stores_tess_level_outer);
+    func(info.stores_tess_level_inner);
+    func(info.stores_indexed_attributes);
+    func(info.stores_global_memory);
+    func(info.uses_local_memory);
+    func(info.uses_fp16);
+    func(info.uses_fp64);
+    func(info.uses_fp16_denorms_flush);
+    func(info.uses_fp16_denorms_preserve);
+    func(info.uses_fp32_denorms_flush);
+    func(info.uses_fp32_denorms_preserve);
+    func(info.uses_int8);
+    func(info.uses_int16);
+    func(info.uses_int64);
+    func(info.uses_image_1d);
+    func(info.uses_sampled_1d);
+    func(info.uses_sparse_residency);
+    func(info.uses_demote_to_helper_invocation);
+    func(info.uses_subgroup_vote);
+    func(info.uses_subgroup_mask);
+    func(info.uses_fswzadd);
+    func(info.uses_derivatives);
+    func(info.uses_typeless_image_reads);
+    func(info.uses_typeless_image_writes);
+    func(info.uses_image_buffers);
+    func(info.uses_shared_increment);
+    func(info.uses_shared_decrement);
+    func(info.uses_global_increment);
+    func(info.uses_global_decrement);
+    func(info.uses_atomic_f32_add);
+    func(info.uses_atomic_f16x2_add);
+    func(info.uses_atomic_f16x2_min);
+    func(info.uses_atomic_f16x2_max);
+    func(info.uses_atomic_f32x2_add);
+    func(info.uses_atomic_f32x2_min);
+    func(info.uses_atomic_f32x2_max);
+    func(info.uses_atomic_s32_min);
+    func(info.uses_atomic_s32_max);
+    func(info.uses_int64_bit_atomics);
+    func(info.uses_global_memory);
+    func(info.uses_atomic_image_u32);
+    func(info.uses_shadow_lod);
+    func(info.uses_rescaling_uniform);
+    func(info.uses_cbuf_indirect);
+    func(info.uses_render_area);
+    func(info.alpha_to_coverage_enabled);
+    func(info.used_constant_buffer_types);
+    func(info.used_storage_buffer_types);
+    func(info.used_indirect_cbuf_types);
+    func(info.constant_buffer_mask);
+    func(info.constant_buffer_used_sizes);
+    func(info.nvn_buffer_base);
+    func(info.nvn_buffer_used);
+    func(info.requires_layer_emulation);
+    func(info.emulated_layer);
+    func(info.used_clip_distances);
+    func(info.constant_buffer_descriptors);
+    func(info.storage_buffers_descriptors);
+    func(info.texture_buffer_descriptors);
+    func(info.image_buffer_descriptors);
+    func(info.texture_descriptors);
+    func(info.image_descriptors);
+}
+
+/// Calls func with the name and the value of every field of profile
+template <typename ProfileType, typename Func>
+void VisitProfile(ProfileType& profile, Func&& func) {
+    func("supported_spirv", profile.supported_spirv);
+    func("unified_descriptor_binding", profile.unified_descriptor_binding);
+    func("support_descriptor_aliasing", profile.support_descriptor_aliasing);
+    func("support_int8", profile.support_int8);
+    func("support_int16", profile.support_int16);
+    func("support_int64", profile.support_int64);
+    func("support_vertex_instance_id", profile.support_vertex_instance_id);
+    func("support_float_controls", profile.support_float_controls);
+    func("support_separate_denorm_behavior", profile.support_separate_denorm_behavior);
+    func("support_separate_rounding_mode", profile.support_separate_rounding_mode);
+    func("support_fp16_denorm_preserve", profile.support_fp16_denorm_preserve);
+    func("support_fp32_denorm_preserve", profile.support_fp32_denorm_preserve);
+    func("support_fp16_denorm_flush", profile.support_fp16_denorm_flush);
+    func("support_fp32_denorm_flush", profile.support_fp32_denorm_flush);
+    func("support_fp16_signed_zero_nan_preserve", profile.support_fp16_signed_zero_nan_preserve);
+    func("support_fp32_signed_zero_nan_preserve", profile.support_fp32_signed_zero_nan_preserve);
+    func("support_fp64_signed_zero_nan_preserve", profile.support_fp64_signed_zero_nan_preserve);
+    func("support_explicit_workgroup_layout", profile.support_explicit_workgroup_layout);
+    func("support_vote", profile.support_vote);
+    func("support_viewport_index_layer_non_geometry",
+         profile.support_viewport_index_layer_non_geometry);
+    func("support_viewport_mask", profile.support_viewport_mask);
+    func("support_typeless_image_loads", profile.support_typeless_image_loads);
+    func("support_demote_to_helper_invocation", profile.support_demote_to_helper_invocation);
+    func("support_int64_atomics", profile.support_int64_atomics);
+    func("support_derivative_control", profile.support_derivative_control);
+    func("support_geometry_shader_passthrough", profile.support_geometry_shader_passthrough);
+    func("support_native_ndc", profile.support_native_ndc);
+    func("support_gl_nv_gpu_shader_5", profile.support_gl_nv_gpu_shader_5);
+    func("support_gl_amd_gpu_shader_half_float", profile.support_gl_amd_gpu_shader_half_float);
+    func("support_gl_texture_shadow_lod", profile.support_gl_texture_shadow_lod);
+    func("support_gl_warp_intrinsics", profile.support_gl_warp_intrinsics);
+    func("support_gl_variable_aoffi", profile.support_gl_variable_aoffi);
+    func("support_gl_sparse_textures", profile.support_gl_sparse_textures);
+    func("support_gl_derivative_control", profile.support_gl_derivative_control);
+    func("support_scaled_attributes", profile.support_scaled_attributes);
+    func("support_multi_viewport", profile.support_multi_viewport);
+    func("support_geometry_streams", profile.support_geometry_streams);
+    func("warp_size_potentially_larger_than_guest",
+         profile.warp_size_potentially_larger_than_guest);
+    func("lower_left_origin_mode", profile.lower_left_origin_mode);
+    func("need_declared_frag_colors", profile.need_declared_frag_colors);
+    func("need_fastmath_off", profile.need_fastmath_off);
+    func("need_gather_subpixel_offset", profile.need_gather_subpixel_offset);
+    func("has_broken_spirv_clamp", profile.has_broken_spirv_clamp);
+    func("has_broken_spirv_position_input", profile.has_broken_spirv_position_input);
+    func("has_broken_unsigned_image_offsets", profile.has_broken_unsigned_image_offsets);
+    func("has_broken_signed_operations", profile.has_broken_signed_operations);
+    func("has_broken_fp16_float_controls", profile.has_broken_fp16_float_controls);
+    func("has_gl_component_indexing_bug", profile.has_gl_component_indexing_bug);
+    func("has_gl_precise_bug", profile.has_gl_precise_bug);
+    func("has_gl_cbuf_ftou_bug", profile.has_gl_cbuf_ftou_bug);
+    func("has_gl_bool_ref_bug", profile.has_gl_bool_ref_bug);
+    func("ignore_nan_fp_comparisons", profile.ignore_nan_fp_comparisons);
+    func("has_broken_spirv_subgroup_mask_vector_extract_dynamic",
+         profile.has_broken_spirv_subgroup_mask_vector_extract_dynamic);
+    func("gl_max_compute_smem_size", profile.gl_max_compute_smem_size);
+    func("has_broken_robust", profile.has_broken_robust);
+    func("min_ssbo_alignment", profile.min_ssbo_alignment);
+    func("max_user_clip_distances", profile.max_user_clip_distances);
+}
+
+/// Calls func with the name and the value of every field of host_info
+template <typename HostInfoType, typename Func>
+void VisitHostTranslateInfo(HostInfoType& host_info, Func&& func) {
+    func("support_float64", host_info.support_float64);
+    func("support_float16", host_info.support_float16);
+    func("support_int64", host_info.support_int64);
+    func("needs_demote_reorder", host_info.needs_demote_reorder);
+    func("support_snorm_render_buffer", host_info.support_snorm_render_buffer);
+    func("support_viewport_index_layer", host_info.support_viewport_index_layer);
+    func("min_ssbo_alignment", host_info.min_ssbo_alignment);
+    func("support_geometry_shader_passthrough", host_info.support_geometry_shader_passthrough);
+    func("support_conditional_barrier", host_info.support_conditional_barrier);
+}
+
+constexpr std::string_view PROFILE_PREFIX = "profile";
+constexpr std::string_view HOST_INFO_PREFIX = "host_info";
+constexpr std::string_view SETTINGS_PREFIX = "settings";
+constexpr std::string_view RESOLUTION_SETUP_NAME = "resolution_setup";
+constexpr std::string_view LOOP_SAFETY_CHECKS_NAME = "disable_shader_loop_safety_checks";
+
+template <size_t N>
+constexpr size_t NUM_BITSET_WORDS = (N + 63) / 64;
+
+class InfoWriter {
+public:
+    explicit InfoWriter(std::ostream& file_) : file{file_} {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void operator()(const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <size_t N>
+    void operator()(const std::bitset<N>& bits) {
+        // The layout of std::bitset is unspecified, write it as words
+        for (size_t word = 0; word < NUM_BITSET_WORDS<N>; ++word) {
+            const u64 value{((bits >> (word * 64)) & std::bitset<N>{~0ULL}).to_ullong()};
+            (*this)(value);
+        }
+    }
+
+    template <typename Key, typename Value>
+    void operator()(const std::map<Key, Value>& map) {
+        (*this)(static_cast<u64>(map.size()));
+        for (const auto& [key, value] : map) {
+            (*this)(key);
+            (*this)(value);
+        }
+    }
+
+    template <typename T, size_t N>
+    void operator()(const boost::container::static_vector<T, N>& vector) {
+        WriteRange(vector);
+    }
+
+    template <typename T, size_t N>
+    void operator()(const boost::container::small_vector<T, N>& vector) {
+        WriteRange(vector);
+    }
+
+private:
+    template <typename Range>
+    void WriteRange(const Range& range) {
+        static_assert(std::is_trivially_copyable_v<typename Range::value_type>);
+        (*this)(static_cast<u64>(range.size()));
+        file.write(reinterpret_cast<const char*>(range.data()),
+                   range.size() * sizeof(typename Range::value_type));
+    }
+
+    std::ostream& file;
+};
+
+class InfoReader {
+public:
+    explicit InfoReader(std::istream& file_) : file{file_} {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void operator()(T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+
+    template <size_t N>
+    void operator()(std::bitset<N>& bits) {
+        bits.reset();
+        for (size_t word = 0; word < NUM_BITSET_WORDS<N>; ++word) {
+            u64 value{};
+            (*this)(value);
+            bits |= std::bitset<N>{value} << (word * 64);
+        }
+    }
+
+    template <typename Key, typename Value>
+    void operator()(std::map<Key, Value>& map) {
+        map.clear();
+        const u64 size{ReadSize()};
+        for (u64 i = 0; i < size && file; ++i) {
+            Key key{};
+            Value value{};
+            (*this)(key);
+            (*this)(value);
+            map.emplace(key, value);
+        }
+    }
+
+    template <typename T, size_t N>
+    void operator()(boost::container::static_vector<T, N>& vector) {
+        ReadRange(vector, N);
+    }
+
+    template <typename T, size_t N>
+    void operator()(boost::container::small_vector<T, N>& vector) {
+        ReadRange(vector, std::numeric_limits<u64>::max());
+    }
+
+private:
+    [[nodiscard]] u64 ReadSize() {
+        u64 size{};
+        (*this)(size);
+        return file ? size : 0;
+    }
+
+    template <typename Range>
+    void ReadRange(Range& range, u64 capacity) {
+        range.clear();
+        const u64 size{ReadSize()};
+        if (size > capacity) {
+            file.setstate(std::ios_base::failbit);
+            return;
+        }
+        // Read one element at a time, a corrupted size fails the stream before allocating much
+        for (u64 i = 0; i < size && file; ++i) {
+            typename Range::value_type value{};
+            (*this)(value);
+            range.push_back(value);
+        }
+    }
+
+    std::istream& file;
+};
+} // Anonymous namespace
+
+u64 RecompilerFingerprint(const Profile& profile, const HostTranslateInfo& host_info) {
+    std::string data;
+    const auto append{[&data](const auto& value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }};
+    const auto append_field{[&append](std::string_view, const auto& value) { append(value); }};
+    append(RECOMPILER_VERSION);
+    VisitProfile(profile, append_field);
+    VisitHostTranslateInfo(host_info, append_field);
+
+    // Settings read by the translation passes and the backends
+    const auto& resolution{Settings::values.resolution_info};
+    append(resolution.active);
+    append(resolution.up_scale);
+    append(resolution.down_shift);
+    append(resolution.up_factor);
+    append(resolution.down_factor);
+    append(Settings::values.disable_shader_loop_safety_checks.GetValue());
+
+    return Common::CityHash64(data.data(), data.size());
+}
+
+std::string SerializeRecompilerTarget(const Profile& profile, const HostTranslateInfo& host_info) {
+    std::string text;
+    const auto write_field{[&text](std::string_view prefix) {
+        return [&text, prefix](std::string_view name, const auto& value) {
+            text += fmt::format("{}.{} = {}\n", prefix, name, static_cast<u64>(value));
+        };
+    }};
+    VisitProfile(profile, write_field(PROFILE_PREFIX));
+    VisitHostTranslateInfo(host_info, write_field(HOST_INFO_PREFIX));
+    write_field(SETTINGS_PREFIX)(RESOLUTION_SETUP_NAME,
+                                 Settings::values.resolution_setup.GetValue());
+    write_field(SETTINGS_PREFIX)(LOOP_SAFETY_CHECKS_NAME,
+                                 Settings::values.disable_shader_loop_safety_checks.GetValue());
+    return text;
+}
+
+bool DeserializeRecompilerTarget(std::string_view text, Profile& profile,
+                                 HostTranslateInfo& host_info) {
+    std::istringstream stream{std::string{text}};
+    std::string line;
+    while (std::getline(stream, line)) {
+        line = Common::StripSpaces(line);
+        if (line.empty() || line.starts_with('#')) {
+            continue;
+        }
+        const size_t separator{line.find('=')};
+        if (separator == std::string::npos) {
+            return false;
+        }
+        const std::string name{Common::StripSpaces(line.substr(0, separator))};
+        const std::string value_text{Common::StripSpaces(line.substr(separator + 1))};
+        u64 value{};
+        const char* const value_end{value_text.data() + value_text.size()};
+        const auto [end, error]{std::from_chars(value_text.data(), value_end, value)};
+        if (error != std::errc{} || end != value_end) {
+            return false;
+        }
+
+        bool found{false};
+        bool in_range{false};
+        const auto read_field{[&](std::string_view prefix) {
+            return [&, prefix](std::string_view field_name, auto& field) {
+                using T = std::remove_reference_t<decltype(field)>;
+                if (found || name != fmt::format("{}.{}", prefix, field_name)) {
+                    return;
+                }
+                found = true;
+                in_range = std::is_same_v<T, bool> ? value <= 1
+                                                   : value <= std::numeric_limits<T>::max();
+                field = static_cast<T>(value);
+            };
+        }};
+        VisitProfile(profile, read_field(PROFILE_PREFIX));
+        VisitHostTranslateInfo(host_info, read_field(HOST_INFO_PREFIX));
+
+        // Settings are applied globally, the rescaling info is derived from the resolution setup
+        u32 resolution_setup{};
+        bool disable_loop_safety_checks{};
+        read_field(SETTINGS_PREFIX)(RESOLUTION_SETUP_NAME, resolution_setup);
+        if (found && in_range && name.ends_with(RESOLUTION_SETUP_NAME)) {
+            Settings::values.resolution_setup.SetValue(
+                static_cast<Settings::ResolutionSetup>(resolution_setup));
+            Settings::UpdateRescalingInfo();
+        }
+        read_field(SETTINGS_PREFIX)(LOOP_SAFETY_CHECKS_NAME, disable_loop_safety_checks);
+        if (found && in_range && name.ends_with(LOOP_SAFETY_CHECKS_NAME)) {
+            Settings::values.disable_shader_loop_safety_checks.SetValue(
+                disable_loop_safety_checks);
+        }
+        if (!found || !in_range) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SerializeInfo(std::ostream& file, const Info& info) {
+    VisitInfo(info, InfoWriter{file});
+}
+
+void DeserializeInfo(std::istream& file, Info& info) {
+    VisitInfo(info, InfoReader{file});
+}
+
+} // namespace Shader
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "common/common_types.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/shader_info.h"
+
+// Helpers for backends caching the output of the recompiler on disk, so shaders translated on a
+// previous boot don't have to go through the recompiler again.
+namespace Shader {
+
+/// Version of the output of the recompiler. Increase it when a change to the recompiler changes
+/// the code or the info it generates for a shader, or the serialized layout of Info.
+constexpr u32 RECOMPILER_VERSION = 1;
+
+/**
+ * Returns a hash identifying the output of the recompiler on this host: the recompiler version,
+ * the profile, the host info and the settings read by the recompiler. Host shaders cached with
+ * another fingerprint have to be translated again.
+ */
+[[nodiscard]] u64 RecompilerFingerprint(const Profile& profile,
+                                        const HostTranslateInfo& host_info);
+
+/**
+ * Returns the profile, the host info and the settings read by the recompiler as text, one
+ * "name = value" line per field. Offline tools use it to translate shaders for this host.
+ */
+[[nodiscard]] std::string SerializeRecompilerTarget(const Profile& profile,
+                                                    const HostTranslateInfo& host_info);
+
+/**
+ * Applies text written by SerializeRecompilerTarget to profile, host_info and the global
+ * settings. Fields missing from the text are left untouched.
+ * @returns False when a line is malformed, names an unknown field or has an out of range value
+ */
+[[nodiscard]] bool DeserializeRecompilerTarget(std::string_view text, Profile& profile,
+                                               HostTranslateInfo& host_info);
+
+/// Writes info to a stream
+void SerializeInfo(std::ostream& file, const Info& info);
+
+/// Reads info written by SerializeInfo, the stream fails on malformed data
+void DeserializeInfo(std::istream& file, Info& info);
+
+} // namespace Shader
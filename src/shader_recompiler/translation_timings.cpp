@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "shader_recompiler/translation_timings.h"
+
+namespace Shader {
+
+namespace {
+thread_local TranslationTimings* thread_timings{};
+} // Anonymous namespace
+
+std::string_view NameOf(TranslationStep step) {
+    switch (step) {
+    case TranslationStep::ControlFlow:
+        return "ControlFlow";
+    case TranslationStep::Decode:
+        return "Decode";
+    case TranslationStep::Lowering:
+        return "Lowering";
+    case TranslationStep::SsaRewrite:
+        return "SsaRewrite";
+    case TranslationStep::ConstantPropagation:
+        return "ConstantPropagation";
+    case TranslationStep::GlobalValueNumbering:
+        return "GlobalValueNumbering";
+    case TranslationStep::Position:
+        return "Position";
+    case TranslationStep::GlobalMemoryToStorageBuffer:
+        return "GlobalMemoryToStorageBuffer";
+    case TranslationStep::Texture:
+        return "Texture";
+    case TranslationStep::Rescaling:
+        return "Rescaling";
+    case TranslationStep::DeadCodeElimination:
+        return "DeadCodeElimination";
+    case TranslationStep::Verification:
+        return "Verification";
+    case TranslationStep::CollectShaderInfo:
+        return "CollectShaderInfo";
+    case TranslationStep::Layer:
+        return "Layer";
+    case TranslationStep::VendorWorkaround:
+        return "VendorWorkaround";
+    case TranslationStep::DualVertexMerge:
+        return "DualVertexMerge";
+    case TranslationStep::Emit:
+        return "Emit";
+    }
+    return "Unknown";
+}
+
+void SetThreadTranslationTimings(TranslationTimings* timings) {
+    thread_timings = timings;
+}
+
+ScopedTranslationTimer::ScopedTranslationTimer(TranslationStep step_)
+    : timings{thread_timings}, step{step_} {
+    if (timings) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedTranslationTimer::~ScopedTranslationTimer() {
+    if (timings) {
+        timings->steps[static_cast<size_t>(step)] += std::chrono::steady_clock::now() - start;
+    }
+}
+
+} // namespace Shader
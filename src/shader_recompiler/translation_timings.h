@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string_view>
+
+#include "common/common_types.h"
+
+namespace Shader {
+
+/// Steps of the translation of a shader, in the order they run
+enum class TranslationStep : u32 {
+    /// Discovery of the control flow graph of the guest program
+    ControlFlow,
+    /// Decoding of the Maxwell instructions into structured IR
+    Decode,
+    /// Lowering of the operations the host doesn't support, before the SSA rewrite
+    Lowering,
+    SsaRewrite,
+    ConstantPropagation,
+    GlobalValueNumbering,
+    Position,
+    GlobalMemoryToStorageBuffer,
+    Texture,
+    Rescaling,
+    DeadCodeElimination,
+    Verification,
+    CollectShaderInfo,
+    Layer,
+    VendorWorkaround,
+    /// Merging of the two programs of a dual vertex shader
+    DualVertexMerge,
+    /// Emission of the host shader by a backend
+    Emit,
+};
+constexpr size_t NUM_TRANSLATION_STEPS = static_cast<size_t>(TranslationStep::Emit) + 1;
+
+[[nodiscard]] std::string_view NameOf(TranslationStep step);
+
+/// Host time spent in each step of the translation of shaders
+struct TranslationTimings {
+    std::array<std::chrono::nanoseconds, NUM_TRANSLATION_STEPS> steps{};
+
+    TranslationTimings& operator+=(const TranslationTimings& rhs) {
+        for (size_t i = 0; i < NUM_TRANSLATION_STEPS; ++i) {
+            steps[i] += rhs.steps[i];
+        }
+        return *this;
+    }
+};
+
+/// Makes the recompiler add the time of each step it runs on the calling thread to timings.
+/// Pass null to stop timing, which is the default.
+void SetThreadTranslationTimings(TranslationTimings* timings);
+
+/// Adds the time until its destruction to a step of the timings of the calling thread
+class ScopedTranslationTimer {
+public:
+    explicit ScopedTranslationTimer(TranslationStep step);
+    ~ScopedTranslationTimer();
+
+    ScopedTranslationTimer(const ScopedTranslationTimer&) = delete;
+    ScopedTranslationTimer& operator=(const ScopedTranslationTimer&) = delete;
+
+private:
+    TranslationTimings* timings;
+    TranslationStep step;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Shader
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
+#include "common/common_types.h"
+#include "tests/audio_core/simd_levels.h"
+
+using namespace AudioCore::Renderer;
+
+namespace {
+
+// PCM float data sources pick one channel of the interleaved input and convert it to 16-bit,
+// saturating the samples past full scale.
+void ReferencePcmFloat(std::vector<s16>& output, const std::vector<f32>& input,
+                       u32 channel_count, u32 channel, u32 sample_count) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    for (u32 i = 0; i < sample_count; i++) {
+        auto sample{static_cast<s32>(input[i * channel_count + channel] *
+                                     std::numeric_limits<s16>::max())};
+        output[i] = static_cast<s16>(std::clamp(sample, min, max));
+    }
+}
+
+// ADPCM frames start with a header byte selecting the coefficient pair and the scale, followed by
+// 4-bit codes. Each sample is predicted from the two previous ones, the history carries them over
+// to the next frame and the next call.
+void ReferenceAdpcm(std::vector<s16>& output, const std::vector<u8>& input, u32 frame_count,
+                    const DecodeKernels::AdpcmCoefficients& coefficients,
+                    std::array<s16, 2>& history) {
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+    u32 read_index{0};
+    u32 write_index{0};
+    for (u32 frame = 0; frame < frame_count; frame++) {
+        const u8 header{input[read_index++]};
+        const u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
+        const u8 scale{static_cast<u8>(header & 0xFU)};
+        const s32 coeff0{coefficients[coeff_index * 2 + 0]};
+        const s32 coeff1{coefficients[coeff_index * 2 + 1]};
+        const auto decode_sample = [&](const s32 code) -> s16 {
+            const auto xn = code * (1 << scale);
+            const auto prediction = coeff0 * history[0] + coeff1 * history[1];
+            const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
+            const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
+            history[1] = history[0];
+            history[0] = static_cast<s16>(saturated);
+            return history[0];
+        };
+        for (u32 i = 0; i < DecodeKernels::AdpcmSamplesPerFrame / 2; i++) {
+            const auto code0{Steps[(input[read_index] >> 4) & 0xF]};
+            const auto code1{Steps[input[read_index] & 0xF]};
+            read_index++;
+            output[write_index++] = decode_sample(code0);
+            output[write_index++] = decode_sample(code1);
+        }
+    }
+}
+
+constexpr std::array<u32, 8> SampleCounts{0, 1, 3, 7, 8, 13, 160, 240};
+
+void CheckPcm(const DecodeKernels::Table& table, std::mt19937& rng) {
+    std::uniform_int_distribution<s32> int_dist(std::numeric_limits<s16>::min(),
+                                                std::numeric_limits<s16>::max());
+    // Past full scale to exercise the saturation
+    std::uniform_real_distribution<f32> float_dist(-1.5f, 1.5f);
+    for (u32 channel_count = 1; channel_count <= 6; channel_count++) {
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            for (const u32 sample_count : SampleCounts) {
+                std::vector<s16> int_input(sample_count * channel_count);
+                std::vector<f32> float_input(sample_count * channel_count);
+                for (size_t i = 0; i < int_input.size(); i++) {
+                    int_input[i] = static_cast<s16>(int_dist(rng));
+                    float_input[i] = float_dist(rng);
+                }
+
+                std::vector<s16> expected(sample_count);
+                std::vector<s16> actual(sample_count);
+                for (u32 i = 0; i < sample_count; i++) {
+                    expected[i] = int_input[i * channel_count + channel];
+                }
+                table.pcm_int16(actual.data(), int_input.data(), channel_count, channel,
+                                sample_count);
+                REQUIRE(actual == expected);
+
+                ReferencePcmFloat(expected, float_input, channel_count, channel, sample_count);
+                table.pcm_float(actual.data(), float_input.data(), channel_count, channel,
+                                sample_count);
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+}
+
+void CheckAdpcm(const DecodeKernels::Table& table, std::mt19937& rng) {
+    // Coefficients are Q11, larger ones than these overflow the 32-bit prediction
+    std::uniform_int_distribution<s32> coefficient_dist(-0x4000, 0x3FFF);
+    std::uniform_int_distribution<s32> history_dist(std::numeric_limits<s16>::min(),
+                                                    std::numeric_limits<s16>::max());
+    std::uniform_int_distribution<u32> byte_dist(0, 0xFF);
+    for (const u32 frame_count : {1U, 2U, 5U, 17U}) {
+        for (u32 iteration = 0; iteration < 16; iteration++) {
+            DecodeKernels::AdpcmCoefficients coefficients{};
+            for (auto& coefficient : coefficients) {
+                coefficient = static_cast<s16>(coefficient_dist(rng));
+            }
+            std::vector<u8> input(frame_count * DecodeKernels::AdpcmFrameSize);
+            for (u32 i = 0; i < input.size(); i++) {
+                input[i] = static_cast<u8>(byte_dist(rng));
+                if (i % DecodeKernels::AdpcmFrameSize == 0) {
+                    // Valid headers only, the reference reads past the table otherwise
+                    input[i] &= 0x7F;
+                }
+            }
+
+            const std::array<s16, 2> start_history{
+                static_cast<s16>(history_dist(rng)),
+                static_cast<s16>(history_dist(rng)),
+            };
+            std::vector<s16> expected(frame_count * DecodeKernels::AdpcmSamplesPerFrame);
+            std::vector<s16> actual(expected.size());
+            auto expected_history{start_history};
+            auto actual_history{start_history};
+            ReferenceAdpcm(expected, input, frame_count, coefficients, expected_history);
+            table.adpcm(actual.data(), input.data(), frame_count, coefficients, actual_history);
+            REQUIRE(actual == expected);
+            REQUIRE(actual_history == expected_history);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DecodeKernels[BitExact]", "[audio_core]") {
+    std::mt19937 rng(0x4445430A);
+    Tests::Audio::ForEachSupportedLevel([&](AudioCore::SimdLevel level) {
+        const DecodeKernels::Table& table = DecodeKernels::GetTable(level);
+        CheckPcm(table, rng);
+        CheckAdpcm(table, rng);
+    });
+}
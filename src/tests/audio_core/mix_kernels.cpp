@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+#include "tests/audio_core/simd_levels.h"
+
+using namespace AudioCore::Renderer;
+
+namespace {
+
+// Mix and MixRamp accumulate the input weighted in Q fixed point, stepping the volume by the ramp
+// after each sample. Returns the last weighted sample, MixRamp stores it for the depop commands.
+template <size_t Q>
+s32 ReferenceMixRamp(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                     f32 ramp_, u32 sample_count) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    Common::FixedPoint<64 - Q, Q> sample{0};
+    for (u32 i = 0; i < sample_count; i++) {
+        sample = input[i] * volume;
+        output[i] = (output[i] + sample).to_int();
+        volume += ramp;
+    }
+    return sample.to_int();
+}
+
+// Volume and VolumeRamp overwrite the output with the input scaled by the gain.
+template <size_t Q>
+void ReferenceGainRamp(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                       f32 ramp_, u32 sample_count) {
+    Common::FixedPoint<64 - Q, Q> gain{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    for (u32 i = 0; i < sample_count; i++) {
+        output[i] = (input[i] * gain).to_int();
+        gain += ramp;
+    }
+}
+
+// Plain volumes, exact fractions which exercise the rounding, and volumes large enough to leave
+// the 32-bit vector range at Q23.
+constexpr std::array<std::pair<f32, f32>, 9> VolumeRamps{{
+    {0.0f, 0.0f},
+    {1.0f, 0.0f},
+    {0.5f, 0.0f},
+    {0.7071f, 0.0f},
+    {0.25f, 0.003f},
+    {1.0f, -1.0f / 240.0f},
+    {-0.8f, 0.01f},
+    {300.0f, 0.0f},
+    {0.1f, 2.5f},
+}};
+
+template <size_t Q>
+void CheckLevel(const MixKernels::Table& table, std::mt19937& rng) {
+    std::uniform_int_distribution<s32> dist(-0x800000, 0x7FFFFF);
+    for (const u32 sample_count : {0U, 1U, 3U, 7U, 8U, 13U, 160U, 240U}) {
+        for (const auto& [volume, ramp] : VolumeRamps) {
+            std::vector<s32> input(sample_count);
+            std::vector<s32> output(sample_count);
+            for (u32 i = 0; i < sample_count; i++) {
+                input[i] = dist(rng);
+                output[i] = dist(rng);
+            }
+            const s64 fixed_volume = MixKernels::ToFixed<Q>(volume);
+            const s64 fixed_ramp = MixKernels::ToFixed<Q>(ramp);
+
+            std::vector<s32> expected = output;
+            std::vector<s32> actual = output;
+            ReferenceMixRamp<Q>(expected, input, volume, 0.0f, sample_count);
+            table.mix(actual.data(), input.data(), fixed_volume, sample_count, Q);
+            REQUIRE(actual == expected);
+
+            expected = output;
+            actual = output;
+            const s32 expected_last = ReferenceMixRamp<Q>(expected, input, volume, ramp,
+                                                          sample_count);
+            const s32 actual_last = table.mix_ramp(actual.data(), input.data(), fixed_volume,
+                                                   fixed_ramp, sample_count, Q);
+            REQUIRE(actual == expected);
+            REQUIRE(actual_last == expected_last);
+
+            ReferenceGainRamp<Q>(expected, input, volume, ramp, sample_count);
+            table.gain_ramp(actual.data(), input.data(), fixed_volume, fixed_ramp, sample_count,
+                            Q);
+            REQUIRE(actual == expected);
+
+            // Commands may use the same mix buffer as input and output.
+            expected = input;
+            actual = input;
+            ReferenceMixRamp<Q>(expected, std::vector<s32>(input), volume, ramp, sample_count);
+            table.mix_ramp(actual.data(), actual.data(), fixed_volume, fixed_ramp, sample_count,
+                           Q);
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MixKernels[BitExact]", "[audio_core]") {
+    std::mt19937 rng(0x4D49580A);
+    Tests::Audio::ForEachSupportedLevel([&](AudioCore::SimdLevel level) {
+        const MixKernels::Table& table = MixKernels::GetTable(level);
+        CheckLevel<15>(table, rng);
+        CheckLevel<23>(table, rng);
+    });
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/resample/resample.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+using AudioCore::SimdLevel;
+using AudioCore::SrcQuality;
+
+TEST_CASE("Resample[BitExact]", "[audio_core]") {
+    constexpr std::array Levels{SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::NEON};
+    // Ratios picking each of the three coefficient tables, and the identity.
+    constexpr std::array Ratios{0.5f, 0.6666f, 1.0f, 1.0884f, 1.25f, 1.5f, 2.0f, 3.7f};
+
+    std::mt19937 rng(0x5253504C);
+    std::uniform_int_distribution<s32> sample_dist(-0x8000, 0x7FFF);
+    std::uniform_int_distribution<s64> fraction_dist(0, 0x7FFF);
+
+    std::vector<s16> input(0x400);
+    for (s16& sample : input) {
+        sample = static_cast<s16>(sample_dist(rng));
+    }
+    // Full scale samples exercise the largest products.
+    input[10] = -0x8000;
+    input[11] = 0x7FFF;
+
+    for (const SimdLevel level : Levels) {
+        if (!AudioCore::IsSimdLevelSupported(level)) {
+            continue;
+        }
+        for (const SrcQuality quality : {SrcQuality::Medium, SrcQuality::High}) {
+            for (const f32 ratio_value : Ratios) {
+                for (const u32 samples_to_write : {1U, 3U, 4U, 7U, 8U, 13U, 160U, 240U}) {
+                    const Common::FixedPoint<49, 15> ratio{ratio_value};
+                    const auto start = Common::FixedPoint<49, 15>::from_base(fraction_dist(rng));
+
+                    auto expected_fraction = start;
+                    std::vector<s32> expected(samples_to_write);
+                    AudioCore::Renderer::Resample(expected, input, ratio, expected_fraction,
+                                                  samples_to_write, quality, SimdLevel::Scalar);
+
+                    auto actual_fraction = start;
+                    std::vector<s32> actual(samples_to_write);
+                    AudioCore::Renderer::Resample(actual, input, ratio, actual_fraction,
+                                                  samples_to_write, quality, level);
+
+                    REQUIRE(actual == expected);
+                    REQUIRE(actual_fraction == expected_fraction);
+                }
+            }
+        }
+    }
+}
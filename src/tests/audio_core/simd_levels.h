@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "audio_core/common/simd_level.h"
+
+namespace Tests::Audio {
+
+constexpr std::array SIMD_LEVELS{
+    AudioCore::SimdLevel::Scalar,
+    AudioCore::SimdLevel::SSE41,
+    AudioCore::SimdLevel::AVX2,
+    AudioCore::SimdLevel::NEON,
+};
+
+/// Calls func with each SIMD level the host supports, the scalar one included
+template <typename Func>
+void ForEachSupportedLevel(Func&& func) {
+    for (const AudioCore::SimdLevel level : SIMD_LEVELS) {
+        if (AudioCore::IsSimdLevelSupported(level)) {
+            func(level);
+        }
+    }
+}
+
+} // namespace Tests::Audio
@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_executor.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "audio_core/renderer/command/performance/performance.h"
+#include "common/common_types.h"
+
+using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+using AudioCore::ADSP::AudioRenderer::VoiceExecutor;
+using AudioCore::Renderer::CommandId;
+using AudioCore::Renderer::CommandListHeader;
+using AudioCore::Renderer::ICommand;
+using AudioCore::Renderer::PerformanceCommand;
+using AudioCore::Renderer::PerformanceState;
+
+namespace {
+constexpr u32 MixBufferCount = 4;
+constexpr u32 BufferCount = MixBufferCount + AudioCore::MaxChannels;
+constexpr u32 SampleCount = 240;
+
+struct TestCommand : ICommand {
+    void Dump(const CommandListProcessor&, std::string&) override {}
+    bool Verify(const CommandListProcessor&) override {
+        return true;
+    }
+};
+
+/// Writes a voice channel buffer, like a data source command
+struct SourceCommand : TestCommand {
+    void Process(const CommandListProcessor& processor) override {
+        auto output{processor.mix_buffers.subspan(output_index * processor.sample_count,
+                                                  processor.sample_count)};
+        for (u32 i = 0; i < processor.sample_count; i++) {
+            output[i] = static_cast<s32>(node_id * 1000 + i);
+        }
+    }
+    u32 output_index{};
+};
+
+/// Accumulates a voice channel buffer into a mix buffer
+struct MixCommand : TestCommand {
+    void Process(const CommandListProcessor& processor) override {
+        auto output{processor.mix_buffers.subspan(output_index * processor.sample_count,
+                                                  processor.sample_count)};
+        auto input{processor.mix_buffers.subspan(input_index * processor.sample_count,
+                                                 processor.sample_count)};
+        for (u32 i = 0; i < processor.sample_count; i++) {
+            output[i] += input[i] * static_cast<s32>(output_index + 1);
+        }
+    }
+    u32 input_index{};
+    u32 output_index{};
+};
+
+/// Order the recording commands ran in, by id
+struct Recorder {
+    void Record(u32 id) {
+        std::scoped_lock lock{mutex};
+        order.push_back(id);
+    }
+
+    std::mutex mutex;
+    std::vector<u32> order;
+};
+
+/// Records when it runs
+struct OrderCommand : TestCommand {
+    void Process(const CommandListProcessor&) override {
+        recorder->Record(id);
+    }
+    Recorder* recorder{};
+    u32 id{};
+};
+
+/// Writes a voice channel buffer and records when it runs
+struct RecordedSourceCommand : SourceCommand {
+    void Process(const CommandListProcessor& processor) override {
+        SourceCommand::Process(processor);
+        recorder->Record(id);
+    }
+    Recorder* recorder{};
+    u32 id{};
+};
+
+/// Performance command recording when it runs instead of writing the time
+struct RecordedPerformanceCommand : PerformanceCommand {
+    void Dump(const CommandListProcessor&, std::string&) override {}
+    void Process(const CommandListProcessor&) override {
+        recorder->Record(id);
+    }
+    bool Verify(const CommandListProcessor&) override {
+        return true;
+    }
+    Recorder* recorder{};
+    u32 id{};
+};
+
+class CommandListBuilder {
+public:
+    CommandListBuilder() : storage(std::make_unique<u8[]>(StorageSize)) {
+        position = storage.get() + sizeof(CommandListHeader);
+    }
+
+    template <typename T>
+    T& Add(CommandId type, u32 node_id) {
+        auto& command{*new (position) T{}};
+        command.magic = AudioCore::Renderer::CommandMagic;
+        command.enabled = true;
+        command.type = type;
+        command.size = static_cast<s16>((sizeof(T) + 15) & ~size_t{15});
+        command.node_id = node_id;
+        position += command.size;
+        count++;
+        return command;
+    }
+
+    u8* Commands() const {
+        return storage.get() + sizeof(CommandListHeader);
+    }
+
+    CommandListHeader* Header() const {
+        return reinterpret_cast<CommandListHeader*>(storage.get());
+    }
+
+    u64 Size() const {
+        return static_cast<u64>(position - storage.get());
+    }
+
+    u32 count{};
+
+private:
+    static constexpr size_t StorageSize = 1 << 20;
+    std::unique_ptr<u8[]> storage;
+    u8* position{};
+};
+
+/// Runs the list like CommandListProcessor::Process, without a system
+void RunList(const CommandListBuilder& list, VoiceExecutor& executor, std::span<s32> buffers) {
+    CommandListProcessor processor{};
+    processor.header = list.Header();
+    processor.commands = list.Commands();
+    processor.commands_buffer_size = list.Size();
+    processor.command_count = list.count;
+    processor.sample_count = SampleCount;
+    processor.buffer_count = BufferCount;
+    processor.mix_buffers = buffers;
+
+    std::string dump;
+    u32 index{};
+    while (index < list.count) {
+        u32 count{executor.Process(processor, list.count - index, dump)};
+        if (count == 0) {
+            auto& command{*reinterpret_cast<ICommand*>(processor.commands)};
+            processor.ProcessCommand(command);
+            processor.commands += command.size;
+            processor.processed_command_count++;
+            count = 1;
+        }
+        index += count;
+    }
+    REQUIRE(processor.processed_command_count == list.count);
+}
+} // Anonymous namespace
+
+TEST_CASE("VoiceExecutor[MatchesSerial]", "[audio_core]") {
+    constexpr u32 VoiceCount = 40;
+    constexpr u32 ChannelCount = 2;
+
+    Recorder recorder;
+    u32 next_id{};
+    CommandListBuilder list;
+    const auto add_order{[&](CommandId type, u32 node_id) {
+        auto& command{list.Add<OrderCommand>(type, node_id)};
+        command.recorder = &recorder;
+        command.id = next_id++;
+        return command.id;
+    }};
+    const auto add_performance{[&](u32 node_id, PerformanceState state) {
+        auto& command{list.Add<RecordedPerformanceCommand>(CommandId::Performance, node_id)};
+        command.recorder = &recorder;
+        command.id = next_id++;
+        command.state = state;
+        return command.id;
+    }};
+
+    // Laid out like CommandGenerator::GenerateVoiceCommands with performance metrics enabled.
+    // The recorded commands of each voice channel, in the order they have to run in
+    std::vector<std::vector<u32>> chains;
+    std::vector<u32> depops;
+    const u32 clear{add_order(CommandId::ClearMixBuffer, 1000)};
+    for (u32 voice = 0; voice < VoiceCount; voice++) {
+        const u32 voice_start{add_performance(voice, PerformanceState::Start)};
+        for (u32 channel = 0; channel < ChannelCount; channel++) {
+            auto& chain{chains.emplace_back()};
+            if (channel == 0) {
+                chain.push_back(voice_start);
+            }
+            chain.push_back(add_performance(voice, PerformanceState::Start));
+            depops.push_back(add_order(CommandId::DepopPrepare, voice));
+
+            auto& source{list.Add<RecordedSourceCommand>(CommandId::DataSourcePcmInt16Version2,
+                                                         voice)};
+            source.output_index = MixBufferCount + channel;
+            source.recorder = &recorder;
+            source.id = next_id++;
+            chain.push_back(source.id);
+            chain.push_back(add_performance(voice, PerformanceState::Stop));
+
+            chain.push_back(add_performance(voice, PerformanceState::Start));
+            for (u32 mix = 0; mix < MixBufferCount; mix++) {
+                auto& command{list.Add<MixCommand>(CommandId::MixRamp, voice)};
+                command.input_index = MixBufferCount + channel;
+                command.output_index = mix;
+            }
+            chain.push_back(add_performance(voice, PerformanceState::Stop));
+        }
+        chains.back().push_back(add_performance(voice, PerformanceState::Stop));
+    }
+    const u32 depop_for_mix{add_order(CommandId::DepopForMixBuffers, 1001)};
+
+    std::vector<s32> serial(BufferCount * SampleCount);
+    VoiceExecutor serial_executor{0};
+    RunList(list, serial_executor, serial);
+    const std::vector<u32> serial_order{std::move(recorder.order)};
+
+    recorder.order.clear();
+    std::vector<s32> parallel(BufferCount * SampleCount);
+    VoiceExecutor parallel_executor{3};
+    RunList(list, parallel_executor, parallel);
+    const std::vector<u32> parallel_order{std::move(recorder.order)};
+
+    for (u32 i = 0; i < MixBufferCount * SampleCount; i++) {
+        REQUIRE(parallel[i] == serial[i]);
+    }
+
+    // Serially, the commands run in list order
+    REQUIRE(serial_order.size() == next_id);
+    for (u32 id = 0; id < next_id; id++) {
+        REQUIRE(serial_order[id] == id);
+    }
+
+    // In parallel, the depop commands run before the voices, and the performance commands around
+    // the commands of their voice channel in list order. Only the order of the chains can differ
+    REQUIRE(parallel_order.size() == next_id);
+    REQUIRE(parallel_order.front() == clear);
+    REQUIRE(std::ranges::equal(std::span{parallel_order}.subspan(1, depops.size()), depops));
+    REQUIRE(parallel_order.back() == depop_for_mix);
+    for (const auto& chain : chains) {
+        std::vector<u32> chain_order;
+        std::ranges::copy_if(parallel_order, std::back_inserter(chain_order), [&](u32 id) {
+            return std::ranges::find(chain, id) != chain.end();
+        });
+        REQUIRE(chain_order == chain);
+    }
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/async_reader.h"
+#include "common/fs/file.h"
+
+using Common::FS::AsyncReader;
+
+namespace {
+constexpr size_t FileSize = 0x40000;
+constexpr size_t NumReads = AsyncReader::MaxInFlightReads * 3;
+
+/// Counts completed reads so the test can wait for all of them
+class Completions {
+public:
+    void Add() {
+        std::scoped_lock lk{mutex};
+        ++count;
+        condition.notify_all();
+    }
+
+    void Wait(size_t expected) {
+        std::unique_lock lk{mutex};
+        condition.wait(lk, [&] { return count >= expected; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t count{};
+};
+
+struct TestFile {
+    TestFile() {
+        data.resize(FileSize);
+        std::mt19937 rng{0xA5F1};
+        for (u8& value : data) {
+            value = static_cast<u8>(rng());
+        }
+        path = std::filesystem::temp_directory_path() / "citron_async_reader_test.bin";
+        {
+            std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+            stream.write(reinterpret_cast<const char*>(data.data()),
+                         static_cast<std::streamsize>(data.size()));
+        }
+        file = std::make_shared<Common::FS::IOFile>(path, Common::FS::FileAccessMode::Read,
+                                                    Common::FS::FileType::BinaryFile);
+    }
+
+    ~TestFile() {
+        file.reset();
+        std::filesystem::remove(path);
+    }
+
+    std::vector<u8> data;
+    std::filesystem::path path;
+    std::shared_ptr<Common::FS::IOFile> file;
+};
+
+struct Request {
+    s64 offset;
+    std::vector<u8> buffer;
+    size_t bytes_read;
+};
+
+void RunReads(AsyncReader& reader) {
+    TestFile test_file;
+    REQUIRE(test_file.file->IsOpen());
+
+    // More reads than the ring holds at once, some cut short by the end of the file and some
+    // starting past it
+    std::mt19937 rng{0x2EAD};
+    std::vector<Request> requests(NumReads);
+    for (size_t i = 0; i < NumReads; ++i) {
+        const size_t size = 1 + rng() % 0x4000;
+        requests[i].offset = static_cast<s64>(rng() % (FileSize + 0x1000));
+        requests[i].buffer.resize(size);
+        requests[i].bytes_read = ~size_t{};
+    }
+
+    Completions completions;
+    for (Request& request : requests) {
+        reader.Read(test_file.file, request.buffer, request.offset,
+                    [&request, &completions](size_t bytes_read) {
+                        request.bytes_read = bytes_read;
+                        completions.Add();
+                    });
+    }
+    completions.Wait(NumReads);
+
+    for (const Request& request : requests) {
+        const size_t offset = static_cast<size_t>(request.offset);
+        const size_t expected = offset >= FileSize
+                                    ? 0
+                                    : std::min(request.buffer.size(), FileSize - offset);
+        REQUIRE(request.bytes_read == expected);
+        REQUIRE(std::equal(request.buffer.begin(), request.buffer.begin() + expected,
+                           test_file.data.begin() + offset));
+    }
+
+    // Completion callbacks may queue further reads
+    std::vector<u8> first(0x100);
+    std::vector<u8> second(0x100);
+    size_t second_read{};
+    Completions chained;
+    reader.Read(test_file.file, first, 0, [&](size_t) {
+        reader.Read(test_file.file, second, FileSize - 0x80, [&](size_t bytes_read) {
+            second_read = bytes_read;
+            chained.Add();
+        });
+    });
+    chained.Wait(1);
+    REQUIRE(std::equal(first.begin(), first.end(), test_file.data.begin()));
+    REQUIRE(second_read == 0x80);
+    REQUIRE(std::equal(second.begin(), second.begin() + 0x80, test_file.data.end() - 0x80));
+}
+} // Anonymous namespace
+
+TEST_CASE("AsyncReader[ThreadPool]", "[common]") {
+    AsyncReader reader{false};
+    REQUIRE(!reader.IsUsingIoUring());
+    RunReads(reader);
+
+    Completions completions;
+    reader.QueueWork([&completions] { completions.Add(); });
+    completions.Wait(1);
+}
+
+TEST_CASE("AsyncReader[IoUring]", "[common]") {
+    AsyncReader reader;
+    // Hosts without io_uring, or with it disabled, go through the thread pool instead
+    RunReads(reader);
+}
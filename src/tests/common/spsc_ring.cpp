@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/spsc_ring.h"
+
+namespace Common {
+
+TEST_CASE("SPSCRing: In place consumption", "[common]") {
+    SPSCRing<std::vector<u32>, 4> ring;
+    REQUIRE(ring.Empty());
+
+    REQUIRE(ring.EmplaceWait({}, std::vector<u32>{1, 2, 3}));
+    REQUIRE(ring.EmplaceWait({}, 2U, 7U));
+    REQUIRE(ring.WaitReadable({}) == 2);
+
+    std::vector<u32>& front = ring.Front();
+    REQUIRE(front == std::vector<u32>{1, 2, 3});
+    ring.PopFront();
+    REQUIRE(ring.Front() == std::vector<u32>{7, 7});
+    ring.PopFront();
+    REQUIRE(ring.Empty());
+}
+
+TEST_CASE("SPSCRing: Ordering across threads", "[common]") {
+    static constexpr u32 NUM_ELEMENTS = 100000;
+    // Small capacity so both sides keep waiting for each other
+    SPSCRing<u32, 8> ring;
+
+    std::jthread producer{[&ring] {
+        for (u32 i = 0; i < NUM_ELEMENTS; ++i) {
+            ring.EmplaceWait({}, i);
+        }
+    }};
+
+    u32 expected = 0;
+    while (expected < NUM_ELEMENTS) {
+        const size_t count = ring.WaitReadable({});
+        REQUIRE(count > 0);
+        REQUIRE(count <= 8);
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(ring.Front() == expected++);
+            ring.PopFront();
+        }
+    }
+    REQUIRE(ring.Empty());
+}
+
+TEST_CASE("SPSCRing: Stop wakes up the consumer", "[common]") {
+    SPSCRing<u32, 4> ring;
+    std::stop_source stop_source;
+    size_t count = 1;
+
+    std::jthread consumer{[&] { count = ring.WaitReadable(stop_source.get_token()); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop_source.request_stop();
+    consumer.join();
+
+    REQUIRE(count == 0);
+}
+
+TEST_CASE("SPSCRing: Stop wakes up a producer on a full ring", "[common]") {
+    SPSCRing<u32, 4> ring;
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(ring.EmplaceWait({}, i));
+    }
+    std::stop_source stop_source;
+    bool pushed = true;
+
+    std::jthread producer{[&] { pushed = ring.EmplaceWait(stop_source.get_token(), 4U); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop_source.request_stop();
+    producer.join();
+
+    // The element was dropped and the ring is left as it was
+    REQUIRE(!pushed);
+    REQUIRE(ring.WaitReadable({}) == 4);
+    REQUIRE(ring.Front() == 0);
+
+    // Stopped producers don't wait at all
+    REQUIRE(!ring.EmplaceWait(stop_source.get_token(), 5U));
+}
+
+} // namespace Common
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+using Core::Crypto::AESCipher;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+
+namespace {
+std::vector<u8> Pattern(std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(i * 7 + (i >> 8));
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("AESCipher[ECB]", "[core]") {
+    const auto key = Common::HexStringToArray<16>("000102030405060708090a0b0c0d0e0f");
+    const auto plain = Common::HexStringToArray<16>("00112233445566778899aabbccddeeff");
+    const auto expected = Common::HexStringToArray<16>("69c4e0d86a7b0430d8cdb78070b4c55a");
+
+    AESCipher<Key128> cipher(key, Mode::ECB);
+    std::array<u8, 16> result{};
+    cipher.Transcode(plain.data(), plain.size(), result.data(), Op::Encrypt);
+    REQUIRE(result == expected);
+    cipher.Transcode(result.data(), result.size(), result.data(), Op::Decrypt);
+    REQUIRE(result == plain);
+}
+
+TEST_CASE("AESCipher[CTR]", "[core]") {
+    const auto key = Common::HexStringToArray<16>("2b7e151628aed2a6abf7158809cf4f3c");
+    const auto counter = Common::HexStringToArray<16>("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    const auto plain = Common::HexStringToArray<64>(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+    const auto expected = Common::HexStringToArray<64>(
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    cipher.SetIV(counter);
+    std::array<u8, 64> result{};
+    cipher.Transcode(plain.data(), plain.size(), result.data(), Op::Decrypt);
+    REQUIRE(result == expected);
+
+    // The counter carries across the whole block and keeps advancing between calls
+    const auto wrapping = Common::HexStringToArray<16>("fffffffffffffffffffffffffffffff0");
+    const std::vector<u8> data = Pattern(0x1000);
+    std::vector<u8> whole(data.size());
+    cipher.SetIV(wrapping);
+    cipher.Transcode(data.data(), data.size(), whole.data(), Op::Decrypt);
+
+    std::vector<u8> pieces(data.size());
+    cipher.SetIV(wrapping);
+    for (std::size_t offset = 0; offset < data.size(); offset += 0x30) {
+        const std::size_t size = std::min<std::size_t>(0x30, data.size() - offset);
+        cipher.Transcode(data.data() + offset, size, pieces.data() + offset, Op::Decrypt);
+    }
+    REQUIRE(pieces == whole);
+
+    AESCipher<Key128> ecb(key, Mode::ECB);
+    for (std::size_t block = 0; block < data.size() / 16; ++block) {
+        std::array<u8, 16> keystream = wrapping;
+        const u32 low = 0xfffffff0U + static_cast<u32>(block);
+        for (std::size_t i = 0; i < 4; ++i) {
+            keystream[15 - i] = static_cast<u8>(low >> (i * 8));
+        }
+        if (block >= 0x10) {
+            std::memset(keystream.data(), 0, 12);
+        }
+        ecb.Transcode(keystream.data(), keystream.size(), keystream.data(), Op::Encrypt);
+        for (std::size_t i = 0; i < 16; ++i) {
+            REQUIRE((data[block * 16 + i] ^ keystream[i]) == whole[block * 16 + i]);
+        }
+    }
+}
+
+TEST_CASE("AESCipher[XTS]", "[core]") {
+    // IEEE 1619 vector 15, exercises ciphertext stealing
+    const auto key = Common::HexStringToArray<32>(
+        "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0");
+    const auto data_unit = Common::HexStringToArray<16>("9a785634120000000000000000000000");
+    const auto plain = Common::HexStringToArray<17>("000102030405060708090a0b0c0d0e0f10");
+    const auto expected = Common::HexStringToArray<17>("6c1625db4671522d3d7599601de7ca09ed");
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    cipher.SetIV(data_unit);
+    std::array<u8, 17> result{};
+    cipher.Transcode(plain.data(), plain.size(), result.data(), Op::Encrypt);
+    REQUIRE(result == expected);
+    cipher.Transcode(result.data(), result.size(), result.data(), Op::Decrypt);
+    REQUIRE(result == plain);
+
+    // Sector transcoding matches setting the Nintendo tweak of every sector by hand
+    static constexpr std::size_t SECTOR_SIZE = 0x200;
+    static constexpr std::size_t FIRST_SECTOR = 0x1FE;
+    const std::vector<u8> data = Pattern(SECTOR_SIZE * 5);
+    std::vector<u8> sectors(data.size());
+    cipher.XTSTranscode(data.data(), data.size(), sectors.data(), FIRST_SECTOR, SECTOR_SIZE,
+                        Op::Decrypt);
+    for (std::size_t sector = 0; sector < data.size() / SECTOR_SIZE; ++sector) {
+        std::array<u8, 16> tweak{};
+        const std::size_t sector_id = FIRST_SECTOR + sector;
+        tweak[14] = static_cast<u8>(sector_id >> 8);
+        tweak[15] = static_cast<u8>(sector_id);
+        cipher.SetIV(tweak);
+
+        std::vector<u8> expected_sector(SECTOR_SIZE);
+        cipher.Transcode(data.data() + sector * SECTOR_SIZE, SECTOR_SIZE, expected_sector.data(),
+                         Op::Decrypt);
+        REQUIRE(std::memcmp(expected_sector.data(), sectors.data() + sector * SECTOR_SIZE,
+                            SECTOR_SIZE) == 0);
+    }
+}
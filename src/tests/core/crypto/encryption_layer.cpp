@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/xts_encryption_layer.h"
+#include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace {
+constexpr size_t DataSize = 0x4000 * 32;
+constexpr size_t NumThreads = 8;
+constexpr size_t ReadsPerThread = 64;
+
+struct Range {
+    size_t offset;
+    size_t size;
+};
+
+FileSys::VirtualFile MakeData() {
+    std::vector<u8> data(DataSize);
+    std::mt19937 rng{0xC1F3};
+    for (u8& value : data) {
+        value = static_cast<u8>(rng());
+    }
+    return std::make_shared<FileSys::VectorVfsFile>(std::move(data));
+}
+
+/// Ranges of up to eight sectors, half of them unaligned unless only aligned reads are allowed
+std::vector<Range> MakeRanges(size_t sector_size, bool aligned_only) {
+    std::vector<Range> ranges(NumThreads * ReadsPerThread);
+    std::mt19937 rng{0x5EC7};
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const bool aligned = aligned_only || i % 2 == 0;
+        const size_t sectors = 1 + rng() % 8;
+        size_t offset = (rng() % (DataSize / sector_size - sectors)) * sector_size;
+        size_t size = sectors * sector_size;
+        if (!aligned) {
+            offset += rng() % sector_size;
+            size -= rng() % sector_size;
+        }
+        ranges[i] = {offset, size};
+    }
+    return ranges;
+}
+
+/// Reads the ranges from several threads at once and compares them to a single threaded read
+void CheckConcurrentReads(const FileSys::VfsFile& shared, const FileSys::VfsFile& reference,
+                          size_t sector_size, bool aligned_only = false) {
+    const std::vector<Range> ranges = MakeRanges(sector_size, aligned_only);
+    std::vector<std::vector<u8>> expected(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        expected[i] = reference.ReadBytes(ranges[i].size, ranges[i].offset);
+    }
+
+    std::vector<std::vector<u8>> results(ranges.size());
+    std::vector<std::jthread> threads;
+    for (size_t thread = 0; thread < NumThreads; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t i = thread; i < ranges.size(); i += NumThreads) {
+                results[i] = shared.ReadBytes(ranges[i].size, ranges[i].offset);
+            }
+        });
+    }
+    threads.clear();
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        REQUIRE(results[i] == expected[i]);
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("EncryptionLayer[XTSConcurrent]", "[core]") {
+    Core::Crypto::Key256 key{};
+    for (size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i * 3 + 1);
+    }
+    const FileSys::VirtualFile data = MakeData();
+    const Core::Crypto::XTSEncryptionLayer shared(data, key);
+    const Core::Crypto::XTSEncryptionLayer reference(data, key);
+    CheckConcurrentReads(shared, reference, 0x4000);
+}
+
+TEST_CASE("EncryptionLayer[CTRConcurrent]", "[core]") {
+    Core::Crypto::Key128 key{};
+    for (size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i * 5 + 2);
+    }
+    Core::Crypto::CTREncryptionLayer::IVData iv{};
+    iv[0] = 0x12;
+    const FileSys::VirtualFile data = MakeData();
+    Core::Crypto::CTREncryptionLayer shared(data, key, 0x100);
+    Core::Crypto::CTREncryptionLayer reference(data, key, 0x100);
+    shared.SetIV(iv);
+    reference.SetIV(iv);
+    CheckConcurrentReads(shared, reference, 0x10);
+}
+
+TEST_CASE("AesCtrStorage[Concurrent]", "[core]") {
+    std::array<u8, FileSys::AesCtrStorage::KeySize> key{};
+    std::array<u8, FileSys::AesCtrStorage::IvSize> iv{};
+    for (size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i * 7 + 3);
+        iv[i] = static_cast<u8>(0xF0 - i);
+    }
+    const FileSys::VirtualFile data = MakeData();
+    const FileSys::AesCtrStorage shared(data, key.data(), key.size(), iv.data(), iv.size());
+    const FileSys::AesCtrStorage reference(data, key.data(), key.size(), iv.data(), iv.size());
+    CheckConcurrentReads(shared, reference, FileSys::AesCtrStorage::BlockSize, true);
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "core/crypto/sha256_native.h"
+
+using Core::Crypto::Sha256Native::Context;
+using Core::Crypto::Sha256Native::Digest;
+
+namespace {
+Digest HashString(std::string_view message) {
+    Digest digest;
+    Core::Crypto::Sha256Native::Hash(reinterpret_cast<const u8*>(message.data()), message.size(),
+                                     digest);
+    return digest;
+}
+} // Anonymous namespace
+
+TEST_CASE("Sha256Native[Vectors]", "[core]") {
+    REQUIRE(HashString("") ==
+            Common::HexStringToArray<32>(
+                "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    REQUIRE(HashString("abc") ==
+            Common::HexStringToArray<32>(
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    REQUIRE(HashString("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+            Common::HexStringToArray<32>(
+                "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+}
+
+TEST_CASE("Sha256Native[Streaming]", "[core]") {
+    // One million 'a' fed in pieces that straddle the block boundaries
+    const std::vector<u8> data(1000000, 'a');
+    Context context;
+    size_t offset = 0;
+    for (size_t piece = 1; offset < data.size(); piece = piece * 3 % 1000 + 1) {
+        const size_t size = std::min(piece, data.size() - offset);
+        context.Update(data.data() + offset, size);
+        offset += size;
+    }
+    Digest digest;
+    context.Finish(digest);
+    REQUIRE(digest == Common::HexStringToArray<32>(
+                          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/fssystem/fssystem_block_cache.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+using namespace Common::Literals;
+using FileSys::BlockCache;
+using FileSys::BlockCacheStorage;
+
+namespace {
+class CountingFile : public FileSys::VectorVfsFile {
+public:
+    explicit CountingFile(std::vector<u8> data) : VectorVfsFile(std::move(data)) {}
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        ++reads;
+        return VectorVfsFile::Read(data, length, offset);
+    }
+
+    mutable std::atomic<size_t> reads{};
+};
+
+std::vector<u8> MakeData(size_t size) {
+    std::vector<u8> data(size);
+    std::mt19937 rng{0xB10C};
+    for (u8& value : data) {
+        value = static_cast<u8>(rng());
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("BlockCacheStorage[Read]", "[core]") {
+    static constexpr size_t BlockSize = 16_KiB;
+    static constexpr size_t Capacity = 256_KiB;
+    const std::vector<u8> data = MakeData(BlockSize * 40 + 123);
+
+    BlockCache cache(Capacity);
+    auto base = std::make_shared<CountingFile>(data);
+    BlockCacheStorage storage(base, BlockSize, cache);
+    REQUIRE(storage.GetSize() == data.size());
+
+    std::mt19937 rng{7};
+    std::vector<u8> buffer;
+    for (int i = 0; i < 2000; ++i) {
+        const size_t offset = rng() % (data.size() + 64);
+        const size_t size = rng() % (BlockSize * 3);
+        buffer.assign(size, 0);
+        const size_t expected = offset < data.size() ? std::min(size, data.size() - offset) : 0;
+        REQUIRE(storage.Read(buffer.data(), size, offset) == expected);
+        REQUIRE(std::memcmp(buffer.data(), data.data() + std::min(offset, data.size()),
+                            expected) == 0);
+        REQUIRE(cache.GetUsedSize() <= Capacity);
+    }
+
+    // Blocks that are still cached don't reach the base storage again
+    buffer.resize(100);
+    storage.Read(buffer.data(), buffer.size(), BlockSize * 39 + 50);
+    const size_t reads = base->reads;
+    storage.Read(buffer.data(), buffer.size(), BlockSize * 39);
+    REQUIRE(base->reads == reads);
+}
+
+TEST_CASE("BlockCacheStorage[ReadAhead]", "[core]") {
+    static constexpr size_t BlockSize = 16_KiB;
+    const std::vector<u8> data = MakeData(BlockSize * 64);
+
+    BlockCache cache(4_MiB);
+    auto base = std::make_shared<CountingFile>(data);
+    BlockCacheStorage storage(base, BlockSize, cache);
+
+    // Stream through the first blocks in small reads
+    std::vector<u8> buffer(4_KiB);
+    size_t offset = 0;
+    for (; offset < BlockSize * 2; offset += buffer.size()) {
+        storage.Read(buffer.data(), buffer.size(), offset);
+    }
+
+    // The following blocks get loaded in the background
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache.GetUsedSize() < BlockSize * (2 + BlockCacheStorage::ReadAheadBlocks) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(cache.GetUsedSize() >= BlockSize * (2 + BlockCacheStorage::ReadAheadBlocks));
+
+    const size_t reads = base->reads;
+    storage.Read(buffer.data(), buffer.size(), offset);
+    REQUIRE(base->reads == reads);
+    REQUIRE(std::memcmp(buffer.data(), data.data() + offset, buffer.size()) == 0);
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/settings.h"
+#include "core/crypto/sha256_native.h"
+#include "core/file_sys/fssystem/fssystem_integrity_verification_storage.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+using FileSys::IntegrityVerificationStorage;
+
+namespace {
+constexpr size_t BlockSize = 0x400;
+constexpr size_t NumBlocks = 16;
+constexpr size_t DataSize = BlockSize * (NumBlocks - 1) + 0x123;
+
+struct Layer {
+    std::shared_ptr<FileSys::VectorVfsFile> data;
+    std::shared_ptr<FileSys::VectorVfsFile> hashes;
+    std::shared_ptr<IntegrityVerificationStorage> storage;
+};
+
+Layer MakeLayer() {
+    std::vector<u8> data(DataSize);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>(i * 13 + (i >> 10));
+    }
+
+    // The last block is hashed zero padded
+    std::vector<u8> hashes(NumBlocks * IntegrityVerificationStorage::HashSize);
+    for (size_t block = 0; block < NumBlocks; ++block) {
+        std::vector<u8> block_data(BlockSize);
+        const size_t size = std::min(BlockSize, DataSize - block * BlockSize);
+        std::copy_n(data.begin() + block * BlockSize, size, block_data.begin());
+        Core::Crypto::Sha256Native::Digest digest;
+        Core::Crypto::Sha256Native::Hash(block_data.data(), block_data.size(), digest);
+        std::copy(digest.begin(), digest.end(),
+                  hashes.begin() + block * IntegrityVerificationStorage::HashSize);
+    }
+
+    Layer layer{
+        .data = std::make_shared<FileSys::VectorVfsFile>(std::move(data)),
+        .hashes = std::make_shared<FileSys::VectorVfsFile>(std::move(hashes)),
+        .storage = std::make_shared<IntegrityVerificationStorage>(),
+    };
+    layer.storage->Initialize(layer.hashes, layer.data, BlockSize,
+                              IntegrityVerificationStorage::HashSize, true);
+    return layer;
+}
+} // Anonymous namespace
+
+TEST_CASE("IntegrityVerificationStorage[Verify]", "[core]") {
+    Settings::values.verify_romfs_integrity.SetValue(true);
+    Layer layer = MakeLayer();
+    const std::vector<u8> expected = layer.data->ReadAllBytes();
+
+    // Corrupt a block before it is first read, and another one after it was verified
+    std::vector<u8> result(DataSize);
+    REQUIRE(layer.storage->Read(result.data(), BlockSize, 0) == BlockSize);
+    const u8 corrupted = static_cast<u8>(~expected[3 * BlockSize + 5]);
+    layer.data->WriteBytes(std::vector<u8>{corrupted}, 3 * BlockSize + 5);
+    layer.data->WriteBytes(std::vector<u8>{static_cast<u8>(~expected[7])}, 7);
+
+    // The whole range covers enough blocks to be verified in parallel
+    REQUIRE(layer.storage->Read(result.data(), DataSize, 0) == DataSize);
+    for (size_t i = 0; i < DataSize; ++i) {
+        const size_t block = i / BlockSize;
+        if (block == 3) {
+            REQUIRE(result[i] == 0);
+        } else if (i != 7) {
+            REQUIRE(result[i] == expected[i]);
+        }
+    }
+
+    // Unaligned reads verify the blocks they touch in full
+    layer.data->WriteBytes(std::vector<u8>{expected[3 * BlockSize + 5]}, 3 * BlockSize + 5);
+    REQUIRE(layer.storage->Read(result.data(), 0x20, 3 * BlockSize + 0x3F0) == 0x20);
+    REQUIRE(std::equal(result.begin(), result.begin() + 0x20,
+                       expected.begin() + 3 * BlockSize + 0x3F0));
+}
+
+TEST_CASE("IntegrityVerificationStorage[Disabled]", "[core]") {
+    Settings::values.verify_romfs_integrity.SetValue(false);
+    Layer layer = MakeLayer();
+    std::vector<u8> expected = layer.data->ReadAllBytes();
+
+    // Without verification corrupted data is returned as is
+    expected[3 * BlockSize + 5] = static_cast<u8>(~expected[3 * BlockSize + 5]);
+    layer.data->WriteBytes(std::vector<u8>{expected[3 * BlockSize + 5]}, 3 * BlockSize + 5);
+    std::vector<u8> result(DataSize);
+    REQUIRE(layer.storage->Read(result.data(), DataSize, 0) == DataSize);
+    REQUIRE(result == expected);
+}
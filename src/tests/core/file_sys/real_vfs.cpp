@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/path_util.h"
+#include "core/file_sys/vfs/vfs_real.h"
+
+namespace {
+constexpr size_t FileSize = 0x3001;
+
+std::vector<u8> MakeData() {
+    std::vector<u8> data(FileSize);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>(i * 7 + (i >> 8));
+    }
+    return data;
+}
+
+#ifdef __linux__
+bool IsMapped(const std::filesystem::path& path) {
+    std::ifstream maps{"/proc/self/maps"};
+    const std::string contents{std::istreambuf_iterator<char>{maps}, {}};
+    return contents.find(path.string()) != std::string::npos;
+}
+#endif
+} // Anonymous namespace
+
+TEST_CASE("RealVfsFile[ReadView]", "[core]") {
+    // Game images are read through a mapping
+    const auto path = std::filesystem::temp_directory_path() / "citron_real_vfs_test.nsp";
+    const std::vector<u8> data = MakeData();
+    {
+        std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+        stream.write(reinterpret_cast<const char*>(data.data()),
+                     static_cast<std::streamsize>(data.size()));
+    }
+
+    {
+        FileSys::RealVfsFilesystem filesystem;
+        const auto file =
+            filesystem.OpenFile(Common::FS::PathToUTF8String(path), FileSys::OpenMode::Read);
+        REQUIRE(file != nullptr);
+
+        // Querying the size doesn't map the file
+        REQUIRE(file->GetSize() == FileSize);
+#ifdef __linux__
+        REQUIRE(!IsMapped(path));
+#endif
+
+        const auto middle = file->ReadView(0x100, 0x10);
+        REQUIRE(middle.size() == 0x100);
+        REQUIRE(std::equal(middle.begin(), middle.end(), data.begin() + 0x10));
+#ifdef __linux__
+        REQUIRE(IsMapped(path));
+#endif
+
+        // Views and reads past the end are cut short
+        const auto tail = file->ReadView(0x10, FileSize - 5);
+        REQUIRE(tail.size() == 5);
+        REQUIRE(std::equal(tail.begin(), tail.end(), data.end() - 5));
+        std::vector<u8> buffer(0x10);
+        REQUIRE(file->Read(buffer.data(), buffer.size(), FileSize - 5) == 5);
+        REQUIRE(std::equal(buffer.begin(), buffer.begin() + 5, data.end() - 5));
+
+        REQUIRE(file->ReadView(0x10, FileSize).empty());
+        REQUIRE(file->ReadView(0x10, FileSize + 0x10).empty());
+        REQUIRE(file->ReadView(0, 0x10).size() == 0);
+        REQUIRE(file->Read(buffer.data(), buffer.size(), FileSize) == 0);
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+using namespace Shader;
+
+namespace {
+
+bool IsMergedInto(const IR::Value& value, const IR::Value& leader) {
+    return value.IsIdentity() && value.Resolve() == leader;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GlobalValueNumbering[Merge]", "[shader_recompiler]") {
+    ObjectPool<IR::Inst> inst_pool;
+    ObjectPool<IR::Block> block_pool;
+
+    // entry -> then -> merge, entry -> merge
+    IR::Block* const entry{block_pool.Create(inst_pool)};
+    IR::Block* const then{block_pool.Create(inst_pool)};
+    IR::Block* const merge{block_pool.Create(inst_pool)};
+    entry->AddBranch(then);
+    entry->AddBranch(merge);
+    then->AddBranch(merge);
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U32 cbuf{entry_ir.GetCbuf(entry_ir.Imm32(0), entry_ir.Imm32(16))};
+    const IR::U32 sum{entry_ir.IAdd(cbuf, entry_ir.Imm32(4))};
+    const IR::F32 attribute{entry_ir.GetAttribute(IR::Attribute::Generic0X)};
+    const IR::U64 address{entry_ir.PackUint2x32(entry_ir.CompositeConstruct(cbuf, cbuf))};
+    const IR::U32 load{entry_ir.LoadGlobal32(address)};
+    const IR::U32 same_load{entry_ir.LoadGlobal32(address)};
+    entry_ir.WriteGlobal32(address, sum);
+    const IR::U32 load_after_write{entry_ir.LoadGlobal32(address)};
+
+    IR::IREmitter then_ir{*then};
+    const IR::U32 then_cbuf{then_ir.GetCbuf(then_ir.Imm32(0), then_ir.Imm32(16))};
+    const IR::U32 then_sum{then_ir.IAdd(then_ir.Imm32(4), then_cbuf)};
+    const IR::F32 then_attribute{then_ir.GetAttribute(IR::Attribute::Generic0X)};
+    const IR::U32 then_product{then_ir.IMul(cbuf, then_ir.Imm32(3))};
+
+    IR::IREmitter merge_ir{*merge};
+    const IR::U32 merge_cbuf{merge_ir.GetCbuf(merge_ir.Imm32(0), merge_ir.Imm32(16))};
+    const IR::U32 merge_product{merge_ir.IMul(cbuf, merge_ir.Imm32(3))};
+    const IR::U32 other_cbuf{merge_ir.GetCbuf(merge_ir.Imm32(0), merge_ir.Imm32(20))};
+
+    IR::Program program;
+    program.blocks = {entry, then, merge};
+    program.post_order_blocks = {merge, then, entry};
+    Optimization::GlobalValueNumberingPass(program);
+
+    // Pure operations are merged with the ones of dominating blocks, in any operand order
+    REQUIRE(IsMergedInto(then_cbuf, cbuf));
+    REQUIRE(IsMergedInto(then_sum, sum));
+    REQUIRE(IsMergedInto(merge_cbuf, cbuf));
+    REQUIRE(!other_cbuf.IsIdentity());
+
+    // Values of a block that doesn't dominate aren't reused
+    REQUIRE(!merge_product.IsIdentity());
+    REQUIRE(!then_product.IsIdentity());
+
+    // Memory and attribute reads are only merged in a block, until something is written
+    REQUIRE(IsMergedInto(same_load, load));
+    REQUIRE(!load_after_write.IsIdentity());
+    REQUIRE(!then_attribute.IsIdentity());
+    REQUIRE(!attribute.IsIdentity());
+}
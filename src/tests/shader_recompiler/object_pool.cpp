@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/object_pool.h"
+
+using namespace Shader;
+
+namespace {
+
+struct Counted {
+    explicit Counted(int& live_, int value_) : live{&live_}, data(4, value_) {
+        ++*live;
+    }
+    ~Counted() {
+        --*live;
+    }
+
+    int* live;
+    std::vector<int> data;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("ObjectPool[Release]", "[shader_recompiler]") {
+    int live{};
+    {
+        ObjectPool<Counted> pool{4};
+        std::vector<Counted*> objects;
+        for (int i = 0; i < 10; ++i) {
+            objects.push_back(pool.Create(live, i));
+        }
+        REQUIRE(live == 10);
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(objects[i]->data[3] == i);
+        }
+
+        // Released objects are destroyed, chunks are squashed into one that fits them all
+        pool.ReleaseContents();
+        REQUIRE(live == 0);
+        Counted* const first{pool.Create(live, 0)};
+        for (int i = 1; i < 10; ++i) {
+            REQUIRE(pool.Create(live, i) == first + i);
+        }
+        REQUIRE(live == 10);
+
+        // Memory is reused by the following objects
+        pool.ReleaseContents();
+        REQUIRE(pool.Create(live, 0) == first);
+        REQUIRE(live == 1);
+    }
+    REQUIRE(live == 0);
+}
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/shader_cache.h"
+
+using namespace Shader;
+
+namespace {
+
+Info MakeInfo() {
+    Info info{};
+    info.uses_workgroup_id = true;
+    info.uses_patches[29] = true;
+    info.interpolation[31] = Interpolation::NoPerspective;
+    info.loads.Set(IR::Attribute::PositionX);
+    info.stores.mask.set(511);
+    info.passthrough.mask.set(64);
+    info.legacy_stores_mapping.emplace(IR::Attribute::ColorFrontDiffuseR,
+                                       IR::Attribute::Generic3X);
+    info.alpha_to_coverage_enabled = true;
+    info.used_storage_buffer_types = IR::Type::U32 | IR::Type::U64;
+    info.constant_buffer_used_sizes[17] = 0x1000;
+    info.nvn_buffer_used.set(15);
+    info.emulated_layer = IR::Attribute::Generic7X;
+    info.constant_buffer_descriptors.push_back({.index = 3, .count = 1});
+    info.storage_buffers_descriptors.push_back(
+        {.cbuf_index = 0, .cbuf_offset = 0x110, .count = 1, .is_written = true});
+    for (u32 i = 0; i < 20; ++i) {
+        // Past the inline capacity of the small vector
+        info.texture_descriptors.push_back({.type = TextureType::ColorArrayCube,
+                                            .is_depth = i % 2 == 0,
+                                            .cbuf_index = 1,
+                                            .cbuf_offset = i * 4,
+                                            .count = 1});
+    }
+    info.image_descriptors.push_back({.type = TextureType::Color2D,
+                                      .format = ImageFormat::R32_UINT,
+                                      .is_written = true,
+                                      .count = 2});
+    return info;
+}
+
+bool operator==(const Info& lhs, const Info& rhs) {
+    return lhs.uses_workgroup_id == rhs.uses_workgroup_id &&
+           lhs.uses_patches == rhs.uses_patches && lhs.interpolation == rhs.interpolation &&
+           lhs.loads.mask == rhs.loads.mask && lhs.stores.mask == rhs.stores.mask &&
+           lhs.passthrough.mask == rhs.passthrough.mask &&
+           lhs.legacy_stores_mapping == rhs.legacy_stores_mapping &&
+           lhs.alpha_to_coverage_enabled == rhs.alpha_to_coverage_enabled &&
+           lhs.used_storage_buffer_types == rhs.used_storage_buffer_types &&
+           lhs.constant_buffer_used_sizes == rhs.constant_buffer_used_sizes &&
+           lhs.nvn_buffer_used == rhs.nvn_buffer_used && lhs.emulated_layer == rhs.emulated_layer &&
+           lhs.constant_buffer_descriptors == rhs.constant_buffer_descriptors &&
+           lhs.storage_buffers_descriptors == rhs.storage_buffers_descriptors &&
+           lhs.texture_descriptors == rhs.texture_descriptors &&
+           lhs.image_descriptors == rhs.image_descriptors;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ShaderCache[InfoRoundTrip]", "[shader_recompiler]") {
+    const Info info = MakeInfo();
+    std::stringstream stream;
+    SerializeInfo(stream, info);
+
+    Info result{};
+    result.texture_descriptors.resize(3);
+    DeserializeInfo(stream, result);
+    REQUIRE(stream.good());
+    REQUIRE(result == info);
+
+    // A truncated info fails the stream instead of reading past its end
+    const std::string data = stream.str();
+    std::istringstream truncated{data.substr(0, data.size() - 1)};
+    DeserializeInfo(truncated, result);
+    REQUIRE(truncated.fail());
+}
+
+TEST_CASE("ShaderCache[Fingerprint]", "[shader_recompiler]") {
+    const Profile profile{};
+    const HostTranslateInfo host_info{};
+    Profile other_profile{};
+    other_profile.has_broken_robust = true;
+    HostTranslateInfo other_host_info{};
+    other_host_info.min_ssbo_alignment = 64;
+
+    const u64 fingerprint = RecompilerFingerprint(profile, host_info);
+    REQUIRE(fingerprint == RecompilerFingerprint(profile, host_info));
+    REQUIRE(fingerprint != RecompilerFingerprint(other_profile, host_info));
+    REQUIRE(fingerprint != RecompilerFingerprint(profile, other_host_info));
+}
+
+TEST_CASE("ShaderCache[TargetRoundTrip]", "[shader_recompiler]") {
+    Profile profile{};
+    profile.supported_spirv = 0x00010600;
+    profile.has_broken_robust = true;
+    profile.min_ssbo_alignment = 256;
+    HostTranslateInfo host_info{};
+    host_info.support_float16 = true;
+    host_info.min_ssbo_alignment = 64;
+    const u64 fingerprint = RecompilerFingerprint(profile, host_info);
+    const std::string text = SerializeRecompilerTarget(profile, host_info);
+
+    Profile result_profile{};
+    HostTranslateInfo result_host_info{};
+    REQUIRE(DeserializeRecompilerTarget(text, result_profile, result_host_info));
+    REQUIRE(RecompilerFingerprint(result_profile, result_host_info) == fingerprint);
+    REQUIRE(SerializeRecompilerTarget(result_profile, result_host_info) == text);
+
+    REQUIRE(!DeserializeRecompilerTarget("profile.unknown = 1\n", result_profile,
+                                         result_host_info));
+    REQUIRE(!DeserializeRecompilerTarget("profile.has_broken_robust = 2\n", result_profile,
+                                         result_host_info));
+    REQUIRE(!DeserializeRecompilerTarget("host_info.min_ssbo_alignment\n", result_profile,
+                                         result_host_info));
+}
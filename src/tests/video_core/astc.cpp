@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "tests/video_core/astc_block_generator.h"
+#include "video_core/textures/astc.h"
+
+using Tests::ASTC::BLOCK_SIZES;
+using Tests::ASTC::BlockGenerator;
+using Tests::ASTC::BlockSize;
+
+TEST_CASE("ASTC[DecompressBlockRow]", "[video_core]") {
+    static constexpr u32 BLOCKS_PER_ROW = 7;
+    static constexpr u32 ROWS_PER_SIZE = 64;
+
+    BlockGenerator generator{0xA57C};
+    for (const BlockSize& size : BLOCK_SIZES) {
+        // Clip the last block horizontally and the image vertically to cover partial blocks
+        const u32 width = BLOCKS_PER_ROW * size.width - 1;
+        const u32 height = size.height - 1;
+        const u32 pitch = width * 4;
+
+        for (u32 row = 0; row < ROWS_PER_SIZE; ++row) {
+            std::vector<u8> blocks(BLOCKS_PER_ROW * 16);
+            for (u32 i = 0; i < BLOCKS_PER_ROW; ++i) {
+                const std::array<u8, 16> block = generator.Generate(size);
+                std::memcpy(blocks.data() + i * 16, block.data(), block.size());
+            }
+
+            std::vector<u8> expected(pitch * height);
+            for (u32 i = 0; i < BLOCKS_PER_ROW; ++i) {
+                std::array<u32, 12 * 12> texels{};
+                Tegra::Texture::ASTC::DecompressBlockReference(
+                    std::span<const u8, 16>(blocks.data() + i * 16, 16), size.width, size.height,
+                    texels);
+                const u32 x = i * size.width;
+                const u32 copy_width = std::min(size.width, width - x);
+                for (u32 y = 0; y < height; ++y) {
+                    std::memcpy(expected.data() + y * pitch + x * 4,
+                                texels.data() + y * size.width, copy_width * 4);
+                }
+            }
+
+            std::vector<u8> result(pitch * height);
+            Tegra::Texture::ASTC::DecompressBlockRow(blocks, width, height, size.width,
+                                                     size.height, result, pitch);
+            REQUIRE(result == expected);
+        }
+    }
+}
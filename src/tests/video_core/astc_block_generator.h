@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <random>
+
+#include "common/common_types.h"
+
+namespace Tests::ASTC {
+
+struct BlockSize {
+    u32 width;
+    u32 height;
+};
+
+constexpr std::array<BlockSize, 14> BLOCK_SIZES{{
+    {4, 4},
+    {5, 4},
+    {5, 5},
+    {6, 5},
+    {6, 6},
+    {8, 5},
+    {8, 6},
+    {8, 8},
+    {10, 5},
+    {10, 6},
+    {10, 8},
+    {10, 10},
+    {12, 10},
+    {12, 12},
+}};
+
+constexpr std::array<u32, 10> LDR_ENDPOINT_MODES{0, 1, 4, 5, 6, 8, 9, 10, 12, 13};
+
+/// Generates random but well-formed LDR blocks, covering every weight grid layout and range
+class BlockGenerator {
+public:
+    explicit BlockGenerator(u32 seed) : rng{seed} {}
+
+    /// Builds a random well-formed LDR block for the given footprint
+    std::array<u8, 16> Generate(const BlockSize& size) {
+        while (true) {
+            std::array<u8, 16> block;
+            for (u8& byte : block) {
+                byte = static_cast<u8>(rng());
+            }
+            if (Random(16) == 0) {
+                // Void extent, the color and extent bits are already random
+                SetBits(block, 0, 13, 0x1DFC);
+                return block;
+            }
+            if (TryGenerate(block, size)) {
+                return block;
+            }
+        }
+    }
+
+private:
+    bool TryGenerate(std::array<u8, 16>& block, const BlockSize& size) {
+        const u32 range_bits = 2 + Random(6);
+        const bool high_precision = Random(2) != 0;
+        const u32 layout = Random(10);
+        const bool dual_plane = layout != 9 && Random(3) == 0;
+        const u32 a = Random(4);
+        const u32 b = Random(4);
+
+        u32 mode = (range_bits & 1) << 4;
+        u32 grid_width = 0;
+        u32 grid_height = 0;
+        if (layout < 5) {
+            mode |= range_bits >> 1;
+            mode |= a << 5;
+            switch (layout) {
+            case 0:
+                mode |= b << 7;
+                grid_width = b + 4;
+                grid_height = a + 2;
+                break;
+            case 1:
+                mode |= 0x4 | b << 7;
+                grid_width = b + 8;
+                grid_height = a + 2;
+                break;
+            case 2:
+                mode |= 0x8 | b << 7;
+                grid_width = a + 2;
+                grid_height = b + 8;
+                break;
+            case 3:
+                mode |= 0xC | (b & 1) << 7;
+                grid_width = a + 2;
+                grid_height = (b & 1) + 6;
+                break;
+            default:
+                mode |= 0x10C | (b & 1) << 7;
+                grid_width = (b & 1) + 2;
+                grid_height = a + 2;
+                break;
+            }
+        } else {
+            mode |= (range_bits >> 1) << 2;
+            switch (layout) {
+            case 5:
+                mode |= a << 5;
+                grid_width = 12;
+                grid_height = a + 2;
+                break;
+            case 6:
+                mode |= 0x80 | a << 5;
+                grid_width = a + 2;
+                grid_height = 12;
+                break;
+            case 7:
+                mode |= 0x180;
+                grid_width = 6;
+                grid_height = 10;
+                break;
+            case 8:
+                mode |= 0x1A0;
+                grid_width = 10;
+                grid_height = 6;
+                break;
+            default:
+                mode |= 0x100 | a << 5 | b << 9;
+                grid_width = a + 6;
+                grid_height = b + 6;
+                break;
+            }
+        }
+        if (layout != 9) {
+            mode |= (high_precision ? 0x200 : 0) | (dual_plane ? 0x400 : 0);
+        }
+        if (grid_width > size.width || grid_height > size.height) {
+            return false;
+        }
+
+        static constexpr std::array<u32, 6> LOW_WEIGHT_RANGES{1, 2, 3, 4, 5, 7};
+        static constexpr std::array<u32, 6> HIGH_WEIGHT_RANGES{9, 11, 15, 19, 23, 31};
+        const bool use_high = layout != 9 && high_precision;
+        const u32 max_weight = (use_high ? HIGH_WEIGHT_RANGES : LOW_WEIGHT_RANGES)[range_bits - 2];
+        const u32 num_weights = grid_width * grid_height * (layout != 9 && dual_plane ? 2 : 1);
+        const u32 weight_bits = BitLength(max_weight, num_weights);
+        if (num_weights > 64 || weight_bits < 24 || weight_bits > 96) {
+            return false;
+        }
+
+        const u32 num_partitions = 1 + Random(dual_plane ? 3 : 4);
+        const u32 cem = LDR_ENDPOINT_MODES[Random(static_cast<u32>(LDR_ENDPOINT_MODES.size()))];
+        const u32 num_values = ((cem >> 2) + 1) * 2 * num_partitions;
+        u32 header_bits = 17;
+        SetBits(block, 0, 11, mode);
+        SetBits(block, 11, 2, num_partitions - 1);
+        if (num_partitions == 1) {
+            SetBits(block, 13, 4, cem);
+        } else {
+            // The partition index stays random, all partitions share the same endpoint mode
+            SetBits(block, 23, 6, cem << 2);
+            header_bits = 29;
+        }
+        const s32 color_bits = 128 - static_cast<s32>(weight_bits + header_bits) -
+                               (layout != 9 && dual_plane ? 2 : 0);
+        // The smallest color range has to fit, otherwise the block is malformed
+        return color_bits >= static_cast<s32>(BitLength(5, num_values));
+    }
+
+    static u32 BitLength(u32 max_value, u32 count) {
+        const u32 check = max_value + 1;
+        if ((check & (check - 1)) == 0) {
+            return std::countr_zero(check) * count;
+        }
+        if (check % 3 == 0) {
+            return std::countr_zero(check / 3) * count + (count * 8 + 4) / 5;
+        }
+        return std::countr_zero(check / 5) * count + (count * 7 + 2) / 3;
+    }
+
+    static void SetBits(std::array<u8, 16>& block, u32 start, u32 count, u32 value) {
+        for (u32 i = 0; i < count; ++i) {
+            const u32 bit = start + i;
+            const u8 mask = static_cast<u8>(1U << (bit % 8));
+            if ((value >> i) & 1) {
+                block[bit / 8] |= mask;
+            } else {
+                block[bit / 8] &= static_cast<u8>(~mask);
+            }
+        }
+    }
+
+    u32 Random(u32 bound) {
+        return static_cast<u32>(rng() % bound);
+    }
+
+    std::mt19937 rng;
+};
+
+} // namespace Tests::ASTC
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "video_core/control/capture_replay.h"
+#include "video_core/control/command_capture.h"
+#include "video_core/engines/maxwell_dma.h"
+#include "video_core/engines/puller.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+
+using Tegra::CommandHeader;
+using Tegra::SubmissionMode;
+using Tegra::Control::CapturedSegment;
+using Tegra::Control::CapturedSubmit;
+using Tegra::Control::CaptureReplayer;
+using Tegra::Engines::MaxwellDMA;
+
+namespace {
+
+constexpr u64 ADDRESS_SPACE = 1;
+constexpr GPUVAddr PUSHBUFFER = 0x100000;
+constexpr GPUVAddr SOURCE = 0x200000;
+constexpr GPUVAddr FIRST_DEST = 0x300000;
+constexpr GPUVAddr SECOND_DEST = 0x400000;
+constexpr u32 COPY_SIZE = 64;
+
+// MaxwellDMA registers, in words
+constexpr u32 LAUNCH_DMA = 0xC0;
+constexpr u32 OFFSET_IN = 0x100;
+constexpr u32 OFFSET_OUT = 0x102;
+
+class HeadlessWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+CommandHeader Method(u32 method, u32 count) {
+    CommandHeader header{};
+    header.method.Assign(method);
+    header.method_count.Assign(count);
+    header.mode.Assign(SubmissionMode::Increasing);
+    return header;
+}
+
+CommandHeader Argument(u32 value) {
+    CommandHeader header{};
+    header.argument = value;
+    return header;
+}
+
+std::vector<u8> Fill(u8 value) {
+    return std::vector<u8>(COPY_SIZE, value);
+}
+
+/**
+ * Two DMA copies from the same source. The source changed between them, the capture stores both
+ * versions: each has to be loaded right before the launch that read it.
+ */
+CapturedSubmit MakeSubmit() {
+    MaxwellDMA::LaunchDMA launch{};
+    launch.data_transfer_type.Assign(MaxwellDMA::LaunchDMA::DataTransferType::NON_PIPELINED);
+    launch.src_memory_layout.Assign(MaxwellDMA::LaunchDMA::MemoryLayout::PITCH);
+    launch.dst_memory_layout.Assign(MaxwellDMA::LaunchDMA::MemoryLayout::PITCH);
+    launch.multi_line_enable.Assign(1);
+    const u32 launch_word = std::bit_cast<u32>(launch);
+
+    const std::vector<CommandHeader> words{
+        Method(0, 1),
+        Argument(static_cast<u32>(Tegra::EngineID::MAXWELL_DMA_COPY_A)),
+        Method(OFFSET_IN, 8),
+        Argument(0),
+        Argument(static_cast<u32>(SOURCE)),
+        Argument(0),
+        Argument(static_cast<u32>(FIRST_DEST)),
+        Argument(COPY_SIZE),
+        Argument(COPY_SIZE),
+        Argument(COPY_SIZE),
+        Argument(1),
+        Method(LAUNCH_DMA, 1),
+        Argument(launch_word), // Word 12, first copy
+        Method(OFFSET_OUT, 2),
+        Argument(0),
+        Argument(static_cast<u32>(SECOND_DEST)),
+        Method(LAUNCH_DMA, 1),
+        Argument(launch_word), // Word 17, second copy
+    };
+    CapturedSegment segment{};
+    segment.header.addr.Assign(PUSHBUFFER);
+    segment.header.size.Assign(words.size());
+    segment.words = words;
+
+    CapturedSubmit submit{};
+    submit.channel = 1;
+    submit.address_space = ADDRESS_SPACE;
+    submit.segments.push_back(std::move(segment));
+    // The destinations are only written, they are backed by ranges read before the copies
+    submit.memory.push_back(
+        {.address_space = ADDRESS_SPACE, .address = FIRST_DEST, .word = 0, .data = Fill(0)});
+    submit.memory.push_back(
+        {.address_space = ADDRESS_SPACE, .address = SECOND_DEST, .word = 0, .data = Fill(0)});
+    submit.memory.push_back(
+        {.address_space = ADDRESS_SPACE, .address = SOURCE, .word = 12, .data = Fill(0xAA)});
+    submit.memory.push_back(
+        {.address_space = ADDRESS_SPACE, .address = SOURCE, .word = 17, .data = Fill(0x55)});
+    return submit;
+}
+
+std::vector<u8> ReadBack(Tegra::MemoryManager& memory_manager, GPUVAddr address) {
+    std::vector<u8> data(COPY_SIZE);
+    memory_manager.ReadBlock(address, data.data(), data.size());
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CaptureReplay[MemoryLoadedAtItsWord]", "[video_core]") {
+    const auto renderer_backend = Settings::values.renderer_backend.GetValue();
+    const bool use_asynchronous_gpu = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.renderer_backend.SetValue(renderer_backend);
+        Settings::values.use_asynchronous_gpu_emulation.SetValue(use_asynchronous_gpu);
+    };
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    Core::System system;
+    system.Initialize();
+    HeadlessWindow window;
+    REQUIRE(system.SetupForGPUReplay(window) == Core::SystemResultStatus::Success);
+    system.GPU().Start();
+    {
+        CaptureReplayer replayer{system};
+        CaptureReplayer::Stats stats;
+        REQUIRE(replayer.Replay(MakeSubmit(), stats));
+        REQUIRE(stats.submits == 1);
+        REQUIRE(stats.words == 18);
+        REQUIRE(stats.memory_ranges == 4);
+
+        const auto memory_manager = replayer.AddressSpace(ADDRESS_SPACE);
+        REQUIRE(ReadBack(*memory_manager, FIRST_DEST) == Fill(0xAA));
+        REQUIRE(ReadBack(*memory_manager, SECOND_DEST) == Fill(0x55));
+    }
+    system.ShutdownMainProcess();
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/control/command_capture.h"
+
+using Tegra::CommandHeader;
+using Tegra::Control::CaptureReader;
+using Tegra::Control::CapturedSegment;
+using Tegra::Control::CapturedSubmit;
+using Tegra::Control::CommandCapture;
+
+namespace {
+
+std::vector<CommandHeader> MakeWords(u32 count, u32 seed) {
+    std::vector<CommandHeader> words(count);
+    for (u32 i = 0; i < count; ++i) {
+        words[i].argument = seed * 0x10001 + i;
+    }
+    return words;
+}
+
+CapturedSegment MakeSegment(GPUVAddr address, u32 count, u32 seed) {
+    CapturedSegment segment{};
+    segment.header.addr.Assign(address);
+    segment.header.size.Assign(count);
+    segment.words = MakeWords(count, seed);
+    return segment;
+}
+
+std::vector<u8> MakeBytes(size_t size, u8 seed) {
+    std::vector<u8> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(seed + i * 3);
+    }
+    return data;
+}
+
+std::vector<CapturedSubmit> MakeSubmits() {
+    std::vector<CapturedSubmit> submits(2);
+    submits[0].channel = 1;
+    submits[0].address_space = 3;
+    submits[0].prefetch = MakeWords(5, 1);
+    submits[0].segments.push_back(MakeSegment(0x10000, 16, 2));
+    submits[0].segments.push_back(MakeSegment(0x20040, 3, 3));
+    submits[0].memory.push_back(
+        {.address_space = 3, .address = 0x30000, .word = 0, .data = MakeBytes(64, 4)});
+    submits[0].memory.push_back(
+        {.address_space = 4, .address = 0x1234, .word = 9, .data = MakeBytes(7, 5)});
+
+    // Lists without a prefetch or without memory
+    submits[1].channel = 2;
+    submits[1].address_space = 4;
+    submits[1].segments.push_back(MakeSegment(0x40000, 32, 6));
+    return submits;
+}
+
+void RequireEqual(const CapturedSubmit& lhs, const CapturedSubmit& rhs) {
+    REQUIRE(lhs.channel == rhs.channel);
+    REQUIRE(lhs.address_space == rhs.address_space);
+    REQUIRE(lhs.prefetch.size() == rhs.prefetch.size());
+    for (size_t i = 0; i < lhs.prefetch.size(); ++i) {
+        REQUIRE(lhs.prefetch[i].argument == rhs.prefetch[i].argument);
+    }
+    REQUIRE(lhs.segments.size() == rhs.segments.size());
+    for (size_t i = 0; i < lhs.segments.size(); ++i) {
+        REQUIRE(lhs.segments[i].header.raw == rhs.segments[i].header.raw);
+        REQUIRE(lhs.segments[i].words.size() == rhs.segments[i].words.size());
+        for (size_t word = 0; word < lhs.segments[i].words.size(); ++word) {
+            REQUIRE(lhs.segments[i].words[word].argument == rhs.segments[i].words[word].argument);
+        }
+    }
+    REQUIRE(lhs.memory.size() == rhs.memory.size());
+    for (size_t i = 0; i < lhs.memory.size(); ++i) {
+        REQUIRE(lhs.memory[i].address_space == rhs.memory[i].address_space);
+        REQUIRE(lhs.memory[i].address == rhs.memory[i].address);
+        REQUIRE(lhs.memory[i].word == rhs.memory[i].word);
+        REQUIRE(lhs.memory[i].data == rhs.memory[i].data);
+    }
+}
+
+/// Writes the submits to a capture file and returns its size
+size_t WriteCapture(const std::filesystem::path& path, const std::vector<CapturedSubmit>& submits) {
+    {
+        CommandCapture capture{path};
+        REQUIRE(capture.IsOpen());
+        for (const CapturedSubmit& submit : submits) {
+            capture.WriteSubmit(submit);
+        }
+        // Reads outside of a submission aren't recorded
+        const std::vector<u8> data = MakeBytes(16, 7);
+        capture.RecordRead(3, 0x50000, data);
+    }
+    return static_cast<size_t>(std::filesystem::file_size(path));
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CommandCapture[RoundTrip]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_command_capture_test.gpucap";
+    const std::vector<CapturedSubmit> submits = MakeSubmits();
+    WriteCapture(path, submits);
+
+    {
+        CaptureReader reader{path};
+        REQUIRE(reader.IsValid());
+        CapturedSubmit submit;
+        for (const CapturedSubmit& expected : submits) {
+            REQUIRE(reader.Next(submit));
+            RequireEqual(submit, expected);
+        }
+        REQUIRE(!reader.Next(submit));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CommandCapture[Truncated]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_command_capture_test.gpucap";
+    const std::vector<CapturedSubmit> submits = MakeSubmits();
+    const size_t size = WriteCapture(path, submits);
+
+    // Cut in the middle of the first submission
+    std::filesystem::resize_file(path, size - 300);
+    {
+        CaptureReader reader{path};
+        REQUIRE(reader.IsValid());
+        CapturedSubmit submit;
+        REQUIRE(!reader.Next(submit));
+    }
+
+    // Files that aren't captures are rejected
+    {
+        std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+        stream << "not a capture file";
+    }
+    {
+        CaptureReader reader{path};
+        REQUIRE(!reader.IsValid());
+    }
+
+    std::filesystem::remove(path);
+}
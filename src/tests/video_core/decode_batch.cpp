@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "video_core/textures/workers.h"
+
+using Tegra::Texture::DecodeBatch;
+using Tegra::Texture::DecodePriority;
+
+TEST_CASE("DecodeBatch[Stages]", "[video_core]") {
+    std::atomic<int> decoded{};
+    std::atomic<int> early_compressions{};
+    std::atomic<int> compressed{};
+    bool complete_after_all{};
+
+    DecodeBatch batch;
+    for (int i = 0; i < 64; ++i) {
+        batch.AddJob(i % 2 ? DecodePriority::Prefetch : DecodePriority::Sampled,
+                     [&decoded] { ++decoded; });
+    }
+    batch.AddStage();
+    // Empty stages are skipped
+    batch.AddStage();
+    for (int i = 0; i < 16; ++i) {
+        batch.AddJob(DecodePriority::Sampled, [&] {
+            if (decoded != 64) {
+                ++early_compressions;
+            }
+            ++compressed;
+        });
+    }
+    batch.SetCompletion(DecodePriority::Sampled,
+                        [&] { complete_after_all = decoded == 64 && compressed == 16; });
+    const auto token = batch.Submit();
+    token.Wait();
+
+    REQUIRE(token.IsComplete());
+    REQUIRE(early_compressions == 0);
+    REQUIRE(complete_after_all);
+
+    // A batch with only a completion still runs it
+    bool ran{};
+    batch.SetCompletion(DecodePriority::Prefetch, [&ran] { ran = true; });
+    batch.Submit().Wait();
+    REQUIRE(ran);
+    REQUIRE(batch.Submit().IsComplete());
+}
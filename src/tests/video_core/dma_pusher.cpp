@@ -0,0 +1,267 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/engines/engine_interface.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+
+using Tegra::Engines::EngineInterface;
+using Tegra::Engines::Maxwell3D;
+
+namespace {
+
+constexpr u32 NumRegisters = 0x100;
+
+using Registers = std::array<u32, NumRegisters>;
+
+struct ExecutedCall {
+    u32 method;
+    u32 argument;
+    bool is_last_call;
+    Registers registers;
+
+    bool operator==(const ExecutedCall&) const = default;
+};
+
+/// Register file that records the methods it executes along with the state they saw
+class FakeEngine final : public Tegra::Engines::EngineInterface {
+public:
+    explicit FakeEngine(bool direct_range_writes_) : direct_range_writes{direct_range_writes_} {}
+
+    void CallMethod(u32 method, u32 method_argument, bool is_last_call) override {
+        registers[method] = method_argument;
+        if (execution_mask[method]) {
+            executed.push_back({method, method_argument, is_last_call, registers});
+        }
+    }
+
+    void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override {
+        for (u32 i = 0; i < amount; ++i) {
+            CallMethod(method, base_start[i], methods_pending - i <= 1);
+        }
+    }
+
+    void WriteRegisterRange(u32 method, const u32* base_start, u32 amount) override {
+        if (!direct_range_writes) {
+            EngineInterface::WriteRegisterRange(method, base_start, amount);
+            return;
+        }
+        // Like Maxwell3D, skip the sink and write the register file directly
+        ConsumeSink();
+        std::memcpy(registers.data() + method, base_start, amount * sizeof(u32));
+    }
+
+    Registers registers{};
+    std::vector<ExecutedCall> executed;
+
+private:
+    bool direct_range_writes;
+};
+
+class HeadlessWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+/// Dispatches an incrementing run one method at a time
+void CallPerMethod(EngineInterface& engine, u32 method, const std::vector<u32>& arguments) {
+    const u32 count = static_cast<u32>(arguments.size());
+    for (u32 i = 0; i < count; ++i) {
+        engine.DispatchMethod(method + i, arguments[i], count - i <= 1, 0);
+    }
+}
+
+/// Dispatches an incrementing run the way DmaPusher::ProcessCommands does
+void CallBulk(EngineInterface& engine, u32 method, const std::vector<u32>& arguments) {
+    const u32 count = static_cast<u32>(arguments.size());
+    for (u32 i = 0; i < count;) {
+        const u32 num_written =
+            engine.WriteRegisterRun(method + i, arguments.data() + i, count - i);
+        if (num_written != 0) {
+            i += num_written;
+            continue;
+        }
+        engine.DispatchMethod(method + i, arguments[i], count - i <= 1, 0);
+        ++i;
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DmaPusher[RegisterRange]", "[video_core]") {
+    const std::vector<u32> arguments{10, 11, 12, 13, 14, 15, 16, 17};
+
+    for (const bool direct : {false, true}) {
+        FakeEngine per_method{direct};
+        FakeEngine bulk{direct};
+        per_method.execution_mask[0x14] = true;
+        bulk.execution_mask[0x14] = true;
+
+        REQUIRE(bulk.WriteRegisterRun(0x10, arguments.data(), 8) == 4);
+        // The executable method stops the run
+        REQUIRE(bulk.WriteRegisterRun(0x14, arguments.data() + 4, 4) == 0);
+
+        FakeEngine bulk_run{direct};
+        bulk_run.execution_mask[0x14] = true;
+        CallPerMethod(per_method, 0x10, arguments);
+        CallBulk(bulk_run, 0x10, arguments);
+
+        // The executed method sees every write before it
+        REQUIRE(bulk_run.executed.size() == 1);
+        REQUIRE(bulk_run.executed[0].registers[0x13] == 13);
+        REQUIRE(bulk_run.executed[0].registers[0x15] == 0);
+        REQUIRE(bulk_run.executed == per_method.executed);
+        if (!direct) {
+            REQUIRE(bulk_run.method_sink == per_method.method_sink);
+        }
+
+        per_method.ConsumeSink();
+        bulk_run.ConsumeSink();
+        REQUIRE(bulk_run.registers == per_method.registers);
+    }
+}
+
+TEST_CASE("DmaPusher[RegisterRangeRandom]", "[video_core]") {
+    std::mt19937 rng{0x1234};
+
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const bool direct = iteration % 2 != 0;
+        FakeEngine per_method{direct};
+        FakeEngine bulk{direct};
+        for (u32 method = 0; method < NumRegisters; ++method) {
+            const bool executes = rng() % 6 == 0;
+            per_method.execution_mask[method] = executes;
+            bulk.execution_mask[method] = executes;
+        }
+
+        // Several runs back to back, so writes queued by one run are pending in the next
+        const int num_runs = 1 + static_cast<int>(rng() % 4);
+        for (int run = 0; run < num_runs; ++run) {
+            const u32 count = 1 + rng() % 32;
+            const u32 method = rng() % (NumRegisters - count);
+            std::vector<u32> arguments(count);
+            for (u32& argument : arguments) {
+                argument = static_cast<u32>(rng());
+            }
+            CallPerMethod(per_method, method, arguments);
+            CallBulk(bulk, method, arguments);
+
+            REQUIRE(bulk.executed == per_method.executed);
+            if (!direct) {
+                REQUIRE(bulk.method_sink == per_method.method_sink);
+                REQUIRE(bulk.registers == per_method.registers);
+            }
+        }
+
+        per_method.ConsumeSink();
+        bulk.ConsumeSink();
+        REQUIRE(bulk.registers == per_method.registers);
+    }
+}
+
+TEST_CASE("DmaPusher[Maxwell3DRegisterRange]", "[video_core]") {
+    using ShadowRamControl = Maxwell3D::Regs::ShadowRamControl;
+    constexpr u32 ShadowRamControlMethod = MAXWELL3D_REG_INDEX(shadow_ram_control);
+
+    const auto renderer_backend = Settings::values.renderer_backend.GetValue();
+    const bool use_asynchronous_gpu = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.renderer_backend.SetValue(renderer_backend);
+        Settings::values.use_asynchronous_gpu_emulation.SetValue(use_asynchronous_gpu);
+    };
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    Core::System system;
+    system.Initialize();
+    HeadlessWindow window;
+    REQUIRE(system.SetupForGPUReplay(window) == Core::SystemResultStatus::Success);
+    system.GPU().Start();
+    {
+        // The null rasterizer sets up the dirty tables and ranges of the channels
+        const auto memory_manager = std::make_shared<Tegra::MemoryManager>(system);
+        system.GPU().InitAddressSpace(*memory_manager);
+        const auto make_channel = [&] {
+            auto channel = system.GPU().AllocateChannel();
+            channel->memory_manager = memory_manager;
+            system.GPU().InitChannel(*channel, 0);
+            return channel;
+        };
+        const auto per_method_channel = make_channel();
+        const auto bulk_channel = make_channel();
+        Maxwell3D& per_method = *per_method_channel->maxwell_3d;
+        Maxwell3D& bulk = *bulk_channel->maxwell_3d;
+        REQUIRE(!bulk.dirty.ranges.empty());
+
+        std::mt19937 rng{0x5678};
+        // With the dirty ranges, then with the tables alone
+        for (const bool use_ranges : {true, false}) {
+            if (!use_ranges) {
+                per_method.dirty.ranges.clear();
+                bulk.dirty.ranges.clear();
+            }
+            for (int iteration = 0; iteration < 200; ++iteration) {
+                // Replay writes the values tracked by the previous iterations
+                const auto control = static_cast<ShadowRamControl>(rng() % 4);
+                for (Maxwell3D* engine : {&per_method, &bulk}) {
+                    engine->DispatchMethod(ShadowRamControlMethod, static_cast<u32>(control),
+                                           true, 0);
+                    engine->dirty.flags.reset();
+                }
+
+                const int num_runs = 1 + static_cast<int>(rng() % 8);
+                for (int run = 0; run < num_runs;) {
+                    const u32 count = 1 + rng() % 48;
+                    const u32 method = rng() % (Maxwell3D::Regs::NUM_REGS - count);
+                    bool executes = false;
+                    for (u32 i = 0; i < count; ++i) {
+                        executes |= bulk.execution_mask[method + i];
+                    }
+                    if (executes) {
+                        // Executed methods have side effects beyond the registers
+                        continue;
+                    }
+                    // Rewrite some registers with the values they hold, those aren't dirty
+                    std::vector<u32> arguments(count);
+                    for (u32 i = 0; i < count; ++i) {
+                        arguments[i] = rng() % 2 == 0 ? per_method.regs.reg_array[method + i]
+                                                      : static_cast<u32>(rng());
+                    }
+                    CallPerMethod(per_method, method, arguments);
+                    CallBulk(bulk, method, arguments);
+                    ++run;
+                }
+
+                per_method.ConsumeSink();
+                bulk.ConsumeSink();
+                REQUIRE(bulk.dirty.flags == per_method.dirty.flags);
+                REQUIRE(bulk.regs.reg_array == per_method.regs.reg_array);
+                REQUIRE(bulk.shadow_state.reg_array == per_method.shadow_state.reg_array);
+            }
+        }
+    }
+    system.ShutdownMainProcess();
+}
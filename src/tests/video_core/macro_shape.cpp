@@ -0,0 +1,296 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_shape.h"
+
+using namespace Tegra::Macro;
+using Maxwell3D = Tegra::Engines::Maxwell3D;
+
+namespace {
+
+constexpr u32 REG_DRAW_END = MAXWELL3D_REG_INDEX(draw.end);
+constexpr u32 REG_DRAW_BEGIN = MAXWELL3D_REG_INDEX(draw.begin);
+constexpr u32 REG_VERTEX_FIRST = MAXWELL3D_REG_INDEX(vertex_buffer.first);
+constexpr u32 REG_BASE_INSTANCE = MAXWELL3D_REG_INDEX(global_base_instance_index);
+constexpr u32 REG_INSTANCE_MASK = 0xD1B;
+constexpr u32 REG_CLEAR_SURFACE = MAXWELL3D_REG_INDEX(clear_surface);
+constexpr u32 REG_RT_DEPTH = MAXWELL3D_REG_INDEX(rt) + 6;
+constexpr u32 REG_CB_SIZE = MAXWELL3D_REG_INDEX(const_buffer.size);
+constexpr u32 REG_CB_OFFSET = MAXWELL3D_REG_INDEX(const_buffer.offset);
+constexpr u32 REG_CB_DATA = MAXWELL3D_REG_INDEX(const_buffer.buffer);
+
+/// Method address with an increment of one, for consecutive register writes
+constexpr u32 Incrementing(u32 method) {
+    return method | (1U << 12);
+}
+
+/// Minimal assembler for the macro instructions the tests need
+struct Assembler {
+    Opcode& Emit(Operation operation, ResultOperation result, u32 dst, u32 src_a) {
+        Opcode& opcode = code.emplace_back();
+        opcode.raw = 0;
+        opcode.operation.Assign(operation);
+        opcode.result_operation.Assign(result);
+        opcode.dst.Assign(dst);
+        opcode.src_a.Assign(src_a);
+        return opcode;
+    }
+
+    void AddImmediate(ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+        Emit(Operation::AddImmediate, result, dst, src_a).immediate.Assign(immediate);
+    }
+
+    void Alu(ALUOperation operation, ResultOperation result, u32 dst, u32 src_a, u32 src_b) {
+        Opcode& opcode = Emit(Operation::ALU, result, dst, src_a);
+        opcode.src_b.Assign(src_b);
+        opcode.alu_operation.Assign(operation);
+    }
+
+    void Insert(ResultOperation result, u32 dst, u32 src_a, u32 src_b, u32 src_bit, u32 size,
+                u32 dst_bit) {
+        Opcode& opcode = Emit(Operation::ExtractInsert, result, dst, src_a);
+        opcode.src_b.Assign(src_b);
+        opcode.bf_src_bit.Assign(src_bit);
+        opcode.bf_size.Assign(size);
+        opcode.bf_dst_bit.Assign(dst_bit);
+    }
+
+    void Read(u32 dst, u32 src_a, s32 immediate) {
+        Emit(Operation::Read, ResultOperation::Move, dst, src_a).immediate.Assign(immediate);
+    }
+
+    void Fetch(u32 dst) {
+        AddImmediate(ResultOperation::IgnoreAndFetch, dst, 0, 0);
+    }
+
+    void SetMethod(u32 method) {
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, static_cast<s32>(method));
+    }
+
+    void Send(u32 src) {
+        AddImmediate(ResultOperation::MoveAndSend, 0, src, 0);
+    }
+
+    /// Branches without delay slot, offset in instructions from the branch
+    void Branch(BranchCondition condition, u32 src, s32 offset) {
+        Opcode& opcode = Emit(Operation::Branch, ResultOperation::IgnoreAndFetch, 0, src);
+        opcode.branch_condition.Assign(condition);
+        opcode.branch_annul.Assign(1);
+        opcode.immediate.Assign(offset);
+    }
+
+    void Exit() {
+        AddImmediate(ResultOperation::Move, 0, 0, 0);
+        code.back().is_exit.Assign(1);
+        AddImmediate(ResultOperation::Move, 0, 0, 0);
+    }
+
+    [[nodiscard]] s32 Here() const {
+        return static_cast<s32>(code.size());
+    }
+
+    [[nodiscard]] std::vector<u32> Code() const {
+        std::vector<u32> words;
+        for (const Opcode& opcode : code) {
+            words.push_back(opcode.raw);
+        }
+        return words;
+    }
+
+    std::vector<Opcode> code;
+};
+
+struct ClearConstBufferVariant {
+    u32 size = 0x5F00;
+    u32 data_method = REG_CB_DATA;
+    s32 clear_value = 0;
+};
+
+/// Sets a constant buffer of a fixed size at the address in the first two parameters and clears
+/// four words per unit of the third parameter
+std::vector<u32> ClearConstBuffer(const ClearConstBufferVariant& variant) {
+    Assembler a;
+    a.SetMethod(Incrementing(REG_CB_SIZE));
+    a.AddImmediate(ResultOperation::MoveAndSend, 0, 0, static_cast<s32>(variant.size));
+    a.AddImmediate(ResultOperation::FetchAndSend, 2, 1, 0);
+    a.AddImmediate(ResultOperation::FetchAndSend, 3, 2, 0);
+    a.Send(0);
+    a.SetMethod(variant.data_method);
+    a.AddImmediate(ResultOperation::Move, 4, 0, variant.clear_value);
+    const s32 skip = a.Here();
+    a.Branch(BranchCondition::Zero, 3, 0);
+    const s32 loop = a.Here();
+    for (int i = 0; i < 4; ++i) {
+        a.Send(4);
+    }
+    a.AddImmediate(ResultOperation::Move, 3, 3, -1);
+    a.Branch(BranchCondition::NotZero, 3, loop - a.Here());
+    a.code[skip].immediate.Assign(a.Here() - skip);
+    a.Exit();
+    return a.Code();
+}
+
+struct MultiLayerClearVariant {
+    u32 depth_register = REG_RT_DEPTH;
+    u32 layer_bit = 10;
+    s32 depth_mask = 0xFFFF;
+};
+
+/// Clears every layer of the render target selected by the clear parameter
+std::vector<u32> MultiLayerClear(const MultiLayerClearVariant& variant) {
+    Assembler a;
+    // Render target configs are 16 registers apart
+    a.Insert(ResultOperation::Move, 2, 0, 1, 6, 4, 4);
+    a.Read(3, 2, static_cast<s32>(variant.depth_register));
+    a.AddImmediate(ResultOperation::Move, 4, 0, variant.depth_mask);
+    a.Alu(ALUOperation::And, ResultOperation::Move, 3, 3, 4);
+    a.SetMethod(REG_CLEAR_SURFACE);
+    const s32 skip = a.Here();
+    a.Branch(BranchCondition::Zero, 3, 0);
+    const s32 loop = a.Here();
+    a.Insert(ResultOperation::MoveAndSend, 6, 1, 5, 0, 16, variant.layer_bit);
+    a.AddImmediate(ResultOperation::Move, 5, 5, 1);
+    a.Alu(ALUOperation::Subtract, ResultOperation::Move, 7, 3, 5);
+    a.Branch(BranchCondition::NotZero, 7, loop - a.Here());
+    a.code[skip].immediate.Assign(a.Here() - skip);
+    a.Exit();
+    return a.Code();
+}
+
+struct DrawArraysVariant {
+    u32 instance_mask_register = REG_INSTANCE_MASK;
+    s32 final_base_instance = 0;
+    u32 instance_id_bit = 26;
+    bool apply_instance_mask = true;
+    bool clear_on_magic_first = false;
+};
+
+/// Draws the indirect parameters (topology, count, instances, first, base instance)
+std::vector<u32> DrawArraysIndirect(const DrawArraysVariant& variant) {
+    Assembler a;
+    a.Fetch(2);
+    a.Fetch(3);
+    a.Fetch(4);
+    a.Fetch(5);
+    if (variant.clear_on_magic_first) {
+        // Clears the screen when the first vertex is a value no random probe will pick
+        a.AddImmediate(ResultOperation::Move, 7, 4, -0x1234);
+        a.Branch(BranchCondition::NotZero, 7, 3);
+        a.SetMethod(REG_CLEAR_SURFACE);
+        a.Send(0);
+    }
+    if (variant.apply_instance_mask) {
+        a.Read(6, 0, static_cast<s32>(variant.instance_mask_register));
+        a.Alu(ALUOperation::And, ResultOperation::Move, 3, 6, 3);
+    }
+    a.AddImmediate(ResultOperation::Move, 7, 0, 1);
+    a.SetMethod(Incrementing(REG_VERTEX_FIRST));
+    a.Send(4);
+    a.Send(2);
+    a.SetMethod(REG_BASE_INSTANCE);
+    a.Send(5);
+    const s32 skip = a.Here();
+    a.Branch(BranchCondition::Zero, 3, 0);
+    const s32 loop = a.Here();
+    a.SetMethod(REG_DRAW_BEGIN);
+    a.Send(1);
+    a.SetMethod(REG_DRAW_END);
+    a.Send(0);
+    // Instances after the first one are drawn as subsequent instances
+    a.Insert(ResultOperation::Move, 1, 1, 7, 0, 1, variant.instance_id_bit);
+    a.AddImmediate(ResultOperation::Move, 3, 3, -1);
+    a.Branch(BranchCondition::NotZero, 3, loop - a.Here());
+    a.code[skip].immediate.Assign(a.Here() - skip);
+    a.SetMethod(REG_BASE_INSTANCE);
+    a.AddImmediate(ResultOperation::MoveAndSend, 0, 0, variant.final_base_instance);
+    a.Exit();
+    return a.Code();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MacroShape[ClearConstBuffer]", "[video_core]") {
+    const DetectedShape detected = DetectShape(ClearConstBuffer({}));
+    REQUIRE(detected.shape == MacroShape::ClearConstBuffer);
+    REQUIRE(detected.const_buffer_size == 0x5F00);
+
+    // Other sizes are clears of a different size, not different macros
+    const DetectedShape resized = DetectShape(ClearConstBuffer({.size = 0x100}));
+    REQUIRE(resized.shape == MacroShape::ClearConstBuffer);
+    REQUIRE(resized.const_buffer_size == 0x100);
+
+    REQUIRE(DetectShape(ClearConstBuffer({.size = 0x5F02})).shape == MacroShape::None);
+    REQUIRE(DetectShape(ClearConstBuffer({.data_method = REG_CB_OFFSET})).shape ==
+            MacroShape::None);
+    REQUIRE(DetectShape(ClearConstBuffer({.clear_value = 1})).shape == MacroShape::None);
+}
+
+TEST_CASE("MacroShape[MultiLayerClear]", "[video_core]") {
+    REQUIRE(DetectShape(MultiLayerClear({})).shape == MacroShape::MultiLayerClear);
+
+    // Reading the array pitch instead of the depth, or writing the layer one bit off
+    REQUIRE(DetectShape(MultiLayerClear({.depth_register = REG_RT_DEPTH + 1})).shape ==
+            MacroShape::None);
+    REQUIRE(DetectShape(MultiLayerClear({.layer_bit = 11})).shape == MacroShape::None);
+}
+
+TEST_CASE("MacroShape[DrawArraysIndirect]", "[video_core]") {
+    REQUIRE(DetectShape(DrawArraysIndirect({})).shape == MacroShape::DrawArraysIndirect);
+
+    REQUIRE(DetectShape(DrawArraysIndirect({.instance_mask_register = REG_INSTANCE_MASK + 1}))
+                .shape == MacroShape::None);
+    REQUIRE(DetectShape(DrawArraysIndirect({.final_base_instance = 1})).shape ==
+            MacroShape::None);
+    REQUIRE(DetectShape(DrawArraysIndirect({.instance_id_bit = 27})).shape == MacroShape::None);
+}
+
+TEST_CASE("MacroShape[Dataflow]", "[video_core]") {
+    const DataflowInfo info = AnalyzeDataflow(DrawArraysIndirect({}));
+    REQUIRE(info.valid);
+    REQUIRE(!info.dynamic_reads);
+    REQUIRE(!info.dynamic_sends);
+    REQUIRE(info.known_reads == std::set<u32>{REG_INSTANCE_MASK});
+    REQUIRE(info.known_sends.contains(REG_DRAW_BEGIN));
+    REQUIRE(info.known_sends.contains(REG_DRAW_END));
+
+    // Branching past the end of the code is malformed
+    std::vector<u32> code = ClearConstBuffer({});
+    code.resize(code.size() - 2);
+    REQUIRE(!AnalyzeDataflow(code).valid);
+    REQUIRE(DetectShape(code).shape == MacroShape::None);
+    REQUIRE(!AnalyzeDataflow({}).valid);
+}
+
+TEST_CASE("MacroShape[Footprint]", "[video_core]") {
+    // The extra clear is never reached by a probe, the dataflow pass still sees it
+    const std::vector<u32> code = DrawArraysIndirect({.clear_on_magic_first = true});
+    const DataflowInfo info = AnalyzeDataflow(code);
+    REQUIRE(info.valid);
+    REQUIRE(info.known_sends.contains(REG_CLEAR_SURFACE));
+    REQUIRE(DetectShape(code).shape == MacroShape::None);
+
+    // Render target indices are enumerated from the four bits of the clear selecting them
+    const DataflowInfo clear_info = AnalyzeDataflow(MultiLayerClear({}));
+    REQUIRE(clear_info.valid);
+    REQUIRE(!clear_info.dynamic_reads);
+    REQUIRE(clear_info.known_reads.size() == 16);
+    REQUIRE(clear_info.known_reads.contains(REG_RT_DEPTH));
+    REQUIRE(clear_info.known_sends == std::set<u32>{REG_CLEAR_SURFACE});
+}
+
+TEST_CASE("MacroShape[EdgeProbes]", "[video_core]") {
+    // Random probes enable every instance they draw, only a cleared mask tells these apart
+    REQUIRE(DetectShape(DrawArraysIndirect({.apply_instance_mask = false})).shape ==
+            MacroShape::None);
+
+    // Random probes use a handful of layers, only a render target with every layer does
+    REQUIRE(DetectShape(MultiLayerClear({.depth_mask = 0xFF})).shape == MacroShape::None);
+}
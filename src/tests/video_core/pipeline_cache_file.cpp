@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/pipeline_cache_file.h"
+
+using VideoCommon::FileEnvironment;
+using VideoCommon::GenericEnvironment;
+using VideoCommon::PipelineCacheFile;
+
+namespace {
+
+constexpr u32 CacheVersion = 1;
+
+/// Environment of a shader of 8 instructions which read one constant buffer value
+class TestEnvironment final : public GenericEnvironment {
+public:
+    explicit TestEnvironment(u32 seed, Shader::Stage stage_) {
+        stage = stage_;
+        code.resize(8);
+        for (u32 i = 0; i < 8; ++i) {
+            code[i] = seed * 100 + i;
+        }
+        cached_lowest = 0;
+        cached_highest = 7 * sizeof(u64);
+        cbuf_values.emplace(seed, seed + 1);
+    }
+
+    u32 ReadCbufValue(u32, u32) override {
+        return 0;
+    }
+
+    Shader::TextureType ReadTextureType(u32) override {
+        return {};
+    }
+
+    Shader::TexturePixelFormat ReadTexturePixelFormat(u32) override {
+        return {};
+    }
+
+    bool IsTexturePixelFormatInteger(u32) override {
+        return false;
+    }
+
+    u32 ReadViewportTransformState() override {
+        return 1;
+    }
+
+    std::optional<Shader::ReplaceConstant> GetReplaceConstBuffer(u32, u32) override {
+        return std::nullopt;
+    }
+};
+
+struct TestKey {
+    u64 id;
+    u64 seed;
+};
+
+/// Loads the pipelines of a cache, checking their environments, and returns their ids
+std::vector<u64> LoadIds(PipelineCacheFile& cache) {
+    std::vector<u64> ids;
+    cache.LoadPipelines(
+        {},
+        [&](std::istream& file, FileEnvironment env, PipelineCacheFile::HostShaders) {
+            TestKey key;
+            file.read(reinterpret_cast<char*>(&key), sizeof(key));
+            REQUIRE(env.ReadInstruction(sizeof(u64)) == key.seed * 100 + 1);
+            ids.push_back(key.id);
+        },
+        [&](std::istream& file, std::vector<FileEnvironment> envs, PipelineCacheFile::HostShaders) {
+            TestKey key;
+            file.read(reinterpret_cast<char*>(&key), sizeof(key));
+            REQUIRE(envs.size() == 2);
+            REQUIRE(envs[0].ReadCbufValue(0, 7) == 8);
+            REQUIRE(envs[1].ReadCbufValue(0, static_cast<u32>(key.seed)) == key.seed + 1);
+            ids.push_back(key.id);
+        });
+    return ids;
+}
+
+void AddCompute(PipelineCacheFile& cache, u64 id, std::span<const u8> host_shaders = {}) {
+    const TestEnvironment env{static_cast<u32>(id), Shader::Stage::Compute};
+    cache.SerializePipeline(TestKey{id, id}, std::array<const GenericEnvironment*, 1>{&env},
+                            host_shaders);
+}
+
+/// Loads the compute pipelines of a cache and returns their host shaders
+std::vector<PipelineCacheFile::HostShaders> LoadHostShaders(PipelineCacheFile& cache) {
+    std::vector<PipelineCacheFile::HostShaders> host_shaders;
+    cache.LoadPipelines(
+        {},
+        [&](std::istream&, FileEnvironment, PipelineCacheFile::HostShaders shaders) {
+            host_shaders.push_back(std::move(shaders));
+        },
+        [](std::istream&, std::vector<FileEnvironment>, PipelineCacheFile::HostShaders) {});
+    return host_shaders;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PipelineCacheFile[RoundTrip]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_pipeline_cache_test.bin";
+    std::filesystem::remove(path);
+
+    std::vector<u64> expected;
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion);
+        REQUIRE(cache.IsOpen());
+
+        // Every graphics pipeline shares its vertex shader
+        const TestEnvironment vertex{7, Shader::Stage::VertexB};
+        for (u64 id = 0; id < 40; ++id) {
+            const TestEnvironment fragment{static_cast<u32>(1000 + id), Shader::Stage::Fragment};
+            cache.SerializePipeline(TestKey{id, 1000 + id},
+                                    std::array<const GenericEnvironment*, 2>{&vertex, &fragment});
+            expected.push_back(id);
+        }
+        AddCompute(cache, 40);
+        expected.push_back(40);
+    }
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion);
+        REQUIRE(LoadIds(cache) == expected);
+        AddCompute(cache, 41);
+        expected.push_back(41);
+    }
+
+    // A record cut short by a crash is dropped, the ones before it are kept
+    {
+        Common::FS::IOFile file{path, Common::FS::FileAccessMode::Append};
+        REQUIRE(file.WriteString(std::string_view{"partial"}) == 7);
+    }
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion);
+        REQUIRE(LoadIds(cache) == expected);
+    }
+
+    // Pipelines of another version are skipped and replaced by the ones built again
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion + 1);
+        REQUIRE(LoadIds(cache).empty());
+        AddCompute(cache, 42);
+    }
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion + 1);
+        REQUIRE(LoadIds(cache) == std::vector<u64>{42});
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCacheFile[HostShaders]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_host_shaders_test.bin";
+    std::filesystem::remove(path);
+
+    constexpr u64 HostShaderKey = 0x1234;
+    const std::vector<u8> shaders{1, 2, 3, 4, 5};
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        AddCompute(cache, 0, shaders);
+        AddCompute(cache, 1);
+    }
+    u64 missing_hash;
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        const auto loaded = LoadHostShaders(cache);
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[0].data == shaders);
+        REQUIRE(loaded[1].data.empty());
+        REQUIRE(loaded[0].hash != loaded[1].hash);
+
+        // Pipelines loaded without host shaders get them once built
+        missing_hash = loaded[1].hash;
+        cache.SerializeHostShaders(missing_hash, shaders);
+    }
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        const auto loaded = LoadHostShaders(cache);
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[1].hash == missing_hash);
+        REQUIRE(loaded[1].data == shaders);
+    }
+
+    // Host shaders built by another recompiler or for another host are ignored
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey + 1);
+        const auto loaded = LoadHostShaders(cache);
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[0].data.empty());
+        REQUIRE(loaded[1].data.empty());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCacheFile[SerializeWhileLoading]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_cache_loading_test.bin";
+    std::filesystem::remove(path);
+
+    constexpr u64 HostShaderKey = 0x1234;
+    const std::vector<u8> shaders{6, 7, 8};
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        AddCompute(cache, 0);
+        AddCompute(cache, 1);
+    }
+    {
+        // Backends append the host shaders of a pipeline from the thread building it
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        size_t num_loaded = 0;
+        cache.LoadPipelines(
+            {},
+            [&](std::istream&, FileEnvironment, PipelineCacheFile::HostShaders host_shaders) {
+                REQUIRE(host_shaders.data.empty());
+                cache.SerializeHostShaders(host_shaders.hash, shaders);
+                ++num_loaded;
+            },
+            [](std::istream&, std::vector<FileEnvironment>, PipelineCacheFile::HostShaders) {});
+        REQUIRE(num_loaded == 2);
+    }
+    {
+        PipelineCacheFile cache;
+        cache.Open(path, CacheVersion, HostShaderKey);
+        const auto loaded = LoadHostShaders(cache);
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[0].data == shaders);
+        REQUIRE(loaded[1].data == shaders);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+
+using namespace Tegra::Texture;
+
+namespace {
+
+constexpr std::array<u32, 8> BYTES_PER_PIXEL{1, 2, 3, 4, 6, 8, 12, 16};
+constexpr SwizzleTable SWIZZLE_TABLE = MakeSwizzleTable();
+
+/// Block linear layout, addressed one byte at a time straight from the GOB definition
+struct Layout {
+    explicit Layout(u32 stride, u32 height, u32 block_height_, u32 block_depth_)
+        : block_height{block_height_}, block_depth{block_depth_} {
+        const u32 gobs_in_x = Common::DivCeil(stride, GOB_SIZE_X);
+        block_size = gobs_in_x * (GOB_SIZE << (block_height + block_depth));
+        slice_size = Common::DivCeil(height, GOB_SIZE_Y << block_height) * block_size;
+    }
+
+    [[nodiscard]] size_t Size(u32 depth) const {
+        return Common::DivCeil(depth, 1U << block_depth) * size_t{slice_size};
+    }
+
+    [[nodiscard]] size_t Offset(u32 x, u32 y, u32 z) const {
+        const u32 gob_y = y / GOB_SIZE_Y;
+        return size_t{z >> block_depth} * slice_size +
+               ((z & ((1U << block_depth) - 1)) << (GOB_SIZE_SHIFT + block_height)) +
+               (gob_y >> block_height) * block_size +
+               ((gob_y & ((1U << block_height) - 1)) << GOB_SIZE_SHIFT) +
+               ((x / GOB_SIZE_X) << (GOB_SIZE_SHIFT + block_height + block_depth)) +
+               SWIZZLE_TABLE[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+    }
+
+    u32 block_height;
+    u32 block_depth;
+    u32 block_size;
+    u32 slice_size;
+};
+
+struct TextureCase {
+    u32 bytes_per_pixel;
+    u32 width;
+    u32 height;
+    u32 depth;
+    u32 block_height;
+    u32 block_depth;
+    u32 stride_alignment;
+};
+
+TextureCase RandomTexture(std::mt19937& rng) {
+    const auto random = [&rng](u32 min, u32 max) {
+        return std::uniform_int_distribution<u32>{min, max}(rng);
+    };
+    return TextureCase{
+        .bytes_per_pixel = BYTES_PER_PIXEL[random(0, BYTES_PER_PIXEL.size() - 1)],
+        .width = random(1, 160),
+        .height = random(1, 80),
+        .depth = random(1, 5),
+        .block_height = random(0, 4),
+        .block_depth = random(0, 2),
+        .stride_alignment = random(0, 6),
+    };
+}
+
+std::vector<u8> RandomBytes(std::mt19937& rng, size_t size) {
+    std::vector<u8> bytes(size);
+    std::ranges::generate(bytes, [&rng] { return static_cast<u8>(rng()); });
+    return bytes;
+}
+
+/// Layout of a whole texture as swizzled by SwizzleTexture and UnswizzleTexture
+Layout TextureLayout(const TextureCase& test) {
+    const u32 stride =
+        Common::AlignUpLog2(test.width, test.stride_alignment) * test.bytes_per_pixel;
+    return Layout{stride, test.height, test.block_height, test.block_depth};
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Swizzle[Texture]", "[video_core]") {
+    std::mt19937 rng{0x5a17};
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        const TextureCase test = RandomTexture(rng);
+        const Layout layout = TextureLayout(test);
+        const u32 pitch = test.width * test.bytes_per_pixel;
+        const size_t linear_size = size_t{pitch} * test.height * test.depth;
+
+        const std::vector<u8> linear = RandomBytes(rng, linear_size);
+        const std::vector<u8> swizzled = RandomBytes(rng, layout.Size(test.depth));
+
+        // Padding of the swizzled image has to be left untouched
+        std::vector<u8> expected_swizzled(layout.Size(test.depth), 0xcd);
+        std::vector<u8> expected_linear(linear_size);
+        for (u32 z = 0; z < test.depth; ++z) {
+            for (u32 y = 0; y < test.height; ++y) {
+                for (u32 x = 0; x < pitch; ++x) {
+                    const size_t linear_offset = (size_t{z} * test.height + y) * pitch + x;
+                    const size_t swizzled_offset = layout.Offset(x, y, z);
+                    expected_swizzled[swizzled_offset] = linear[linear_offset];
+                    expected_linear[linear_offset] = swizzled[swizzled_offset];
+                }
+            }
+        }
+
+        std::vector<u8> swizzle_output(layout.Size(test.depth), 0xcd);
+        SwizzleTexture(swizzle_output, linear, test.bytes_per_pixel, test.width, test.height,
+                       test.depth, test.block_height, test.block_depth, test.stride_alignment);
+        std::vector<u8> unswizzle_output(linear_size);
+        UnswizzleTexture(unswizzle_output, swizzled, test.bytes_per_pixel, test.width, test.height,
+                         test.depth, test.block_height, test.block_depth, test.stride_alignment);
+
+        REQUIRE(swizzle_output == expected_swizzled);
+        REQUIRE(unswizzle_output == expected_linear);
+    }
+}
+
+TEST_CASE("Swizzle[Subrect]", "[video_core]") {
+    std::mt19937 rng{0x5b17};
+    const auto random = [&rng](u32 min, u32 max) {
+        return std::uniform_int_distribution<u32>{min, max}(rng);
+    };
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        const TextureCase test = RandomTexture(rng);
+        const u32 bpp = test.bytes_per_pixel;
+        const u32 origin_x = random(0, test.width - 1);
+        const u32 origin_y = random(0, test.height - 1);
+        const u32 extent_x = random(1, test.width - origin_x);
+        // Lines past the end of the first slice continue in the following ones
+        const u32 extent_y = random(1, test.height * test.depth);
+        const u32 pitch_linear = extent_x * bpp + random(0, 3) * bpp;
+        const Layout layout{Common::AlignUpLog2(test.width * bpp, GOB_SIZE_X_SHIFT), test.height,
+                            test.block_height, test.block_depth};
+        const size_t linear_size = size_t{pitch_linear} * test.height * test.depth;
+
+        const std::vector<u8> linear = RandomBytes(rng, linear_size);
+        // Texels crossing the end of the last GOB line write past the image
+        const size_t swizzled_size = layout.Size(test.depth) + 16;
+        const std::vector<u8> swizzled = RandomBytes(rng, swizzled_size);
+
+        std::vector<u8> expected_swizzled(swizzled_size, 0xcd);
+        std::vector<u8> expected_linear(linear_size, 0xcd);
+        u32 unprocessed_lines = extent_y;
+        const u32 lines_per_slice = std::min(extent_y, test.height - origin_y);
+        for (u32 z = 0; z < test.depth && unprocessed_lines != 0; ++z) {
+            const u32 lines = std::min(unprocessed_lines, lines_per_slice);
+            for (u32 line = 0; line < lines; ++line) {
+                for (u32 column = 0; column < extent_x; ++column) {
+                    // Texels are moved whole from the swizzled offset of their first byte, 3, 6
+                    // and 12 byte texels crossing a 16 byte chunk are not split
+                    const size_t linear_offset =
+                        (size_t{z} * test.height + line) * pitch_linear + column * bpp;
+                    const size_t swizzled_offset =
+                        layout.Offset((origin_x + column) * bpp, origin_y + line, z);
+                    for (u32 byte = 0; byte < bpp; ++byte) {
+                        expected_swizzled[swizzled_offset + byte] = linear[linear_offset + byte];
+                        expected_linear[linear_offset + byte] = swizzled[swizzled_offset + byte];
+                    }
+                }
+            }
+            unprocessed_lines -= lines;
+        }
+
+        std::vector<u8> swizzle_output(swizzled_size, 0xcd);
+        SwizzleSubrect(swizzle_output, linear, bpp, test.width, test.height, test.depth, origin_x,
+                       origin_y, extent_x, extent_y, test.block_height, test.block_depth,
+                       pitch_linear);
+        std::vector<u8> unswizzle_output(linear_size, 0xcd);
+        UnswizzleSubrect(unswizzle_output, swizzled, bpp, test.width, test.height, test.depth,
+                         origin_x, origin_y, extent_x, extent_y, test.block_height,
+                         test.block_depth, pitch_linear);
+
+        REQUIRE(swizzle_output == expected_swizzled);
+        REQUIRE(unswizzle_output == expected_linear);
+    }
+}
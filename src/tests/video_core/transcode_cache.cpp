@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+using VideoCommon::TranscodeCache;
+using VideoCommon::TranscodeKey;
+
+namespace {
+
+/// Size of the records of 64 byte levels, header included
+constexpr u64 RecordSize = 48 + 64;
+
+std::vector<u8> MakeLevel(u8 seed) {
+    std::vector<u8> level(64);
+    for (size_t i = 0; i < level.size(); ++i) {
+        level[i] = static_cast<u8>(seed + i);
+    }
+    return level;
+}
+
+TranscodeKey MakeKey(u8 seed) {
+    const std::vector<u8> guest(16, seed);
+    return VideoCommon::MakeTranscodeKey(guest, VideoCore::Surface::PixelFormat::ASTC_2D_4X4_UNORM,
+                                         VideoCommon::TranscodeMode::AstcToRgba8,
+                                         VideoCommon::Extent3D{4, 4, 1});
+}
+
+/// Returns true when the cache holds the level of seed
+bool HasLevel(TranscodeCache& cache, u8 seed) {
+    std::vector<u8> output(64);
+    const std::optional<size_t> buffer_size = cache.Find(MakeKey(seed), output);
+    if (!buffer_size) {
+        return false;
+    }
+    REQUIRE(*buffer_size == 128u + seed);
+    REQUIRE(output == MakeLevel(seed));
+    return true;
+}
+
+void InsertLevel(TranscodeCache& cache, u8 seed) {
+    cache.Insert(MakeKey(seed), MakeLevel(seed), 128u + seed);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("TranscodeCache[RoundTrip]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_transcode_cache_test.bin";
+    std::filesystem::remove(path);
+    {
+        TranscodeCache cache;
+        cache.Open(path, 1ULL << 20);
+        REQUIRE(cache.IsOpen());
+        REQUIRE(!HasLevel(cache, 1));
+        InsertLevel(cache, 1);
+        InsertLevel(cache, 2);
+
+        // New entries are read back from the file, they are not mapped yet
+        REQUIRE(HasLevel(cache, 1));
+        REQUIRE(HasLevel(cache, 2));
+
+        // Size mismatches are misses
+        std::vector<u8> small(32);
+        REQUIRE(!cache.Find(MakeKey(1), small));
+        REQUIRE(cache.Hits() == 2);
+        REQUIRE(cache.Misses() == 2);
+    }
+    {
+        // Entries of the previous session are read from the mapping
+        TranscodeCache cache;
+        cache.Open(path, 1ULL << 20);
+        REQUIRE(HasLevel(cache, 1));
+        REQUIRE(HasLevel(cache, 2));
+        cache.Close();
+        REQUIRE(!cache.IsOpen());
+    }
+    {
+        // A record cut short is dropped, the valid ones are kept
+        Common::FS::IOFile file{path, Common::FS::FileAccessMode::Append};
+        const std::array<u8, 20> partial_record{};
+        REQUIRE(file.WriteSpan(std::span<const u8>(partial_record)) == partial_record.size());
+    }
+    {
+        TranscodeCache cache;
+        cache.Open(path, 1ULL << 20);
+        REQUIRE(HasLevel(cache, 1));
+        REQUIRE(HasLevel(cache, 2));
+        InsertLevel(cache, 3);
+        REQUIRE(HasLevel(cache, 3));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TranscodeCache[Eviction]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "citron_transcode_evict_test.bin";
+    std::filesystem::remove(path);
+    {
+        TranscodeCache cache;
+        cache.Open(path, RecordSize * 3);
+        InsertLevel(cache, 1);
+        InsertLevel(cache, 2);
+        InsertLevel(cache, 3);
+
+        // Finding level 1 makes level 2 the least recently used
+        REQUIRE(HasLevel(cache, 1));
+        InsertLevel(cache, 4);
+        REQUIRE(!HasLevel(cache, 2));
+        REQUIRE(HasLevel(cache, 1));
+        REQUIRE(HasLevel(cache, 3));
+        REQUIRE(HasLevel(cache, 4));
+    }
+    // Closing compacted the evicted record away
+    REQUIRE(std::filesystem::file_size(path) == 16 + RecordSize * 3);
+    {
+        TranscodeCache cache;
+        cache.Open(path, RecordSize * 3);
+        REQUIRE(HasLevel(cache, 1));
+        REQUIRE(HasLevel(cache, 3));
+        REQUIRE(HasLevel(cache, 4));
+        REQUIRE(!HasLevel(cache, 2));
+    }
+    {
+        // A smaller budget evicts the least recently used entries on load
+        TranscodeCache cache;
+        cache.Open(path, RecordSize);
+        REQUIRE(!HasLevel(cache, 1));
+        REQUIRE(!HasLevel(cache, 3));
+        REQUIRE(HasLevel(cache, 4));
+    }
+    REQUIRE(std::filesystem::file_size(path) == 16 + RecordSize);
+    std::filesystem::remove(path);
+}
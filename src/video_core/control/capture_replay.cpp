@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "core/hle/kernel/k_memory_manager.h"
+#include "core/hle/kernel/kernel.h"
+#include "video_core/control/capture_replay.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/control/command_capture.h"
+#include "video_core/gpu.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra::Control {
+
+using Kernel::KMemoryManager;
+
+CaptureReplayer::CaptureReplayer(Core::System& system_)
+    : system{system_}, device_memory{system.Host1x().MemoryManager()},
+      // Device pages without a process map to this id, nothing is notified of their caching
+      asid{device_memory.RegisterProcess(nullptr)} {}
+
+CaptureReplayer::~CaptureReplayer() {
+    channels.clear();
+    for (const Allocation& allocation : allocations) {
+        const size_t size = allocation.num_pages * Core::DEVICE_PAGESIZE;
+        device_memory.Unmap(allocation.device_address, size);
+        device_memory.Free(allocation.device_address, size);
+        system.Kernel().MemoryManager().Close(allocation.physical_address, allocation.num_pages);
+    }
+    device_memory.UnregisterProcess(asid);
+}
+
+bool CaptureReplayer::Replay(const CapturedSubmit& submit, Stats& stats) {
+    auto& channel = channels[submit.channel];
+    if (!channel) {
+        channel = system.GPU().AllocateChannel();
+        channel->memory_manager = AddressSpace(submit.address_space);
+        system.GPU().InitChannel(*channel, 0);
+    }
+
+    // Lists with prefetched words don't execute their segments
+    u64 num_words = submit.prefetch.size();
+    if (submit.prefetch.empty()) {
+        for (const CapturedSegment& segment : submit.segments) {
+            const std::span<const u8> words{reinterpret_cast<const u8*>(segment.words.data()),
+                                            segment.words.size() * sizeof(CommandHeader)};
+            if (!Write(submit.address_space, segment.header.addr, words)) {
+                return false;
+            }
+            num_words += segment.words.size();
+        }
+    }
+    stats.words += num_words;
+    stats.memory_ranges += submit.memory.size();
+    ++stats.submits;
+
+    // Ranges are recorded in execution order, load each run of them sharing a word and execute
+    // the list up to the next one
+    u64 begin = 0;
+    auto range = submit.memory.begin();
+    while (begin < num_words || range != submit.memory.end()) {
+        const auto load_start = Clock::now();
+        while (range != submit.memory.end() &&
+               (num_words == 0 || std::min(range->word, num_words - 1) <= begin)) {
+            if (!Write(range->address_space, range->address, range->data)) {
+                return false;
+            }
+            stats.memory_bytes += range->data.size();
+            ++range;
+        }
+        const u64 end = range != submit.memory.end() ? std::min(range->word, num_words - 1)
+                                                     : num_words;
+
+        // Synchronous GPU emulation, the push returns once the words executed
+        const auto execute_start = Clock::now();
+        stats.load_memory += execute_start - load_start;
+        Push(*channel, submit, begin, end);
+        stats.execute += Clock::now() - execute_start;
+        begin = end;
+    }
+    return true;
+}
+
+std::shared_ptr<MemoryManager> CaptureReplayer::AddressSpace(u64 id) {
+    AddressSpaceState& state = address_spaces[id];
+    if (!state.memory_manager) {
+        state.memory_manager = std::make_shared<MemoryManager>(system);
+        system.GPU().InitAddressSpace(*state.memory_manager);
+    }
+    return state.memory_manager;
+}
+
+bool CaptureReplayer::Write(u64 id, GPUVAddr address, std::span<const u8> data) {
+    const auto memory_manager = AddressSpace(id);
+    if (!MapPages(address_spaces[id], address, data.size())) {
+        return false;
+    }
+    memory_manager->WriteBlock(address, data.data(), data.size());
+    return true;
+}
+
+bool CaptureReplayer::MapPages(AddressSpaceState& state, GPUVAddr address, u64 size) {
+    const GPUVAddr end = Common::AlignUp(address + size, Core::DEVICE_PAGESIZE);
+    GPUVAddr page = Common::AlignDown(address, Core::DEVICE_PAGESIZE);
+    while (page < end) {
+        if (state.mapped_pages.contains(page)) {
+            page += Core::DEVICE_PAGESIZE;
+            continue;
+        }
+        const GPUVAddr run_start = page;
+        while (page < end && !state.mapped_pages.contains(page)) {
+            state.mapped_pages.insert(page);
+            page += Core::DEVICE_PAGESIZE;
+        }
+        const size_t run_size = page - run_start;
+        const size_t num_pages = run_size / Core::DEVICE_PAGESIZE;
+        const Kernel::KPhysicalAddress physical_address =
+            system.Kernel().MemoryManager().AllocateAndOpenContinuous(
+                num_pages, 1,
+                KMemoryManager::EncodeOption(KMemoryManager::Pool::Application,
+                                             KMemoryManager::Direction::FromFront));
+        if (physical_address == 0) {
+            LOG_ERROR(HW_GPU, "Out of memory backing 0x{:x} bytes at 0x{:016x}", run_size,
+                      run_start);
+            return false;
+        }
+        const DAddr device_address = device_memory.Allocate(run_size);
+        device_memory.MapPhysical(device_address,
+                                  GetInteger(physical_address) - Core::DramMemoryMap::Base,
+                                  run_size);
+        state.memory_manager->Map(run_start, device_address, run_size, PTEKind::INVALID, false);
+        allocations.push_back({physical_address, device_address, num_pages});
+    }
+    return true;
+}
+
+void CaptureReplayer::Push(ChannelState& channel, const CapturedSubmit& submit, u64 begin,
+                           u64 end) {
+    if (begin == end) {
+        return;
+    }
+    CommandList list;
+    if (!submit.prefetch.empty()) {
+        list.prefetch_command_list.assign(submit.prefetch.begin() + begin,
+                                          submit.prefetch.begin() + end);
+    } else {
+        u64 segment_begin = 0;
+        for (const CapturedSegment& segment : submit.segments) {
+            const u64 segment_end = segment_begin + segment.words.size();
+            const u64 first = std::max(begin, segment_begin);
+            const u64 last = std::min(end, segment_end);
+            if (first < last) {
+                CommandListHeader header = segment.header;
+                header.addr.Assign(segment.header.addr +
+                                   (first - segment_begin) * sizeof(CommandHeader));
+                header.size.Assign(last - first);
+                list.command_lists.push_back(header);
+            }
+            segment_begin = segment_end;
+        }
+    }
+    system.GPU().PushGPUEntries(channel.bind_id, std::move(list));
+}
+
+} // namespace Tegra::Control
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hle/kernel/k_typed_address.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+
+namespace Core {
+class System;
+}
+
+namespace Tegra {
+
+class MemoryManager;
+
+namespace Control {
+
+struct CapturedSubmit;
+struct ChannelState;
+
+/**
+ * Executes command lists recorded by CommandCapture again on the GPU of a system set up with
+ * System::SetupForGPUReplay, without a guest. The address spaces and channels of the capture are
+ * created on first use, their pages are backed by application memory the first time they are
+ * written. Each list is split where the memory it read has to be loaded, so the ranges are
+ * written between the method runs that read them.
+ */
+class CaptureReplayer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        u64 submits{};
+        u64 words{};
+        u64 memory_ranges{};
+        u64 memory_bytes{};
+        Clock::duration load_memory{};
+        Clock::duration execute{};
+    };
+
+    explicit CaptureReplayer(Core::System& system);
+    ~CaptureReplayer();
+
+    CaptureReplayer(const CaptureReplayer&) = delete;
+    CaptureReplayer& operator=(const CaptureReplayer&) = delete;
+
+    /// Executes a captured list, returns false when its memory couldn't be backed
+    [[nodiscard]] bool Replay(const CapturedSubmit& submit, Stats& stats);
+
+    /// Returns the address space with the id it had when captured, created on first use
+    [[nodiscard]] std::shared_ptr<MemoryManager> AddressSpace(u64 id);
+
+private:
+    struct AddressSpaceState {
+        std::shared_ptr<MemoryManager> memory_manager;
+        std::unordered_set<GPUVAddr> mapped_pages;
+    };
+
+    struct Allocation {
+        Kernel::KPhysicalAddress physical_address;
+        DAddr device_address;
+        size_t num_pages;
+    };
+
+    /// Writes to an address space, returns false when its pages couldn't be backed
+    bool Write(u64 id, GPUVAddr address, std::span<const u8> data);
+
+    /// Maps the pages of a range that aren't mapped yet, each run of them to contiguous memory
+    bool MapPages(AddressSpaceState& state, GPUVAddr address, u64 size);
+
+    /// Pushes the words [begin, end) of a list, its prefetched words or its segments
+    void Push(ChannelState& channel, const CapturedSubmit& submit, u64 begin, u64 end);
+
+    Core::System& system;
+    MaxwellDeviceMemoryManager& device_memory;
+    Core::Asid asid;
+    std::unordered_map<u64, AddressSpaceState> address_spaces;
+    std::unordered_map<s32, std::shared_ptr<ChannelState>> channels;
+    std::vector<Allocation> allocations;
+};
+
+} // namespace Control
+
+} // namespace Tegra
@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/control/command_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra::Control {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 't', 'r', 'n', 'g', 'c', 'a', 'p'};
+constexpr u32 CAPTURE_VERSION = 3;
+
+/// Upper bound of the counts accepted from a file, above any list the GPU can receive
+constexpr u32 MAX_CAPTURED_WORDS = 1U << 24;
+
+/// Upper bound of the size of a memory range accepted from a file
+constexpr u64 MAX_CAPTURED_BYTES = 1ULL << 30;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct SubmitHeader {
+    s32 channel;
+    u32 num_prefetch_words;
+    u32 num_segments;
+    u32 num_memory_ranges;
+    u64 address_space;
+};
+static_assert(sizeof(SubmitHeader) == 24);
+
+struct MemoryHeader {
+    u64 address_space;
+    u64 address;
+    u64 word;
+    u64 size;
+};
+static_assert(sizeof(MemoryHeader) == 32);
+
+/// Writes a whole span, empty ones are skipped as they may not point to any storage
+template <typename T>
+bool WriteAll(const Common::FS::IOFile& file, std::span<const T> data) {
+    return data.empty() || file.WriteSpan(data) == data.size();
+}
+
+/// Reads a whole span, empty ones are skipped as they may not point to any storage
+template <typename T>
+bool ReadAll(const Common::FS::IOFile& file, std::span<T> data) {
+    return data.empty() || file.ReadSpan(data) == data.size();
+}
+} // Anonymous namespace
+
+CommandCapture::CommandCapture(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Write} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Unable to create GPU command capture at {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = CAPTURE_VERSION,
+        .reserved = 0,
+    };
+    if (!file.WriteObject(header)) {
+        file.Close();
+        return;
+    }
+    LOG_INFO(HW_GPU, "Capturing GPU commands to {}", Common::FS::PathToUTF8String(path));
+}
+
+CommandCapture::~CommandCapture() {
+    for (const auto& address_space : bound_address_spaces) {
+        if (const auto memory_manager = address_space.lock()) {
+            memory_manager->BindCapture(nullptr);
+        }
+    }
+}
+
+void CommandCapture::BeginSubmit(const ChannelState& channel, const CommandList& entries) {
+    if (!file.IsOpen()) {
+        return;
+    }
+    const std::shared_ptr<MemoryManager>& memory_manager = channel.memory_manager;
+    // The pushbuffers are read before recording starts, they are stored with their segments
+    pending.channel = channel.bind_id;
+    pending.address_space = memory_manager->GetID();
+    pending.prefetch.assign(entries.prefetch_command_list.begin(),
+                            entries.prefetch_command_list.end());
+    pending.segments.resize(entries.command_lists.size());
+    for (size_t i = 0; i < entries.command_lists.size(); ++i) {
+        CapturedSegment& segment = pending.segments[i];
+        segment.header = entries.command_lists[i];
+        segment.words.resize(segment.header.size);
+        memory_manager->ReadBlockUnsafe(segment.header.addr, segment.words.data(),
+                                        segment.words.size() * sizeof(CommandHeader));
+    }
+
+    std::scoped_lock lock{mutex};
+    for (const CapturedSegment& segment : pending.segments) {
+        UpdateRange(pending.address_space, segment.header.addr,
+                    std::span(reinterpret_cast<const u8*>(segment.words.data()),
+                              segment.words.size() * sizeof(CommandHeader)));
+    }
+    std::erase_if(bound_address_spaces, [](const auto& address_space) {
+        return address_space.expired();
+    });
+    const bool is_bound = std::ranges::any_of(bound_address_spaces, [&](const auto& address_space) {
+        return address_space.lock() == memory_manager;
+    });
+    if (!is_bound) {
+        memory_manager->BindCapture(this);
+        bound_address_spaces.push_back(memory_manager);
+    }
+    pending_pusher = channel.dma_pusher.get();
+    recording.store(true, std::memory_order_release);
+}
+
+void CommandCapture::EndSubmit() {
+    std::scoped_lock lock{mutex};
+    if (!recording.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    Write(pending);
+    pending.memory.clear();
+    pending_pusher = nullptr;
+}
+
+void CommandCapture::RecordRead(u64 address_space, GPUVAddr address, std::span<const u8> data) {
+    if (!recording.load(std::memory_order_acquire) || data.empty()) {
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    if (!recording.load(std::memory_order_relaxed) || !UpdateRange(address_space, address, data)) {
+        return;
+    }
+    pending.memory.push_back({
+        .address_space = address_space,
+        .address = address,
+        .word = pending_pusher->CurrentWord(),
+        .data = std::vector<u8>(data.begin(), data.end()),
+    });
+}
+
+void CommandCapture::WriteSubmit(const CapturedSubmit& submit) {
+    std::scoped_lock lock{mutex};
+    Write(submit);
+}
+
+bool CommandCapture::UpdateRange(u64 address_space, GPUVAddr address, std::span<const u8> data) {
+    const u64 size = data.size();
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(data.data()), size);
+    const RangeKey key{address_space, address, size};
+    if (const auto it = recorded_ranges.find(key);
+        it != recorded_ranges.end() && it->second == hash) {
+        return false;
+    }
+    // Replays load the range over the ranges it overlaps, those have to be recorded again the
+    // next time they are read
+    max_range_size = std::max(max_range_size, size);
+    const GPUVAddr first = address > max_range_size ? address - max_range_size : 0;
+    auto it = recorded_ranges.lower_bound(RangeKey{address_space, first, 0});
+    while (it != recorded_ranges.end() && std::get<0>(it->first) == address_space &&
+           std::get<1>(it->first) < address + size) {
+        const auto& [range_address_space, range_address, range_size] = it->first;
+        if (range_address + range_size > address && it->first != key) {
+            it = recorded_ranges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    recorded_ranges.insert_or_assign(key, hash);
+    return true;
+}
+
+void CommandCapture::Write(const CapturedSubmit& submit) {
+    if (!file.IsOpen()) {
+        return;
+    }
+    const SubmitHeader header{
+        .channel = submit.channel,
+        .num_prefetch_words = static_cast<u32>(submit.prefetch.size()),
+        .num_segments = static_cast<u32>(submit.segments.size()),
+        .num_memory_ranges = static_cast<u32>(submit.memory.size()),
+        .address_space = submit.address_space,
+    };
+    bool success = file.WriteObject(header);
+    success &= WriteAll(file, std::span(submit.prefetch));
+    for (const CapturedSegment& segment : submit.segments) {
+        ASSERT(segment.words.size() == segment.header.size);
+        success &= file.WriteObject(segment.header.raw);
+        success &= WriteAll(file, std::span(segment.words));
+    }
+    for (const CapturedMemory& memory : submit.memory) {
+        const MemoryHeader memory_header{
+            .address_space = memory.address_space,
+            .address = memory.address,
+            .word = memory.word,
+            .size = memory.data.size(),
+        };
+        success &= file.WriteObject(memory_header);
+        success &= WriteAll(file, std::span(memory.data));
+    }
+    if (!success) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU command capture, stopping");
+        file.Close();
+    }
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Read} {
+    FileHeader header{};
+    is_valid = file.IsOpen() && file.ReadObject(header) && header.magic == MAGIC_NUMBER &&
+               header.version == CAPTURE_VERSION;
+}
+
+CaptureReader::~CaptureReader() = default;
+
+bool CaptureReader::Next(CapturedSubmit& submit) {
+    SubmitHeader header{};
+    if (!is_valid || !file.ReadObject(header) || header.num_prefetch_words > MAX_CAPTURED_WORDS ||
+        header.num_segments > MAX_CAPTURED_WORDS ||
+        header.num_memory_ranges > MAX_CAPTURED_WORDS) {
+        return false;
+    }
+    submit.channel = header.channel;
+    submit.address_space = header.address_space;
+    submit.prefetch.resize(header.num_prefetch_words);
+    if (!ReadAll(file, std::span(submit.prefetch))) {
+        return false;
+    }
+    submit.segments.resize(header.num_segments);
+    for (CapturedSegment& segment : submit.segments) {
+        if (!file.ReadObject(segment.header.raw)) {
+            return false;
+        }
+        segment.words.resize(segment.header.size);
+        if (!ReadAll(file, std::span(segment.words))) {
+            return false;
+        }
+    }
+    submit.memory.resize(header.num_memory_ranges);
+    for (CapturedMemory& memory : submit.memory) {
+        MemoryHeader memory_header{};
+        if (!file.ReadObject(memory_header) || memory_header.size > MAX_CAPTURED_BYTES) {
+            return false;
+        }
+        memory.address_space = memory_header.address_space;
+        memory.address = memory_header.address;
+        memory.word = memory_header.word;
+        memory.data.resize(memory_header.size);
+        if (!ReadAll(file, std::span(memory.data))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::filesystem::path NewCapturePath() {
+    const auto dump_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::DumpDir)};
+    const auto capture_dir{dump_dir / "gpu_captures"};
+    if (!Common::FS::CreateDir(dump_dir) || !Common::FS::CreateDir(capture_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create GPU capture directories");
+    }
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return capture_dir /
+           fmt::format("{}.gpucap", std::chrono::duration_cast<std::chrono::seconds>(now).count());
+}
+
+} // namespace Tegra::Control
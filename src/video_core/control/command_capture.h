@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+class MemoryManager;
+
+namespace Control {
+
+struct ChannelState;
+
+/// Pushbuffer segment of a captured command list, with the words it pointed to at submit time
+struct CapturedSegment {
+    CommandListHeader header;
+    std::vector<CommandHeader> words;
+};
+
+/// Memory of an address space read while a command list executed, as it was when read
+struct CapturedMemory {
+    u64 address_space{};
+    GPUVAddr address{};
+    /// Word of the list whose method run read the memory, see DmaPusher::CurrentWord
+    u64 word{};
+    std::vector<u8> data;
+};
+
+/// Command list submitted to a channel, with the memory its execution read
+struct CapturedSubmit {
+    s32 channel{};
+    /// Address space bound to the channel, the pushbuffer segments are read from it
+    u64 address_space{};
+    std::vector<CommandHeader> prefetch;
+    std::vector<CapturedSegment> segments;
+    /**
+     * Memory read by the list, in the order it was read. Each range has to be loaded before the
+     * method run at its word executes: the GPU may write the memory earlier in the list, and
+     * loading the range sooner would hide that write from the commands that read it before.
+     * Ranges are positioned at the start of method runs, so a run that reads memory its own
+     * methods wrote isn't replayed exactly.
+     */
+    std::vector<CapturedMemory> memory;
+};
+
+/**
+ * Records the command lists received by the GPU scheduler to a file, so they can be executed
+ * again later without the guest. Along with each list the capture stores its pushbuffer words and
+ * every range the engines read through the GPU address spaces while executing it: semaphores,
+ * macro parameters, shader code, constant buffers, descriptors... Ranges whose contents didn't
+ * change since they were last recorded are skipped.
+ */
+class CommandCapture {
+public:
+    explicit CommandCapture(const std::filesystem::path& path);
+    ~CommandCapture();
+
+    [[nodiscard]] bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Starts recording a command list, the memory read until EndSubmit is stored with it
+    void BeginSubmit(const ChannelState& channel, const CommandList& entries);
+
+    /// Writes the command list started by BeginSubmit
+    void EndSubmit();
+
+    /// Records memory read through an address space, ignored outside of a submission
+    void RecordRead(u64 address_space, GPUVAddr address, std::span<const u8> data);
+
+    /// Writes a submission to the file
+    void WriteSubmit(const CapturedSubmit& submit);
+
+private:
+    using RangeKey = std::tuple<u64, GPUVAddr, u64>;
+
+    /// Returns true when the range has to be recorded, false when it holds what was last recorded
+    bool UpdateRange(u64 address_space, GPUVAddr address, std::span<const u8> data);
+
+    /// Writes a submission, the mutex must be held
+    void Write(const CapturedSubmit& submit);
+
+    Common::FS::IOFile file;
+    CapturedSubmit pending;
+    const DmaPusher* pending_pusher{};
+    std::vector<std::weak_ptr<MemoryManager>> bound_address_spaces;
+    std::map<RangeKey, u64> recorded_ranges;
+    u64 max_range_size{};
+    std::atomic_bool recording{};
+    std::mutex mutex;
+};
+
+/// Reads back a file written by CommandCapture
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::filesystem::path& path);
+    ~CaptureReader();
+
+    /// Returns false if the file can't be opened or is not a capture of a supported version
+    [[nodiscard]] bool IsValid() const {
+        return is_valid;
+    }
+
+    /// Reads the next submission, returns false at the end of the file or on truncated data
+    [[nodiscard]] bool Next(CapturedSubmit& submit);
+
+private:
+    Common::FS::IOFile file;
+    bool is_valid{};
+};
+
+/// Path of a new capture file in the dump directory
+[[nodiscard]] std::filesystem::path NewCapturePath();
+
+} // namespace Control
+
+} // namespace Tegra
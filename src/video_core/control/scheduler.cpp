@@ -4,12 +4,18 @@
 #include <memory>
 
 #include "common/assert.h"
+#include "common/settings.h"
 #include "video_core/control/channel_state.h"
+#include "video_core/control/command_capture.h"
 #include "video_core/control/scheduler.h"
 #include "video_core/gpu.h"
 
 namespace Tegra::Control {
-Scheduler::Scheduler(GPU& gpu_) : gpu{gpu_} {}
+Scheduler::Scheduler(GPU& gpu_) : gpu{gpu_} {
+    if (Settings::values.capture_gpu_commands) {
+        capture = std::make_unique<CommandCapture>(NewCapturePath());
+    }
+}
 
 Scheduler::~Scheduler() = default;
 
@@ -19,8 +25,14 @@ void Scheduler::Push(s32 channel, CommandList&& entries) {
     ASSERT(it != channels.end());
     auto channel_state = it->second;
     gpu.BindChannel(channel_state->bind_id);
+    if (capture) {
+        capture->BeginSubmit(*channel_state, entries);
+    }
     channel_state->dma_pusher->Push(std::move(entries));
     channel_state->dma_pusher->DispatchCalls();
+    if (capture) {
+        capture->EndSubmit();
+    }
 }
 
 void Scheduler::DeclareChannel(std::shared_ptr<ChannelState> new_channel) {
@@ -15,6 +15,7 @@ class GPU;
 
 namespace Control {
 
+class CommandCapture;
 struct ChannelState;
 
 class Scheduler {
@@ -29,6 +30,7 @@ public:
 private:
     std::unordered_map<s32, std::shared_ptr<ChannelState>> channels;
     std::mutex scheduling_guard;
+    std::unique_ptr<CommandCapture> capture;
     GPU& gpu;
 };
 
@@ -74,4 +74,16 @@ void SetupDirtyFlags(Maxwell3D::DirtyState::Tables& tables) {
     SetupDirtyShaders(tables);
 }
 
+void BuildDirtyRanges(Maxwell3D::DirtyState& dirty) {
+    const auto& tables = dirty.tables;
+    dirty.ranges.clear();
+    for (u32 method = 0; method < Maxwell3D::Regs::NUM_REGS; ++method) {
+        const std::array flags{tables[0][method], tables[1][method]};
+        if (dirty.ranges.empty() || dirty.ranges.back().flags != flags) {
+            dirty.ranges.push_back({method, flags});
+        }
+        dirty.range_index[method] = static_cast<u16>(dirty.ranges.size() - 1);
+    }
+}
+
 } // namespace VideoCommon::Dirty
@@ -61,4 +61,7 @@ void FillBlock(Tegra::Engines::Maxwell3D::DirtyState::Tables& tables, std::size_
 
 void SetupDirtyFlags(Tegra::Engines::Maxwell3D::DirtyState::Tables& tables);
 
+/// Builds the range table used by bulk register writes, call once every table is filled
+void BuildDirtyRanges(Tegra::Engines::Maxwell3D::DirtyState& dirty);
+
 } // namespace VideoCommon::Dirty
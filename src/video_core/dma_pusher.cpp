@@ -60,12 +60,20 @@ bool DmaPusher::Step() {
 
     if (command_list.prefetch_command_list.size()) {
         // Prefetched command list from nvdrv, used for things like synchronization
+        segment_word_base = 0;
+        command_word = 0;
         ProcessCommands(command_list.prefetch_command_list);
         dma_pushbuffer.pop();
     } else {
+        if (dma_pushbuffer_subindex == 0) {
+            next_segment_word = 0;
+        }
         const CommandListHeader command_list_header{
             command_list.command_lists[dma_pushbuffer_subindex++]};
         dma_state.dma_get = command_list_header.addr;
+        segment_word_base = next_segment_word;
+        next_segment_word += command_list_header.size;
+        command_word = 0;
 
         if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
             // We've gone through the current list, remove it from the queue
@@ -129,6 +137,7 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
         if (dma_state.method_count) {
             // Data word of methods command
             dma_state.dma_word_offset = static_cast<u32>(index * sizeof(u32));
+            command_word = index;
             if (dma_state.non_incrementing) {
                 const u32 max_write = static_cast<u32>(
                     std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
@@ -137,6 +146,18 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once) {
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
+                const u32 num_written = CallRegisterRange(&command_header.argument, max_write);
+                if (num_written != 0) {
+                    dma_state.method += num_written;
+                    dma_state.method_count -= num_written;
+                    index += num_written;
+                    continue;
+                }
+                dma_state.is_last_call = dma_state.method_count <= 1;
+                CallMethod(command_header.argument);
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -169,6 +190,7 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.subchannel = command_header.subchannel;
                 dma_state.dma_word_offset = static_cast<u64>(
                     -static_cast<s64>(dma_state.dma_get)); // negate to set address as 0
+                command_word = index;
                 CallMethod(command_header.arg_count);
                 dma_state.non_incrementing = true;
                 dma_increment_once = false;
@@ -201,14 +223,9 @@ void DmaPusher::CallMethod(u32 argument) const {
             dma_state.method_count,
         });
     } else {
-        auto subchannel = subchannels[dma_state.subchannel];
-        if (!subchannel->execution_mask[dma_state.method]) [[likely]] {
-            subchannel->method_sink.emplace_back(dma_state.method, argument);
-            return;
-        }
-        subchannel->ConsumeSink();
-        subchannel->current_dma_segment = dma_state.dma_get + dma_state.dma_word_offset;
-        subchannel->CallMethod(dma_state.method, argument, dma_state.is_last_call);
+        subchannels[dma_state.subchannel]->DispatchMethod(
+            dma_state.method, argument, dma_state.is_last_call,
+            dma_state.dma_get + dma_state.dma_word_offset);
     }
 }
 
@@ -225,6 +242,16 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::CallRegisterRange(const u32* base_start, u32 num_methods) const {
+    if (dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    // Only the leading methods without side effects are written in bulk, the first method that
+    // has to be executed goes through the regular path
+    return subchannels[dma_state.subchannel]->WriteRegisterRun(dma_state.method, base_start,
+                                                                num_methods);
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
@@ -138,6 +138,14 @@ public:
 
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /**
+     * Position of the method run being executed within the words of the current command list:
+     * its prefetched words, or its segments one after the other. Only valid on the GPU thread.
+     */
+    [[nodiscard]] u64 CurrentWord() const noexcept {
+        return segment_word_base + command_word;
+    }
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
@@ -148,12 +156,17 @@ private:
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    /// Writes the leading methods without side effects, returns how many were written
+    u32 CallRegisterRange(const u32* base_start, u32 num_methods) const;
 
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
     std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
     std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
+    u64 segment_word_base{};                ///< List words before the segment
+    u64 next_segment_word{};                ///< List words up to the segment end
+    u64 command_word{};                     ///< Method run word within the segment
 
     struct DmaState {
         u32 method;            ///< Current method
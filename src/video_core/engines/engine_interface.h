@@ -30,6 +30,46 @@ public:
     virtual void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                  u32 methods_pending) = 0;
 
+    /**
+     * Writes a run of consecutive registers, none of them set in the execution mask.
+     * By default the writes are queued in the sink like single method calls.
+     */
+    virtual void WriteRegisterRange(u32 method, const u32* base_start, u32 amount) {
+        for (u32 i = 0; i < amount; ++i) {
+            method_sink.emplace_back(method + i, base_start[i]);
+        }
+    }
+
+    /**
+     * Queues the method in the sink, or executes it after the queued writes if it is set in the
+     * execution mask.
+     */
+    void DispatchMethod(u32 method, u32 argument, bool is_last_call, GPUVAddr dma_segment) {
+        if (!execution_mask[method]) [[likely]] {
+            method_sink.emplace_back(method, argument);
+            return;
+        }
+        ConsumeSink();
+        current_dma_segment = dma_segment;
+        CallMethod(method, argument, is_last_call);
+    }
+
+    /**
+     * Writes the leading methods of an incrementing run that are not set in the execution mask
+     * with a single WriteRegisterRange call.
+     * @returns The number of methods written
+     */
+    u32 WriteRegisterRun(u32 method, const u32* base_start, u32 amount) {
+        u32 num_registers = 0;
+        while (num_registers < amount && !execution_mask[method + num_registers]) {
+            ++num_registers;
+        }
+        if (num_registers != 0) {
+            WriteRegisterRange(method, base_start, num_registers);
+        }
+        return num_registers;
+    }
+
     void ConsumeSink() {
         if (method_sink.empty()) {
             return;
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -42,6 +43,10 @@ void Maxwell3D::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_) {
     upload_state.BindRasterizer(rasterizer_);
 }
 
+void Maxwell3D::BindMacroDiskCache(u64 program_id) {
+    macro_engine->BindDiskCache(program_id);
+}
+
 void Maxwell3D::InitializeRegisterDefaults() {
     // Initializes registers to their default values - what games expect them to be at boot. This is
     // for certain registers that may not be explicitly set by games.
@@ -327,6 +332,44 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessDirtyRegisterRange(u32 method, const u32* arguments, u32 amount) {
+    u32* const registers = regs.reg_array.data() + method;
+    // State blocks are often written again with the values they already hold, skip over those
+    u32 index = 0;
+    while (index < amount) {
+        const auto first_change =
+            std::mismatch(registers + index, registers + amount, arguments + index).first;
+        index = static_cast<u32>(first_change - registers);
+        if (index == amount) {
+            break;
+        }
+        u32 end = index + 1;
+        while (end < amount && registers[end] != arguments[end]) {
+            ++end;
+        }
+        MarkDirtyRange(method + index, method + end);
+        index = end;
+    }
+    std::memcpy(registers, arguments, amount * sizeof(u32));
+}
+
+void Maxwell3D::MarkDirtyRange(u32 begin, u32 end) {
+    if (dirty.ranges.empty()) {
+        for (u32 method = begin; method < end; ++method) {
+            for (const auto& table : dirty.tables) {
+                dirty.flags[table[method]] = true;
+            }
+        }
+        return;
+    }
+    for (size_t index = dirty.range_index[begin];
+         index < dirty.ranges.size() && dirty.ranges[index].begin < end; ++index) {
+        for (const u8 flag : dirty.ranges[index].flags) {
+            dirty.flags[flag] = true;
+        }
+    }
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -433,6 +476,22 @@ void Maxwell3D::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
     ProcessMethodCall(method, argument, method_argument, is_last_call);
 }
 
+void Maxwell3D::WriteRegisterRange(u32 method, const u32* base_start, u32 amount) {
+    ASSERT(method + amount <= Regs::NUM_REGS);
+
+    // Keep the order of the writes queued before
+    ConsumeSink();
+
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(shadow_state.reg_array.data() + method, base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        base_start = shadow_state.reg_array.data() + method;
+    }
+    ProcessDirtyRegisterRange(method, base_start, amount);
+}
+
 void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                 u32 methods_pending) {
     // Methods after 0xE00 are special, they're actually triggers for some microcode that was
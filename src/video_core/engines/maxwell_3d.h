@@ -59,6 +59,9 @@ public:
     /// Binds a rasterizer to this engine.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Reuses the macro analysis of previous sessions of the title, if its disk cache was loaded.
+    void BindMacroDiskCache(u64 program_id);
+
     /// Register structure of the Maxwell3D engine.
     struct Regs {
         static constexpr std::size_t NUM_REGS = 0xE00;
@@ -3078,6 +3081,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write a run of registers without side effects in a single pass.
+    void WriteRegisterRange(u32 method, const u32* base_start, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3095,8 +3101,18 @@ public:
         using Table = std::array<u8, Regs::NUM_REGS>;
         using Tables = std::array<Table, 2>;
 
+        /// Run of consecutive registers with the same entries in every table
+        struct Range {
+            u32 begin;
+            std::array<u8, 2> flags;
+        };
+
         Flags flags;
         Tables tables{};
+
+        /// Tables compressed into runs by BuildDirtyRanges, empty until the tables are set up
+        std::vector<Range> ranges;
+        std::array<u16, Regs::NUM_REGS> range_index{}; ///< Range containing each register
     } dirty;
 
     std::unique_ptr<DrawManager> draw_manager;
@@ -3140,6 +3156,12 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes a block of registers, flagging only the ones that change
+    void ProcessDirtyRegisterRange(u32 method, const u32* arguments, u32 amount);
+
+    /// Sets the dirty flags of every register in [begin, end)
+    void MarkDirtyRange(u32 begin, u32 end);
+
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
@@ -10,8 +10,8 @@
 #include <thread>
 #include <variant>
 
-#include "common/bounded_threadsafe_queue.h"
 #include "common/polyfill_thread.h"
+#include "common/spsc_ring.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -89,8 +89,8 @@ struct CommandDataContainer {
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
-    std::mutex write_lock;
+    using CommandQueue = Common::SPSCRing<CommandDataContainer, 0x1000>;
+    std::mutex write_lock; ///< Serializes the threads pushing commands
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
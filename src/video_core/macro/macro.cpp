@@ -16,6 +16,7 @@
 #include "common/settings.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/macro/macro.h"
+#include "video_core/macro/macro_disk_cache.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
 
@@ -68,6 +69,10 @@ void MacroEngine::ClearCode(u32 method) {
     uploaded_macro_code.erase(method);
 }
 
+void MacroEngine::BindDiskCache(u64 title_id) {
+    hle_macros->SetDiskCache(Macro::FindMacroDiskCache(title_id));
+}
+
 void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
@@ -96,10 +101,12 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
             }
         }
         auto& cache_info = macro_cache[method];
+        std::span<const u32> code_span;
 
         if (!mid_method.has_value()) {
             cache_info.lle_program = Compile(macro_code->second);
             cache_info.hash = Common::HashValue(macro_code->second);
+            code_span = macro_code->second;
         } else {
             const auto& macro_cached = uploaded_macro_code[mid_method.value()];
             const auto rebased_method = method - mid_method.value();
@@ -109,10 +116,14 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
                         code.size() * sizeof(u32));
             cache_info.hash = Common::HashValue(code);
             cache_info.lle_program = Compile(code);
+            code_span = code;
         }
 
-        auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
-        if (!hle_program || Settings::values.disable_macro_hle) {
+        std::unique_ptr<CachedMacro> hle_program;
+        if (!Settings::values.disable_macro_hle) {
+            hle_program = hle_macros->GetHLEProgram(cache_info.hash, code_span);
+        }
+        if (!hle_program) {
             maxwell3d.RefreshParameters();
             cache_info.lle_program->Execute(parameters, method);
         } else {
@@ -120,6 +120,9 @@ public:
     // Clear the code associated with a method.
     void ClearCode(u32 method);
 
+    // Reuses the macro analysis of previous sessions of the title, if its disk cache was loaded
+    void BindDiskCache(u64 title_id);
+
     // Compiles the macro if its not in the cache, and executes the compiled macro
     void Execute(u32 method, const std::vector<u32>& parameters);
 
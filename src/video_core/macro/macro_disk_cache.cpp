@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/macro/macro_disk_cache.h"
+
+namespace Tegra::Macro {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 't', 'r', 'n', 'm', 'a', 'c', 'r'};
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct Record {
+    u64 hash;
+    u32 shape;
+    u32 const_buffer_size;
+};
+static_assert(sizeof(Record) == 16);
+
+[[nodiscard]] bool IsValidShape(u32 shape) {
+    return shape <= static_cast<u32>(MacroShape::MultiLayerClear);
+}
+
+std::mutex caches_mutex;
+std::unordered_map<u64, std::weak_ptr<MacroDiskCache>> caches;
+} // Anonymous namespace
+
+MacroDiskCache::MacroDiskCache(const std::filesystem::path& path_) : path{path_} {
+    Load();
+}
+
+MacroDiskCache::~MacroDiskCache() = default;
+
+std::optional<DetectedShape> MacroDiskCache::Find(u64 hash) const {
+    std::scoped_lock lock{mutex};
+    const auto it = entries.find(hash);
+    if (it == entries.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void MacroDiskCache::Insert(u64 hash, const DetectedShape& shape) {
+    std::scoped_lock lock{mutex};
+    if (!entries.emplace(hash, shape).second || !file) {
+        return;
+    }
+    const Record record{
+        .hash = hash,
+        .shape = static_cast<u32>(shape.shape),
+        .const_buffer_size = shape.const_buffer_size,
+    };
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    // New macros are rare past the first frames, don't lose them if the emulator is killed
+    file.flush();
+}
+
+size_t MacroDiskCache::Size() const {
+    std::scoped_lock lock{mutex};
+    return entries.size();
+}
+
+void MacroDiskCache::Load() {
+    std::vector<Record> records;
+    if (std::ifstream input{path, std::ios::in | std::ios::binary}) {
+        FileHeader header{};
+        input.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (input && header.magic == MAGIC_NUMBER &&
+            header.version == SHAPE_DETECTION_VERSION) {
+            Record record{};
+            while (input.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+                if (!IsValidShape(record.shape)) {
+                    break;
+                }
+                records.push_back(record);
+            }
+        } else {
+            LOG_INFO(HW_GPU, "Discarding outdated macro cache");
+        }
+    }
+
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR(Common_Filesystem, "Unable to open macro cache at {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = SHAPE_DETECTION_VERSION,
+        .reserved = 0,
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Record& record : records) {
+        const DetectedShape shape{
+            .shape = static_cast<MacroShape>(record.shape),
+            .const_buffer_size = record.const_buffer_size,
+        };
+        if (entries.emplace(record.hash, shape).second) {
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+    file.flush();
+    LOG_INFO(HW_GPU, "Loaded {} macros from the macro cache", entries.size());
+}
+
+std::shared_ptr<MacroDiskCache> LoadMacroDiskCache(u64 title_id) {
+    if (title_id == 0 || !Settings::values.use_disk_shader_cache.GetValue()) {
+        return nullptr;
+    }
+    std::scoped_lock lock{caches_mutex};
+    if (auto cache = caches[title_id].lock()) {
+        return cache;
+    }
+    const auto shader_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::ShaderDir)};
+    const auto base_dir{shader_dir / fmt::format("{:016x}", title_id)};
+    if (!Common::FS::CreateDir(shader_dir) || !Common::FS::CreateDir(base_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create macro cache directories");
+        return nullptr;
+    }
+    auto cache = std::make_shared<MacroDiskCache>(base_dir / "macros.bin");
+    caches[title_id] = cache;
+    return cache;
+}
+
+std::shared_ptr<MacroDiskCache> FindMacroDiskCache(u64 title_id) {
+    std::scoped_lock lock{caches_mutex};
+    const auto it = caches.find(title_id);
+    return it != caches.end() ? it->second.lock() : nullptr;
+}
+
+} // namespace Tegra::Macro
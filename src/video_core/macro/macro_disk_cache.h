@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "video_core/macro/macro_shape.h"
+
+namespace Tegra::Macro {
+
+/**
+ * Shape detection results of the macros uploaded by a title, stored next to its pipeline cache.
+ * Macros are uploaded again on every boot and scene transition, with this later sessions skip
+ * analyzing the ones they have already seen, including those that don't match any shape.
+ */
+class MacroDiskCache {
+public:
+    explicit MacroDiskCache(const std::filesystem::path& path);
+    ~MacroDiskCache();
+
+    MacroDiskCache(const MacroDiskCache&) = delete;
+    MacroDiskCache& operator=(const MacroDiskCache&) = delete;
+
+    [[nodiscard]] std::optional<DetectedShape> Find(u64 hash) const;
+
+    void Insert(u64 hash, const DetectedShape& shape);
+
+    [[nodiscard]] size_t Size() const;
+
+private:
+    /// Reads the valid records of the file and writes them back, dropping stale or broken data
+    void Load();
+
+    std::filesystem::path path;
+    std::unordered_map<u64, DetectedShape> entries;
+    std::ofstream file;
+    mutable std::mutex mutex;
+};
+
+/**
+ * Loads the cache of the title from disk, or returns it if it's already loaded. The cache stays
+ * available to FindMacroDiskCache while a reference to it is held. Returns nullptr if disk caches
+ * are off.
+ */
+[[nodiscard]] std::shared_ptr<MacroDiskCache> LoadMacroDiskCache(u64 title_id);
+
+/// Returns the cache of the title if it was loaded, without accessing the disk
+[[nodiscard]] std::shared_ptr<MacroDiskCache> FindMacroDiskCache(u64 title_id);
+
+} // namespace Tegra::Macro
@@ -2,14 +2,18 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <array>
+#include <optional>
 #include <vector>
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/macro/macro.h"
+#include "video_core/macro/macro_disk_cache.h"
 #include "video_core/macro/macro_hle.h"
+#include "video_core/macro/macro_shape.h"
 #include "video_core/memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 
@@ -441,21 +445,28 @@ public:
     }
 };
 
-template <size_t base_size>
 class HLE_ClearConstBuffer final : public HLEMacroImpl {
 public:
-    explicit HLE_ClearConstBuffer(Maxwell3D& maxwell3d_) : HLEMacroImpl(maxwell3d_) {}
+    explicit HLE_ClearConstBuffer(Maxwell3D& maxwell3d_, u32 base_size_)
+        : HLEMacroImpl(maxwell3d_), base_size{base_size_} {}
 
     void Execute(const std::vector<u32>& parameters, [[maybe_unused]] u32 method) override {
         maxwell3d.RefreshParameters();
-        static constexpr std::array<u32, base_size> zeroes{};
+        const u32 amount = parameters[2] * 4;
+        if (amount > zeroes.size()) {
+            zeroes.resize(amount, 0);
+        }
         auto& regs = maxwell3d.regs;
-        regs.const_buffer.size = static_cast<u32>(base_size);
+        regs.const_buffer.size = base_size;
         regs.const_buffer.address_high = parameters[0];
         regs.const_buffer.address_low = parameters[1];
         regs.const_buffer.offset = 0;
-        maxwell3d.ProcessCBMultiData(zeroes.data(), parameters[2] * 4);
+        maxwell3d.ProcessCBMultiData(zeroes.data(), amount);
     }
+
+private:
+    u32 base_size;
+    std::vector<u32> zeroes;
 };
 
 class HLE_ClearMemory final : public HLEMacroImpl {
@@ -566,12 +577,12 @@ HLEMacro::HLEMacro(Maxwell3D& maxwell3d_) : maxwell3d{maxwell3d_} {
     builders.emplace(0x6C97861D891EDf7EULL,
                      std::function<std::unique_ptr<CachedMacro>(Maxwell3D&)>(
                          [](Maxwell3D& maxwell3d__) -> std::unique_ptr<CachedMacro> {
-                             return std::make_unique<HLE_ClearConstBuffer<0x5F00>>(maxwell3d__);
+                             return std::make_unique<HLE_ClearConstBuffer>(maxwell3d__, 0x5F00);
                          }));
     builders.emplace(0xD246FDDF3A6173D7ULL,
                      std::function<std::unique_ptr<CachedMacro>(Maxwell3D&)>(
                          [](Maxwell3D& maxwell3d__) -> std::unique_ptr<CachedMacro> {
-                             return std::make_unique<HLE_ClearConstBuffer<0x7000>>(maxwell3d__);
+                             return std::make_unique<HLE_ClearConstBuffer>(maxwell3d__, 0x7000);
                          }));
     builders.emplace(0xEE4D0004BEC8ECF4ULL,
                      std::function<std::unique_ptr<CachedMacro>(Maxwell3D&)>(
@@ -600,4 +611,46 @@ std::unique_ptr<CachedMacro> HLEMacro::GetHLEProgram(u64 hash) const {
     return it->second(maxwell3d);
 }
 
+void HLEMacro::SetDiskCache(std::shared_ptr<Macro::MacroDiskCache> disk_cache_) {
+    disk_cache = std::move(disk_cache_);
+}
+
+std::unique_ptr<CachedMacro> HLEMacro::GetHLEProgram(u64 hash, std::span<const u32> code) {
+    if (auto program = GetHLEProgram(hash)) {
+        return program;
+    }
+    auto [it, is_new] = detected_shapes.try_emplace(hash);
+    if (is_new) {
+        std::optional<Macro::DetectedShape> stored;
+        if (disk_cache) {
+            stored = disk_cache->Find(hash);
+        }
+        if (stored) {
+            it->second = *stored;
+        } else {
+            it->second = Macro::DetectShape(code);
+            if (it->second.shape != Macro::MacroShape::None) {
+                LOG_INFO(HW_GPU, "Macro 0x{:016X} detected as {}", hash,
+                         Macro::NameOf(it->second.shape));
+            }
+            if (disk_cache) {
+                disk_cache->Insert(hash, it->second);
+            }
+        }
+    }
+    switch (it->second.shape) {
+    case Macro::MacroShape::DrawArraysIndirect:
+        return std::make_unique<HLE_DrawArraysIndirect<false>>(maxwell3d);
+    case Macro::MacroShape::DrawIndexedIndirect:
+        return std::make_unique<HLE_DrawIndexedIndirect<false>>(maxwell3d);
+    case Macro::MacroShape::ClearConstBuffer:
+        return std::make_unique<HLE_ClearConstBuffer>(maxwell3d, it->second.const_buffer_size);
+    case Macro::MacroShape::MultiLayerClear:
+        return std::make_unique<HLE_MultiLayerClear>(maxwell3d);
+    case Macro::MacroShape::None:
+        break;
+    }
+    return nullptr;
+}
+
 } // namespace Tegra
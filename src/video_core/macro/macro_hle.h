@@ -5,9 +5,11 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 #include <unordered_map>
 
 #include "common/common_types.h"
+#include "video_core/macro/macro_shape.h"
 
 namespace Tegra {
 
@@ -15,6 +17,10 @@ namespace Engines {
 class Maxwell3D;
 }
 
+namespace Macro {
+class MacroDiskCache;
+}
+
 class HLEMacro {
 public:
     explicit HLEMacro(Engines::Maxwell3D& maxwell3d_);
@@ -24,10 +30,19 @@ public:
     // Returns nullptr otherwise.
     [[nodiscard]] std::unique_ptr<CachedMacro> GetHLEProgram(u64 hash) const;
 
+    // Results of previous sessions used to skip detecting the shape of known macros
+    void SetDiskCache(std::shared_ptr<Macro::MacroDiskCache> disk_cache_);
+
+    // Same as above, but falls back to recognizing the behaviour of the code when the hash is
+    // unknown. Detection results are remembered by hash, macros are uploaded again very often.
+    [[nodiscard]] std::unique_ptr<CachedMacro> GetHLEProgram(u64 hash, std::span<const u32> code);
+
 private:
     Engines::Maxwell3D& maxwell3d;
     std::unordered_map<u64, std::function<std::unique_ptr<CachedMacro>(Engines::Maxwell3D&)>>
         builders;
+    std::unordered_map<u64, Macro::DetectedShape> detected_shapes;
+    std::shared_ptr<Macro::MacroDiskCache> disk_cache;
 };
 
 } // namespace Tegra
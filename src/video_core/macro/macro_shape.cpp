@@ -0,0 +1,946 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_shape.h"
+
+namespace Tegra::Macro {
+
+using Maxwell3D = Engines::Maxwell3D;
+
+namespace {
+
+constexpr u32 REG_DRAW_END = MAXWELL3D_REG_INDEX(draw.end);
+constexpr u32 REG_DRAW_BEGIN = MAXWELL3D_REG_INDEX(draw.begin);
+constexpr u32 REG_VERTEX_FIRST = MAXWELL3D_REG_INDEX(vertex_buffer.first);
+constexpr u32 REG_VERTEX_COUNT = MAXWELL3D_REG_INDEX(vertex_buffer.count);
+constexpr u32 REG_INDEX_FIRST = MAXWELL3D_REG_INDEX(index_buffer.first);
+constexpr u32 REG_INDEX_COUNT = MAXWELL3D_REG_INDEX(index_buffer.count);
+constexpr u32 REG_VERTEX_ID_BASE = MAXWELL3D_REG_INDEX(vertex_id_base);
+constexpr u32 REG_BASE_VERTEX = MAXWELL3D_REG_INDEX(global_base_vertex_index);
+constexpr u32 REG_BASE_INSTANCE = MAXWELL3D_REG_INDEX(global_base_instance_index);
+constexpr u32 REG_INSTANCE_MASK = 0xD1B;
+constexpr u32 REG_CLEAR_SURFACE = MAXWELL3D_REG_INDEX(clear_surface);
+constexpr u32 REG_RT_DEPTH = MAXWELL3D_REG_INDEX(rt) + 6;
+constexpr u32 RT_STRIDE = sizeof(Maxwell3D::Regs::RenderTargetConfig) / sizeof(u32);
+constexpr u32 REG_CB_SIZE = MAXWELL3D_REG_INDEX(const_buffer.size);
+constexpr u32 REG_CB_ADDRESS_HIGH = MAXWELL3D_REG_INDEX(const_buffer.address_high);
+constexpr u32 REG_CB_ADDRESS_LOW = MAXWELL3D_REG_INDEX(const_buffer.address_low);
+constexpr u32 REG_CB_OFFSET = MAXWELL3D_REG_INDEX(const_buffer.offset);
+constexpr u32 REG_CB_DATA = MAXWELL3D_REG_INDEX(const_buffer.buffer);
+constexpr u32 NUM_CB_DATA = Maxwell3D::Regs::NumCBData;
+
+static_assert(offsetof(Maxwell3D::Regs::RenderTargetConfig, array_pitch) == 7 * sizeof(u32),
+              "The render target depth is expected right before the array pitch");
+
+// Enough for the largest edge probes, clearing every layer a render target can have
+constexpr u32 MAX_SANDBOX_STEPS = 0x100000;
+constexpr u32 NUM_PROBES = 8;
+
+/// Methods with side effects beyond storing the value, the register state is recorded on them
+bool IsTrigger(u32 method) {
+    if (method == REG_DRAW_END || method == REG_CLEAR_SURFACE) {
+        return true;
+    }
+    return method >= REG_CB_DATA && method < REG_CB_DATA + NUM_CB_DATA;
+}
+
+/// Constant buffer data writes land in the same place no matter the index they are written to
+u32 CanonicalMethod(u32 method) {
+    if (method >= REG_CB_DATA && method < REG_CB_DATA + NUM_CB_DATA) {
+        return REG_CB_DATA;
+    }
+    return method;
+}
+
+using RegisterState = std::map<u32, u32>;
+
+struct TriggerEvent {
+    u32 method;
+    u32 value;
+    RegisterState state;
+
+    bool operator==(const TriggerEvent&) const = default;
+};
+
+struct Probe {
+    std::vector<u32> parameters;
+    RegisterState registers; ///< Values of registers the probe relies on
+    u64 seed;
+};
+
+/// Register file seen by a sandboxed macro or a shape model
+class ProbeState {
+public:
+    explicit ProbeState(const Probe& probe_) : probe{probe_} {}
+
+    u32 Read(u32 method) const {
+        if (const auto it = written.find(method); it != written.end()) {
+            return it->second;
+        }
+        if (const auto it = probe.registers.find(method); it != probe.registers.end()) {
+            return it->second;
+        }
+        // Registers the probe doesn't care about hold pseudo random values, a macro depending
+        // on them won't behave the same across probes
+        u64 value = probe.seed ^ (static_cast<u64>(method) * 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 31)) * 0xBF58476D1CE4E5B9ULL;
+        return static_cast<u32>(value ^ (value >> 29));
+    }
+
+    void Write(u32 method, u32 value) {
+        method = CanonicalMethod(method);
+        written[method] = value;
+        if (IsTrigger(method)) {
+            events.push_back(TriggerEvent{method, value, written});
+        }
+    }
+
+    bool SameBehaviour(const ProbeState& other) const {
+        return written == other.written && events == other.events;
+    }
+
+    const Probe& probe;
+    RegisterState written;
+    std::vector<TriggerEvent> events;
+};
+
+/// Runs a macro like the interpreter does, against a probe register file instead of the GPU
+class Sandbox {
+public:
+    explicit Sandbox(std::span<const u32> code_, ProbeState& state_)
+        : code{code_}, state{state_} {}
+
+    bool Run(std::span<const u32> parameters_) {
+        parameters = parameters_;
+        if (parameters.empty()) {
+            return false;
+        }
+        registers[1] = parameters[0];
+        next_parameter = 1;
+        while (!failed) {
+            if (!Step(false)) {
+                break;
+            }
+        }
+        return !failed && next_parameter == parameters.size();
+    }
+
+private:
+    bool Fail() {
+        failed = true;
+        return false;
+    }
+
+    bool Step(bool is_delay_slot) {
+        if (++steps > MAX_SANDBOX_STEPS || pc % 4 != 0 || pc / 4 >= code.size()) {
+            return Fail();
+        }
+        const u32 base_address = pc;
+        const Opcode opcode{code[pc / 4]};
+        pc += 4;
+        if (delayed_pc) {
+            pc = *delayed_pc;
+            delayed_pc.reset();
+        }
+        switch (opcode.operation) {
+        case Operation::ALU: {
+            const std::optional<u32> result = Alu(opcode.alu_operation, registers[opcode.src_a],
+                                                  registers[opcode.src_b]);
+            if (!result) {
+                return Fail();
+            }
+            ProcessResult(opcode.result_operation, opcode.dst, *result);
+            break;
+        }
+        case Operation::AddImmediate:
+            ProcessResult(opcode.result_operation, opcode.dst,
+                          registers[opcode.src_a] + opcode.immediate);
+            break;
+        case Operation::ExtractInsert: {
+            u32 dst = registers[opcode.src_a];
+            u32 src = registers[opcode.src_b];
+            src = (src >> opcode.bf_src_bit) & opcode.GetBitfieldMask();
+            dst &= ~(opcode.GetBitfieldMask() << opcode.bf_dst_bit);
+            dst |= src << opcode.bf_dst_bit;
+            ProcessResult(opcode.result_operation, opcode.dst, dst);
+            break;
+        }
+        case Operation::ExtractShiftLeftImmediate: {
+            const u32 dst = registers[opcode.src_a];
+            const u32 src = registers[opcode.src_b];
+            // Shift amounts wrap around like they do for the interpreter on the host
+            ProcessResult(opcode.result_operation, opcode.dst,
+                          ((src >> (dst & 31)) & opcode.GetBitfieldMask()) << opcode.bf_dst_bit);
+            break;
+        }
+        case Operation::ExtractShiftLeftRegister: {
+            const u32 dst = registers[opcode.src_a];
+            const u32 src = registers[opcode.src_b];
+            ProcessResult(opcode.result_operation, opcode.dst,
+                          ((src >> opcode.bf_src_bit) & opcode.GetBitfieldMask()) << (dst & 31));
+            break;
+        }
+        case Operation::Read:
+            ProcessResult(opcode.result_operation, opcode.dst,
+                          state.Read(registers[opcode.src_a] + opcode.immediate));
+            break;
+        case Operation::Branch: {
+            if (is_delay_slot) {
+                return Fail();
+            }
+            const u32 value = registers[opcode.src_a];
+            const bool taken = opcode.branch_condition == BranchCondition::Zero ? value == 0
+                                                                                 : value != 0;
+            if (taken) {
+                if (opcode.branch_annul) {
+                    pc = base_address + opcode.GetBranchTarget();
+                    return true;
+                }
+                delayed_pc = base_address + opcode.GetBranchTarget();
+                return Step(true);
+            }
+            break;
+        }
+        default:
+            return Fail();
+        }
+        if (opcode.is_exit && !is_delay_slot) {
+            Step(true);
+            return false;
+        }
+        return !failed;
+    }
+
+    std::optional<u32> Alu(ALUOperation operation, u32 src_a, u32 src_b) {
+        switch (operation) {
+        case ALUOperation::Add: {
+            const u64 result{static_cast<u64>(src_a) + src_b};
+            carry_flag = result > 0xffffffff;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::AddWithCarry: {
+            const u64 result{static_cast<u64>(src_a) + src_b + (carry_flag ? 1ULL : 0ULL)};
+            carry_flag = result > 0xffffffff;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::Subtract: {
+            const u64 result{static_cast<u64>(src_a) - src_b};
+            carry_flag = result < 0x100000000;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::SubtractWithBorrow: {
+            const u64 result{static_cast<u64>(src_a) - src_b - (carry_flag ? 0ULL : 1ULL)};
+            carry_flag = result < 0x100000000;
+            return static_cast<u32>(result);
+        }
+        case ALUOperation::Xor:
+            return src_a ^ src_b;
+        case ALUOperation::Or:
+            return src_a | src_b;
+        case ALUOperation::And:
+            return src_a & src_b;
+        case ALUOperation::AndNot:
+            return src_a & ~src_b;
+        case ALUOperation::Nand:
+            return ~(src_a & src_b);
+        default:
+            return std::nullopt;
+        }
+    }
+
+    void ProcessResult(ResultOperation operation, u32 reg, u32 result) {
+        switch (operation) {
+        case ResultOperation::IgnoreAndFetch:
+            SetRegister(reg, Fetch());
+            break;
+        case ResultOperation::Move:
+            SetRegister(reg, result);
+            break;
+        case ResultOperation::MoveAndSetMethod:
+            SetRegister(reg, result);
+            method_address.raw = result;
+            break;
+        case ResultOperation::FetchAndSend:
+            SetRegister(reg, Fetch());
+            Send(result);
+            break;
+        case ResultOperation::MoveAndSend:
+            SetRegister(reg, result);
+            Send(result);
+            break;
+        case ResultOperation::FetchAndSetMethod:
+            SetRegister(reg, Fetch());
+            method_address.raw = result;
+            break;
+        case ResultOperation::MoveAndSetMethodFetchAndSend:
+            SetRegister(reg, result);
+            method_address.raw = result;
+            Send(Fetch());
+            break;
+        case ResultOperation::MoveAndSetMethodSend:
+            SetRegister(reg, result);
+            method_address.raw = result;
+            Send((result >> 12) & 0b111111);
+            break;
+        }
+    }
+
+    void SetRegister(u32 reg, u32 value) {
+        if (reg != 0) {
+            registers[reg] = value;
+        }
+    }
+
+    u32 Fetch() {
+        if (next_parameter >= parameters.size()) {
+            Fail();
+            return 0;
+        }
+        return parameters[next_parameter++];
+    }
+
+    void Send(u32 value) {
+        state.Write(method_address.address, value);
+        method_address.address.Assign(method_address.address.Value() +
+                                      method_address.increment.Value());
+    }
+
+    std::span<const u32> code;
+    ProbeState& state;
+    std::span<const u32> parameters;
+    size_t next_parameter{};
+    std::array<u32, NUM_MACRO_REGISTERS> registers{};
+    MethodAddress method_address{};
+    u32 pc{};
+    std::optional<u32> delayed_pc;
+    bool carry_flag{};
+    bool failed{};
+    u32 steps{};
+};
+
+constexpr size_t MAX_TRACKED_VALUES = 64;
+
+/// Values a macro register may hold, std::nullopt when there are too many to enumerate
+using ValueSet = std::optional<std::set<u32>>;
+
+ValueSet Constant(u32 value) {
+    return std::set<u32>{value};
+}
+
+/// Every value a bitfield of an unknown value can take, shifted to where it is extracted from
+ValueSet FieldValues(u32 mask, u32 shift) {
+    if (mask >= MAX_TRACKED_VALUES) {
+        return std::nullopt;
+    }
+    std::set<u32> values;
+    for (u32 value = 0; value <= mask; ++value) {
+        values.insert(value << shift);
+    }
+    return values;
+}
+
+/// Every value an unknown value masked with the given bits can take
+ValueSet Submasks(u32 mask) {
+    if ((1ULL << std::popcount(mask)) > MAX_TRACKED_VALUES) {
+        return std::nullopt;
+    }
+    std::set<u32> values;
+    for (u32 submask = mask;; submask = (submask - 1) & mask) {
+        values.insert(submask);
+        if (submask == 0) {
+            break;
+        }
+    }
+    return values;
+}
+
+template <typename Func>
+ValueSet Apply(const ValueSet& a, const ValueSet& b, Func&& func) {
+    if (!a || !b) {
+        return std::nullopt;
+    }
+    std::set<u32> values;
+    for (const u32 value_a : *a) {
+        for (const u32 value_b : *b) {
+            values.insert(func(value_a, value_b));
+            if (values.size() > MAX_TRACKED_VALUES) {
+                return std::nullopt;
+            }
+        }
+    }
+    return values;
+}
+
+void JoinValues(ValueSet& lhs, const ValueSet& rhs) {
+    if (!lhs) {
+        return;
+    }
+    if (!rhs) {
+        lhs.reset();
+        return;
+    }
+    lhs->insert(rhs->begin(), rhs->end());
+    if (lhs->size() > MAX_TRACKED_VALUES) {
+        lhs.reset();
+    }
+}
+
+/// Abstract macro state, each register holds the set of values it may have on some path
+struct AbstractState {
+    std::array<ValueSet, NUM_MACRO_REGISTERS> registers{};
+    ValueSet method_address;
+
+    bool operator==(const AbstractState&) const = default;
+
+    void Join(const AbstractState& other) {
+        for (size_t i = 0; i < registers.size(); ++i) {
+            JoinValues(registers[i], other.registers[i]);
+        }
+        JoinValues(method_address, other.method_address);
+    }
+};
+
+class DataflowPass {
+public:
+    explicit DataflowPass(std::span<const u32> code_) : code{code_} {}
+
+    DataflowInfo Run() {
+        info.valid = true;
+        // Registers start cleared except for $r1, which holds the first parameter
+        AbstractState entry;
+        entry.registers.fill(Constant(0));
+        entry.registers[1].reset();
+        entry.method_address = Constant(0);
+        Merge(0, entry);
+        while (!worklist.empty() && info.valid) {
+            const u32 pc = worklist.back();
+            worklist.pop_back();
+            Visit(pc, states[pc]);
+        }
+        return info;
+    }
+
+private:
+    void Merge(u32 pc, const AbstractState& state) {
+        if (pc % 4 != 0 || pc / 4 >= code.size()) {
+            info.valid = false;
+            return;
+        }
+        const auto [it, inserted] = states.try_emplace(pc, state);
+        if (!inserted) {
+            AbstractState joined = it->second;
+            joined.Join(state);
+            if (joined == it->second) {
+                return;
+            }
+            it->second = joined;
+        }
+        worklist.push_back(pc);
+    }
+
+    void Visit(u32 pc, AbstractState state) {
+        const Opcode opcode{code[pc / 4]};
+        if (opcode.operation == Operation::Branch) {
+            const ValueSet& values = state.registers[opcode.src_a];
+            const auto is_taken = [&](u32 value) {
+                return (opcode.branch_condition == BranchCondition::Zero) == (value == 0);
+            };
+            const u32 target = pc + opcode.GetBranchTarget();
+            const bool can_take = !values || std::ranges::any_of(*values, is_taken);
+            const bool can_skip = !values || !std::ranges::all_of(*values, is_taken);
+            if (can_take) {
+                if (opcode.branch_annul) {
+                    Merge(target, state);
+                } else {
+                    AbstractState delay_state = state;
+                    if (!DelaySlot(pc + 4, delay_state)) {
+                        return;
+                    }
+                    Merge(target, delay_state);
+                }
+            }
+            if (can_skip && !opcode.is_exit) {
+                Merge(pc + 4, state);
+            } else if (can_skip) {
+                DelaySlot(pc + 4, state);
+            }
+            return;
+        }
+        Transfer(opcode, state);
+        if (opcode.is_exit) {
+            DelaySlot(pc + 4, state);
+            return;
+        }
+        Merge(pc + 4, state);
+    }
+
+    bool DelaySlot(u32 pc, AbstractState& state) {
+        if (pc / 4 >= code.size()) {
+            info.valid = false;
+            return false;
+        }
+        const Opcode opcode{code[pc / 4]};
+        if (opcode.operation == Operation::Branch) {
+            info.valid = false;
+            return false;
+        }
+        Transfer(opcode, state);
+        return true;
+    }
+
+    void Transfer(Opcode opcode, AbstractState& state) {
+        const ValueSet& src_a = state.registers[opcode.src_a];
+        const ValueSet& src_b = state.registers[opcode.src_b];
+        const u32 src_bit = opcode.bf_src_bit;
+        const u32 dst_bit = opcode.bf_dst_bit;
+        // Unknown operands of bitfield operations are replaced by one value per field value,
+        // the result only depends on the field
+        ValueSet result;
+        switch (opcode.operation) {
+        case Operation::ALU:
+            result = Alu(opcode.alu_operation, src_a, src_b);
+            break;
+        case Operation::AddImmediate:
+            result = Apply(src_a, Constant(static_cast<u32>(opcode.immediate.Value())),
+                           std::plus<u32>{});
+            break;
+        case Operation::ExtractInsert: {
+            const u32 mask = opcode.GetBitfieldMask();
+            result = Apply(src_a, src_b ? src_b : FieldValues(mask, src_bit),
+                           [&](u32 dst, u32 src) {
+                               dst &= ~(mask << dst_bit);
+                               return dst | (((src >> src_bit) & mask) << dst_bit);
+                           });
+            break;
+        }
+        case Operation::ExtractShiftLeftImmediate: {
+            const u32 mask = opcode.GetBitfieldMask();
+            if (!src_b) {
+                result = FieldValues(mask, dst_bit);
+                break;
+            }
+            result = Apply(src_a ? src_a : FieldValues(31, 0), src_b, [&](u32 dst, u32 src) {
+                return ((src >> (dst & 31)) & mask) << dst_bit;
+            });
+            break;
+        }
+        case Operation::ExtractShiftLeftRegister: {
+            const u32 mask = opcode.GetBitfieldMask();
+            result = Apply(src_a ? src_a : FieldValues(31, 0),
+                           src_b ? src_b : FieldValues(mask, src_bit), [&](u32 dst, u32 src) {
+                               return ((src >> src_bit) & mask) << (dst & 31);
+                           });
+            break;
+        }
+        case Operation::Read: {
+            const ValueSet addresses =
+                Apply(src_a, Constant(static_cast<u32>(opcode.immediate.Value())),
+                      std::plus<u32>{});
+            if (addresses) {
+                info.known_reads.insert(addresses->begin(), addresses->end());
+            } else {
+                info.dynamic_reads = true;
+            }
+            break;
+        }
+        default:
+            info.valid = false;
+            return;
+        }
+        const auto set_register = [&](ValueSet value) {
+            if (opcode.dst != 0) {
+                state.registers[opcode.dst] = std::move(value);
+            }
+        };
+        switch (opcode.result_operation) {
+        case ResultOperation::IgnoreAndFetch:
+            set_register(std::nullopt);
+            break;
+        case ResultOperation::Move:
+            set_register(result);
+            break;
+        case ResultOperation::MoveAndSetMethod:
+            set_register(result);
+            state.method_address = result;
+            break;
+        case ResultOperation::FetchAndSend:
+            set_register(std::nullopt);
+            Send(state);
+            break;
+        case ResultOperation::MoveAndSend:
+            set_register(result);
+            Send(state);
+            break;
+        case ResultOperation::FetchAndSetMethod:
+            set_register(std::nullopt);
+            state.method_address = result;
+            break;
+        case ResultOperation::MoveAndSetMethodFetchAndSend:
+        case ResultOperation::MoveAndSetMethodSend:
+            set_register(result);
+            state.method_address = result;
+            Send(state);
+            break;
+        }
+    }
+
+    ValueSet Alu(ALUOperation operation, const ValueSet& a, const ValueSet& b) {
+        switch (operation) {
+        case ALUOperation::Add:
+            return Apply(a, b, std::plus<u32>{});
+        case ALUOperation::Subtract:
+            return Apply(a, b, std::minus<u32>{});
+        case ALUOperation::Xor:
+            return Apply(a, b, std::bit_xor<u32>{});
+        case ALUOperation::Or:
+            return Apply(a, b, std::bit_or<u32>{});
+        case ALUOperation::And:
+            // Masking an unknown value with known bits leaves a few values to enumerate
+            if (a && !b) {
+                return Apply(a, Submasks(Union(*a)), std::bit_and<u32>{});
+            }
+            if (!a && b) {
+                return Apply(Submasks(Union(*b)), b, std::bit_and<u32>{});
+            }
+            return Apply(a, b, std::bit_and<u32>{});
+        case ALUOperation::AndNot:
+            return Apply(a, b, [](u32 lhs, u32 rhs) { return lhs & ~rhs; });
+        case ALUOperation::Nand:
+            return Apply(a, b, [](u32 lhs, u32 rhs) { return ~(lhs & rhs); });
+        case ALUOperation::AddWithCarry:
+        case ALUOperation::SubtractWithBorrow:
+            // The carry flag isn't tracked
+            return std::nullopt;
+        default:
+            info.valid = false;
+            return std::nullopt;
+        }
+    }
+
+    static u32 Union(const std::set<u32>& values) {
+        u32 bits = 0;
+        for (const u32 value : values) {
+            bits |= value;
+        }
+        return bits;
+    }
+
+    void Send(AbstractState& state) {
+        if (!state.method_address) {
+            info.dynamic_sends = true;
+            return;
+        }
+        std::set<u32> next_addresses;
+        for (const u32 raw : *state.method_address) {
+            MethodAddress address{raw};
+            info.known_sends.insert(address.address);
+            address.address.Assign(address.address.Value() + address.increment.Value());
+            next_addresses.insert(address.raw);
+        }
+        state.method_address = std::move(next_addresses);
+    }
+
+    std::span<const u32> code;
+    DataflowInfo info;
+    std::map<u32, AbstractState> states;
+    std::vector<u32> worklist;
+};
+
+/// Reference behaviour of a macro with a HLE implementation
+struct ShapeModel {
+    MacroShape shape;
+    std::array<u32, 2> key_methods; ///< Methods the macro has to be able to write
+    bool (*may_read)(u32 reg);      ///< Registers the HLE implementation depends on
+    bool (*may_send)(u32 method);   ///< Methods the HLE implementation writes
+    void (*make_edge_probes)(std::vector<Probe>& probes);
+    void (*make_probe)(std::mt19937& rng, Probe& probe);
+    void (*run)(const DetectedShape& detected, const Probe& probe, ProbeState& state);
+};
+
+u32 RandomTopology(std::mt19937& rng) {
+    using Topology = Maxwell3D::Regs::PrimitiveTopology;
+    static constexpr std::array topologies{Topology::Points, Topology::Lines,
+                                           Topology::Triangles, Topology::TriangleStrip};
+    return static_cast<u32>(topologies[rng() % topologies.size()]);
+}
+
+/// Builds a draw parameter buffer with between one and three enabled instances
+void MakeDrawProbe(std::mt19937& rng, Probe& probe, size_t num_parameters) {
+    probe.parameters.resize(num_parameters);
+    for (u32& parameter : probe.parameters) {
+        parameter = static_cast<u32>(rng());
+    }
+    probe.parameters[0] = RandomTopology(rng);
+    probe.parameters[2] = 1 + static_cast<u32>(rng() % 3);
+    probe.registers[REG_INSTANCE_MASK] =
+        rng() % 2 == 0 ? 0xFFFFFFFF : static_cast<u32>(rng()) | probe.parameters[2];
+}
+
+/// Draws without instances, with every instance masked off, and with the largest parameters
+void MakeDrawEdgeProbes(std::vector<Probe>& probes, size_t num_parameters) {
+    const auto add = [&](u32 value, u32 num_instances, u32 instance_mask) {
+        Probe& probe = probes.emplace_back();
+        probe.parameters.assign(num_parameters, value);
+        probe.parameters[0] = static_cast<u32>(Maxwell3D::Regs::PrimitiveTopology::Triangles);
+        probe.parameters[2] = num_instances;
+        probe.registers[REG_INSTANCE_MASK] = instance_mask;
+    };
+    add(0, 0, 0xFFFFFFFF);
+    add(0, 3, 0);
+    add(0xFFFFFFFF, 3, 0xFFFFFFFF);
+    // Only the mask keeps the number of instances low
+    add(0xFFFFFFFF, 0xFFFFFFFF, 5);
+}
+
+void DrawInstances(ProbeState& state, u32 topology, u32 num_instances) {
+    for (u32 instance = 0; instance < num_instances; ++instance) {
+        const u32 instance_id = instance == 0 ? 0 : 1;
+        state.Write(REG_DRAW_BEGIN, topology | (instance_id << 26));
+        state.Write(REG_DRAW_END, 0);
+    }
+}
+
+bool ReadsInstanceMask(u32 reg) {
+    return reg == REG_INSTANCE_MASK;
+}
+
+bool IsConstBufferMethod(u32 method) {
+    return method >= REG_CB_SIZE && method < REG_CB_DATA + NUM_CB_DATA;
+}
+
+constexpr std::array<ShapeModel, 4> SHAPE_MODELS{{
+    {
+        .shape = MacroShape::DrawArraysIndirect,
+        .key_methods = {REG_DRAW_BEGIN, REG_DRAW_END},
+        .may_read = ReadsInstanceMask,
+        .may_send =
+            [](u32 method) {
+                return method == REG_VERTEX_FIRST || method == REG_VERTEX_COUNT ||
+                       method == REG_BASE_INSTANCE || method == REG_DRAW_BEGIN ||
+                       method == REG_DRAW_END;
+            },
+        .make_edge_probes = [](std::vector<Probe>& probes) { MakeDrawEdgeProbes(probes, 5); },
+        .make_probe = [](std::mt19937& rng, Probe& probe) { MakeDrawProbe(rng, probe, 5); },
+        .run =
+            [](const DetectedShape&, const Probe& probe, ProbeState& state) {
+                const std::vector<u32>& params = probe.parameters;
+                const u32 num_instances = state.Read(REG_INSTANCE_MASK) & params[2];
+                state.Write(REG_VERTEX_FIRST, params[3]);
+                state.Write(REG_VERTEX_COUNT, params[1]);
+                state.Write(REG_BASE_INSTANCE, params[4]);
+                DrawInstances(state, params[0], num_instances);
+                state.Write(REG_BASE_INSTANCE, 0);
+            },
+    },
+    {
+        .shape = MacroShape::DrawIndexedIndirect,
+        .key_methods = {REG_DRAW_BEGIN, REG_DRAW_END},
+        .may_read = ReadsInstanceMask,
+        .may_send =
+            [](u32 method) {
+                return method == REG_VERTEX_ID_BASE || method == REG_BASE_VERTEX ||
+                       method == REG_BASE_INSTANCE || method == REG_INDEX_FIRST ||
+                       method == REG_INDEX_COUNT || method == REG_DRAW_BEGIN ||
+                       method == REG_DRAW_END;
+            },
+        .make_edge_probes = [](std::vector<Probe>& probes) { MakeDrawEdgeProbes(probes, 6); },
+        .make_probe = [](std::mt19937& rng, Probe& probe) { MakeDrawProbe(rng, probe, 6); },
+        .run =
+            [](const DetectedShape&, const Probe& probe, ProbeState& state) {
+                const std::vector<u32>& params = probe.parameters;
+                const u32 num_instances = state.Read(REG_INSTANCE_MASK) & params[2];
+                state.Write(REG_VERTEX_ID_BASE, params[4]);
+                state.Write(REG_BASE_VERTEX, params[4]);
+                state.Write(REG_BASE_INSTANCE, params[5]);
+                state.Write(REG_INDEX_FIRST, params[3]);
+                state.Write(REG_INDEX_COUNT, params[1]);
+                DrawInstances(state, params[0], num_instances);
+                state.Write(REG_VERTEX_ID_BASE, 0);
+                state.Write(REG_BASE_VERTEX, 0);
+                state.Write(REG_BASE_INSTANCE, 0);
+            },
+    },
+    {
+        .shape = MacroShape::ClearConstBuffer,
+        .key_methods = {REG_CB_SIZE, REG_CB_DATA},
+        .may_read = [](u32) { return false; },
+        .may_send = IsConstBufferMethod,
+        .make_edge_probes =
+            [](std::vector<Probe>& probes) {
+                // Nothing to clear, and the largest constant buffer at the highest address
+                probes.push_back({.parameters = {0, 0, 0}});
+                probes.push_back({.parameters = {0xFFFFFFFF, 0xFFFFFFFF, 0x10000 / 16}});
+            },
+        .make_probe =
+            [](std::mt19937& rng, Probe& probe) {
+                probe.parameters = {static_cast<u32>(rng() & 0xFF), static_cast<u32>(rng()),
+                                    static_cast<u32>(rng() % 9)};
+            },
+        .run =
+            [](const DetectedShape& detected, const Probe& probe, ProbeState& state) {
+                const std::vector<u32>& params = probe.parameters;
+                state.Write(REG_CB_SIZE, detected.const_buffer_size);
+                state.Write(REG_CB_ADDRESS_HIGH, params[0]);
+                state.Write(REG_CB_ADDRESS_LOW, params[1]);
+                state.Write(REG_CB_OFFSET, 0);
+                for (u32 i = 0; i < params[2] * 4; ++i) {
+                    state.Write(REG_CB_DATA, 0);
+                }
+            },
+    },
+    {
+        .shape = MacroShape::MultiLayerClear,
+        .key_methods = {REG_CLEAR_SURFACE, REG_CLEAR_SURFACE},
+        .may_read =
+            [](u32 reg) {
+                // The clear selects one of 16 render targets, like the HLE implementation
+                const u32 offset = reg - REG_RT_DEPTH;
+                return reg >= REG_RT_DEPTH && offset % RT_STRIDE == 0 && offset / RT_STRIDE < 16;
+            },
+        .may_send = [](u32 method) { return method == REG_CLEAR_SURFACE; },
+        .make_edge_probes =
+            [](std::vector<Probe>& probes) {
+                const auto add = [&](u32 clear, u32 rt, u32 depth) {
+                    probes.push_back({.parameters = {clear | (rt << 6)},
+                                      .registers = {{REG_RT_DEPTH + rt * RT_STRIDE, depth}}});
+                };
+                // No layers, only the low half of the depth, every layer, every bit outside of
+                // the layer set
+                add(0x3F, 0, 0);
+                add(0x3F, 7, 0xFFFF0003);
+                add(0x3F, 1, 0xFFFF);
+                add(0xFC00003F, 7, 2);
+            },
+        .make_probe =
+            [](std::mt19937& rng, Probe& probe) {
+                const u32 rt = static_cast<u32>(rng() % Maxwell3D::Regs::NumRenderTargets);
+                probe.parameters = {static_cast<u32>(rng() & 0x3F) | (rt << 6)};
+                probe.registers[REG_RT_DEPTH + rt * RT_STRIDE] = 1 + static_cast<u32>(rng() % 4);
+            },
+        .run =
+            [](const DetectedShape&, const Probe& probe, ProbeState& state) {
+                const Maxwell3D::Regs::ClearSurface clear{probe.parameters[0]};
+                const u32 num_layers = state.Read(REG_RT_DEPTH + clear.RT * RT_STRIDE) & 0xFFFF;
+                for (u32 layer = 0; layer < num_layers; ++layer) {
+                    Maxwell3D::Regs::ClearSurface layer_clear{clear};
+                    layer_clear.layer.Assign(layer);
+                    state.Write(REG_CLEAR_SURFACE, layer_clear.raw);
+                }
+            },
+    },
+}};
+
+/**
+ * Proves the footprint of the macro fits the model: it reads only registers the HLE
+ * implementation depends on and writes only methods it writes, so whatever it sends is a function
+ * of the parameters and of those registers. The probes then check it is the same function.
+ */
+bool PassesDataflow(const ShapeModel& model, const DataflowInfo& info) {
+    if (info.dynamic_reads || info.dynamic_sends) {
+        return false;
+    }
+    if (!std::ranges::all_of(info.known_reads, model.may_read) ||
+        !std::ranges::all_of(info.known_sends, model.may_send)) {
+        return false;
+    }
+    for (const u32 method : model.key_methods) {
+        const auto it = info.known_sends.lower_bound(method);
+        if (it == info.known_sends.end() || CanonicalMethod(*it) != CanonicalMethod(method)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MatchesModel(std::span<const u32> code, const ShapeModel& model, DetectedShape& detected) {
+    std::mt19937 rng{0x6D616372};
+    std::vector<Probe> probes;
+    model.make_edge_probes(probes);
+    for (Probe& probe : probes) {
+        probe.seed = (static_cast<u64>(rng()) << 32) | rng();
+    }
+    for (u32 probe_index = 0; probe_index < NUM_PROBES; ++probe_index) {
+        Probe& probe = probes.emplace_back();
+        probe.seed = (static_cast<u64>(rng()) << 32) | rng();
+        model.make_probe(rng, probe);
+    }
+
+    for (size_t probe_index = 0; probe_index < probes.size(); ++probe_index) {
+        const Probe& probe = probes[probe_index];
+        ProbeState macro_state{probe};
+        if (!Sandbox{code, macro_state}.Run(probe.parameters)) {
+            return false;
+        }
+        if (probe_index == 0 && model.shape == MacroShape::ClearConstBuffer) {
+            // The size is a constant of the macro, learn it from the first run
+            const auto it = macro_state.written.find(REG_CB_SIZE);
+            if (it == macro_state.written.end() || it->second == 0 || it->second > 0x10000 ||
+                it->second % 4 != 0) {
+                return false;
+            }
+            detected.const_buffer_size = it->second;
+        }
+        ProbeState model_state{probe};
+        model.run(detected, probe, model_state);
+        if (!macro_state.SameBehaviour(model_state)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+DataflowInfo AnalyzeDataflow(std::span<const u32> code) {
+    if (code.empty()) {
+        return {};
+    }
+    return DataflowPass{code}.Run();
+}
+
+DetectedShape DetectShape(std::span<const u32> code) {
+    const DataflowInfo info = AnalyzeDataflow(code);
+    if (!info.valid) {
+        return {};
+    }
+    for (const ShapeModel& model : SHAPE_MODELS) {
+        if (!PassesDataflow(model, info)) {
+            continue;
+        }
+        DetectedShape detected{.shape = model.shape};
+        if (MatchesModel(code, model, detected)) {
+            return detected;
+        }
+    }
+    return {};
+}
+
+const char* NameOf(MacroShape shape) {
+    switch (shape) {
+    case MacroShape::None:
+        return "None";
+    case MacroShape::DrawArraysIndirect:
+        return "DrawArraysIndirect";
+    case MacroShape::DrawIndexedIndirect:
+        return "DrawIndexedIndirect";
+    case MacroShape::ClearConstBuffer:
+        return "ClearConstBuffer";
+    case MacroShape::MultiLayerClear:
+        return "MultiLayerClear";
+    }
+    return "Unknown";
+}
+
+} // namespace Tegra::Macro
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <set>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra::Macro {
+
+/// Bump whenever the detection rules change, results stored on disk are discarded
+constexpr u32 SHAPE_DETECTION_VERSION = 2;
+
+/// Macros with a HLE implementation that can be recognized from their behaviour
+enum class MacroShape : u32 {
+    None,
+    DrawArraysIndirect,
+    DrawIndexedIndirect,
+    ClearConstBuffer,
+    MultiLayerClear,
+};
+
+struct DetectedShape {
+    MacroShape shape{MacroShape::None};
+    u32 const_buffer_size{}; ///< Size written to the constant buffer by ClearConstBuffer
+};
+
+/// Result of a pass tracking the values each register may hold on every reachable instruction
+struct DataflowInfo {
+    bool valid{};              ///< False if the code can run out of bounds or is malformed
+    std::set<u32> known_reads; ///< Every register a read can address, unless dynamic_reads
+    std::set<u32> known_sends; ///< Every method a send can write, unless dynamic_sends
+    bool dynamic_reads{};      ///< Some read address takes too many values to enumerate
+    bool dynamic_sends{};      ///< Some method address takes too many values to enumerate
+};
+
+[[nodiscard]] DataflowInfo AnalyzeDataflow(std::span<const u32> code);
+
+/**
+ * Finds out if a macro behaves like one of the macros with a HLE implementation, regardless of its
+ * hash. The dataflow pass has to prove the macro reads only the registers the HLE implementation
+ * depends on and writes only the methods it writes. The candidates left are then run in a sandbox
+ * against a reference model of the shape, with edge case parameters and random ones, and only
+ * shapes matching every probe are reported.
+ */
+[[nodiscard]] DetectedShape DetectShape(std::span<const u32> code);
+
+[[nodiscard]] const char* NameOf(MacroShape shape);
+
+} // namespace Tegra::Macro
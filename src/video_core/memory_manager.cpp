@@ -9,6 +9,7 @@
 #include "core/core.h"
 #include "core/hle/kernel/k_page_table.h"
 #include "core/hle/kernel/k_process.h"
+#include "video_core/control/command_capture.h"
 #include "video_core/guest_memory.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/invalidation_accumulator.h"
@@ -179,6 +180,17 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
     rasterizer = rasterizer_;
 }
 
+void MemoryManager::BindCapture(Control::CommandCapture* capture_) {
+    capture.store(capture_, std::memory_order_relaxed);
+}
+
+void MemoryManager::RecordRead(GPUVAddr gpu_addr, const void* data, std::size_t size) const {
+    if (Control::CommandCapture* const active = capture.load(std::memory_order_relaxed)) {
+        active->RecordRead(unique_identifier, gpu_addr,
+                           std::span(static_cast<const u8*>(data), size));
+    }
+}
+
 GPUVAddr MemoryManager::Map(GPUVAddr gpu_addr, DAddr dev_addr, std::size_t size, PTEKind kind,
                             bool is_big_pages) {
     if (is_big_pages) [[likely]] {
@@ -243,6 +255,13 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr, std::size_t s
 
 template <typename T>
 T MemoryManager::Read(GPUVAddr addr) const {
+    if (capture.load(std::memory_order_relaxed) != nullptr) [[unlikely]] {
+        // Captured reads take the block path, which records them
+        T value{};
+        ReadBlockUnsafe(addr, &value, sizeof(T));
+        return value;
+    }
+
     if (auto page_pointer{GetPointer(addr)}; page_pointer) {
         // NOTE: Avoid adding any extra logic to this fast-path block
         T value;
@@ -368,6 +387,7 @@ inline void MemoryManager::MemoryOperation(GPUVAddr gpu_src_addr, std::size_t si
 template <bool is_safe>
 void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
                                   [[maybe_unused]] VideoCommon::CacheType which) const {
+    const void* const dest_start = dest_buffer;
     auto set_to_zero = [&]([[maybe_unused]] std::size_t page_index,
                            [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         std::memset(dest_buffer, 0, copy_amount);
@@ -403,6 +423,9 @@ void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std:
         MemoryOperation<false>(base, copy_amount, mapped_normal, set_to_zero, set_to_zero);
     };
     MemoryOperation<true>(gpu_src_addr, size, mapped_big, set_to_zero, read_short_pages);
+    if (capture.load(std::memory_order_relaxed) != nullptr) [[unlikely]] {
+        RecordRead(gpu_src_addr, dest_start, size);
+    }
 }
 
 void MemoryManager::ReadBlock(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
@@ -768,7 +791,11 @@ const u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size
     }
     auto dev_addr = GpuToCpuAddress(src_addr);
     if (dev_addr) {
-        return memory.GetSpan(*dev_addr, size);
+        auto* const span = memory.GetSpan(*dev_addr, size);
+        if (span && capture.load(std::memory_order_relaxed) != nullptr) [[unlikely]] {
+            RecordRead(src_addr, span, size);
+        }
+        return span;
     }
     return nullptr;
 }
@@ -33,6 +33,10 @@ class System;
 
 namespace Tegra {
 
+namespace Control {
+class CommandCapture;
+}
+
 class MemoryManager final {
 public:
     explicit MemoryManager(Core::System& system_, u64 address_space_bits_ = 40,
@@ -50,6 +54,9 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Binds a command capture that records the memory read through this address space.
+    void BindCapture(Control::CommandCapture* capture);
+
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
@@ -207,6 +214,7 @@ private:
     u64 big_page_table_mask;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
+    std::atomic<Control::CommandCapture*> capture = nullptr;
 
     enum class EntryType : u64 {
         Free = 0,
@@ -225,6 +233,9 @@ private:
     GPUVAddr BigPageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr dev_addr, size_t size,
                             PTEKind kind);
 
+    /// Hands memory read by the GPU to the bound capture
+    void RecordRead(GPUVAddr gpu_addr, const void* data, std::size_t size) const;
+
     template <bool is_big_page>
     inline EntryType GetEntry(size_t position) const;
 
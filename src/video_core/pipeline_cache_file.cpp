@@ -0,0 +1,672 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <unordered_set>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "video_core/pipeline_cache_file.h"
+
+namespace VideoCommon {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 't', 'p', 'i', 'p', 'e', 'c', 'h'};
+/// Version of the layout of the file and of its records
+constexpr u32 FORMAT_VERSION = 1;
+/// Version of the serialized environments, see GenericEnvironment::Serialize
+constexpr u32 ENVIRONMENT_VERSION = 1;
+/// Pipelines have at most one environment per stage
+constexpr u32 MAX_PIPELINE_ENVIRONMENTS = Tegra::Engines::Maxwell3D::Regs::MaxShaderProgram;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+    /// Offset of the last index record written, 0 if there is none
+    u64 index_offset;
+};
+static_assert(sizeof(FileHeader) == 24);
+
+struct RecordHeader {
+    u64 hash;
+    u32 type;
+    u32 version;
+    /// Size of the compressed payload following the header
+    u32 size;
+    u32 uncompressed_size;
+};
+static_assert(sizeof(RecordHeader) == 24);
+
+struct IndexEntry {
+    u64 hash;
+    u64 offset;
+    u32 type;
+    u32 version;
+};
+static_assert(sizeof(IndexEntry) == 24);
+
+/// Payload of a pipeline record, followed by the environment hashes and the key
+struct PipelineHeader {
+    u32 num_envs;
+    u32 key_size;
+};
+static_assert(sizeof(PipelineHeader) == 8);
+
+/// Input stream buffer reading straight from memory, without copying it into a string first
+class MemoryStreamBuffer final : public std::streambuf {
+public:
+    explicit MemoryStreamBuffer(std::span<const u8> data) {
+        char* const begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+[[nodiscard]] std::optional<RecordHeader> ReadRecordHeader(std::span<const u8> data, u64 offset) {
+    RecordHeader header;
+    if (offset > data.size() || data.size() - offset < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, data.data() + offset, sizeof(header));
+    if (header.size > data.size() - offset - sizeof(header)) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+[[nodiscard]] std::optional<std::vector<u8>> DecompressRecord(std::span<const u8> data, u64 offset,
+                                                              const RecordHeader& header) {
+    std::vector<u8> payload = Common::Compression::DecompressDataZSTD(
+        data.subspan(offset + sizeof(RecordHeader), header.size));
+    if (payload.size() != header.uncompressed_size) {
+        return std::nullopt;
+    }
+    return payload;
+}
+
+/// Decompresses the payload of a record copied out of the mapping
+[[nodiscard]] std::optional<std::vector<u8>> DecompressCopiedRecord(std::span<const u8> record) {
+    const std::optional<RecordHeader> header = ReadRecordHeader(record, 0);
+    return header ? DecompressRecord(record, 0, *header) : std::nullopt;
+}
+
+[[nodiscard]] u64 RecordSize(std::span<const u8> data, u64 offset) {
+    const std::optional<RecordHeader> header = ReadRecordHeader(data, offset);
+    return header ? sizeof(RecordHeader) + header->size : 0;
+}
+
+/// Appends an index record at offset, the end of file, and points the header of file to it
+[[nodiscard]] bool WriteIndexRecord(Common::FS::IOFile& file, u64 offset, u32 index_type,
+                                    std::span<const IndexEntry> index) {
+    const std::vector<u8> compressed = Common::Compression::CompressDataZSTDDefault(
+        reinterpret_cast<const u8*>(index.data()), index.size_bytes());
+    if (compressed.empty()) {
+        return false;
+    }
+    const RecordHeader record{
+        .hash = 0,
+        .type = index_type,
+        .version = FORMAT_VERSION,
+        .size = static_cast<u32>(compressed.size()),
+        .uncompressed_size = static_cast<u32>(index.size_bytes()),
+    };
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = FORMAT_VERSION,
+        .reserved = 0,
+        .index_offset = offset,
+    };
+    return file.WriteObject(record) &&
+           file.WriteSpan(std::span<const u8>(compressed)) == compressed.size() &&
+           file.Seek(0) && file.WriteObject(header);
+}
+} // Anonymous namespace
+
+PipelineCacheFile::PipelineCacheFile() = default;
+
+PipelineCacheFile::~PipelineCacheFile() {
+    Close();
+}
+
+void PipelineCacheFile::Open(const std::filesystem::path& path_, u32 cache_version_,
+                             u64 host_shader_key_) {
+    Close();
+
+    std::scoped_lock lock{mutex};
+    path = path_;
+    cache_version = cache_version_;
+    host_shader_key = host_shader_key_;
+
+    if (Common::FS::Exists(path) && mapped.Open(path)) {
+        const u64 valid_size = LoadIndex();
+        if (valid_size == 0) {
+            LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
+            Reset();
+            if (!Common::FS::RemoveFile(path)) {
+                LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                          Common::FS::PathToUTF8String(path));
+                return;
+            }
+        } else if (valid_size != mapped.Size()) {
+            // A record was cut short, drop the tail so new records are appended after valid data
+            LOG_WARNING(Common_Filesystem, "Truncating corrupted pipeline cache");
+            mapped.Close();
+            Common::FS::IOFile truncate_file{path, Common::FS::FileAccessMode::ReadWrite};
+            if (!truncate_file.SetSize(valid_size)) {
+                LOG_ERROR(Common_Filesystem, "Failed to truncate pipeline cache file {}",
+                          Common::FS::PathToUTF8String(path));
+                Reset();
+                return;
+            }
+            truncate_file.Close();
+            if (!mapped.Open(path)) {
+                Reset();
+                return;
+            }
+        }
+    }
+    file.Open(path, Common::FS::FileAccessMode::ReadAppend);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
+                  Common::FS::PathToUTF8String(path));
+        Reset();
+        return;
+    }
+    if (!mapped.IsOpen()) {
+        const FileHeader header{
+            .magic = MAGIC_NUMBER,
+            .version = FORMAT_VERSION,
+            .reserved = 0,
+            .index_offset = 0,
+        };
+        if (!file.WriteObject(header)) {
+            LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache header");
+            Reset();
+            return;
+        }
+        file_size = sizeof(FileHeader);
+    }
+}
+
+void PipelineCacheFile::Close() {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        Reset();
+        return;
+    }
+    // Map the file again to read the records appended since it was opened
+    file.Close();
+    if (!mapped.Open(path)) {
+        Reset();
+        return;
+    }
+    const std::vector<std::pair<RecordKey, Entry>> live_records = LiveRecords();
+    u64 live_size = 0;
+    for (const auto& [key, entry] : live_records) {
+        live_size += RecordSize(mapped.Data(), entry.offset);
+    }
+    // The index in use is rewritten anyway when there are new records
+    const u64 dead_size = mapped.Size() - sizeof(FileHeader) - index_size - live_size;
+    if (dead_size > mapped.Size() / 4) {
+        if (!Compact(live_records)) {
+            LOG_ERROR(Common_Filesystem, "Failed to compact pipeline cache file {}",
+                      Common::FS::PathToUTF8String(path));
+        }
+    } else if (has_new_records && !WriteIndex(live_records)) {
+        // The header may be stale now, the next load scans the records instead
+        LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache index");
+    }
+    Reset();
+}
+
+bool PipelineCacheFile::IsOpen() const {
+    std::scoped_lock lock{mutex};
+    return file.IsOpen();
+}
+
+void PipelineCacheFile::SerializePipeline(std::span<const char> key,
+                                          std::span<const GenericEnvironment* const> envs,
+                                          std::span<const u8> host_shaders) {
+    if (envs.empty() || envs.size() > MAX_PIPELINE_ENVIRONMENTS ||
+        !std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
+        return;
+    }
+    const PipelineHeader pipeline{
+        .num_envs = static_cast<u32>(envs.size()),
+        .key_size = static_cast<u32>(key.size()),
+    };
+    std::vector<u8> payload(sizeof(pipeline) + envs.size() * sizeof(u64) + key.size());
+    std::memcpy(payload.data(), &pipeline, sizeof(pipeline));
+    std::memcpy(payload.data() + sizeof(pipeline) + envs.size() * sizeof(u64), key.data(),
+                key.size());
+
+    std::vector<std::string> env_data(envs.size());
+    for (size_t index = 0; index < envs.size(); ++index) {
+        std::ostringstream stream;
+        envs[index]->Serialize(stream);
+        env_data[index] = stream.str();
+
+        const u64 hash = Common::CityHash64(env_data[index].data(), env_data[index].size());
+        std::memcpy(payload.data() + sizeof(pipeline) + index * sizeof(u64), &hash, sizeof(hash));
+    }
+
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    for (size_t index = 0; index < envs.size(); ++index) {
+        u64 hash;
+        std::memcpy(&hash, payload.data() + sizeof(pipeline) + index * sizeof(u64), sizeof(hash));
+        const RecordKey env_key{hash, RecordType::Environment};
+        const auto it = entries.find(env_key);
+        if (it != entries.end() && it->second.version == ENVIRONMENT_VERSION) {
+            // Shared with a pipeline cached before
+            continue;
+        }
+        const std::span data(reinterpret_cast<const u8*>(env_data[index].data()),
+                             env_data[index].size());
+        if (!WriteRecord(env_key, ENVIRONMENT_VERSION, data)) {
+            return;
+        }
+    }
+    const RecordKey pipeline_key{Common::CityHash64(key.data(), key.size()), RecordType::Pipeline};
+    if (!WriteRecord(pipeline_key, cache_version, payload) || host_shaders.empty() ||
+        host_shader_key == 0) {
+        return;
+    }
+    std::array<u64, MAX_PIPELINE_ENVIRONMENTS> env_hashes;
+    std::memcpy(env_hashes.data(), payload.data() + sizeof(pipeline), envs.size() * sizeof(u64));
+    const u64 host_hash =
+        HostShadersHash(pipeline_key.hash, std::span(env_hashes).first(envs.size()));
+    void(WriteRecord(RecordKey{host_hash, RecordType::HostShaders}, cache_version, host_shaders));
+}
+
+void PipelineCacheFile::SerializeHostShaders(u64 hash, std::span<const u8> data) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen() || host_shader_key == 0 || data.empty()) {
+        return;
+    }
+    const RecordKey key{hash, RecordType::HostShaders};
+    const auto it = entries.find(key);
+    if (it != entries.end() && it->second.version == cache_version) {
+        return;
+    }
+    void(WriteRecord(key, cache_version, data));
+}
+
+void PipelineCacheFile::LoadPipelines(
+    std::stop_token stop_loading,
+    Common::UniqueFunction<void, std::istream&, FileEnvironment, HostShaders> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>, HostShaders>
+        load_graphics) {
+    // Records are copied out under the lock and decompressed without it, the pipelines built from
+    // them append their host shaders meanwhile
+    std::vector<std::pair<RecordKey, Entry>> pipelines;
+    size_t num_stale = 0;
+    {
+        std::scoped_lock lock{mutex};
+        // Pipelines cached in this session are already built and aren't mapped
+        for (const auto& [key, entry] : entries) {
+            if (key.type != RecordType::Pipeline || entry.offset >= mapped.Size()) {
+                continue;
+            }
+            if (entry.version != cache_version) {
+                ++num_stale;
+                continue;
+            }
+            pipelines.emplace_back(key, entry);
+        }
+    }
+    std::ranges::sort(pipelines, {}, [](const auto& pipeline) { return pipeline.second.offset; });
+    if (num_stale != 0) {
+        LOG_INFO(Common_Filesystem, "Skipping {} pipelines of an old pipeline cache version",
+                 num_stale);
+    }
+
+    for (const auto& [key, entry] : pipelines) {
+        if (stop_loading.stop_requested()) {
+            return;
+        }
+        std::optional<std::vector<u8>> record;
+        {
+            std::scoped_lock lock{mutex};
+            record = CopyRecord(key, entry);
+        }
+        const std::optional<std::vector<u8>> payload =
+            record ? DecompressCopiedRecord(*record) : std::nullopt;
+        PipelineHeader pipeline{};
+        if (payload && payload->size() >= sizeof(pipeline)) {
+            std::memcpy(&pipeline, payload->data(), sizeof(pipeline));
+        }
+        if (pipeline.num_envs == 0 || pipeline.num_envs > MAX_PIPELINE_ENVIRONMENTS ||
+            payload->size() !=
+                sizeof(pipeline) + pipeline.num_envs * sizeof(u64) + pipeline.key_size) {
+            LOG_ERROR(Common_Filesystem, "Corrupted pipeline cache record at offset {}",
+                      entry.offset);
+            continue;
+        }
+
+        std::array<u64, MAX_PIPELINE_ENVIRONMENTS> env_hashes;
+        std::memcpy(env_hashes.data(), payload->data() + sizeof(pipeline),
+                    pipeline.num_envs * sizeof(u64));
+        const std::span pipeline_envs = std::span(env_hashes).first(pipeline.num_envs);
+        std::vector<std::vector<u8>> env_records(pipeline.num_envs);
+        HostShaders host_shaders{};
+        std::optional<std::vector<u8>> host_record;
+        bool is_valid = true;
+        {
+            std::scoped_lock lock{mutex};
+            for (u32 index = 0; index < pipeline.num_envs; ++index) {
+                const RecordKey env_key{env_hashes[index], RecordType::Environment};
+                const auto it = entries.find(env_key);
+                std::optional<std::vector<u8>> env_record;
+                if (it != entries.end() && it->second.version == ENVIRONMENT_VERSION) {
+                    env_record = CopyRecord(env_key, it->second);
+                }
+                if (!env_record) {
+                    is_valid = false;
+                    break;
+                }
+                env_records[index] = std::move(*env_record);
+            }
+            host_shaders.hash = HostShadersHash(key.hash, pipeline_envs);
+            if (is_valid && host_shader_key != 0) {
+                const RecordKey host_key{host_shaders.hash, RecordType::HostShaders};
+                const auto it = entries.find(host_key);
+                if (it != entries.end() && it->second.version == cache_version &&
+                    it->second.offset < mapped.Size()) {
+                    host_record = CopyRecord(host_key, it->second);
+                }
+            }
+        }
+
+        std::vector<FileEnvironment> envs(pipeline.num_envs);
+        for (u32 index = 0; index < pipeline.num_envs && is_valid; ++index) {
+            const std::optional<std::vector<u8>> env_data =
+                DecompressCopiedRecord(env_records[index]);
+            if (!env_data) {
+                is_valid = false;
+                break;
+            }
+            MemoryStreamBuffer buffer{*env_data};
+            std::istream stream{&buffer};
+            stream.exceptions(std::istream::failbit);
+            try {
+                envs[index].Deserialize(stream);
+            } catch (const std::ios_base::failure&) {
+                is_valid = false;
+            }
+        }
+        if (!is_valid) {
+            LOG_ERROR(Common_Filesystem, "Missing shader environment in pipeline cache");
+            continue;
+        }
+        if (host_record) {
+            host_shaders.data = DecompressCopiedRecord(*host_record).value_or(std::vector<u8>{});
+        }
+
+        MemoryStreamBuffer key_buffer{std::span(*payload).last(pipeline.key_size)};
+        std::istream key_stream{&key_buffer};
+        key_stream.exceptions(std::istream::failbit);
+        try {
+            if (envs.front().ShaderStage() == Shader::Stage::Compute) {
+                load_compute(key_stream, std::move(envs.front()), std::move(host_shaders));
+            } else {
+                load_graphics(key_stream, std::move(envs), std::move(host_shaders));
+            }
+        } catch (const std::ios_base::failure& e) {
+            LOG_ERROR(Common_Filesystem, "Invalid pipeline key in pipeline cache: {}", e.what());
+        }
+    }
+}
+
+u64 PipelineCacheFile::LoadIndex() {
+    const std::span<const u8> data = mapped.Data();
+    FileHeader header;
+    if (data.size() < sizeof(header)) {
+        return 0;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != MAGIC_NUMBER || header.version != FORMAT_VERSION) {
+        return 0;
+    }
+    if (header.index_offset == 0) {
+        return ScanRecords(sizeof(FileHeader));
+    }
+    const std::optional<RecordHeader> index_header = ReadRecordHeader(data, header.index_offset);
+    std::optional<std::vector<u8>> index;
+    if (index_header && index_header->type == static_cast<u32>(RecordType::Index)) {
+        index = DecompressRecord(data, header.index_offset, *index_header);
+    }
+    if (!index || index->size() % sizeof(IndexEntry) != 0) {
+        LOG_WARNING(Common_Filesystem, "Invalid pipeline cache index, scanning all records");
+        return ScanRecords(sizeof(FileHeader));
+    }
+    const size_t num_entries = index->size() / sizeof(IndexEntry);
+    entries.reserve(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+        IndexEntry entry;
+        std::memcpy(&entry, index->data() + i * sizeof(IndexEntry), sizeof(entry));
+        if (entry.offset < sizeof(FileHeader) || entry.offset >= header.index_offset) {
+            continue;
+        }
+        entries.insert_or_assign(RecordKey{entry.hash, static_cast<RecordType>(entry.type)},
+                                 Entry{entry.offset, entry.version});
+    }
+    index_size = sizeof(RecordHeader) + index_header->size;
+    return ScanRecords(header.index_offset + index_size);
+}
+
+u64 PipelineCacheFile::ScanRecords(u64 offset) {
+    const std::span<const u8> data = mapped.Data();
+    const u64 start = offset;
+    while (const std::optional<RecordHeader> record = ReadRecordHeader(data, offset)) {
+        if (record->type != static_cast<u32>(RecordType::Index)) {
+            entries.insert_or_assign(RecordKey{record->hash, static_cast<RecordType>(record->type)},
+                                     Entry{offset, record->version});
+        }
+        offset += sizeof(RecordHeader) + record->size;
+    }
+    // Records the index doesn't cover yet are added to the next one
+    has_new_records = offset != start;
+    file_size = offset;
+    return offset;
+}
+
+std::optional<std::vector<u8>> PipelineCacheFile::ReadRecord(const RecordKey& key,
+                                                             const Entry& entry) const {
+    const std::span<const u8> data = mapped.Data();
+    const std::optional<RecordHeader> header = ReadRecordHeader(data, entry.offset);
+    std::optional<std::vector<u8>> payload;
+    if (header && header->hash == key.hash && header->type == static_cast<u32>(key.type)) {
+        payload = DecompressRecord(data, entry.offset, *header);
+    }
+    if (!payload) {
+        LOG_ERROR(Common_Filesystem, "Invalid pipeline cache record at offset {}", entry.offset);
+    }
+    return payload;
+}
+
+std::optional<std::vector<u8>> PipelineCacheFile::CopyRecord(const RecordKey& key,
+                                                             const Entry& entry) const {
+    const std::span<const u8> data = mapped.Data();
+    const std::optional<RecordHeader> header = ReadRecordHeader(data, entry.offset);
+    if (!header || header->hash != key.hash || header->type != static_cast<u32>(key.type)) {
+        LOG_ERROR(Common_Filesystem, "Invalid pipeline cache record at offset {}", entry.offset);
+        return std::nullopt;
+    }
+    const auto record = data.subspan(entry.offset, sizeof(RecordHeader) + header->size);
+    return std::vector<u8>(record.begin(), record.end());
+}
+
+bool PipelineCacheFile::WriteRecord(const RecordKey& key, u32 version, std::span<const u8> data) {
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+    if (compressed.empty()) {
+        LOG_ERROR(Common_Filesystem, "Failed to compress pipeline cache record");
+        return false;
+    }
+    const RecordHeader header{
+        .hash = key.hash,
+        .type = static_cast<u32>(key.type),
+        .version = version,
+        .size = static_cast<u32>(compressed.size()),
+        .uncompressed_size = static_cast<u32>(data.size()),
+    };
+    if (!file.WriteObject(header) ||
+        file.WriteSpan(std::span<const u8>(compressed)) != compressed.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to write pipeline cache record");
+        // The file may end in a partial record now, the next load truncates it
+        file.Close();
+        return false;
+    }
+    entries.insert_or_assign(key, Entry{file_size, version});
+    file_size += sizeof(RecordHeader) + compressed.size();
+    has_new_records = true;
+    return true;
+}
+
+u64 PipelineCacheFile::HostShadersHash(u64 pipeline_hash, std::span<const u64> env_hashes) const {
+    // Shaders depend on the environments too, the pipeline key only identifies their code
+    std::array<u64, MAX_PIPELINE_ENVIRONMENTS + 2> data;
+    data[0] = pipeline_hash;
+    data[1] = host_shader_key;
+    std::ranges::copy(env_hashes, data.begin() + 2);
+    return Common::CityHash64(reinterpret_cast<const char*>(data.data()),
+                              (env_hashes.size() + 2) * sizeof(u64));
+}
+
+std::vector<std::pair<PipelineCacheFile::RecordKey, PipelineCacheFile::Entry>>
+PipelineCacheFile::LiveRecords() const {
+    // Environments are live as long as a pipeline of the current version references them
+    std::vector<std::pair<RecordKey, Entry>> live_records;
+    std::unordered_set<u64> env_hashes;
+    for (const auto& [key, entry] : entries) {
+        if (key.type != RecordType::Pipeline || entry.version != cache_version) {
+            continue;
+        }
+        const std::optional<std::vector<u8>> payload = ReadRecord(key, entry);
+        PipelineHeader pipeline{};
+        if (payload && payload->size() >= sizeof(pipeline)) {
+            std::memcpy(&pipeline, payload->data(), sizeof(pipeline));
+        }
+        if (pipeline.num_envs == 0 || pipeline.num_envs > MAX_PIPELINE_ENVIRONMENTS ||
+            payload->size() != sizeof(pipeline) + pipeline.num_envs * sizeof(u64) +
+                                   pipeline.key_size) {
+            continue;
+        }
+        std::array<u64, MAX_PIPELINE_ENVIRONMENTS> pipeline_env_hashes;
+        std::memcpy(pipeline_env_hashes.data(), payload->data() + sizeof(pipeline),
+                    pipeline.num_envs * sizeof(u64));
+        const std::span pipeline_envs = std::span(pipeline_env_hashes).first(pipeline.num_envs);
+        env_hashes.insert(pipeline_envs.begin(), pipeline_envs.end());
+        live_records.emplace_back(key, entry);
+
+        if (host_shader_key == 0) {
+            continue;
+        }
+        const RecordKey host_key{HostShadersHash(key.hash, pipeline_envs),
+                                 RecordType::HostShaders};
+        const auto it = entries.find(host_key);
+        if (it != entries.end() && it->second.version == cache_version) {
+            live_records.emplace_back(host_key, it->second);
+        }
+    }
+    for (const u64 hash : env_hashes) {
+        const RecordKey key{hash, RecordType::Environment};
+        const auto it = entries.find(key);
+        if (it != entries.end() && it->second.version == ENVIRONMENT_VERSION) {
+            live_records.emplace_back(key, it->second);
+        }
+    }
+    // Keep the records in the order they were written, pipelines load in that order
+    std::ranges::sort(live_records, {}, [](const auto& record) { return record.second.offset; });
+    return live_records;
+}
+
+bool PipelineCacheFile::WriteIndex(std::span<const std::pair<RecordKey, Entry>> live_records) {
+    std::vector<IndexEntry> index;
+    index.reserve(live_records.size());
+    for (const auto& [key, entry] : live_records) {
+        index.push_back(IndexEntry{
+            .hash = key.hash,
+            .offset = entry.offset,
+            .type = static_cast<u32>(key.type),
+            .version = entry.version,
+        });
+    }
+    const u64 index_offset = mapped.Size();
+    // The file is written through another handle, it can't stay mapped on every host
+    mapped.Close();
+    Common::FS::IOFile index_file{path, Common::FS::FileAccessMode::ReadWrite};
+    return index_file.IsOpen() && index_file.Seek(static_cast<s64>(index_offset)) &&
+           WriteIndexRecord(index_file, index_offset, static_cast<u32>(RecordType::Index), index);
+}
+
+bool PipelineCacheFile::Compact(std::span<const std::pair<RecordKey, Entry>> live_records) {
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile temp_file{temp_path, Common::FS::FileAccessMode::Write};
+        if (!temp_file.IsOpen()) {
+            LOG_ERROR(Common_Filesystem, "Failed to create {}",
+                      Common::FS::PathToUTF8String(temp_path));
+            return false;
+        }
+        const FileHeader header{
+            .magic = MAGIC_NUMBER,
+            .version = FORMAT_VERSION,
+            .reserved = 0,
+            .index_offset = 0,
+        };
+        bool success = temp_file.WriteObject(header);
+
+        // Records are copied as they are, without decompressing them
+        std::vector<IndexEntry> index;
+        index.reserve(live_records.size());
+        u64 offset = sizeof(FileHeader);
+        for (const auto& [key, entry] : live_records) {
+            if (!success) {
+                break;
+            }
+            const u64 size = RecordSize(mapped.Data(), entry.offset);
+            success = temp_file.WriteSpan(mapped.Data().subspan(entry.offset, size)) == size;
+            index.push_back(IndexEntry{
+                .hash = key.hash,
+                .offset = offset,
+                .type = static_cast<u32>(key.type),
+                .version = entry.version,
+            });
+            offset += size;
+        }
+        success = success &&
+                  WriteIndexRecord(temp_file, offset, static_cast<u32>(RecordType::Index), index);
+        if (!success) {
+            temp_file.Close();
+            void(Common::FS::RemoveFile(temp_path));
+            return false;
+        }
+    }
+    // The file has to be unmapped before it can be replaced
+    mapped.Close();
+    return Common::FS::RemoveFile(path) && Common::FS::RenameFile(temp_path, path);
+}
+
+void PipelineCacheFile::Reset() {
+    file.Close();
+    mapped.Close();
+    entries.clear();
+    file_size = 0;
+    index_size = 0;
+    has_new_records = false;
+}
+
+} // namespace VideoCommon
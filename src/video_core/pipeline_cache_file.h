@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/mapped_file.h"
+#include "common/polyfill_thread.h"
+#include "common/unique_function.h"
+#include "video_core/shader_environment.h"
+
+namespace VideoCommon {
+
+/**
+ * Disk cache of the guest state of the pipelines built by a backend, used to build them again on
+ * the following boots.
+ *
+ * The file is a header followed by records, each a record header and a zstd compressed payload:
+ * - Environment records hold a serialized shader environment, keyed by the hash of its contents.
+ *   Pipelines sharing a shader reference the same record.
+ * - Pipeline records hold the key of a pipeline and the hashes of its environments, keyed by the
+ *   hash of the pipeline key.
+ * - Host shader records hold the shaders a backend built for a pipeline, keyed by the hashes of
+ *   the pipeline and its environments and the host shader key of the backend. They let backends
+ *   skip the recompiler for pipelines built on a previous boot.
+ * - Index records list the offset of every live record. The file header points to the last one.
+ *
+ * Opening a cache maps the file and reads its index, then scans the records appended after the
+ * index in case the previous session didn't close the cache. Records are read straight from the
+ * mapping. New records are appended to the file, and the index is written again when the cache is
+ * closed, or the whole file is compacted once dead records take a large part of it.
+ *
+ * Each record carries the version it was written with, records of another version are ignored
+ * and dropped on the next compaction. Pipeline records use the cache version of the backend, which
+ * only has to change with the layout of its pipeline keys: the records hold guest state, so
+ * changes to the recompiler don't invalidate them. Changes to the recompiler or the host change
+ * the host shader key instead, which only invalidates the host shader records.
+ */
+class PipelineCacheFile {
+public:
+    PipelineCacheFile();
+    ~PipelineCacheFile();
+
+    PipelineCacheFile(const PipelineCacheFile&) = delete;
+    PipelineCacheFile& operator=(const PipelineCacheFile&) = delete;
+
+    /// Host shaders cached for a pipeline, serialized by the backend
+    struct HostShaders {
+        /// Identifies the host shader record of the pipeline, see SerializeHostShaders
+        u64 hash;
+        /// Payload of the record, empty when the pipeline has no host shaders cached
+        std::vector<u8> data;
+    };
+
+    /**
+     * Opens the cache at path, creating it if it doesn't exist, and loads its index.
+     *
+     * @param path            Path of the cache file
+     * @param cache_version   Version of the pipeline records of the backend
+     * @param host_shader_key Identifies the host shaders built by the backend, 0 when it doesn't
+     *                        cache them
+     */
+    void Open(const std::filesystem::path& path, u32 cache_version, u64 host_shader_key = 0);
+
+    /// Writes the index of the records appended since the cache was opened and closes it
+    void Close();
+
+    /// Returns true when a cache file is open
+    [[nodiscard]] bool IsOpen() const;
+
+    /**
+     * Appends a pipeline to the cache, with the environments of its stages not cached yet.
+     *
+     * @param key          Key of the pipeline, read back by the load callbacks
+     * @param envs         Environments of the stages of the pipeline
+     * @param host_shaders Host shaders built for the pipeline, not cached when empty
+     */
+    void SerializePipeline(std::span<const char> key,
+                           std::span<const GenericEnvironment* const> envs,
+                           std::span<const u8> host_shaders = {});
+
+    template <typename Key, typename Envs>
+    void SerializePipeline(const Key& key, const Envs& envs,
+                           std::span<const u8> host_shaders = {}) {
+        static_assert(std::is_trivially_copyable_v<Key>);
+        static_assert(std::has_unique_object_representations_v<Key>);
+        SerializePipeline(std::span(reinterpret_cast<const char*>(&key), sizeof(key)),
+                          std::span(envs.data(), envs.size()), host_shaders);
+    }
+
+    /**
+     * Appends the host shaders of a pipeline loaded from the cache without them.
+     *
+     * @param hash Hash of the host shaders passed to the load callback of the pipeline
+     * @param data Host shaders built for the pipeline
+     */
+    void SerializeHostShaders(u64 hash, std::span<const u8> data);
+
+    /**
+     * Calls the load callbacks for every pipeline of the current version, in the order they were
+     * first cached. The stream passed to the callbacks holds the key of the pipeline. The cache
+     * isn't locked while the callbacks run, pipelines may be serialized meanwhile.
+     */
+    void LoadPipelines(
+        std::stop_token stop_loading,
+        Common::UniqueFunction<void, std::istream&, FileEnvironment, HostShaders> load_compute,
+        Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>, HostShaders>
+            load_graphics);
+
+private:
+    enum class RecordType : u32 {
+        Environment,
+        Pipeline,
+        Index,
+        HostShaders,
+    };
+
+    struct RecordKey {
+        u64 hash;
+        RecordType type;
+
+        bool operator==(const RecordKey&) const noexcept = default;
+    };
+
+    struct RecordKeyHash {
+        size_t operator()(const RecordKey& key) const noexcept {
+            return static_cast<size_t>(key.hash ^ static_cast<u64>(key.type));
+        }
+    };
+
+    struct Entry {
+        u64 offset;
+        u32 version;
+    };
+
+    /// Loads the index and the records after it, returns the end of the last valid record
+    u64 LoadIndex();
+
+    /// Adds the records in [offset, end of the mapping), returns the end of the last valid record
+    u64 ScanRecords(u64 offset);
+
+    /// Reads and decompresses the payload of a record from the mapping
+    [[nodiscard]] std::optional<std::vector<u8>> ReadRecord(const RecordKey& key,
+                                                            const Entry& entry) const;
+
+    /// Copies a record out of the mapping, its header followed by its compressed payload
+    [[nodiscard]] std::optional<std::vector<u8>> CopyRecord(const RecordKey& key,
+                                                            const Entry& entry) const;
+
+    /// Appends a record to the file
+    bool WriteRecord(const RecordKey& key, u32 version, std::span<const u8> data);
+
+    /// Hash of the host shader record of a pipeline
+    [[nodiscard]] u64 HostShadersHash(u64 pipeline_hash, std::span<const u64> env_hashes) const;
+
+    /// Records to keep: pipelines of the current version with their host shaders and the
+    /// environments they reference
+    [[nodiscard]] std::vector<std::pair<RecordKey, Entry>> LiveRecords() const;
+
+    /// Appends an index of the live records to the file and points the header to it
+    bool WriteIndex(std::span<const std::pair<RecordKey, Entry>> live_records);
+
+    /// Rewrites the file with the live records only
+    bool Compact(std::span<const std::pair<RecordKey, Entry>> live_records);
+
+    void Reset();
+
+    mutable std::mutex mutex;
+    std::filesystem::path path;
+    Common::FS::MappedFile mapped;
+    Common::FS::IOFile file;
+    std::unordered_map<RecordKey, Entry, RecordKeyHash> entries;
+    u32 cache_version = 0;
+    u64 host_shader_key = 0;
+    u64 file_size = 0;
+    /// Size of the index record the file header points to
+    u64 index_size = 0;
+    bool has_new_records = false;
+};
+
+} // namespace VideoCommon
@@ -3,6 +3,8 @@
 
 #include "common/alignment.h"
 #include "video_core/control/channel_state.h"
+#include "video_core/dirty_flags.h"
+#include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_null/null_rasterizer.h"
@@ -18,13 +20,22 @@ bool AccelerateDMA::BufferClear(GPUVAddr src_address, u64 amount, u32 value) {
     return true;
 }
 
-RasterizerNull::RasterizerNull(Tegra::GPU& gpu) : m_gpu{gpu} {}
+RasterizerNull::RasterizerNull(Tegra::GPU& gpu)
+    : m_gpu{gpu}, m_shader_cache{gpu.Host1x().MemoryManager()} {}
 RasterizerNull::~RasterizerNull() = default;
 
-void RasterizerNull::Draw(bool is_indexed, u32 instance_count) {}
+void RasterizerNull::Draw(bool is_indexed, u32 instance_count) {
+    if (m_translate_shaders) {
+        m_shader_cache.PrepareGraphics();
+    }
+}
 void RasterizerNull::DrawTexture() {}
 void RasterizerNull::Clear(u32 layer_count) {}
-void RasterizerNull::DispatchCompute() {}
+void RasterizerNull::DispatchCompute() {
+    if (m_translate_shaders) {
+        m_shader_cache.PrepareCompute();
+    }
+}
 void RasterizerNull::ResetCounter(VideoCommon::QueryType type) {}
 void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
                            VideoCommon::QueryPropertiesFlags flags, u32 payload, u32 subreport) {
@@ -47,11 +58,27 @@ void RasterizerNull::FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType) {
 bool RasterizerNull::MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType) {
     return false;
 }
-void RasterizerNull::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType) {}
+void RasterizerNull::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    if (True(which & VideoCommon::CacheType::ShaderCache)) {
+        m_shader_cache.InvalidateRegion(addr, size);
+    }
+}
 bool RasterizerNull::OnCPUWrite(PAddr addr, u64 size) {
+    if (addr == 0 || size == 0) {
+        return false;
+    }
+    m_shader_cache.InvalidateRegion(addr, size);
     return false;
 }
-void RasterizerNull::OnCacheInvalidation(PAddr addr, u64 size) {}
+void RasterizerNull::OnCacheInvalidation(PAddr addr, u64 size) {
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    m_shader_cache.OnCacheInvalidation(addr, size);
+}
 VideoCore::RasterizerDownloadArea RasterizerNull::GetFlushArea(PAddr addr, u64 size) {
     VideoCore::RasterizerDownloadArea new_area{
         .start_address = Common::AlignDown(addr, Core::DEVICE_PAGESIZE),
@@ -60,8 +87,12 @@ VideoCore::RasterizerDownloadArea RasterizerNull::GetFlushArea(PAddr addr, u64 s
     };
     return new_area;
 }
-void RasterizerNull::InvalidateGPUCache() {}
-void RasterizerNull::UnmapMemory(DAddr addr, u64 size) {}
+void RasterizerNull::InvalidateGPUCache() {
+    m_shader_cache.SyncGuestHost();
+}
+void RasterizerNull::UnmapMemory(DAddr addr, u64 size) {
+    m_shader_cache.OnCacheInvalidation(addr, size);
+}
 void RasterizerNull::ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) {}
 void RasterizerNull::SignalFence(std::function<void()>&& func) {
     func();
@@ -76,7 +107,10 @@ void RasterizerNull::SignalSyncPoint(u32 value) {
 }
 void RasterizerNull::SignalReference() {}
 void RasterizerNull::ReleaseFences(bool) {}
-void RasterizerNull::FlushAndInvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType) {}
+void RasterizerNull::FlushAndInvalidateRegion(DAddr addr, u64 size,
+                                              VideoCommon::CacheType which) {
+    InvalidateRegion(addr, size, which);
+}
 void RasterizerNull::WaitForIdle() {}
 void RasterizerNull::FragmentBarrier() {}
 void RasterizerNull::TiledCacheBarrier() {}
@@ -95,13 +129,19 @@ void RasterizerNull::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size
 void RasterizerNull::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                        const VideoCore::DiskResourceLoadCallback& callback) {}
 void RasterizerNull::InitializeChannel(Tegra::Control::ChannelState& channel) {
+    // The shader cache relies on the engine flagging shader register writes
+    VideoCommon::Dirty::SetupDirtyFlags(channel.maxwell_3d->dirty.tables);
+    VideoCommon::Dirty::BuildDirtyRanges(channel.maxwell_3d->dirty);
     CreateChannel(channel);
+    m_shader_cache.CreateChannel(channel);
 }
 void RasterizerNull::BindChannel(Tegra::Control::ChannelState& channel) {
     BindToChannel(channel.bind_id);
+    m_shader_cache.BindToChannel(channel.bind_id);
 }
 void RasterizerNull::ReleaseChannel(s32 channel_id) {
     EraseChannel(channel_id);
+    m_shader_cache.EraseChannel(channel_id);
 }
 
 } // namespace Null
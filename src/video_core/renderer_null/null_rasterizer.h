@@ -7,6 +7,7 @@
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_null/null_shader_cache.h"
 
 namespace Core {
 class System;
@@ -83,9 +84,20 @@ public:
     void BindChannel(Tegra::Control::ChannelState& channel) override;
     void ReleaseChannel(s32 channel_id) override;
 
+    /// Translates the shaders of draws and dispatches to IR, off by default
+    void EnableShaderTranslation(bool enabled) {
+        m_translate_shaders = enabled;
+    }
+
+    [[nodiscard]] const ShaderCache::Stats& GetShaderStats() const noexcept {
+        return m_shader_cache.GetStats();
+    }
+
 private:
     Tegra::GPU& m_gpu;
     AccelerateDMA m_accelerate_dma;
+    ShaderCache m_shader_cache;
+    bool m_translate_shaders{};
 };
 
 } // namespace Null
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/logging/log.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/program_header.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_shader_cache.h"
+#include "video_core/shader_environment.h"
+
+namespace Null {
+
+using Shader::Maxwell::MergeDualVertexPrograms;
+using Shader::Maxwell::TranslateProgram;
+
+ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_)
+    : VideoCommon::ShaderCache{device_memory_},
+      // Describe a capable desktop GPU, there is no device to query
+      host_info{
+          .support_float64 = true,
+          .support_float16 = true,
+          .support_int64 = true,
+          .needs_demote_reorder = false,
+          .support_snorm_render_buffer = true,
+          .support_viewport_index_layer = true,
+          .min_ssbo_alignment = 16,
+          .support_geometry_shader_passthrough = false,
+          .support_conditional_barrier = true,
+      } {}
+
+ShaderCache::~ShaderCache() = default;
+
+void ShaderCache::PrepareGraphics() {
+    if (!RefreshStages(unique_hashes)) {
+        return;
+    }
+    if (!graphics_pipelines.insert(unique_hashes).second) {
+        return;
+    }
+    ++stats.graphics_pipelines;
+    Shader::SetThreadTranslationTimings(&stats.timings);
+    TranslateGraphics(unique_hashes);
+    Shader::SetThreadTranslationTimings(nullptr);
+}
+
+void ShaderCache::PrepareCompute() {
+    const VideoCommon::ShaderInfo* const shader{ComputeShader()};
+    if (!shader || !compute_pipelines.insert(shader->unique_hash).second) {
+        return;
+    }
+    ++stats.compute_pipelines;
+    Shader::SetThreadTranslationTimings(&stats.timings);
+    TranslateCompute(*shader);
+    Shader::SetThreadTranslationTimings(nullptr);
+}
+
+void ShaderCache::TranslateGraphics(const std::array<u64, NUM_PROGRAMS>& hashes) try {
+    GraphicsEnvironments environments;
+    GetGraphicsEnvironments(environments, hashes);
+    const std::span<Shader::Environment* const> envs{environments.Span()};
+
+    pools.ReleaseContents();
+    std::array<Shader::IR::Program, NUM_PROGRAMS> programs;
+    const bool uses_vertex_a{hashes[0] != 0};
+    size_t env_index{};
+    for (size_t index = 0; index < NUM_PROGRAMS; ++index) {
+        if (hashes[index] == 0) {
+            continue;
+        }
+        Shader::Environment& env{*envs[env_index]};
+        ++env_index;
+
+        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+        if (!uses_vertex_a || index != 1) {
+            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+        } else {
+            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            programs[index] = MergeDualVertexPrograms(programs[0], program_vb, env);
+        }
+        ++stats.programs;
+    }
+} catch (const Shader::Exception& exception) {
+    LOG_ERROR(HW_GPU, "{}", exception.what());
+    ++stats.failures;
+}
+
+void ShaderCache::TranslateCompute(const VideoCommon::ShaderInfo& shader) try {
+    const GPUVAddr program_base{kepler_compute->regs.code_loc.Address()};
+    const auto& qmd{kepler_compute->launch_description};
+    VideoCommon::ComputeEnvironment env{*kepler_compute, *gpu_memory, program_base,
+                                        qmd.program_start};
+    env.SetCachedSize(shader.size_bytes);
+
+    pools.ReleaseContents();
+    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+    [[maybe_unused]] const auto program{
+        TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    ++stats.programs;
+} catch (const Shader::Exception& exception) {
+    LOG_ERROR(HW_GPU, "{}", exception.what());
+    ++stats.failures;
+}
+
+} // namespace Null
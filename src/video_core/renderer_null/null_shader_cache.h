@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <set>
+#include <unordered_set>
+
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/translation_timings.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/shader_cache.h"
+
+namespace Null {
+
+/**
+ * Translates the shaders of the pipelines used by draws and dispatches to IR, without a backend
+ * to emit them for. Each pipeline is translated once, the first time it is used.
+ */
+class ShaderCache final : public VideoCommon::ShaderCache {
+public:
+    struct Stats {
+        size_t graphics_pipelines{};
+        size_t compute_pipelines{};
+        size_t programs{};
+        size_t failures{};
+        Shader::TranslationTimings timings;
+    };
+
+    explicit ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory);
+    ~ShaderCache();
+
+    /// Translates the graphics pipeline of the bound channel if it wasn't seen before
+    void PrepareGraphics();
+
+    /// Translates the compute pipeline of the bound channel if it wasn't seen before
+    void PrepareCompute();
+
+    [[nodiscard]] const Stats& GetStats() const noexcept {
+        return stats;
+    }
+
+private:
+    static constexpr size_t NUM_PROGRAMS = Tegra::Engines::Maxwell3D::Regs::MaxShaderProgram;
+
+    struct ShaderPools {
+        void ReleaseContents() {
+            // Blocks unlink their instructions when destroyed, release them before the
+            // instructions
+            flow_block.ReleaseContents();
+            block.ReleaseContents();
+            inst.ReleaseContents();
+        }
+
+        Shader::ObjectPool<Shader::IR::Inst> inst{8192};
+        Shader::ObjectPool<Shader::IR::Block> block{32};
+        Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    };
+
+    void TranslateGraphics(const std::array<u64, NUM_PROGRAMS>& hashes);
+
+    void TranslateCompute(const VideoCommon::ShaderInfo& shader);
+
+    ShaderPools pools;
+    Shader::HostTranslateInfo host_info;
+    std::array<u64, NUM_PROGRAMS> unique_hashes{};
+    std::set<std::array<u64, NUM_PROGRAMS>> graphics_pipelines;
+    std::unordered_set<u64> compute_pipelines;
+    Stats stats;
+};
+
+} // namespace Null
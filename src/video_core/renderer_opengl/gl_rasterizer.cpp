@@ -19,6 +19,7 @@
 #include "video_core/control/channel_state.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_disk_cache.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_opengl/gl_device.h"
 #include "video_core/renderer_opengl/gl_query_cache.h"
@@ -154,6 +155,8 @@ void RasterizerOpenGL::SyncVertexInstances() {
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
     shader_cache.LoadDiskResources(title_id, stop_loading, callback);
+    texture_cache.LoadDiskResources(title_id);
+    macro_disk_cache = Tegra::Macro::LoadMacroDiskCache(title_id);
 }
 
 void RasterizerOpenGL::Clear(u32 layer_count) {
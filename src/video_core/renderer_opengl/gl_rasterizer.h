@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstddef>
+#include <memory>
 #include <optional>
 
 #include <boost/container/static_vector.hpp>
@@ -34,7 +35,11 @@ class EmuWindow;
 
 namespace Tegra {
 class MemoryManager;
+
+namespace Macro {
+class MacroDiskCache;
 }
+} // namespace Tegra
 
 namespace OpenGL {
 
@@ -249,6 +254,8 @@ private:
     BufferCacheRuntime buffer_cache_runtime;
     BufferCache buffer_cache;
     ShaderCache shader_cache;
+    /// Macro analysis of the title, loaded with the shader cache for the channels to share
+    std::shared_ptr<Tegra::Macro::MacroDiskCache> macro_disk_cache;
     QueryCache query_cache;
     AccelerateDMA accelerate_dma;
     FenceManagerOpenGL fence_manager;
@@ -47,8 +47,6 @@ using VideoCommon::ComputeEnvironment;
 using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
-using VideoCommon::LoadPipelines;
-using VideoCommon::SerializePipeline;
 using Context = ShaderContext::Context;
 
 constexpr u32 CACHE_VERSION = 10;
@@ -266,7 +264,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         LOG_ERROR(Common_Filesystem, "Failed to create shader cache directories");
         return;
     }
-    shader_cache_filename = base_dir / "opengl.bin";
+    shader_cache_file.Open(base_dir / "opengl.bin", CACHE_VERSION);
 
     if (!workers && !strict_context_required) {
         workers = CreateWorkers();
@@ -292,7 +290,8 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env,
+                                VideoCommon::PipelineCacheFile::HostShaders) {
         ComputePipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
@@ -310,7 +309,8 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         ++state.total;
         ++state.total_compute;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs,
+                                 VideoCommon::PipelineCacheFile::HostShaders) {
         GraphicsPipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
@@ -332,7 +332,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         ++state.total;
         ++state.total_graphics;
     }};
-    LoadPipelines(stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
+    shader_cache_file.LoadPipelines(stop_loading, load_compute, load_graphics);
 
     LOG_INFO(Render_OpenGL, "Total Pipeline Count: {}", state.total);
 
@@ -437,7 +437,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline() {
     main_pools.ReleaseContents();
     auto pipeline{CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(),
                                          use_asynchronous_shaders)};
-    if (!pipeline || shader_cache_filename.empty()) {
+    if (!pipeline || !shader_cache_file.IsOpen()) {
         return pipeline;
     }
     boost::container::static_vector<const GenericEnvironment*, Maxwell::MaxShaderProgram> env_ptrs;
@@ -446,7 +446,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline() {
             env_ptrs.push_back(&environments.envs[index]);
         }
     }
-    SerializePipeline(graphics_key, env_ptrs, shader_cache_filename, CACHE_VERSION);
+    shader_cache_file.SerializePipeline(graphics_key, env_ptrs);
     return pipeline;
 }
 
@@ -565,11 +565,10 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
 
     main_pools.ReleaseContents();
     auto pipeline{CreateComputePipeline(main_pools, key, env)};
-    if (!pipeline || shader_cache_filename.empty()) {
+    if (!pipeline || !shader_cache_file.IsOpen()) {
         return pipeline;
     }
-    SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env}, shader_cache_filename,
-                      CACHE_VERSION);
+    shader_cache_file.SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env});
     return pipeline;
 }
 
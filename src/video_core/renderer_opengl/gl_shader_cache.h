@@ -10,6 +10,7 @@
 #include "common/thread_worker.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/profile.h"
+#include "video_core/pipeline_cache_file.h"
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
 #include "video_core/renderer_opengl/gl_shader_context.h"
@@ -84,7 +85,7 @@ private:
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
 
-    std::filesystem::path shader_cache_filename;
+    VideoCommon::PipelineCacheFile shader_cache_file;
     std::unique_ptr<ShaderWorker> workers;
 };
 
@@ -11,6 +11,7 @@
 namespace OpenGL::ShaderContext {
 struct ShaderPools {
     void ReleaseContents() {
+        // Blocks unlink their instructions when destroyed, release them before the instructions
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
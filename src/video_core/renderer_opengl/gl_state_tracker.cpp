@@ -228,6 +228,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyClipControl(tables);
     SetupDirtyDepthClampEnabled(tables);
     SetupDirtyMisc(tables);
+    BuildDirtyRanges(channel_state.maxwell_3d->dirty);
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
@@ -6,11 +6,13 @@
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <thread>
 #include <vector>
 
 #include "common/bit_cast.h"
 #include "common/cityhash.h"
+#include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/microprofile.h"
@@ -21,6 +23,7 @@
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/program_header.h"
+#include "shader_recompiler/shader_cache.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
@@ -54,7 +57,6 @@ using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 
-constexpr u32 CACHE_VERSION = 11;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
 template <typename Container>
@@ -279,6 +281,14 @@ size_t GetTotalPipelineWorkers() {
 #endif
 }
 
+/// Pools of the calling worker, kept alive so the memory of the last translated pipeline is
+/// reused by the next one instead of being allocated again for each pipeline in the disk cache
+ShaderPools& WorkerShaderPools() {
+    thread_local ShaderPools pools;
+    pools.ReleaseContents();
+    return pools;
+}
+
 } // Anonymous namespace
 
 size_t ComputePipelineCacheKey::Hash() const noexcept {
@@ -299,6 +309,153 @@ bool GraphicsPipelineCacheKey::operator==(const GraphicsPipelineCacheKey& rhs) c
     return std::memcmp(&rhs, this, Size()) == 0;
 }
 
+std::vector<HostShader> TranslateGraphicsShaders(ShaderPools& pools,
+                                                 const GraphicsPipelineCacheKey& key,
+                                                 std::span<Shader::Environment* const> envs,
+                                                 const Shader::Profile& profile,
+                                                 const Shader::HostTranslateInfo& host_info) {
+    const u64 hash{key.Hash()};
+    size_t env_index{0};
+    std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
+    const bool uses_vertex_a{key.unique_hashes[0] != 0};
+    const bool uses_vertex_b{key.unique_hashes[1] != 0};
+
+    // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
+    Shader::IR::Program* layer_source_program{};
+
+    for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        const bool is_emulated_stage = layer_source_program != nullptr &&
+                                       index == static_cast<u32>(Maxwell::ShaderType::Geometry);
+        if (key.unique_hashes[index] == 0 && is_emulated_stage) {
+            auto topology = MaxwellToOutputTopology(key.state.topology);
+            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
+                                                          *layer_source_program, topology);
+            continue;
+        }
+        if (key.unique_hashes[index] == 0) {
+            continue;
+        }
+        Shader::Environment& env{*envs[env_index]};
+        ++env_index;
+
+        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+        if (!uses_vertex_a || index != 1) {
+            // Normal path
+            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+        } else {
+            // VertexB path when VertexA is present.
+            auto& program_va{programs[0]};
+            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
+        }
+
+        if (Settings::values.dump_shaders) {
+            env.Dump(hash, key.unique_hashes[index]);
+        }
+
+        if (programs[index].info.requires_layer_emulation) {
+            layer_source_program = &programs[index];
+        }
+    }
+    std::vector<HostShader> shaders;
+    const Shader::IR::Program* previous_stage{};
+    Shader::Backend::Bindings binding;
+    for (size_t index = uses_vertex_a && uses_vertex_b ? 1 : 0;
+         index < Maxwell::MaxShaderProgram; ++index) {
+        const bool is_emulated_stage = layer_source_program != nullptr &&
+                                       index == static_cast<u32>(Maxwell::ShaderType::Geometry);
+        if (key.unique_hashes[index] == 0 && !is_emulated_stage) {
+            continue;
+        }
+        UNIMPLEMENTED_IF(index == 0);
+
+        Shader::IR::Program& program{programs[index]};
+        const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
+        ConvertLegacyToGeneric(program, runtime_info);
+        std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+        shaders.push_back(HostShader{
+            .stage_index = static_cast<u32>(index - 1),
+            .info = program.info,
+            .code = std::move(code),
+        });
+        previous_stage = &program;
+    }
+    return shaders;
+}
+
+std::vector<HostShader> TranslateComputeShader(ShaderPools& pools,
+                                               const ComputePipelineCacheKey& key,
+                                               Shader::Environment& env,
+                                               const Shader::Profile& profile,
+                                               const Shader::HostTranslateInfo& host_info) {
+    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+
+    // Dump it before error.
+    if (Settings::values.dump_shaders) {
+        env.Dump(key.Hash(), key.unique_hash);
+    }
+
+    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    std::vector<u32> code{EmitSPIRV(profile, program)};
+    std::vector<HostShader> shaders;
+    shaders.push_back(HostShader{
+        .stage_index = 0,
+        .info = program.info,
+        .code = std::move(code),
+    });
+    return shaders;
+}
+
+std::vector<u8> SerializeHostShaders(std::span<const HostShader> shaders) {
+    std::ostringstream stream;
+    const u32 num_shaders{static_cast<u32>(shaders.size())};
+    stream.write(reinterpret_cast<const char*>(&num_shaders), sizeof(num_shaders));
+    for (const HostShader& shader : shaders) {
+        const u32 code_size{static_cast<u32>(shader.code.size())};
+        stream.write(reinterpret_cast<const char*>(&shader.stage_index), sizeof(shader.stage_index))
+            .write(reinterpret_cast<const char*>(&code_size), sizeof(code_size))
+            .write(reinterpret_cast<const char*>(shader.code.data()),
+                   shader.code.size() * sizeof(u32));
+        Shader::SerializeInfo(stream, shader.info);
+    }
+    const std::string data{stream.str()};
+    return std::vector<u8>(data.begin(), data.end());
+}
+
+std::vector<HostShader> DeserializeHostShaders(std::span<const u8> data) {
+    if (data.empty() || Settings::values.dump_shaders) {
+        // Dumping needs the guest shaders to be translated again
+        return {};
+    }
+    std::istringstream stream{std::string(reinterpret_cast<const char*>(data.data()), data.size())};
+    stream.exceptions(std::istream::failbit);
+    try {
+        u32 num_shaders{};
+        stream.read(reinterpret_cast<char*>(&num_shaders), sizeof(num_shaders));
+        if (num_shaders == 0 || num_shaders > Maxwell::MaxShaderStage) {
+            return {};
+        }
+        std::vector<HostShader> shaders(num_shaders);
+        for (HostShader& shader : shaders) {
+            u32 code_size{};
+            stream.read(reinterpret_cast<char*>(&shader.stage_index), sizeof(shader.stage_index))
+                .read(reinterpret_cast<char*>(&code_size), sizeof(code_size));
+            if (shader.stage_index >= Maxwell::MaxShaderStage ||
+                code_size > data.size() / sizeof(u32)) {
+                return {};
+            }
+            shader.code.resize(code_size);
+            stream.read(reinterpret_cast<char*>(shader.code.data()), code_size * sizeof(u32));
+            Shader::DeserializeInfo(stream, shader.info);
+        }
+        return shaders;
+    } catch (const std::ios_base::failure& e) {
+        LOG_ERROR(Render_Vulkan, "Invalid cached shaders: {}", e.what());
+        return {};
+    }
+}
+
 PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
                              const Device& device_, Scheduler& scheduler_,
                              DescriptorPool& descriptor_pool_,
@@ -540,7 +697,15 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         LOG_ERROR(Common_Filesystem, "Failed to create pipeline cache directories");
         return;
     }
-    pipeline_cache_filename = base_dir / "vulkan.bin";
+    pipeline_cache_file.Open(base_dir / "vulkan.bin", CACHE_VERSION,
+                             Shader::RecompilerFingerprint(profile, host_info));
+
+    // Lets citron_shader_compile translate the cached shaders for this host without a device
+    const std::string target{Shader::SerializeRecompilerTarget(profile, host_info)};
+    if (Common::FS::WriteStringToFile(shader_dir / "vulkan_profile.txt",
+                                      Common::FS::FileType::TextFile, target) != target.size()) {
+        LOG_WARNING(Render_Vulkan, "Failed to write the shader recompiler profile");
+    }
 
     if (use_vulkan_pipeline_cache) {
         vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
@@ -561,13 +726,18 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env,
+                                VideoCommon::PipelineCacheFile::HostShaders shaders) {
         ComputePipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
-            ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
+        workers.QueueWork([this, key, env_ = std::move(env), shaders_ = std::move(shaders), &state,
+                           &callback]() mutable {
+            ShaderPools& pools{WorkerShaderPools()};
+            std::vector<u8> built_shaders;
+            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false,
+                                                shaders_.data, &built_shaders)};
+            SerializeBuiltShaders(shaders_.hash, std::move(built_shaders));
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -580,7 +750,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         ++state.total;
         ++state.total_compute;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs,
+                                 VideoCommon::PipelineCacheFile::HostShaders shaders) {
         GraphicsPipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -597,14 +768,18 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
-            ShaderPools pools;
+        workers.QueueWork([this, key, envs_ = std::move(envs), shaders_ = std::move(shaders),
+                           &state, &callback]() mutable {
+            ShaderPools& pools{WorkerShaderPools()};
             boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
             for (auto& env : envs_) {
                 env_ptrs.push_back(&env);
             }
+            std::vector<u8> built_shaders;
             auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
+                                                 state.statistics.get(), false, shaders_.data,
+                                                 &built_shaders)};
+            SerializeBuiltShaders(shaders_.hash, std::move(built_shaders));
 
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
@@ -618,8 +793,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         ++state.total;
         ++state.total_graphics;
     }};
-    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
-                               load_graphics);
+    pipeline_cache_file.LoadPipelines(stop_loading, load_compute, load_graphics);
 
     LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}", state.total);
 
@@ -681,82 +855,30 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     ShaderPools& pools, const GraphicsPipelineCacheKey& key,
     std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-    bool build_in_parallel) try {
+    bool build_in_parallel, std::span<const u8> cached_shaders,
+    std::vector<u8>* built_shaders) try {
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
-    size_t env_index{0};
-    std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
-    const bool uses_vertex_a{key.unique_hashes[0] != 0};
-    const bool uses_vertex_b{key.unique_hashes[1] != 0};
-
-    // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
-    Shader::IR::Program* layer_source_program{};
 
-    for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
-        const bool is_emulated_stage = layer_source_program != nullptr &&
-                                       index == static_cast<u32>(Maxwell::ShaderType::Geometry);
-        if (key.unique_hashes[index] == 0 && is_emulated_stage) {
-            auto topology = MaxwellToOutputTopology(key.state.topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
-            continue;
-        }
-        if (key.unique_hashes[index] == 0) {
-            continue;
-        }
-        Shader::Environment& env{*envs[env_index]};
-        ++env_index;
-
-        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
-        if (!uses_vertex_a || index != 1) {
-            // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
-        } else {
-            // VertexB path when VertexA is present.
-            auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
-        }
-
-        if (Settings::values.dump_shaders) {
-            env.Dump(hash, key.unique_hashes[index]);
-        }
-
-        if (programs[index].info.requires_layer_emulation) {
-            layer_source_program = &programs[index];
+    std::vector<HostShader> shaders{DeserializeHostShaders(cached_shaders)};
+    if (shaders.empty()) {
+        shaders = TranslateGraphicsShaders(pools, key, envs, profile, host_info);
+        if (built_shaders) {
+            *built_shaders = SerializeHostShaders(shaders);
         }
     }
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
     std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
-
-    const Shader::IR::Program* previous_stage{};
-    Shader::Backend::Bindings binding;
-    for (size_t index = uses_vertex_a && uses_vertex_b ? 1 : 0; index < Maxwell::MaxShaderProgram;
-         ++index) {
-        const bool is_emulated_stage = layer_source_program != nullptr &&
-                                       index == static_cast<u32>(Maxwell::ShaderType::Geometry);
-        if (key.unique_hashes[index] == 0 && !is_emulated_stage) {
-            continue;
-        }
-        UNIMPLEMENTED_IF(index == 0);
-
-        Shader::IR::Program& program{programs[index]};
-        const size_t stage_index{index - 1};
-        infos[stage_index] = &program.info;
-
-        const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
-        ConvertLegacyToGeneric(program, runtime_info);
-        std::vector<u32> code = EmitSPIRV(profile, runtime_info, program, binding);
-        // Reserve space to reduce allocations during shader compilation
-        code.reserve(std::max<size_t>(code.size(), 16 * 1024 / sizeof(u32)));
-        device.SaveShader(code);
-        modules[stage_index] = BuildShader(device, code);
+    for (const HostShader& shader : shaders) {
+        const size_t stage_index{shader.stage_index};
+        infos[stage_index] = &shader.info;
+        device.SaveShader(shader.code);
+        modules[stage_index] = BuildShader(device, shader.code);
         if (device.HasDebuggingToolAttached()) {
-            const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[index])};
+            const std::string name{
+                fmt::format("Shader {:016x}", key.unique_hashes[stage_index + 1])};
             modules[stage_index].SetObjectNameEXT(name.c_str());
         }
-        previous_stage = &program;
     }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<GraphicsPipeline>(
@@ -794,12 +916,15 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
-    auto pipeline{
-        CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
-    if (!pipeline || pipeline_cache_filename.empty()) {
+    const bool is_cache_open{pipeline_cache_file.IsOpen()};
+    std::vector<u8> shaders;
+    auto pipeline{CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr,
+                                         true, {}, is_cache_open ? &shaders : nullptr)};
+    if (!pipeline || !is_cache_open) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs)] {
+    serialization_thread.QueueWork([this, key = graphics_key, envs = std::move(environments.envs),
+                                    shaders_ = std::move(shaders)] {
         boost::container::static_vector<const GenericEnvironment*, Maxwell::MaxShaderProgram>
             env_ptrs;
         for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
@@ -807,7 +932,7 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
                 env_ptrs.push_back(&envs[index]);
             }
         }
-        SerializePipeline(key, env_ptrs, pipeline_cache_filename, CACHE_VERSION);
+        pipeline_cache_file.SerializePipeline(key, env_ptrs, shaders_);
     });
     return pipeline;
 }
@@ -820,20 +945,25 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     env.SetCachedSize(shader->size_bytes);
 
     main_pools.ReleaseContents();
-    auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true)};
-    if (!pipeline || pipeline_cache_filename.empty()) {
+    const bool is_cache_open{pipeline_cache_file.IsOpen()};
+    std::vector<u8> shaders;
+    auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true, {},
+                                        is_cache_open ? &shaders : nullptr)};
+    if (!pipeline || !is_cache_open) {
         return pipeline;
     }
-    serialization_thread.QueueWork([this, key, env_ = std::move(env)] {
-        SerializePipeline(key, std::array<const GenericEnvironment*, 1>{&env_},
-                          pipeline_cache_filename, CACHE_VERSION);
-    });
+    serialization_thread.QueueWork(
+        [this, key, env_ = std::move(env), shaders_ = std::move(shaders)] {
+            const std::array<const GenericEnvironment*, 1> env_ptrs{&env_};
+            pipeline_cache_file.SerializePipeline(key, env_ptrs, shaders_);
+        });
     return pipeline;
 }
 
 std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
-    PipelineStatistics* statistics, bool build_in_parallel) try {
+    PipelineStatistics* statistics, bool build_in_parallel, std::span<const u8> cached_shaders,
+    std::vector<u8>* built_shaders) try {
     auto hash = key.Hash();
     if (device.HasBrokenCompute()) {
         LOG_ERROR(Render_Vulkan, "Skipping 0x{:016x}", hash);
@@ -842,19 +972,16 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
 
-    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
-
-    // Dump it before error.
-    if (Settings::values.dump_shaders) {
-        env.Dump(hash, key.unique_hash);
+    std::vector<HostShader> shaders{DeserializeHostShaders(cached_shaders)};
+    if (shaders.size() != 1) {
+        shaders = TranslateComputeShader(pools, key, env, profile, host_info);
+        if (built_shaders) {
+            *built_shaders = SerializeHostShaders(shaders);
+        }
     }
-
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-    std::vector<u32> code = EmitSPIRV(profile, program);
-    // Reserve space to reduce allocations during shader compilation
-    code.reserve(std::max<size_t>(code.size(), 16 * 1024 / sizeof(u32)));
-    device.SaveShader(code);
-    vk::ShaderModule spv_module{BuildShader(device, code)};
+    const HostShader& shader{shaders.front()};
+    device.SaveShader(shader.code);
+    vk::ShaderModule spv_module{BuildShader(device, shader.code)};
     if (device.HasDebuggingToolAttached()) {
         const auto name{fmt::format("Shader {:016x}", key.unique_hash)};
         spv_module.SetObjectNameEXT(name.c_str());
@@ -862,7 +989,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
                                              guest_descriptor_queue, thread_worker, statistics,
-                                             &shader_notify, program.info, std::move(spv_module));
+                                             &shader_notify, shader.info, std::move(spv_module));
 
 } catch (const vk::Exception& exception) {
     if (exception.GetResult() == VK_ERROR_OUT_OF_DEVICE_MEMORY) {
@@ -876,6 +1003,15 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     return nullptr;
 }
 
+void PipelineCache::SerializeBuiltShaders(u64 hash, std::vector<u8> shaders) {
+    if (shaders.empty()) {
+        return;
+    }
+    serialization_thread.QueueWork([this, hash, shaders_ = std::move(shaders)] {
+        pipeline_cache_file.SerializeHostShaders(hash, shaders_);
+    });
+}
+
 void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                                  const vk::PipelineCache& pipeline_cache,
                                                  u32 cache_version) try {
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -20,8 +21,10 @@
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/object_pool.h"
 #include "shader_recompiler/profile.h"
+#include "shader_recompiler/shader_info.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/pipeline_cache_file.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
@@ -88,6 +91,7 @@ using VideoCommon::ShaderInfo;
 
 struct ShaderPools {
     void ReleaseContents() {
+        // Blocks unlink their instructions when destroyed, release them before the instructions
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
@@ -98,6 +102,33 @@ struct ShaderPools {
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
 };
 
+/// Version of the pipelines and host shaders stored in the pipeline cache file
+constexpr u32 CACHE_VERSION = 11;
+
+/// SPIR-V and info of a pipeline stage, cached to skip the recompiler on the following boots
+struct HostShader {
+    u32 stage_index;
+    Shader::Info info;
+    std::vector<u32> code;
+};
+
+/// Translates the stages of a graphics pipeline to SPIR-V, this doesn't need a device
+[[nodiscard]] std::vector<HostShader> TranslateGraphicsShaders(
+    ShaderPools& pools, const GraphicsPipelineCacheKey& key,
+    std::span<Shader::Environment* const> envs, const Shader::Profile& profile,
+    const Shader::HostTranslateInfo& host_info);
+
+/// Translates the shader of a compute pipeline to SPIR-V, this doesn't need a device
+[[nodiscard]] std::vector<HostShader> TranslateComputeShader(
+    ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
+    const Shader::Profile& profile, const Shader::HostTranslateInfo& host_info);
+
+/// Serializes host shaders to be stored in the pipeline cache file
+[[nodiscard]] std::vector<u8> SerializeHostShaders(std::span<const HostShader> shaders);
+
+/// Returns the shaders written by SerializeHostShaders, or nothing when they have to be translated
+[[nodiscard]] std::vector<HostShader> DeserializeHostShaders(std::span<const u8> data);
+
 class PipelineCache : public VideoCommon::ShaderCache {
 public:
     explicit PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_, const Device& device,
@@ -121,19 +152,25 @@ private:
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
+    /// Builds a graphics pipeline from the cached shaders when they are valid, or translates its
+    /// stages and serializes the shaders to built_shaders when it isn't null
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(
         ShaderPools& pools, const GraphicsPipelineCacheKey& key,
         std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-        bool build_in_parallel);
+        bool build_in_parallel, std::span<const u8> cached_shaders = {},
+        std::vector<u8>* built_shaders = nullptr);
 
     std::unique_ptr<ComputePipeline> CreateComputePipeline(const ComputePipelineCacheKey& key,
                                                            const ShaderInfo* shader);
 
-    std::unique_ptr<ComputePipeline> CreateComputePipeline(ShaderPools& pools,
-                                                           const ComputePipelineCacheKey& key,
-                                                           Shader::Environment& env,
-                                                           PipelineStatistics* statistics,
-                                                           bool build_in_parallel);
+    /// Builds a compute pipeline, like the graphics pipeline overload
+    std::unique_ptr<ComputePipeline> CreateComputePipeline(
+        ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
+        PipelineStatistics* statistics, bool build_in_parallel,
+        std::span<const u8> cached_shaders = {}, std::vector<u8>* built_shaders = nullptr);
+
+    /// Queues the shaders built for a pipeline loaded from the cache without them
+    void SerializeBuiltShaders(u64 hash, std::vector<u8> shaders);
 
     void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                       const vk::PipelineCache& pipeline_cache, u32 cache_version);
@@ -178,7 +215,7 @@ public:
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
 
-    std::filesystem::path pipeline_cache_filename;
+    VideoCommon::PipelineCacheFile pipeline_cache_file;
 
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
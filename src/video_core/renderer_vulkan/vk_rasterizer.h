@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 
 #include <boost/container/static_vector.hpp>
 
@@ -39,6 +40,10 @@ namespace Engines {
 class Maxwell3D;
 }
 
+namespace Macro {
+class MacroDiskCache;
+}
+
 } // namespace Tegra
 
 namespace Vulkan {
@@ -213,6 +218,8 @@ private:
     QueryCacheRuntime query_cache_runtime;
     QueryCache query_cache;
     PipelineCache pipeline_cache;
+    /// Macro analysis of the title, loaded with the pipeline cache for the channels to share
+    std::shared_ptr<Tegra::Macro::MacroDiskCache> macro_disk_cache;
     AccelerateDMA accelerate_dma;
     FenceManager fence_manager;
 
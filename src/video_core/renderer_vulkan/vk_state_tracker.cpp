@@ -236,6 +236,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyVertexAttributes(tables);
     SetupDirtyVertexBindings(tables);
     SetupDirtySpecialOps(tables);
+    BuildDirtyRanges(channel_state.maxwell_3d->dirty);
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
@@ -8,6 +8,8 @@
 #include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/settings.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/dirty_flags.h"
@@ -309,6 +311,21 @@ void TextureCache<P>::RunGarbageCollector() {
     }
 }
 
+template <class P>
+void TextureCache<P>::LoadDiskResources(u64 title_id) {
+    if (title_id == 0 || !Settings::values.use_disk_texture_cache.GetValue()) {
+        return;
+    }
+    const auto shader_dir{Common::FS::GetCitronPath(Common::FS::CitronPath::ShaderDir)};
+    const auto base_dir{shader_dir / fmt::format("{:016x}", title_id)};
+    if (!Common::FS::CreateDir(shader_dir) || !Common::FS::CreateDir(base_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create texture transcode cache directories");
+        return;
+    }
+    const u64 max_size = u64{Settings::values.disk_texture_cache_size_mb.GetValue()} * 1_MiB;
+    transcode_cache.Open(base_dir / "texture_transcode.bin", max_size);
+}
+
 template <class P>
 void TextureCache<P>::TickFrame() {
     // FIXED: VRAM leak prevention - Enhanced frame tick with VRAM monitoring
@@ -1407,7 +1424,8 @@ void TextureCache<P>::DownloadImageIntoBuffer(typename TextureCache<P>::Image* i
 }
 
 template <class P>
-void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
+void TextureCache<P>::RefreshContents(Image& image, ImageId image_id,
+                                      Tegra::Texture::DecodePriority priority) {
     if (False(image.flags & ImageFlagBits::CpuModified)) {
         // Only upload modified images
         return;
@@ -1421,7 +1439,7 @@ void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
         return;
     }
     if (True(image.flags & ImageFlagBits::AsynchronousDecode)) {
-        QueueAsyncDecode(image, image_id);
+        QueueAsyncDecode(image, image_id, priority);
         return;
     }
     auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
@@ -1450,7 +1468,8 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies,
+                     transcode_cache.IsOpen() ? &transcode_cache : nullptr);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1637,38 +1656,27 @@ u64 TextureCache<P>::GetScaledImageSizeBytes(const ImageBase& image) {
 }
 
 template <class P>
-void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
+void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id,
+                                       Tegra::Texture::DecodePriority priority) {
     UNIMPLEMENTED_IF(False(image.flags & ImageFlagBits::Converted));
     LOG_INFO(HW_GPU, "Queuing async texture decode");
 
     image.flags |= ImageFlagBits::IsDecoding;
     auto decode = std::make_unique<AsyncDecodeContext>();
-    auto* decode_ptr = decode.get();
     decode->image_id = image_id;
-    async_decodes.push_back(std::move(decode));
 
-    static Common::ScratchBuffer<u8> local_unswizzle_data_buffer;
-    local_unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
+    decode->input_data.resize_destructive(image.unswizzled_size_bytes);
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> swizzle_data(
         *gpu_memory, image.gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
 
-    auto copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
-                                 local_unswizzle_data_buffer);
-    const size_t out_size = MapSizeBytes(image);
-
-    auto func = [out_size, copies, info = image.info,
-                 input = std::move(local_unswizzle_data_buffer),
-                 async_decode = decode_ptr]() mutable {
-        async_decode->decoded_data.resize_destructive(out_size);
-        std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
-
-        // TODO: Do we need this lock?
-        std::unique_lock lock{async_decode->mutex};
-        async_decode->copies = std::move(copies);
-        async_decode->complete = true;
-    };
-    texture_decode_worker.QueueWork(std::move(func));
+    decode->copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
+                                    decode->input_data);
+    decode->decoded_data.resize_destructive(MapSizeBytes(image));
+    const std::span copies{decode->copies.data(), decode->copies.size()};
+    decode->token =
+        ConvertImageAsync(decode->input_data, image.info, decode->decoded_data, copies,
+                          transcode_cache.IsOpen() ? &transcode_cache : nullptr, priority);
+    async_decodes.push_back(std::move(decode));
 }
 
 template <class P>
@@ -1677,8 +1685,7 @@ void TextureCache<P>::TickAsyncDecode() {
     auto i = async_decodes.begin();
     while (i != async_decodes.end()) {
         auto* async_decode = i->get();
-        std::unique_lock lock{async_decode->mutex};
-        if (!async_decode->complete) {
+        if (!async_decode->token.IsComplete()) {
             ++i;
             continue;
         }
@@ -2746,7 +2753,10 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
             TrackImage(image, image_id);
         }
     } else {
-        RefreshContents(image, image_id);
+        // Images written by the GPU are render or copy targets, their draw waits on the upload
+        RefreshContents(image, image_id,
+                        is_modification ? Tegra::Texture::DecodePriority::RenderTarget
+                                        : Tegra::Texture::DecodePriority::Sampled);
         SynchronizeAliases(image_id);
     }
     if (is_modification) {
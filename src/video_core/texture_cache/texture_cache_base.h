@@ -34,8 +34,10 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
+#include "video_core/textures/workers.h"
 
 namespace Tegra {
 namespace Control {
@@ -57,11 +59,16 @@ struct ImageViewInOut {
 };
 
 struct AsyncDecodeContext {
+    ~AsyncDecodeContext() {
+        // Queued jobs still reference the buffers below
+        token.Wait();
+    }
+
     ImageId image_id;
+    Common::ScratchBuffer<u8> input_data;
     Common::ScratchBuffer<u8> decoded_data;
     boost::container::small_vector<BufferImageCopy, 16> copies;
-    std::mutex mutex;
-    std::atomic_bool complete;
+    Tegra::Texture::DecodeToken token;
 };
 
 using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
@@ -143,6 +150,9 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Open the persistent transcode cache of a title
+    void LoadDiskResources(u64 title_id);
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -354,7 +364,9 @@ public:
     FramebufferId GetFramebufferId(const RenderTargets& key);
 
     /// Refresh the contents (pixel data) of an image
-    void RefreshContents(Image& image, ImageId image_id);
+    void RefreshContents(Image& image, ImageId image_id,
+                         Tegra::Texture::DecodePriority priority =
+                             Tegra::Texture::DecodePriority::Sampled);
 
     /// Upload data from guest to an image
     template <typename StagingBuffer>
@@ -470,7 +482,7 @@ public:
     bool ScaleDown(Image& image);
     u64 GetScaledImageSizeBytes(const ImageBase& image);
 
-    void QueueAsyncDecode(Image& image, ImageId image_id);
+    void QueueAsyncDecode(Image& image, ImageId image_id, Tegra::Texture::DecodePriority priority);
     void TickAsyncDecode();
 
     Runtime& runtime;
@@ -556,7 +568,9 @@ public:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
-    Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
+    // Declared before the async decodes, they wait for pending jobs that may still use it
+    TranscodeCache transcode_cache;
+
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
     // Join caching
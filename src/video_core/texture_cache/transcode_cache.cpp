@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace VideoCommon {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'c', 't', 'r', 'n', 't', 'x', 'c', 'h'};
+constexpr u32 PACK_VERSION = 1;
+constexpr u64 RECORD_ALIGNMENT = 16;
+
+struct PackHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(PackHeader) == 16);
+
+struct RecordHeader {
+    TranscodeKey key;
+    u64 buffer_size;
+    u64 size;
+};
+static_assert(sizeof(RecordHeader) == 48);
+
+[[nodiscard]] u64 RecordSize(u64 data_size) {
+    return sizeof(RecordHeader) + Common::AlignUp(data_size, RECORD_ALIGNMENT);
+}
+} // Anonymous namespace
+
+size_t TranscodeKey::Hash() const noexcept {
+    return static_cast<size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(this), sizeof(TranscodeKey)));
+}
+
+TranscodeKey MakeTranscodeKey(std::span<const u8> guest_data,
+                              VideoCore::Surface::PixelFormat format, TranscodeMode mode,
+                              const Extent3D& extent) {
+    return TranscodeKey{
+        .hash = Common::CityHash64(reinterpret_cast<const char*>(guest_data.data()),
+                                   guest_data.size()),
+        .format = static_cast<u32>(format),
+        .mode = static_cast<u32>(mode),
+        .width = extent.width,
+        .height = extent.height,
+        .slices = extent.depth,
+        .guest_size = static_cast<u32>(guest_data.size()),
+    };
+}
+
+TranscodeCache::TranscodeCache() = default;
+
+TranscodeCache::~TranscodeCache() {
+    Close();
+}
+
+void TranscodeCache::Open(const std::filesystem::path& path_, u64 max_size_) {
+    Close();
+
+    std::scoped_lock lock{mutex};
+    path = path_;
+    max_size = max_size_;
+
+    if (Common::FS::Exists(path) && mapped.Open(path)) {
+        const u64 valid_size = LoadIndex();
+        if (valid_size == 0) {
+            LOG_INFO(Common_Filesystem, "Deleting old texture transcode cache");
+            Reset();
+            if (!Common::FS::RemoveFile(path)) {
+                LOG_ERROR(Common_Filesystem, "Failed to delete texture transcode cache {}",
+                          Common::FS::PathToUTF8String(path));
+                return;
+            }
+        } else if (valid_size != mapped.Size()) {
+            // A record was cut short, drop the tail so new records are appended after valid data
+            LOG_WARNING(Common_Filesystem, "Truncating corrupted texture transcode cache");
+            Reset();
+            Common::FS::IOFile truncate_file{path, Common::FS::FileAccessMode::ReadWrite};
+            if (!truncate_file.SetSize(valid_size)) {
+                LOG_ERROR(Common_Filesystem, "Failed to truncate texture transcode cache");
+                return;
+            }
+            truncate_file.Close();
+            if (!mapped.Open(path) || LoadIndex() != valid_size) {
+                Reset();
+                return;
+            }
+        }
+    }
+    file.Open(path, Common::FS::FileAccessMode::ReadAppend);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open texture transcode cache {}",
+                  Common::FS::PathToUTF8String(path));
+        Reset();
+        return;
+    }
+    if (!mapped.IsOpen()) {
+        const PackHeader header{
+            .magic = MAGIC_NUMBER,
+            .version = PACK_VERSION,
+            .reserved = 0,
+        };
+        if (!file.WriteObject(header)) {
+            LOG_ERROR(Common_Filesystem, "Failed to write texture transcode cache header");
+            Reset();
+            return;
+        }
+        file_size = sizeof(PackHeader);
+    }
+    while (live_size > max_size) {
+        EvictOldest();
+    }
+    LOG_INFO(HW_GPU, "Loaded {} transcoded texture levels ({} MiB)", entries.size(),
+             live_size >> 20);
+}
+
+void TranscodeCache::Close() {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    LOG_INFO(HW_GPU, "Texture transcode cache: {} hits, {} misses", Hits(), Misses());
+    if (dead_size != 0) {
+        Compact();
+    }
+    Reset();
+}
+
+bool TranscodeCache::IsOpen() const {
+    std::scoped_lock lock{mutex};
+    return file.IsOpen();
+}
+
+std::optional<size_t> TranscodeCache::Find(const TranscodeKey& key, std::span<u8> output) {
+    std::scoped_lock lock{mutex};
+    const auto it = entries.find(key);
+    if (it == entries.end() || it->second.size != output.size()) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    const Entry& entry = it->second;
+    lru.splice(lru.end(), lru, entry.lru_it);
+
+    const size_t buffer_size = entry.buffer_size;
+    if (entry.offset + entry.size <= mapped.Size()) {
+        // Close unmaps the pack, the copy has to finish under the lock
+        std::memcpy(output.data(), mapped.Data().data() + entry.offset, output.size());
+    } else if (!file.Seek(static_cast<s64>(entry.offset)) ||
+               file.ReadSpan(output) != output.size()) {
+        LOG_ERROR(Common_Filesystem, "Failed to read texture transcode cache entry");
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return buffer_size;
+}
+
+void TranscodeCache::Insert(const TranscodeKey& key, std::span<const u8> data,
+                            size_t buffer_size) {
+    const u64 record_size = RecordSize(data.size());
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen() || record_size > max_size || entries.contains(key)) {
+        return;
+    }
+    while (live_size + record_size > max_size) {
+        EvictOldest();
+    }
+    const RecordHeader header{
+        .key = key,
+        .buffer_size = buffer_size,
+        .size = data.size(),
+    };
+    static constexpr std::array<u8, RECORD_ALIGNMENT> padding{};
+    const size_t padding_size = record_size - sizeof(RecordHeader) - data.size();
+
+    // Reads may have moved the stream, switching back to writing needs a seek
+    if (!file.Seek(0, Common::FS::SeekOrigin::End) || !file.WriteObject(header) ||
+        file.WriteSpan(data) != data.size() ||
+        file.WriteSpan(std::span(padding).first(padding_size)) != padding_size) {
+        LOG_ERROR(Common_Filesystem, "Failed to write texture transcode cache entry");
+        // The pack may end in a partial record now, the next load truncates it
+        file.Close();
+        return;
+    }
+    AddEntry(key, file_size + sizeof(RecordHeader), data.size(), buffer_size);
+    file_size += record_size;
+}
+
+u64 TranscodeCache::LoadIndex() {
+    const std::span<const u8> data = mapped.Data();
+    PackHeader header;
+    if (data.size() < sizeof(header)) {
+        return 0;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != MAGIC_NUMBER || header.version != PACK_VERSION) {
+        return 0;
+    }
+    u64 offset = sizeof(PackHeader);
+    while (data.size() - offset >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        const u64 record_size = RecordSize(record.size);
+        if (record.size > data.size() || record_size > data.size() - offset) {
+            break;
+        }
+        AddEntry(record.key, offset + sizeof(RecordHeader), record.size, record.buffer_size);
+        offset += record_size;
+    }
+    file_size = offset;
+    return offset;
+}
+
+void TranscodeCache::AddEntry(const TranscodeKey& key, u64 offset, u64 size, u64 buffer_size) {
+    const auto [it, is_new] = entries.try_emplace(key);
+    if (!is_new) {
+        lru.erase(it->second.lru_it);
+        live_size -= RecordSize(it->second.size);
+        dead_size += RecordSize(it->second.size);
+    }
+    it->second = Entry{
+        .offset = offset,
+        .size = size,
+        .buffer_size = buffer_size,
+        .lru_it = lru.insert(lru.end(), key),
+    };
+    live_size += RecordSize(size);
+}
+
+void TranscodeCache::EvictOldest() {
+    if (lru.empty()) {
+        return;
+    }
+    const auto it = entries.find(lru.front());
+    const u64 record_size = RecordSize(it->second.size);
+    live_size -= record_size;
+    dead_size += record_size;
+    entries.erase(it);
+    lru.pop_front();
+}
+
+void TranscodeCache::Compact() {
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile temp_file{temp_path, Common::FS::FileAccessMode::Write};
+        if (!temp_file.IsOpen()) {
+            LOG_ERROR(Common_Filesystem, "Failed to create {}",
+                      Common::FS::PathToUTF8String(temp_path));
+            return;
+        }
+        const PackHeader header{
+            .magic = MAGIC_NUMBER,
+            .version = PACK_VERSION,
+            .reserved = 0,
+        };
+        bool success = temp_file.WriteObject(header);
+
+        // Records are written oldest first, loading them back restores the LRU order
+        std::vector<u8> buffer;
+        for (auto it = lru.begin(); success && it != lru.end(); ++it) {
+            const Entry& entry = entries.at(*it);
+            const RecordHeader record{
+                .key = *it,
+                .buffer_size = entry.buffer_size,
+                .size = entry.size,
+            };
+            buffer.resize(RecordSize(entry.size) - sizeof(RecordHeader));
+            std::ranges::fill(buffer, u8{0});
+            const std::span record_data = std::span(buffer).first(entry.size);
+            if (entry.offset + entry.size <= mapped.Size()) {
+                std::memcpy(buffer.data(), mapped.Data().data() + entry.offset, entry.size);
+            } else {
+                success = file.Seek(static_cast<s64>(entry.offset)) &&
+                          file.ReadSpan(record_data) == record_data.size();
+            }
+            success = success && temp_file.WriteObject(record) &&
+                      temp_file.WriteSpan(std::span<const u8>(buffer)) == buffer.size();
+        }
+        if (!success) {
+            LOG_ERROR(Common_Filesystem, "Failed to compact texture transcode cache");
+            temp_file.Close();
+            void(Common::FS::RemoveFile(temp_path));
+            return;
+        }
+    }
+    // The pack has to be unmapped and closed before it can be replaced
+    file.Close();
+    mapped.Close();
+    if (!Common::FS::RemoveFile(path) || !Common::FS::RenameFile(temp_path, path)) {
+        LOG_ERROR(Common_Filesystem, "Failed to replace texture transcode cache {}",
+                  Common::FS::PathToUTF8String(path));
+    }
+}
+
+void TranscodeCache::Reset() {
+    file.Close();
+    mapped.Close();
+    entries.clear();
+    lru.clear();
+    file_size = 0;
+    live_size = 0;
+    dead_size = 0;
+}
+
+} // namespace VideoCommon
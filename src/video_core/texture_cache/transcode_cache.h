@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/mapped_file.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+/// How the host representation of a guest level was produced
+enum class TranscodeMode : u32 {
+    AstcToRgba8,
+    AstcToBc1,
+    AstcToBc3,
+    BcnToRgba,
+};
+
+/// Identifies a transcoded guest level, hashed over the guest data
+struct TranscodeKey {
+    u64 hash;
+    u32 format;
+    u32 mode;
+    u32 width;
+    u32 height;
+    u32 slices;
+    u32 guest_size;
+
+    [[nodiscard]] size_t Hash() const noexcept;
+
+    bool operator==(const TranscodeKey&) const noexcept = default;
+};
+static_assert(sizeof(TranscodeKey) == 32, "TranscodeKey has padding");
+
+/// Builds the key of a level from its unswizzled guest data
+[[nodiscard]] TranscodeKey MakeTranscodeKey(std::span<const u8> guest_data,
+                                            VideoCore::Surface::PixelFormat format,
+                                            TranscodeMode mode, const Extent3D& extent);
+
+/**
+ * Persistent cache of CPU transcoded texture levels (ASTC decoding or recompression, BCn
+ * decompression), stored in a pack file next to the pipeline cache of a title.
+ * Entries loaded from disk are read straight from a memory mapping of the pack, new entries are
+ * appended to it. The pack is kept under a size budget by evicting the least recently used entries
+ * and compacted when the cache is closed.
+ * All methods are thread safe, levels can be transcoded from the async decode worker.
+ */
+class TranscodeCache {
+public:
+    TranscodeCache();
+    ~TranscodeCache();
+
+    TranscodeCache(const TranscodeCache&) = delete;
+    TranscodeCache& operator=(const TranscodeCache&) = delete;
+
+    /// Opens the pack at path, creating it if it doesn't exist, and loads its index
+    void Open(const std::filesystem::path& path, u64 max_size);
+
+    /// Compacts the pack if needed and closes it
+    void Close();
+
+    /// Returns true when a pack is open
+    [[nodiscard]] bool IsOpen() const;
+
+    /**
+     * Copies the cached contents of a level into output.
+     * @param key    Key of the level
+     * @param output Destination of the transcoded level, its size must match the cached level
+     * @returns The buffer size of the level copy on a hit, std::nullopt on a miss
+     */
+    [[nodiscard]] std::optional<size_t> Find(const TranscodeKey& key, std::span<u8> output);
+
+    /// Stores a transcoded level, evicting old entries when the pack grows past its budget
+    void Insert(const TranscodeKey& key, std::span<const u8> data, size_t buffer_size);
+
+    [[nodiscard]] u64 Hits() const noexcept {
+        return hits.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] u64 Misses() const noexcept {
+        return misses.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct KeyHash {
+        size_t operator()(const TranscodeKey& key) const noexcept {
+            return key.Hash();
+        }
+    };
+
+    struct Entry {
+        u64 offset;
+        u64 size;
+        u64 buffer_size;
+        std::list<TranscodeKey>::iterator lru_it;
+    };
+
+    /// Parses the mapped pack, returns the end of the last valid record or 0 if it is invalid
+    u64 LoadIndex();
+
+    void AddEntry(const TranscodeKey& key, u64 offset, u64 size, u64 buffer_size);
+
+    void EvictOldest();
+
+    /// Rewrites the live entries in LRU order, dropping evicted records from the pack
+    void Compact();
+
+    void Reset();
+
+    mutable std::mutex mutex;
+    std::filesystem::path path;
+    Common::FS::MappedFile mapped;
+    Common::FS::IOFile file;
+    std::unordered_map<TranscodeKey, Entry, KeyHash> entries;
+    std::list<TranscodeKey> lru;
+    u64 max_size = 0;
+    u64 file_size = 0;
+    u64 live_size = 0;
+    u64 dead_size = 0;
+
+    std::atomic<u64> hits{};
+    std::atomic<u64> misses{};
+};
+
+} // namespace VideoCommon
@@ -30,6 +30,7 @@
 #include "video_core/texture_cache/format_lookup_table.h"
 #include "video_core/texture_cache/formatter.h"
 #include "video_core/texture_cache/samples_helper.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/util.h"
 #include "video_core/textures/astc.h"
 #include "video_core/textures/bcn.h"
@@ -574,6 +575,40 @@ void SwizzleBlockLinearImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr
     ASSERT(host_offset - copy.buffer_offset == copy.buffer_size);
 }
 
+[[nodiscard]] TranscodeMode TranscodeModeOf(bool astc, Settings::AstcRecompression recompression) {
+    if (!astc) {
+        return TranscodeMode::BcnToRgba;
+    }
+    switch (recompression) {
+    case Settings::AstcRecompression::Bc1:
+        return TranscodeMode::AstcToBc1;
+    case Settings::AstcRecompression::Bc3:
+        return TranscodeMode::AstcToBc3;
+    default:
+        return TranscodeMode::AstcToRgba8;
+    }
+}
+
+/// Returns the size ConvertImage produces for a level, matching its output offsets
+[[nodiscard]] u32 TranscodedLevelSize(TranscodeMode mode, Extent3D extent, u32 num_layers,
+                                      PixelFormat format) {
+    switch (mode) {
+    case TranscodeMode::AstcToRgba8:
+        return extent.width * extent.height * num_layers *
+               BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
+    case TranscodeMode::AstcToBc1:
+    case TranscodeMode::AstcToBc3: {
+        const u32 aligned_plane_dim =
+            Common::AlignUp(extent.width, 4) * Common::AlignUp(extent.height, 4);
+        const u32 bpp_div = mode == TranscodeMode::AstcToBc1 ? 2 : 1;
+        return (aligned_plane_dim * extent.depth * num_layers) / bpp_div;
+    }
+    case TranscodeMode::BcnToRgba:
+        return extent.width * extent.height * num_layers * ConvertedBytesPerBlock(format);
+    }
+    return 0;
+}
+
 } // Anonymous namespace
 
 u32 CalculateGuestSizeInBytes(const ImageInfo& info) noexcept {
@@ -925,12 +960,32 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
     return copies;
 }
 
-void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+Tegra::Texture::DecodeToken ConvertImageAsync(std::span<const u8> input, const ImageInfo& info,
+                                              std::span<u8> output,
+                                              std::span<BufferImageCopy> copies,
+                                              TranscodeCache* transcode_cache,
+                                              Tegra::Texture::DecodePriority priority) {
+    using Tegra::Texture::DecodePriority;
+
+    // Work left on a level once its texels are decoded, queued as a second stage of the batch
+    struct PendingLevel {
+        TranscodeMode mode;
+        DecodePriority priority;
+        std::vector<u8> decoded;
+        Extent3D decoded_extent;
+        u32 output_offset;
+        u32 output_size;
+        size_t buffer_size;
+        std::optional<TranscodeKey> transcode_key;
+    };
+    std::vector<PendingLevel> pending_levels;
+    Tegra::Texture::DecodeBatch batch;
     u32 output_offset = 0;
-    Common::ScratchBuffer<u8> decode_scratch;
 
     const Extent2D tile_size = DefaultBlockSize(info.format);
+    const bool astc = IsPixelFormatASTC(info.format);
+    const TranscodeMode mode =
+        TranscodeModeOf(astc, Settings::values.astc_recompression.GetValue());
     for (BufferImageCopy& copy : copies) {
         const u32 level = copy.image_subresource.base_level;
         const Extent3D mip_size = AdjustMipSize(info.size, level);
@@ -943,58 +998,113 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         const auto input_offset = input.subspan(copy.buffer_offset);
         copy.buffer_offset = output_offset;
 
-        const auto recompression_setting = Settings::values.astc_recompression.GetValue();
-        const bool astc = IsPixelFormatASTC(info.format);
-
-        if (astc && recompression_setting == Settings::AstcRecompression::Uncompressed) {
-            Tegra::Texture::ASTC::Decompress(
-                input_offset, copy.image_extent.width, copy.image_extent.height,
-                copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, output.subspan(output_offset));
+        const u32 num_layers = static_cast<u32>(copy.image_subresource.num_layers);
+        const u32 num_slices = num_layers * copy.image_extent.depth;
+        const u32 level_size =
+            TranscodedLevelSize(mode, copy.image_extent, num_layers, info.format);
+
+        // 3D levels write past the per layer output size, keep them out of the cache
+        std::optional<TranscodeKey> transcode_key;
+        if (transcode_cache && copy.image_extent.depth == 1) {
+            transcode_key = MakeTranscodeKey(
+                input_offset.first(copy.buffer_size), info.format, mode,
+                Extent3D{copy.image_extent.width, copy.image_extent.height, num_layers});
+            if (const auto buffer_size = transcode_cache->Find(
+                    *transcode_key, output.subspan(output_offset, level_size))) {
+                copy.buffer_size = *buffer_size;
+                copy.buffer_row_length = mip_size.width;
+                copy.buffer_image_height = mip_size.height;
+                output_offset += level_size;
+                continue;
+            }
+        }
 
-            output_offset += copy.image_extent.width * copy.image_extent.height *
-                             copy.image_subresource.num_layers *
-                             BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
-        } else if (astc) {
+        // Mip levels of sampled images are rarely needed right away, let base levels go first
+        const DecodePriority level_priority =
+            priority == DecodePriority::Sampled && level > 0 ? DecodePriority::Prefetch : priority;
+        PendingLevel pending{
+            .mode = mode,
+            .priority = level_priority,
+            .decoded = {},
+            .decoded_extent = {copy.image_extent.width, copy.image_extent.height, num_slices},
+            .output_offset = output_offset,
+            .output_size = level_size,
+            .buffer_size = copy.buffer_size,
+            .transcode_key = transcode_key,
+        };
+        switch (mode) {
+        case TranscodeMode::AstcToRgba8:
+            Tegra::Texture::ASTC::QueueDecompress(
+                batch, level_priority, input_offset, copy.image_extent.width,
+                copy.image_extent.height, num_slices, tile_size.width, tile_size.height,
+                output.subspan(output_offset));
+            break;
+        case TranscodeMode::AstcToBc1:
+        case TranscodeMode::AstcToBc3:
             // BC1 uses 0.5 bytes per texel
             // BC3 uses 1 byte per texel
-            const auto compress = recompression_setting == Settings::AstcRecompression::Bc1
-                                      ? Tegra::Texture::BCN::CompressBC1
-                                      : Tegra::Texture::BCN::CompressBC3;
-            const auto bpp_div = recompression_setting == Settings::AstcRecompression::Bc1 ? 2 : 1;
-
-            const u32 plane_dim = copy.image_extent.width * copy.image_extent.height;
-            const u32 level_size = plane_dim * copy.image_extent.depth *
-                                   copy.image_subresource.num_layers *
-                                   BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
-            decode_scratch.resize_destructive(level_size);
-
-            Tegra::Texture::ASTC::Decompress(
-                input_offset, copy.image_extent.width, copy.image_extent.height,
-                copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, decode_scratch);
-
-            compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
-                     copy.image_subresource.num_layers * copy.image_extent.depth,
-                     output.subspan(output_offset));
-
-            const u32 aligned_plane_dim = Common::AlignUp(copy.image_extent.width, 4) *
-                                          Common::AlignUp(copy.image_extent.height, 4);
-
-            copy.buffer_size =
-                (aligned_plane_dim * copy.image_extent.depth * copy.image_subresource.num_layers) /
-                bpp_div;
-            output_offset += static_cast<u32>(copy.buffer_size);
-        } else {
-            DecompressBCn(input_offset, output.subspan(output_offset), copy, info.format);
-            output_offset += copy.image_extent.width * copy.image_extent.height *
-                             copy.image_subresource.num_layers *
-                             ConvertedBytesPerBlock(info.format);
+            pending.decoded.resize(copy.image_extent.width * copy.image_extent.height *
+                                   num_slices * BytesPerBlock(PixelFormat::A8B8G8R8_UNORM));
+            Tegra::Texture::ASTC::QueueDecompress(
+                batch, level_priority, input_offset, copy.image_extent.width,
+                copy.image_extent.height, num_slices, tile_size.width, tile_size.height,
+                pending.decoded);
+            copy.buffer_size = level_size;
+            pending.buffer_size = level_size;
+            break;
+        case TranscodeMode::BcnToRgba:
+            batch.AddJob(level_priority, [input_offset, output = output.subspan(output_offset),
+                                          copy, format = info.format]() mutable {
+                DecompressBCn(input_offset, output, copy, format);
+            });
+            break;
+        }
+        if (!pending.decoded.empty() || pending.transcode_key) {
+            pending_levels.push_back(std::move(pending));
         }
+        output_offset += level_size;
 
         copy.buffer_row_length = mip_size.width;
         copy.buffer_image_height = mip_size.height;
     }
+    if (!pending_levels.empty()) {
+        // Recompression reads the decoded texels, it goes through the same priority queues once
+        // every level is decoded
+        batch.AddStage();
+        for (const PendingLevel& pending : pending_levels) {
+            const std::span<u8> level_output = output.subspan(pending.output_offset);
+            const Extent3D extent = pending.decoded_extent;
+            if (pending.mode == TranscodeMode::AstcToBc1) {
+                Tegra::Texture::BCN::QueueCompressBC1(batch, pending.priority, pending.decoded,
+                                                      extent.width, extent.height, extent.depth,
+                                                      level_output);
+            } else if (pending.mode == TranscodeMode::AstcToBc3) {
+                Tegra::Texture::BCN::QueueCompressBC3(batch, pending.priority, pending.decoded,
+                                                      extent.width, extent.height, extent.depth,
+                                                      level_output);
+            }
+        }
+        // The completion owns the decoded texels, keeping them alive until the batch is done
+        batch.SetCompletion(priority, [pending_levels = std::move(pending_levels), output,
+                                       transcode_cache] {
+            for (const PendingLevel& pending : pending_levels) {
+                const std::span<u8> level_output = output.subspan(pending.output_offset);
+                if (pending.transcode_key) {
+                    transcode_cache->Insert(*pending.transcode_key,
+                                            level_output.first(pending.output_size),
+                                            pending.buffer_size);
+                }
+            }
+        });
+    }
+    return batch.Submit();
+}
+
+void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                  std::span<BufferImageCopy> copies, TranscodeCache* transcode_cache) {
+    ConvertImageAsync(input, info, output, copies, transcode_cache,
+                      Tegra::Texture::DecodePriority::RenderTarget)
+        .Wait();
 }
 
 boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(const ImageInfo& info) {
@@ -14,9 +14,12 @@
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
+#include "video_core/textures/workers.h"
 
 namespace VideoCommon {
 
+class TranscodeCache;
+
 using Tegra::Texture::TICEntry;
 
 using LevelArray = std::array<u32, MAX_MIP_LEVELS>;
@@ -67,7 +70,17 @@ struct OverlapResult {
     std::span<const u8> input, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies, TranscodeCache* transcode_cache = nullptr);
+
+/**
+ * Queues the conversion of every level and slice on the decode workers as a single batch.
+ * The copies are updated before returning, the output is only valid once the token completes.
+ * Input and output must stay alive until then.
+ */
+[[nodiscard]] Tegra::Texture::DecodeToken ConvertImageAsync(
+    std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+    std::span<BufferImageCopy> copies, TranscodeCache* transcode_cache,
+    Tegra::Texture::DecodePriority priority);
 
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
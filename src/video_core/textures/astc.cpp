@@ -8,6 +8,7 @@
 #include <bit>
 #include <cassert>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -16,9 +17,17 @@
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
+#include "common/swap.h"
 #include "video_core/textures/astc.h"
 #include "video_core/textures/workers.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 class InputBitStream {
 public:
     constexpr explicit InputBitStream(std::span<const u8> data, size_t start_offset = 0)
@@ -815,16 +824,129 @@ public:
     }
 };
 
-static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, const u32 nPartitions,
-                              const u32 nBitsForColorData) {
-    // First figure out how many color values we have
-    u32 nValues = 0;
-    for (u32 i = 0; i < nPartitions; i++) {
-        nValues += ((modes[i] >> 2) + 1) << 1;
-    }
+// Dequantizes a single color endpoint value to the 0-255 range.
+// This procedure is outlined in ASTC spec C.2.13
+static u32 UnquantizeColorValue(const IntegerEncodedValue& val) {
+    const u32 bitlen = val.num_bits;
+    const u32 bitval = val.bit_value;
 
-    // Then based on the number of values and the remaining number of bits,
-    // figure out the max value for each of them...
+    assert(bitlen >= 1);
+
+    u32 A = 0, B = 0, C = 0, D = 0;
+    // A is just the lsb replicated 9 times.
+    A = ReplicateBitTo9(bitval & 1);
+
+    switch (val.encoding) {
+    // Replicate bits
+    case IntegerEncoding::JustBits:
+        return FastReplicateTo8(bitval, bitlen);
+
+    // Use algorithm in C.2.13
+    case IntegerEncoding::Trit: {
+
+        D = val.trit_value;
+
+        switch (bitlen) {
+        case 1: {
+            C = 204;
+        } break;
+
+        case 2: {
+            C = 93;
+            // B = b000b0bb0
+            u32 b = (bitval >> 1) & 1;
+            B = (b << 8) | (b << 4) | (b << 2) | (b << 1);
+        } break;
+
+        case 3: {
+            C = 44;
+            // B = cb000cbcb
+            u32 cb = (bitval >> 1) & 3;
+            B = (cb << 7) | (cb << 2) | cb;
+        } break;
+
+        case 4: {
+            C = 22;
+            // B = dcb000dcb
+            u32 dcb = (bitval >> 1) & 7;
+            B = (dcb << 6) | dcb;
+        } break;
+
+        case 5: {
+            C = 11;
+            // B = edcb000ed
+            u32 edcb = (bitval >> 1) & 0xF;
+            B = (edcb << 5) | (edcb >> 2);
+        } break;
+
+        case 6: {
+            C = 5;
+            // B = fedcb000f
+            u32 fedcb = (bitval >> 1) & 0x1F;
+            B = (fedcb << 4) | (fedcb >> 4);
+        } break;
+
+        default:
+            assert(false && "Unsupported trit encoding for color values!");
+            break;
+        } // switch(bitlen)
+    }     // case IntegerEncoding::Trit
+    break;
+
+    case IntegerEncoding::Quint: {
+
+        D = val.quint_value;
+
+        switch (bitlen) {
+        case 1: {
+            C = 113;
+        } break;
+
+        case 2: {
+            C = 54;
+            // B = b0000bb00
+            u32 b = (bitval >> 1) & 1;
+            B = (b << 8) | (b << 3) | (b << 2);
+        } break;
+
+        case 3: {
+            C = 26;
+            // B = cb0000cbc
+            u32 cb = (bitval >> 1) & 3;
+            B = (cb << 7) | (cb << 1) | (cb >> 1);
+        } break;
+
+        case 4: {
+            C = 13;
+            // B = dcb0000dc
+            u32 dcb = (bitval >> 1) & 7;
+            B = (dcb << 6) | (dcb >> 1);
+        } break;
+
+        case 5: {
+            C = 6;
+            // B = edcb0000e
+            u32 edcb = (bitval >> 1) & 0xF;
+            B = (edcb << 5) | (edcb >> 3);
+        } break;
+
+        default:
+            assert(false && "Unsupported quint encoding for color values!");
+            break;
+        } // switch(bitlen)
+    }     // case IntegerEncoding::Quint
+    break;
+    } // switch(val.encoding)
+
+    u32 T = D * C + B;
+    T ^= A;
+    T = (A & 0x80) | (T >> 2);
+    return T;
+}
+
+// Based on the number of color values and the number of bits available for them,
+// figure out the max value each of them can take.
+static u32 FindColorValueRange(u32 nValues, u32 nBitsForColorData) {
     u32 range = 256;
     while (--range > 0) {
         IntegerEncodedValue val = ASTC_ENCODINGS_VALUES[range];
@@ -843,6 +965,20 @@ static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, co
             break;
         }
     }
+    return range;
+}
+
+static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, const u32 nPartitions,
+                              const u32 nBitsForColorData) {
+    // First figure out how many color values we have
+    u32 nValues = 0;
+    for (u32 i = 0; i < nPartitions; i++) {
+        nValues += ((modes[i] >> 2) + 1) << 1;
+    }
+
+    // Then based on the number of values and the remaining number of bits,
+    // figure out the max value for each of them...
+    const u32 range = FindColorValueRange(nValues, nBitsForColorData);
 
     // We now have enough to decode our integer sequence.
     IntegerEncodedVector decodedColorValues;
@@ -851,133 +987,13 @@ static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, co
     DecodeIntegerSequence(decodedColorValues, colorStream, range, nValues);
 
     // Once we have the decoded values, we need to dequantize them to the 0-255 range
-    // This procedure is outlined in ASTC spec C.2.13
     u32 outIdx = 0;
     for (auto itr = decodedColorValues.begin(); itr != decodedColorValues.end(); ++itr) {
         // Have we already decoded all that we need?
         if (outIdx >= nValues) {
             break;
         }
-
-        const IntegerEncodedValue& val = *itr;
-        u32 bitlen = val.num_bits;
-        u32 bitval = val.bit_value;
-
-        assert(bitlen >= 1);
-
-        u32 A = 0, B = 0, C = 0, D = 0;
-        // A is just the lsb replicated 9 times.
-        A = ReplicateBitTo9(bitval & 1);
-
-        switch (val.encoding) {
-        // Replicate bits
-        case IntegerEncoding::JustBits:
-            out[outIdx++] = FastReplicateTo8(bitval, bitlen);
-            break;
-
-        // Use algorithm in C.2.13
-        case IntegerEncoding::Trit: {
-
-            D = val.trit_value;
-
-            switch (bitlen) {
-            case 1: {
-                C = 204;
-            } break;
-
-            case 2: {
-                C = 93;
-                // B = b000b0bb0
-                u32 b = (bitval >> 1) & 1;
-                B = (b << 8) | (b << 4) | (b << 2) | (b << 1);
-            } break;
-
-            case 3: {
-                C = 44;
-                // B = cb000cbcb
-                u32 cb = (bitval >> 1) & 3;
-                B = (cb << 7) | (cb << 2) | cb;
-            } break;
-
-            case 4: {
-                C = 22;
-                // B = dcb000dcb
-                u32 dcb = (bitval >> 1) & 7;
-                B = (dcb << 6) | dcb;
-            } break;
-
-            case 5: {
-                C = 11;
-                // B = edcb000ed
-                u32 edcb = (bitval >> 1) & 0xF;
-                B = (edcb << 5) | (edcb >> 2);
-            } break;
-
-            case 6: {
-                C = 5;
-                // B = fedcb000f
-                u32 fedcb = (bitval >> 1) & 0x1F;
-                B = (fedcb << 4) | (fedcb >> 4);
-            } break;
-
-            default:
-                assert(false && "Unsupported trit encoding for color values!");
-                break;
-            } // switch(bitlen)
-        }     // case IntegerEncoding::Trit
-        break;
-
-        case IntegerEncoding::Quint: {
-
-            D = val.quint_value;
-
-            switch (bitlen) {
-            case 1: {
-                C = 113;
-            } break;
-
-            case 2: {
-                C = 54;
-                // B = b0000bb00
-                u32 b = (bitval >> 1) & 1;
-                B = (b << 8) | (b << 3) | (b << 2);
-            } break;
-
-            case 3: {
-                C = 26;
-                // B = cb0000cbc
-                u32 cb = (bitval >> 1) & 3;
-                B = (cb << 7) | (cb << 1) | (cb >> 1);
-            } break;
-
-            case 4: {
-                C = 13;
-                // B = dcb0000dc
-                u32 dcb = (bitval >> 1) & 7;
-                B = (dcb << 6) | (dcb >> 1);
-            } break;
-
-            case 5: {
-                C = 6;
-                // B = edcb0000e
-                u32 edcb = (bitval >> 1) & 0xF;
-                B = (edcb << 5) | (edcb >> 3);
-            } break;
-
-            default:
-                assert(false && "Unsupported quint encoding for color values!");
-                break;
-            } // switch(bitlen)
-        }     // case IntegerEncoding::Quint
-        break;
-        } // switch(val.encoding)
-
-        if (val.encoding != IntegerEncoding::JustBits) {
-            u32 T = D * C + B;
-            T ^= A;
-            T = (A & 0x80) | (T >> 2);
-            out[outIdx++] = T;
-        }
+        out[outIdx++] = UnquantizeColorValue(*itr);
     }
 
     // Make sure that each of our values is in the proper range...
@@ -1651,43 +1667,783 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
-void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
+// The batched decoder below produces the exact same texels as DecompressBlock, but avoids the
+// bit-by-bit stream reads, evaluates the unquantization through lookup tables and runs weight
+// infill and endpoint interpolation through SIMD kernels. Blocks it doesn't handle (malformed
+// blocks, HDR endpoints) are forwarded to DecompressBlock.
+namespace {
+
+constexpr u32 MAX_BLOCK_TEXELS = 12 * 12;
+
+// Spec limit for the number of weights in a block, larger weight grids are errors
+constexpr u32 MAX_WEIGHTS = 64;
+
+// Unquantized weight slot that always reads as zero, used for infill taps outside of the grid
+constexpr u8 ZERO_WEIGHT_INDEX = MAX_BLOCK_TEXELS;
+
+struct Block128 {
+    u64 lo;
+    u64 hi;
+};
+
+/// Reads up to 32 bits from the block, bits past the end read as zero like InputBitStream does
+constexpr u32 ExtractBits(const Block128& block, u32 start, u32 count) {
+    if (count == 0 || start >= 128) {
+        return 0;
+    }
+    u64 value;
+    if (start >= 64) {
+        value = block.hi >> (start - 64);
+    } else if (start == 0) {
+        value = block.lo;
+    } else {
+        value = (block.lo >> start) | (block.hi << (64 - start));
+    }
+    return static_cast<u32>(value & ((u64{1} << count) - 1));
+}
+
+/// Returns the bit range [start, start + count) of the block moved down to bit zero
+constexpr Block128 ExtractRange(const Block128& block, u32 start, u32 count) {
+    Block128 result{};
+    if (start == 0) {
+        result = block;
+    } else if (start < 64) {
+        result.lo = (block.lo >> start) | (block.hi << (64 - start));
+        result.hi = block.hi >> start;
+    } else if (start < 128) {
+        result.lo = block.hi >> (start - 64);
+    }
+    if (count < 64) {
+        result.lo &= (u64{1} << count) - 1;
+        result.hi = 0;
+    } else if (count < 128) {
+        result.hi &= (u64{1} << (count - 64)) - 1;
+    }
+    return result;
+}
+
+u64 ReverseBits(u64 value) {
+    value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+    value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return Common::swap64(value);
+}
+
+constexpr bool IsLDREndpointMode(u32 mode) {
+    switch (mode) {
+    case 0:
+    case 1:
+    case 4:
+    case 5:
+    case 6:
+    case 8:
+    case 9:
+    case 10:
+    case 12:
+    case 13:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct BlockMode {
+    bool valid = false;
+    bool dual_plane = false;
+    u8 grid_width = 0;
+    u8 grid_height = 0;
+    u8 max_weight = 0;
+    u16 num_weights = 0;
+    u16 weight_bits = 0;
+};
+
+struct DecoderTables {
+    /// Weight grid layout of every possible 11-bit block mode
+    std::array<BlockMode, 2048> block_modes;
+    /// Trits and quints packed in a trit/quint block, indexed by the raw T/Q bits
+    std::array<std::array<u8, 5>, 256> trits;
+    std::array<std::array<u8, 3>, 128> quints;
+    /// Unquantized values indexed by range and (trit/quint << num_bits) | bits
+    std::array<std::array<u8, 256>, 256> color_values;
+    std::array<std::array<u8, 256>, 32> weight_values;
+    /// Color value range indexed by the number of color values / 2 and color bits
+    std::array<std::array<u8, 129>, 17> color_ranges;
+};
+
+const DecoderTables& GetDecoderTables() {
+    static const std::unique_ptr<DecoderTables> tables = [] {
+        auto result = std::make_unique<DecoderTables>();
+        for (u32 mode = 0; mode < 2048; ++mode) {
+            if ((mode & 0x1FF) == 0x1FC) {
+                // Void extent blocks are handled separately
+                continue;
+            }
+            const std::array<u8, 2> mode_bytes{static_cast<u8>(mode), static_cast<u8>(mode >> 8)};
+            InputBitStream strm(mode_bytes);
+            const TexelWeightParams params = DecodeBlockInfo(strm);
+            if (params.m_bError) {
+                continue;
+            }
+            BlockMode& entry = result->block_modes[mode];
+            entry.valid = true;
+            entry.dual_plane = params.m_bDualPlane;
+            entry.grid_width = static_cast<u8>(params.m_Width);
+            entry.grid_height = static_cast<u8>(params.m_Height);
+            entry.max_weight = static_cast<u8>(params.m_MaxWeight);
+            entry.num_weights = static_cast<u16>(params.GetNumWeightValues());
+            entry.weight_bits = static_cast<u16>(params.GetPackedBitSize());
+        }
+        // Trit and quint blocks without any plain bits are just the packed T/Q bits
+        for (u32 packed = 0; packed < 256; ++packed) {
+            const std::array<u8, 1> packed_byte{static_cast<u8>(packed)};
+            IntegerEncodedVector values;
+            InputBitStream strm(packed_byte);
+            DecodeTritBlock(strm, values, 0);
+            for (u32 i = 0; i < 5; ++i) {
+                result->trits[packed][i] = static_cast<u8>(values[i].trit_value);
+            }
+        }
+        for (u32 packed = 0; packed < 128; ++packed) {
+            const std::array<u8, 1> packed_byte{static_cast<u8>(packed)};
+            IntegerEncodedVector values;
+            InputBitStream strm(packed_byte);
+            DecodeQuintBlock(strm, values, 0);
+            for (u32 i = 0; i < 3; ++i) {
+                result->quints[packed][i] = static_cast<u8>(values[i].quint_value);
+            }
+        }
+        const auto for_each_value = [](u32 range, auto&& func) {
+            IntegerEncodedValue val = ASTC_ENCODINGS_VALUES[range];
+            const u32 num_digits = val.encoding == IntegerEncoding::Trit    ? 3
+                                   : val.encoding == IntegerEncoding::Quint ? 5
+                                                                            : 1;
+            for (u32 digit = 0; digit < num_digits; ++digit) {
+                for (u32 bits = 0; bits < (1U << val.num_bits); ++bits) {
+                    val.bit_value = bits;
+                    val.quint_value = digit;
+                    func((digit << val.num_bits) | bits, val);
+                }
+            }
+        };
+        for (u32 range = 0; range < 256; ++range) {
+            if (ASTC_ENCODINGS_VALUES[range].num_bits == 0) {
+                // Unusable for color values, these blocks take the fallback path
+                continue;
+            }
+            for_each_value(range, [&](u32 index, const IntegerEncodedValue& val) {
+                result->color_values[range][index] = static_cast<u8>(UnquantizeColorValue(val));
+            });
+        }
+        for (u32 range = 1; range < 32; ++range) {
+            for_each_value(range, [&](u32 index, const IntegerEncodedValue& val) {
+                result->weight_values[range][index] = static_cast<u8>(UnquantizeTexelWeight(val));
+            });
+        }
+        for (u32 num_values = 2; num_values <= 32; num_values += 2) {
+            for (u32 bits = 0; bits <= 128; ++bits) {
+                result->color_ranges[num_values / 2][bits] =
+                    static_cast<u8>(FindColorValueRange(num_values, bits));
+            }
+        }
+        return result;
+    }();
+    return *tables;
+}
+
+/// Decodes a bounded integer sequence straight from a bit block. Each output value is
+/// (trit/quint << num_bits) | bits, which indexes the unquantization tables. The output is
+/// written in whole trit/quint blocks, so it needs room for up to four extra values.
+void DecodeIntegerSequenceFast(const DecoderTables& tables, u8* out, const Block128& bits,
+                               u32 range, u32 count) {
+    const IntegerEncodedValue val = ASTC_ENCODINGS_VALUES[range];
+    const u32 n = val.num_bits;
+    u32 pos = 0;
+    switch (val.encoding) {
+    case IntegerEncoding::JustBits:
+        for (u32 i = 0; i < count; ++i, pos += n) {
+            out[i] = static_cast<u8>(ExtractBits(bits, pos, n));
+        }
+        break;
+    case IntegerEncoding::Trit:
+        for (u32 i = 0; i < count; i += 5) {
+            std::array<u32, 5> m;
+            u32 t;
+            m[0] = ExtractBits(bits, pos, n);
+            t = ExtractBits(bits, pos + n, 2);
+            m[1] = ExtractBits(bits, pos + n + 2, n);
+            t |= ExtractBits(bits, pos + 2 * n + 2, 2) << 2;
+            m[2] = ExtractBits(bits, pos + 2 * n + 4, n);
+            t |= ExtractBits(bits, pos + 3 * n + 4, 1) << 4;
+            m[3] = ExtractBits(bits, pos + 3 * n + 5, n);
+            t |= ExtractBits(bits, pos + 4 * n + 5, 2) << 5;
+            m[4] = ExtractBits(bits, pos + 4 * n + 7, n);
+            t |= ExtractBits(bits, pos + 5 * n + 7, 1) << 7;
+            pos += 5 * n + 8;
+            const std::array<u8, 5>& trits = tables.trits[t];
+            for (u32 j = 0; j < 5; ++j) {
+                out[i + j] = static_cast<u8>((trits[j] << n) | m[j]);
+            }
+        }
+        break;
+    case IntegerEncoding::Quint:
+        for (u32 i = 0; i < count; i += 3) {
+            std::array<u32, 3> m;
+            u32 q;
+            m[0] = ExtractBits(bits, pos, n);
+            q = ExtractBits(bits, pos + n, 3);
+            m[1] = ExtractBits(bits, pos + n + 3, n);
+            q |= ExtractBits(bits, pos + 2 * n + 3, 2) << 3;
+            m[2] = ExtractBits(bits, pos + 2 * n + 5, n);
+            q |= ExtractBits(bits, pos + 3 * n + 5, 2) << 5;
+            pos += 3 * n + 7;
+            const std::array<u8, 3>& quints = tables.quints[q];
+            for (u32 j = 0; j < 3; ++j) {
+                out[i + j] = static_cast<u8>((quints[j] << n) | m[j]);
+            }
+        }
+        break;
+    }
+}
+
+/// Bilinear infill taps from a weight grid to the texels of a block (Section C.2.18)
+struct InfillTable {
+    alignas(16) std::array<std::array<u8, MAX_BLOCK_TEXELS>, 4> index;
+    alignas(16) std::array<std::array<u8, MAX_BLOCK_TEXELS>, 4> weight;
+};
+
+class InfillCache {
+public:
+    const InfillTable& Get(u32 block_width, u32 block_height, u32 grid_width, u32 grid_height) {
+        if (block_width != cached_block_width || block_height != cached_block_height) {
+            tables = {};
+            cached_block_width = block_width;
+            cached_block_height = block_height;
+        }
+        std::unique_ptr<InfillTable>& table = tables[grid_height * 13 + grid_width];
+        if (!table) {
+            table = Build(block_width, block_height, grid_width, grid_height);
+        }
+        return *table;
+    }
+
+private:
+    static std::unique_ptr<InfillTable> Build(u32 block_width, u32 block_height, u32 grid_width,
+                                              u32 grid_height) {
+        auto table = std::make_unique<InfillTable>();
+        for (auto& index : table->index) {
+            index.fill(ZERO_WEIGHT_INDEX);
+        }
+        for (auto& weight : table->weight) {
+            weight.fill(0);
+        }
+        const u32 Ds = (1024 + (block_width / 2)) / (block_width - 1);
+        const u32 Dt = (1024 + (block_height / 2)) / (block_height - 1);
+        const u32 grid_size = grid_width * grid_height;
+        for (u32 t = 0; t < block_height; t++) {
+            for (u32 s = 0; s < block_width; s++) {
+                const u32 gs = (Ds * s * (grid_width - 1) + 32) >> 6;
+                const u32 gt = (Dt * t * (grid_height - 1) + 32) >> 6;
+                const u32 js = gs >> 4;
+                const u32 fs = gs & 0xF;
+                const u32 jt = gt >> 4;
+                const u32 ft = gt & 0xF;
+
+                const u32 w11 = (fs * ft + 8) >> 4;
+                const std::array<u32, 4> weights{16 - fs - ft + w11, fs - w11, ft - w11, w11};
+
+                const u32 v0 = js + jt * grid_width;
+                const std::array<u32, 4> taps{v0, v0 + 1, v0 + grid_width, v0 + grid_width + 1};
+
+                const u32 texel = t * block_width + s;
+                for (u32 i = 0; i < 4; ++i) {
+                    table->index[i][texel] =
+                        static_cast<u8>(taps[i] < grid_size ? taps[i] : ZERO_WEIGHT_INDEX);
+                    table->weight[i][texel] = static_cast<u8>(weights[i]);
+                }
+            }
+        }
+        return table;
+    }
+
+    u32 cached_block_width = 0;
+    u32 cached_block_height = 0;
+    std::array<std::unique_ptr<InfillTable>, 13 * 13> tables;
+};
+
+/// Unquantized weights of one plane, with the zero slot at ZERO_WEIGHT_INDEX
+using GridWeights = std::array<u32, MAX_BLOCK_TEXELS + 1>;
+
+/// Infilled weights of one plane, padded so kernels can always process whole vectors
+using TexelWeights = std::array<u32, MAX_BLOCK_TEXELS>;
+
+struct BlockEndpoints {
+    /// Endpoints replicated to 16 bits, in RGBA order
+    alignas(16) std::array<std::array<u32, 4>, 4> low;
+    alignas(16) std::array<std::array<u32, 4>, 4> high;
+};
+
+/// Parameters of the clipped texel region a block writes to
+struct BlockOutput {
+    u8* data;
+    u32 pitch;
+    u32 width;
+    u32 height;
+};
+
+struct DecodeKernels {
+    void (*infill)(const InfillTable& table, const GridWeights& grid, u32 num_texels,
+                   TexelWeights& out);
+    void (*interpolate)(const BlockEndpoints& endpoints, const u8* partitions,
+                        const TexelWeights& weights, const TexelWeights* plane_weights,
+                        u32 plane_channel, u32 block_width, const BlockOutput& output);
+};
+
+u32 InfillTexel(const InfillTable& table, const GridWeights& grid, u32 texel) {
+    u32 sum = 8;
+    for (u32 i = 0; i < 4; ++i) {
+        sum += grid[table.index[i][texel]] * table.weight[i][texel];
+    }
+    return sum >> 4;
+}
+
+// Evaluates the same expression as DecompressBlock, the float conversion there is exact
+// and equals (255 * C + 32768) >> 16 for every C, including the special cased 65535.
+constexpr u32 InterpolateChannel(u32 low, u32 high, u32 weight) {
+    const u32 value = (low * (64 - weight) + high * weight + 32) >> 6;
+    return (value * 255 + 32768) >> 16;
+}
+
+void InfillGeneric(const InfillTable& table, const GridWeights& grid, u32 num_texels,
+                   TexelWeights& out) {
+    for (u32 texel = 0; texel < num_texels; ++texel) {
+        out[texel] = InfillTexel(table, grid, texel);
+    }
+}
+
+void InterpolateGeneric(const BlockEndpoints& endpoints, const u8* partitions,
+                        const TexelWeights& weights, const TexelWeights* plane_weights,
+                        u32 plane_channel, u32 block_width, const BlockOutput& output) {
+    for (u32 y = 0; y < output.height; ++y) {
+        u8* const row = output.data + y * output.pitch;
+        for (u32 x = 0; x < output.width; ++x) {
+            const u32 texel = y * block_width + x;
+            const u32 partition = partitions ? partitions[texel] : 0;
+            for (u32 c = 0; c < 4; ++c) {
+                const u32 weight =
+                    plane_weights && c == plane_channel ? (*plane_weights)[texel] : weights[texel];
+                row[x * 4 + c] = static_cast<u8>(InterpolateChannel(
+                    endpoints.low[partition][c], endpoints.high[partition][c], weight));
+            }
+        }
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+CITRON_TARGET_SSE41 __m128i InterpolateTexelSSE41(__m128i low, __m128i high, __m128i weight) {
+    const __m128i inv_weight = _mm_sub_epi32(_mm_set1_epi32(64), weight);
+    __m128i value = _mm_add_epi32(_mm_mullo_epi32(low, inv_weight), _mm_mullo_epi32(high, weight));
+    value = _mm_srli_epi32(_mm_add_epi32(value, _mm_set1_epi32(32)), 6);
+    value = _mm_sub_epi32(_mm_slli_epi32(value, 8), value);
+    return _mm_srli_epi32(_mm_add_epi32(value, _mm_set1_epi32(32768)), 16);
+}
+
+CITRON_TARGET_SSE41 void InfillSSE41(const InfillTable& table, const GridWeights& grid,
+                                     u32 num_texels, TexelWeights& out) {
+    for (u32 texel = 0; texel < num_texels; texel += 4) {
+        __m128i sum = _mm_set1_epi32(8);
+        for (u32 i = 0; i < 4; ++i) {
+            const u8* const index = &table.index[i][texel];
+            const __m128i values =
+                _mm_setr_epi32(static_cast<int>(grid[index[0]]), static_cast<int>(grid[index[1]]),
+                               static_cast<int>(grid[index[2]]), static_cast<int>(grid[index[3]]));
+            u32 packed_weights;
+            std::memcpy(&packed_weights, &table.weight[i][texel], sizeof(packed_weights));
+            const __m128i weights = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed_weights));
+            sum = _mm_add_epi32(sum, _mm_mullo_epi32(values, weights));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[texel]), _mm_srli_epi32(sum, 4));
+    }
+}
+
+CITRON_TARGET_SSE41 void InterpolateSSE41(const BlockEndpoints& endpoints, const u8* partitions,
+                                          const TexelWeights& weights,
+                                          const TexelWeights* plane_weights, u32 plane_channel,
+                                          u32 block_width, const BlockOutput& output) {
+    const __m128i plane_mask = _mm_cmpeq_epi32(_mm_setr_epi32(0, 1, 2, 3),
+                                               _mm_set1_epi32(static_cast<int>(plane_channel)));
+    for (u32 y = 0; y < output.height; ++y) {
+        u8* const row = output.data + y * output.pitch;
+        for (u32 x = 0; x < output.width; ++x) {
+            const u32 texel = y * block_width + x;
+            const u32 partition = partitions ? partitions[texel] : 0;
+            const __m128i low =
+                _mm_load_si128(reinterpret_cast<const __m128i*>(endpoints.low[partition].data()));
+            const __m128i high =
+                _mm_load_si128(reinterpret_cast<const __m128i*>(endpoints.high[partition].data()));
+            __m128i weight = _mm_set1_epi32(static_cast<int>(weights[texel]));
+            if (plane_weights) {
+                const __m128i plane_weight =
+                    _mm_set1_epi32(static_cast<int>((*plane_weights)[texel]));
+                weight = _mm_blendv_epi8(weight, plane_weight, plane_mask);
+            }
+            const __m128i value = InterpolateTexelSSE41(low, high, weight);
+            const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(value, value), value);
+            const u32 rgba = static_cast<u32>(_mm_cvtsi128_si32(packed));
+            std::memcpy(row + x * 4, &rgba, sizeof(rgba));
+        }
+    }
+}
+
+CITRON_TARGET_AVX2 void InfillAVX2(const InfillTable& table, const GridWeights& grid,
+                                   u32 num_texels, TexelWeights& out) {
+    const int* const base = reinterpret_cast<const int*>(grid.data());
+    for (u32 texel = 0; texel < num_texels; texel += 8) {
+        __m256i sum = _mm256_set1_epi32(8);
+        for (u32 i = 0; i < 4; ++i) {
+            const __m256i index = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&table.index[i][texel])));
+            const __m256i weights = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&table.weight[i][texel])));
+            const __m256i values = _mm256_i32gather_epi32(base, index, 4);
+            sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(values, weights));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[texel]), _mm256_srli_epi32(sum, 4));
+    }
+}
+
+CITRON_TARGET_AVX2 __m256i LoadEndpointPairAVX2(const std::array<std::array<u32, 4>, 4>& table,
+                                                 u32 first, u32 second) {
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(table[first].data()));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(table[second].data()));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+CITRON_TARGET_AVX2 __m256i LoadWeightPairAVX2(const TexelWeights& weights, u32 first, u32 second) {
+    return _mm256_setr_m128i(_mm_set1_epi32(static_cast<int>(weights[first])),
+                             _mm_set1_epi32(static_cast<int>(weights[second])));
+}
+
+CITRON_TARGET_AVX2 void InterpolateAVX2(const BlockEndpoints& endpoints, const u8* partitions,
+                                        const TexelWeights& weights,
+                                        const TexelWeights* plane_weights, u32 plane_channel,
+                                        u32 block_width, const BlockOutput& output) {
+    const __m256i plane_mask =
+        _mm256_cmpeq_epi32(_mm256_setr_epi32(0, 1, 2, 3, 0, 1, 2, 3),
+                           _mm256_set1_epi32(static_cast<int>(plane_channel)));
+    for (u32 y = 0; y < output.height; ++y) {
+        u8* const row = output.data + y * output.pitch;
+        // Two texels per iteration, the partition and weights of each fill one 128-bit lane
+        for (u32 x = 0; x < output.width; x += 2) {
+            const u32 texel = y * block_width + x;
+            const u32 next = x + 1 < output.width ? texel + 1 : texel;
+            const u32 first = partitions ? partitions[texel] : 0;
+            const u32 second = partitions ? partitions[next] : 0;
+            const __m256i low = LoadEndpointPairAVX2(endpoints.low, first, second);
+            const __m256i high = LoadEndpointPairAVX2(endpoints.high, first, second);
+            __m256i weight = LoadWeightPairAVX2(weights, texel, next);
+            if (plane_weights) {
+                weight = _mm256_blendv_epi8(weight, LoadWeightPairAVX2(*plane_weights, texel, next),
+                                            plane_mask);
+            }
+            const __m256i inv_weight = _mm256_sub_epi32(_mm256_set1_epi32(64), weight);
+            __m256i value = _mm256_add_epi32(_mm256_mullo_epi32(low, inv_weight),
+                                             _mm256_mullo_epi32(high, weight));
+            value = _mm256_srli_epi32(_mm256_add_epi32(value, _mm256_set1_epi32(32)), 6);
+            value = _mm256_sub_epi32(_mm256_slli_epi32(value, 8), value);
+            value = _mm256_srli_epi32(_mm256_add_epi32(value, _mm256_set1_epi32(32768)), 16);
+            const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(value, value), value);
+            const u32 rgba0 = static_cast<u32>(_mm256_extract_epi32(packed, 0));
+            std::memcpy(row + x * 4, &rgba0, sizeof(rgba0));
+            if (x + 1 < output.width) {
+                const u32 rgba1 = static_cast<u32>(_mm256_extract_epi32(packed, 4));
+                std::memcpy(row + x * 4 + 4, &rgba1, sizeof(rgba1));
+            }
+        }
+    }
+}
+#endif
+
+#ifdef ARCHITECTURE_arm64
+void InfillNEON(const InfillTable& table, const GridWeights& grid, u32 num_texels,
+                TexelWeights& out) {
+    for (u32 texel = 0; texel < num_texels; texel += 4) {
+        uint32x4_t sum = vdupq_n_u32(8);
+        for (u32 i = 0; i < 4; ++i) {
+            const u8* const index = &table.index[i][texel];
+            const u8* const weight = &table.weight[i][texel];
+            const std::array<u32, 4> values{grid[index[0]], grid[index[1]], grid[index[2]],
+                                            grid[index[3]]};
+            const std::array<u32, 4> weights{weight[0], weight[1], weight[2], weight[3]};
+            sum = vmlaq_u32(sum, vld1q_u32(values.data()), vld1q_u32(weights.data()));
+        }
+        vst1q_u32(&out[texel], vshrq_n_u32(sum, 4));
+    }
+}
+
+void InterpolateNEON(const BlockEndpoints& endpoints, const u8* partitions,
+                     const TexelWeights& weights, const TexelWeights* plane_weights,
+                     u32 plane_channel, u32 block_width, const BlockOutput& output) {
+    static constexpr std::array<u32, 4> CHANNELS{0, 1, 2, 3};
+    const uint32x4_t plane_mask = vceqq_u32(vld1q_u32(CHANNELS.data()), vdupq_n_u32(plane_channel));
+    for (u32 y = 0; y < output.height; ++y) {
+        u8* const row = output.data + y * output.pitch;
+        for (u32 x = 0; x < output.width; ++x) {
+            const u32 texel = y * block_width + x;
+            const u32 partition = partitions ? partitions[texel] : 0;
+            const uint32x4_t low = vld1q_u32(endpoints.low[partition].data());
+            const uint32x4_t high = vld1q_u32(endpoints.high[partition].data());
+            uint32x4_t weight = vdupq_n_u32(weights[texel]);
+            if (plane_weights) {
+                weight = vbslq_u32(plane_mask, vdupq_n_u32((*plane_weights)[texel]), weight);
+            }
+            const uint32x4_t inv_weight = vsubq_u32(vdupq_n_u32(64), weight);
+            uint32x4_t value = vmlaq_u32(vmulq_u32(low, inv_weight), high, weight);
+            value = vshrq_n_u32(vaddq_u32(value, vdupq_n_u32(32)), 6);
+            value = vshrq_n_u32(vmlaq_n_u32(vdupq_n_u32(32768), value, 255), 16);
+            const uint16x4_t narrow = vmovn_u32(value);
+            const uint8x8_t bytes = vmovn_u16(vcombine_u16(narrow, narrow));
+            const u32 rgba = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+            std::memcpy(row + x * 4, &rgba, sizeof(rgba));
+        }
+    }
+}
+#endif
+
+const DecodeKernels& GetDecodeKernels() {
+    static const DecodeKernels kernels = [] {
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.avx2) {
+            return DecodeKernels{InfillAVX2, InterpolateAVX2};
+        }
+        if (caps.sse4_1) {
+            return DecodeKernels{InfillSSE41, InterpolateSSE41};
+        }
+#elif defined(ARCHITECTURE_arm64)
+        return DecodeKernels{InfillNEON, InterpolateNEON};
+#endif
+        return DecodeKernels{InfillGeneric, InterpolateGeneric};
+    }();
+    return kernels;
+}
+
+void FillTexels(const BlockOutput& output, u32 rgba) {
+    for (u32 y = 0; y < output.height; ++y) {
+        u8* const row = output.data + y * output.pitch;
+        for (u32 x = 0; x < output.width; ++x) {
+            std::memcpy(row + x * 4, &rgba, sizeof(rgba));
+        }
+    }
+}
+
+/// Decodes a block directly into the output, returns false when the block has to be decoded by
+/// DecompressBlock instead.
+bool DecompressBlockFast(const DecoderTables& tables, const DecodeKernels& kernels,
+                         InfillCache& infill_cache, const Block128& block, u32 block_width,
+                         u32 block_height, const BlockOutput& output) {
+    const u32 mode_bits = ExtractBits(block, 0, 11);
+    if ((mode_bits & 0x1FF) == 0x1FC) {
+        if ((mode_bits & 0x600) != 0x400 || ExtractBits(block, 11, 1) == 0) {
+            // HDR void extent or reserved bits
+            return false;
+        }
+        const u32 r = ExtractBits(block, 64, 16);
+        const u32 g = ExtractBits(block, 80, 16);
+        const u32 b = ExtractBits(block, 96, 16);
+        const u32 a = ExtractBits(block, 112, 16);
+        FillTexels(output, (r >> 8) | (g & 0xFF00) | (b & 0xFF00) << 8 | (a & 0xFF00) << 16);
+        return true;
+    }
+    const BlockMode& mode = tables.block_modes[mode_bits];
+    if (!mode.valid || mode.grid_width > block_width || mode.grid_height > block_height ||
+        mode.num_weights > MAX_WEIGHTS) {
+        return false;
+    }
+    const u32 num_partitions = ExtractBits(block, 11, 2) + 1;
+    if (num_partitions == 4 && mode.dual_plane) {
+        return false;
+    }
+
+    std::array<u32, 4> cem{};
+    u32 partition_index = 0;
+    u32 base_cem = 0;
+    u32 header_bits = 0;
+    if (num_partitions == 1) {
+        cem[0] = ExtractBits(block, 13, 4);
+        header_bits = 17;
+    } else {
+        partition_index = ExtractBits(block, 13, 10);
+        base_cem = ExtractBits(block, 23, 6);
+        header_bits = 29;
+    }
+    const u32 base_mode = base_cem & 3;
+    const u32 extra_cem_bits = base_mode == 0 ? 0 : num_partitions * 3 - 4;
+    const u32 plane_selector_bits = mode.dual_plane ? 2 : 0;
+    const s32 color_bits = 128 - static_cast<s32>(mode.weight_bits) -
+                           static_cast<s32>(header_bits + extra_cem_bits + plane_selector_bits);
+    if (color_bits <= 0) {
+        return false;
+    }
+    const u32 trailer = header_bits + static_cast<u32>(color_bits);
+    const u32 plane_index = ExtractBits(block, trailer, plane_selector_bits);
+    if (base_mode != 0) {
+        u32 cem_bits = ((ExtractBits(block, trailer + plane_selector_bits, extra_cem_bits) << 6) |
+                        base_cem) >>
+                       2;
+        const u32 c_bits = cem_bits;
+        cem_bits >>= num_partitions;
+        for (u32 i = 0; i < num_partitions; ++i) {
+            cem[i] = (base_mode - ((c_bits >> i) & 1 ? 0 : 1)) << 2 | ((cem_bits >> (2 * i)) & 3);
+        }
+    } else if (num_partitions > 1) {
+        cem.fill(base_cem >> 2);
+    }
+    u32 num_values = 0;
+    for (u32 i = 0; i < num_partitions; ++i) {
+        if (!IsLDREndpointMode(cem[i])) {
+            return false;
+        }
+        num_values += ((cem[i] >> 2) + 1) << 1;
+    }
+    const u32 color_range = tables.color_ranges[num_values / 2][color_bits];
+    if (ASTC_ENCODINGS_VALUES[color_range].num_bits == 0) {
+        return false;
+    }
+
+    std::array<u8, 32 + 4> color_indices;
+    DecodeIntegerSequenceFast(tables, color_indices.data(),
+                              ExtractRange(block, header_bits, static_cast<u32>(color_bits)),
+                              color_range, num_values);
+    std::array<u32, 32> color_values;
+    for (u32 i = 0; i < num_values; ++i) {
+        color_values[i] = tables.color_values[color_range][color_indices[i]];
+    }
+
+    BlockEndpoints endpoints;
+    const u32* color_values_ptr = color_values.data();
+    for (u32 i = 0; i < num_partitions; ++i) {
+        Pixel low;
+        Pixel high;
+        ComputeEndpoints(low, high, color_values_ptr, cem[i]);
+        for (u32 c = 0; c < 4; ++c) {
+            // Pixel stores ARGB, the output is RGBA
+            const u32 component = (c + 1) & 3;
+            endpoints.low[i][c] = ReplicateByteTo16(static_cast<u32>(low.Component(component)));
+            endpoints.high[i][c] = ReplicateByteTo16(static_cast<u32>(high.Component(component)));
+        }
+    }
+
+    const Block128 reversed{ReverseBits(block.hi), ReverseBits(block.lo)};
+    std::array<u8, MAX_WEIGHTS + 4> weight_indices;
+    DecodeIntegerSequenceFast(tables, weight_indices.data(),
+                              ExtractRange(reversed, 0, mode.weight_bits), mode.max_weight,
+                              mode.num_weights);
+
+    const u32 grid_size = mode.grid_width * mode.grid_height;
+    const u32 num_planes = mode.dual_plane ? 2 : 1;
+    const std::array<u8, 256>& weight_table = tables.weight_values[mode.max_weight];
+    std::array<GridWeights, 2> grid_weights;
+    for (u32 plane = 0; plane < num_planes; ++plane) {
+        for (u32 i = 0; i < grid_size; ++i) {
+            grid_weights[plane][i] = weight_table[weight_indices[i * num_planes + plane]];
+        }
+        grid_weights[plane][ZERO_WEIGHT_INDEX] = 0;
+    }
+
+    const u32 num_texels = block_width * block_height;
+    const InfillTable& infill =
+        infill_cache.Get(block_width, block_height, mode.grid_width, mode.grid_height);
+    alignas(32) std::array<TexelWeights, 2> weights;
+    for (u32 plane = 0; plane < num_planes; ++plane) {
+        kernels.infill(infill, grid_weights[plane], num_texels, weights[plane]);
+    }
+
+    std::array<u8, MAX_BLOCK_TEXELS> partitions;
+    if (num_partitions > 1) {
+        const s32 small_block = num_texels < 32;
+        for (u32 y = 0; y < output.height; ++y) {
+            for (u32 x = 0; x < output.width; ++x) {
+                partitions[y * block_width + x] = static_cast<u8>(Select2DPartition(
+                    static_cast<s32>(partition_index), static_cast<s32>(x), static_cast<s32>(y),
+                    static_cast<s32>(num_partitions), small_block));
+            }
+        }
+    }
+
+    // The dual plane channel in ARGB order is (plane_index + 1) & 3, which is plane_index in RGBA
+    kernels.interpolate(endpoints, num_partitions > 1 ? partitions.data() : nullptr, weights[0],
+                        mode.dual_plane ? &weights[1] : nullptr, plane_index, block_width,
+                        output);
+    return true;
+}
+
+} // Anonymous namespace
+
+void DecompressBlockRow(std::span<const u8> blocks, u32 width, u32 height, u32 block_width,
+                        u32 block_height, std::span<u8> output, u32 pitch) {
+    const DecoderTables& tables = GetDecoderTables();
+    const DecodeKernels& kernels = GetDecodeKernels();
+    thread_local InfillCache infill_cache;
+
+    const u32 num_blocks = Common::DivideUp(width, block_width);
+    for (u32 block_index = 0; block_index < num_blocks; ++block_index) {
+        const u32 x = block_index * block_width;
+        const std::span<const u8, 16> block_data{blocks.subspan(block_index * 16, 16)};
+        const BlockOutput block_output{
+            .data = output.data() + x * 4,
+            .pitch = pitch,
+            .width = std::min(block_width, width - x),
+            .height = std::min(block_height, height),
+        };
+        Block128 block;
+        std::memcpy(&block.lo, block_data.data(), sizeof(block.lo));
+        std::memcpy(&block.hi, block_data.data() + sizeof(block.lo), sizeof(block.hi));
+        if (DecompressBlockFast(tables, kernels, infill_cache, block, block_width, block_height,
+                                block_output)) {
+            continue;
+        }
+        std::array<u32, MAX_BLOCK_TEXELS> texels;
+        DecompressBlock(block_data, block_width, block_height, texels);
+        for (u32 y = 0; y < block_output.height; ++y) {
+            std::memcpy(block_output.data + y * pitch, texels.data() + y * block_width,
+                        block_output.width * 4);
+        }
+    }
+}
+
+void DecompressBlockReference(std::span<const u8, 16> block, u32 block_width, u32 block_height,
+                              std::span<u32, 12 * 12> output) {
+    DecompressBlock(block, block_width, block_height, output);
+}
+
+void QueueDecompress(DecodeBatch& batch, DecodePriority priority, std::span<const u8> data,
+                     u32 width, u32 height, u32 depth, u32 block_width, u32 block_height,
+                     std::span<u8> output) {
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
 
-    Common::ThreadWorker& workers{GetThreadWorkers()};
-
     for (u32 z = 0; z < depth; ++z) {
         const u32 depth_offset = z * height * width * 4;
         for (u32 y_index = 0; y_index < rows; ++y_index) {
             auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
                                       cols, z, depth_offset, y_index] {
                 const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
-
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                    u32 decompWidth = std::min(block_width, width - x);
-                    u32 decompHeight = std::min(block_height, height - y);
-
-                    const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                    for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
-                    }
-                }
+                const u32 row_index = (z * rows * cols) + (y_index * cols);
+                DecompressBlockRow(data.subspan(row_index * 16, cols * 16), width, height - y,
+                                   block_width, block_height,
+                                   output.subspan(depth_offset + y * width * 4), width * 4);
             };
-            workers.QueueWork(std::move(decompress_stride));
+            batch.AddJob(priority, std::move(decompress_stride));
         }
-        workers.WaitForRequests();
     }
 }
 
+void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
+                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
+    DecodeBatch batch;
+    QueueDecompress(batch, DecodePriority::RenderTarget, data, width, height, depth, block_width,
+                    block_height, output);
+    batch.Submit().Wait();
+}
+
 } // namespace Tegra::Texture::ASTC
@@ -3,9 +3,41 @@
 
 #pragma once
 
+#include <span>
+
+#include "common/common_types.h"
+#include "video_core/textures/workers.h"
+
 namespace Tegra::Texture::ASTC {
 
+/// Decompresses an image into RGBA8 on the decode workers and waits for the result
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output);
 
+/**
+ * Adds the jobs decompressing an image into RGBA8 to a decode batch, one per row of blocks.
+ * Slices are not waited on, so several images and levels can share a batch. The input and output
+ * must stay alive until the batch completes.
+ */
+void QueueDecompress(DecodeBatch& batch, DecodePriority priority, std::span<const u8> data,
+                     u32 width, u32 height, u32 depth, u32 block_width, u32 block_height,
+                     std::span<u8> output);
+
+/**
+ * Decompresses a horizontal row of ASTC blocks straight into an RGBA8 image.
+ * @param blocks       Compressed blocks of the row, 16 bytes each
+ * @param width        Width in texels of the row, the last block is clipped to it
+ * @param height       Texel rows left in the image, blocks are clipped to it
+ * @param block_width  Width of the block footprint
+ * @param block_height Height of the block footprint
+ * @param output       Destination of the top left texel of the row
+ * @param pitch        Distance in bytes between two texel rows of the output
+ */
+void DecompressBlockRow(std::span<const u8> blocks, u32 width, u32 height, u32 block_width,
+                        u32 block_height, std::span<u8> output, u32 pitch);
+
+/// Decompresses a single block with the scalar reference decoder, used for validation
+void DecompressBlockReference(std::span<const u8, 16> block, u32 block_width, u32 block_height,
+                              std::span<u32, 12 * 12> output);
+
 } // namespace Tegra::Texture::ASTC
@@ -5,21 +5,19 @@
 #include <string.h>
 #include "common/alignment.h"
 #include "video_core/textures/bcn.h"
-#include "video_core/textures/workers.h"
 
 namespace Tegra::Texture::BCN {
 
 using BCNCompressor = void(u8* block_output, const u8* block_input, bool any_alpha);
 
 template <u32 BytesPerBlock, bool ThresholdAlpha = false>
-void CompressBCN(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output, BCNCompressor f) {
+void QueueCompressBCN(DecodeBatch& batch, DecodePriority priority, std::span<const uint8_t> data,
+                      uint32_t width, uint32_t height, uint32_t depth, std::span<uint8_t> output,
+                      BCNCompressor f) {
     constexpr u8 alpha_threshold = 128;
     constexpr u32 bytes_per_px = 4;
     const u32 plane_dim = width * height;
 
-    Common::ThreadWorker& workers{GetThreadWorkers()};
-
     for (u32 z = 0; z < depth; z++) {
         for (u32 y = 0; y < height; y += 4) {
             auto compress_row = [z, y, width, height, plane_dim, f, data, output]() {
@@ -60,27 +58,41 @@ void CompressBCN(std::span<const uint8_t> data, uint32_t width, uint32_t height,
                       reinterpret_cast<u8*>(input_colors), any_alpha);
                 }
             };
-            workers.QueueWork(std::move(compress_row));
+            batch.AddJob(priority, std::move(compress_row));
         }
-        workers.WaitForRequests();
     }
 }
 
+void QueueCompressBC1(DecodeBatch& batch, DecodePriority priority, std::span<const uint8_t> data,
+                      uint32_t width, uint32_t height, uint32_t depth, std::span<uint8_t> output) {
+    QueueCompressBCN<8, true>(batch, priority, data, width, height, depth, output,
+                              [](u8* block_output, const u8* block_input, bool any_alpha) {
+                                  stb_compress_bc1_block(block_output, block_input, any_alpha,
+                                                         STB_DXT_NORMAL);
+                              });
+}
+
+void QueueCompressBC3(DecodeBatch& batch, DecodePriority priority, std::span<const uint8_t> data,
+                      uint32_t width, uint32_t height, uint32_t depth, std::span<uint8_t> output) {
+    QueueCompressBCN<16, false>(batch, priority, data, width, height, depth, output,
+                                [](u8* block_output, const u8* block_input, bool any_alpha) {
+                                    stb_compress_bc3_block(block_output, block_input,
+                                                           STB_DXT_NORMAL);
+                                });
+}
+
 void CompressBC1(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                  std::span<uint8_t> output) {
-    CompressBCN<8, true>(data, width, height, depth, output,
-                         [](u8* block_output, const u8* block_input, bool any_alpha) {
-                             stb_compress_bc1_block(block_output, block_input, any_alpha,
-                                                    STB_DXT_NORMAL);
-                         });
+    DecodeBatch batch;
+    QueueCompressBC1(batch, DecodePriority::RenderTarget, data, width, height, depth, output);
+    batch.Submit().Wait();
 }
 
 void CompressBC3(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                  std::span<uint8_t> output) {
-    CompressBCN<16, false>(data, width, height, depth, output,
-                           [](u8* block_output, const u8* block_input, bool any_alpha) {
-                               stb_compress_bc3_block(block_output, block_input, STB_DXT_NORMAL);
-                           });
+    DecodeBatch batch;
+    QueueCompressBC3(batch, DecodePriority::RenderTarget, data, width, height, depth, output);
+    batch.Submit().Wait();
 }
 
 } // namespace Tegra::Texture::BCN
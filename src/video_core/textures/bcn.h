@@ -6,11 +6,25 @@
 #include <span>
 
 #include "common/common_types.h"
+#include "video_core/textures/workers.h"
 
 namespace Tegra::Texture::BCN {
 
+/// Compresses an RGBA8 image into BC1 on the decode workers and waits for the result
 void CompressBC1(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
 
+/// Compresses an RGBA8 image into BC3 on the decode workers and waits for the result
 void CompressBC3(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
 
+/**
+ * Adds the jobs compressing an RGBA8 image into BC1 to a decode batch, one per row of blocks.
+ * The input and output must stay alive until the batch completes.
+ */
+void QueueCompressBC1(DecodeBatch& batch, DecodePriority priority, std::span<const u8> data,
+                      u32 width, u32 height, u32 depth, std::span<u8> output);
+
+/// Same as QueueCompressBC1, compressing into BC3
+void QueueCompressBC3(DecodeBatch& batch, DecodePriority priority, std::span<const u8> data,
+                      u32 width, u32 height, u32 depth, std::span<u8> output);
+
 } // namespace Tegra::Texture::BCN
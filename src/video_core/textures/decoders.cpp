@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
@@ -13,6 +15,13 @@
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#include "common/x64/simd.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 namespace Tegra::Texture {
 namespace {
 template <u32 mask>
@@ -33,9 +42,199 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+#ifdef _MSC_VER
+#define SWIZZLE_INLINE __forceinline
+#else
+#define SWIZZLE_INLINE inline __attribute__((always_inline))
+#endif
+
+/// Offset of the 16 byte GOB line chunk holding byte x of a line, chunks are the largest unit that
+/// is contiguous in both the linear and the block linear layouts
+constexpr u32 ChunkOffset(u32 x, u32 x_shift) {
+    return ((x >> GOB_SIZE_X_SHIFT) << x_shift) + (((x >> 4) & 1) << 5 | ((x >> 5) & 1) << 8);
+}
+
+/// Moves GOB line chunks with 128-bit loads and stores
+struct ChunkMover {
+    static SWIZZLE_INLINE void Move(u8* dst, const u8* src) {
+#if defined(ARCHITECTURE_x86_64)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+#elif defined(ARCHITECTURE_arm64)
+        vst1q_u8(dst, vld1q_u8(src));
+#else
+        std::memcpy(dst, src, 16);
+#endif
+    }
+
+    /// Splits 64 block linear bytes into 32 byte halves of an even line and the line after it
+    static SWIZZLE_INLINE void UnswizzlePair(u8* dst0, u8* dst1, const u8* src) {
+        Move(dst0, src);
+        Move(dst1, src + 16);
+        Move(dst0 + 16, src + 32);
+        Move(dst1 + 16, src + 48);
+    }
+
+    /// Interleaves 32 byte halves of an even line and the line after it into block linear
+    static SWIZZLE_INLINE void SwizzlePair(u8* dst, const u8* src0, const u8* src1) {
+        Move(dst, src0);
+        Move(dst + 16, src1);
+        Move(dst + 32, src0 + 16);
+        Move(dst + 48, src1 + 16);
+    }
+};
+
+#ifdef ARCHITECTURE_x86_64
+/// Moves line pairs with 256-bit loads and stores, the 128-bit lanes are swapped between lines.
+/// These can't be force inlined into the generic line walker, they get inlined once the walker is
+/// inlined into the AVX2 entry points.
+struct ChunkMoverAVX2 {
+    CITRON_TARGET_AVX2 static void Move(u8* dst, const u8* src) {
+        ChunkMover::Move(dst, src);
+    }
+
+    CITRON_TARGET_AVX2 static void UnswizzlePair(u8* dst0, u8* dst1, const u8* src) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst0),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst1),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    CITRON_TARGET_AVX2 static void SwizzlePair(u8* dst, const u8* src0, const u8* src1) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
+};
+#endif
+
+/// Describes how lines of a slice are laid out in both the linear and block linear memory
+struct LineLayout {
+    u32 origin_x;
+    u32 origin_y;
+    u32 num_columns;
+    u32 pitch;
+    u32 block_height;
+    u32 block_size;
+    u32 x_shift;
+};
+
+constexpr u32 SwizzledLineOffset(const LineLayout& layout, u32 y) {
+    const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+    const u32 block_height_mask = (1U << layout.block_height) - 1;
+    const u32 offset_y = (block_y >> layout.block_height) * layout.block_size +
+                         ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+    return offset_y + pdep<SWIZZLE_Y_BITS>(y);
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
-void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
-                 u32 block_height, u32 block_depth, u32 stride) {
+SWIZZLE_INLINE void MoveTexels(u8* linear, u8* swizzled, u32 x_begin, u32 x_end, u32 x_shift) {
+    u32 swizzled_x = pdep<SWIZZLE_X_BITS>(x_begin);
+    for (u32 x = x_begin; x < x_end;
+         x += BYTES_PER_PIXEL, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
+        u8* const swizzled_texel = swizzled + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + swizzled_x;
+        u8* const linear_texel = linear + (x - x_begin);
+        if constexpr (TO_LINEAR) {
+            std::memcpy(swizzled_texel, linear_texel, BYTES_PER_PIXEL);
+        } else {
+            std::memcpy(linear_texel, swizzled_texel, BYTES_PER_PIXEL);
+        }
+    }
+}
+
+template <bool TO_LINEAR, class Mover>
+SWIZZLE_INLINE void MoveChunk(u8* linear, u8* swizzled) {
+    if constexpr (TO_LINEAR) {
+        Mover::Move(swizzled, linear);
+    } else {
+        Mover::Move(linear, swizzled);
+    }
+}
+
+/// Moves the texels of a line that lie outside of whole chunks
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+SWIZZLE_INLINE void MoveLineEdges(u8* linear, u8* swizzled, u32 x_begin, u32 chunks_begin,
+                                  u32 chunks_end, u32 x_end, u32 x_shift) {
+    MoveTexels<TO_LINEAR, BYTES_PER_PIXEL>(linear, swizzled, x_begin, chunks_begin, x_shift);
+    MoveTexels<TO_LINEAR, BYTES_PER_PIXEL>(linear + (chunks_end - x_begin), swizzled, chunks_end,
+                                           x_end, x_shift);
+}
+
+/**
+ * Moves lines between linear and block linear memory.
+ * Texels up to the first 16 byte boundary and after the last one are moved one by one, the chunks
+ * in between are moved whole. Lines sharing a GOB row pair are moved together, as their chunks are
+ * interleaved in the block linear layout.
+ * Texel sizes that aren't a power of two can straddle chunks and are always moved one by one.
+ */
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL, class Mover>
+SWIZZLE_INLINE void SwizzleLines(u8* linear, u8* swizzled, const LineLayout& layout,
+                                 u32 num_lines) {
+    const u32 x_begin = layout.origin_x * BYTES_PER_PIXEL;
+    const u32 x_end = x_begin + layout.num_columns * BYTES_PER_PIXEL;
+    const u32 x_shift = layout.x_shift;
+    if constexpr (!std::has_single_bit(BYTES_PER_PIXEL)) {
+        for (u32 line = 0; line < num_lines; ++line) {
+            u8* const swizzled_line = swizzled + SwizzledLineOffset(layout, layout.origin_y + line);
+            MoveTexels<TO_LINEAR, BYTES_PER_PIXEL>(linear + line * layout.pitch, swizzled_line,
+                                                   x_begin, x_end, x_shift);
+        }
+        return;
+    }
+    const u32 chunks_begin = std::min(Common::AlignUp(x_begin, 16U), x_end);
+    const u32 chunks_end = std::max(chunks_begin, Common::AlignDown(x_end, 16U));
+
+    u32 line = 0;
+    while (line < num_lines) {
+        const u32 y = layout.origin_y + line;
+        u8* const linear_line = linear + line * layout.pitch - x_begin;
+        u8* const swizzled_line = swizzled + SwizzledLineOffset(layout, y);
+        MoveLineEdges<TO_LINEAR, BYTES_PER_PIXEL>(linear_line + x_begin, swizzled_line, x_begin,
+                                                  chunks_begin, chunks_end, x_end, x_shift);
+        if ((y & 1) != 0 || line + 1 == num_lines) {
+            for (u32 x = chunks_begin; x < chunks_end; x += 16) {
+                MoveChunk<TO_LINEAR, Mover>(linear_line + x,
+                                            swizzled_line + ChunkOffset(x, x_shift));
+            }
+            ++line;
+            continue;
+        }
+        // The odd line is 16 bytes after the even line in each chunk of the GOB
+        u8* const linear_next = linear_line + layout.pitch;
+        u8* const swizzled_next = swizzled_line + 16;
+        MoveLineEdges<TO_LINEAR, BYTES_PER_PIXEL>(linear_next + x_begin, swizzled_next, x_begin,
+                                                  chunks_begin, chunks_end, x_end, x_shift);
+        u32 x = chunks_begin;
+        if ((x & 31) != 0 && x < chunks_end) {
+            MoveChunk<TO_LINEAR, Mover>(linear_line + x, swizzled_line + ChunkOffset(x, x_shift));
+            MoveChunk<TO_LINEAR, Mover>(linear_next + x, swizzled_next + ChunkOffset(x, x_shift));
+            x += 16;
+        }
+        for (; x + 32 <= chunks_end; x += 32) {
+            u8* const swizzled_pair = swizzled_line + ChunkOffset(x, x_shift);
+            if constexpr (TO_LINEAR) {
+                Mover::SwizzlePair(swizzled_pair, linear_line + x, linear_next + x);
+            } else {
+                Mover::UnswizzlePair(linear_line + x, linear_next + x, swizzled_pair);
+            }
+        }
+        if (x < chunks_end) {
+            MoveChunk<TO_LINEAR, Mover>(linear_line + x, swizzled_line + ChunkOffset(x, x_shift));
+            MoveChunk<TO_LINEAR, Mover>(linear_next + x, swizzled_next + ChunkOffset(x, x_shift));
+        }
+        line += 2;
+    }
+}
+
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL, class Mover>
+SWIZZLE_INLINE void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width,
+                                u32 height, u32 depth, u32 block_height, u32 block_depth,
+                                u32 stride) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_x = 0;
@@ -51,47 +250,34 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
     const u32 slice_size =
         Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
 
-    const u32 block_height_mask = (1U << block_height) - 1;
     const u32 block_depth_mask = (1U << block_depth) - 1;
-    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+    const LineLayout layout{
+        .origin_x = origin_x,
+        .origin_y = origin_y,
+        .num_columns = width,
+        .pitch = pitch,
+        .block_height = block_height,
+        .block_size = block_size,
+        .x_shift = GOB_SIZE_SHIFT + block_height + block_depth,
+    };
+    // Input is only read from, the const is cast away so both directions share the line walker
+    u8* const linear = TO_LINEAR ? const_cast<u8*>(input.data()) : output.data();
+    u8* const swizzled = TO_LINEAR ? output.data() : const_cast<u8*>(input.data());
 
     for (u32 slice = 0; slice < depth; ++slice) {
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
-        for (u32 line = 0; line < height; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
-
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
-        }
+        SwizzleLines<TO_LINEAR, BYTES_PER_PIXEL, Mover>(linear + slice * pitch * height,
+                                                        swizzled + offset_z, layout, height);
     }
 }
 
-template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
-void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height,
-                        u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
-                        u32 block_height, u32 block_depth, u32 pitch_linear) {
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL, class Mover>
+SWIZZLE_INLINE void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 width,
+                                       u32 height, u32 depth, u32 origin_x, u32 origin_y,
+                                       u32 extent_x, u32 num_lines, u32 block_height,
+                                       u32 block_depth, u32 pitch_linear) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_z = 0;
@@ -106,9 +292,19 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     const u32 slice_size =
         Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
 
-    const u32 block_height_mask = (1U << block_height) - 1;
     const u32 block_depth_mask = (1U << block_depth) - 1;
-    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+    const LineLayout layout{
+        .origin_x = origin_x,
+        .origin_y = origin_y,
+        .num_columns = extent_x,
+        .pitch = pitch,
+        .block_height = block_height,
+        .block_size = block_size,
+        .x_shift = GOB_SIZE_SHIFT + block_height + block_depth,
+    };
+    // Input is only read from, the const is cast away so both directions share the line walker
+    u8* const linear = TO_LINEAR ? const_cast<u8*>(input.data()) : output.data();
+    u8* const swizzled = TO_LINEAR ? output.data() : const_cast<u8*>(input.data());
 
     u32 unprocessed_lines = num_lines;
     u32 extent_y = std::min(num_lines, height - origin_y);
@@ -118,32 +314,8 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
         const u32 lines_in_y = std::min(unprocessed_lines, extent_y);
-        for (u32 line = 0; line < lines_in_y; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
-
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < extent_x;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
-        }
+        SwizzleLines<TO_LINEAR, BYTES_PER_PIXEL, Mover>(linear + slice * pitch * height,
+                                                        swizzled + offset_z, layout, lines_in_y);
         unprocessed_lines -= lines_in_y;
         if (unprocessed_lines == 0) {
             return;
@@ -151,14 +323,41 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     }
 }
 
-template <bool TO_LINEAR>
-void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
-             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
+template <bool TO_LINEAR, class Mover>
+SWIZZLE_INLINE void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                            u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
+                            u32 stride_alignment) {
+    switch (bytes_per_pixel) {
+#define BPP_CASE(x)                                                                                \
+    case x:                                                                                        \
+        return SwizzleImpl<TO_LINEAR, x, Mover>(output, input, width, height, depth, block_height, \
+                                                block_depth, stride_alignment);
+        BPP_CASE(1)
+        BPP_CASE(2)
+        BPP_CASE(3)
+        BPP_CASE(4)
+        BPP_CASE(6)
+        BPP_CASE(8)
+        BPP_CASE(12)
+        BPP_CASE(16)
+#undef BPP_CASE
+    default:
+        ASSERT_MSG(false, "Invalid bytes_per_pixel={}", bytes_per_pixel);
+        break;
+    }
+}
+
+template <bool TO_LINEAR, class Mover>
+SWIZZLE_INLINE void SubrectSwizzle(std::span<u8> output, std::span<const u8> input,
+                                   u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
+                                   u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
+                                   u32 block_height, u32 block_depth, u32 pitch_linear) {
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
-        return SwizzleImpl<TO_LINEAR, x>(output, input, width, height, depth, block_height,        \
-                                         block_depth, stride_alignment);
+        return SwizzleSubrectImpl<TO_LINEAR, x, Mover>(output, input, width, height, depth,        \
+                                                       origin_x, origin_y, extent_x, extent_y,     \
+                                                       block_height, block_depth, pitch_linear);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -174,6 +373,72 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     }
 }
 
+using SwizzleFunction = void (*)(std::span<u8>, std::span<const u8>, u32, u32, u32, u32, u32, u32,
+                                 u32);
+using SwizzleSubrectFunction = void (*)(std::span<u8>, std::span<const u8>, u32, u32, u32, u32,
+                                        u32, u32, u32, u32, u32, u32, u32);
+
+struct SwizzleKernels {
+    SwizzleFunction unswizzle;
+    SwizzleFunction swizzle;
+    SwizzleSubrectFunction unswizzle_subrect;
+    SwizzleSubrectFunction swizzle_subrect;
+};
+
+template <bool TO_LINEAR>
+void SwizzleGeneric(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                    u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
+                    u32 stride_alignment) {
+    Swizzle<TO_LINEAR, ChunkMover>(output, input, bytes_per_pixel, width, height, depth,
+                                   block_height, block_depth, stride_alignment);
+}
+
+template <bool TO_LINEAR>
+void SwizzleSubrectGeneric(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                           u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y,
+                           u32 extent_x, u32 extent_y, u32 block_height, u32 block_depth,
+                           u32 pitch_linear) {
+    SubrectSwizzle<TO_LINEAR, ChunkMover>(output, input, bytes_per_pixel, width, height, depth,
+                                          origin_x, origin_y, extent_x, extent_y, block_height,
+                                          block_depth, pitch_linear);
+}
+
+#ifdef ARCHITECTURE_x86_64
+template <bool TO_LINEAR>
+CITRON_TARGET_AVX2 void SwizzleAVX2(std::span<u8> output, std::span<const u8> input,
+                                    u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
+                                    u32 block_height, u32 block_depth, u32 stride_alignment) {
+    Swizzle<TO_LINEAR, ChunkMoverAVX2>(output, input, bytes_per_pixel, width, height, depth,
+                                       block_height, block_depth, stride_alignment);
+}
+
+template <bool TO_LINEAR>
+CITRON_TARGET_AVX2 void SwizzleSubrectAVX2(std::span<u8> output, std::span<const u8> input,
+                                           u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
+                                           u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
+                                           u32 block_height, u32 block_depth, u32 pitch_linear) {
+    SubrectSwizzle<TO_LINEAR, ChunkMoverAVX2>(output, input, bytes_per_pixel, width, height,
+                                              depth, origin_x, origin_y, extent_x, extent_y,
+                                              block_height, block_depth, pitch_linear);
+}
+#endif
+
+const SwizzleKernels& GetSwizzleKernels() {
+    static const SwizzleKernels kernels = [] {
+#ifdef ARCHITECTURE_x86_64
+        if (Common::GetCPUCaps().avx2) {
+            return SwizzleKernels{SwizzleAVX2<false>, SwizzleAVX2<true>,
+                                  SwizzleSubrectAVX2<false>, SwizzleSubrectAVX2<true>};
+        }
+#endif
+        return SwizzleKernels{SwizzleGeneric<false>, SwizzleGeneric<true>,
+                              SwizzleSubrectGeneric<false>, SwizzleSubrectGeneric<true>};
+    }();
+    return kernels;
+}
+
+#undef SWIZZLE_INLINE
+
 } // Anonymous namespace
 
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
@@ -183,8 +448,8 @@ void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes
     const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
     width = (width * bytes_per_pixel) >> new_bpp;
     bytes_per_pixel = 1U << new_bpp;
-    Swizzle<false>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                   stride);
+    GetSwizzleKernels().unswizzle(output, input, bytes_per_pixel, width, height, depth,
+                                  block_height, block_depth, stride);
 }
 
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
@@ -194,56 +459,24 @@ void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_p
     const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
     width = (width * bytes_per_pixel) >> new_bpp;
     bytes_per_pixel = 1U << new_bpp;
-    Swizzle<true>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                  stride);
+    GetSwizzleKernels().swizzle(output, input, bytes_per_pixel, width, height, depth, block_height,
+                                block_depth, stride);
 }
 
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
                     u32 block_height, u32 block_depth, u32 pitch_linear) {
-    switch (bytes_per_pixel) {
-#define BPP_CASE(x)                                                                                \
-    case x:                                                                                        \
-        return SwizzleSubrectImpl<true, x>(output, input, width, height, depth, origin_x,          \
-                                           origin_y, extent_x, extent_y, block_height,             \
-                                           block_depth, pitch_linear);
-        BPP_CASE(1)
-        BPP_CASE(2)
-        BPP_CASE(3)
-        BPP_CASE(4)
-        BPP_CASE(6)
-        BPP_CASE(8)
-        BPP_CASE(12)
-        BPP_CASE(16)
-#undef BPP_CASE
-    default:
-        ASSERT_MSG(false, "Invalid bytes_per_pixel={}", bytes_per_pixel);
-        break;
-    }
+    GetSwizzleKernels().swizzle_subrect(output, input, bytes_per_pixel, width, height, depth,
+                                        origin_x, origin_y, extent_x, extent_y, block_height,
+                                        block_depth, pitch_linear);
 }
 
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
                       u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear) {
-    switch (bytes_per_pixel) {
-#define BPP_CASE(x)                                                                                \
-    case x:                                                                                        \
-        return SwizzleSubrectImpl<false, x>(output, input, width, height, depth, origin_x,         \
-                                            origin_y, extent_x, extent_y, block_height,            \
-                                            block_depth, pitch_linear);
-        BPP_CASE(1)
-        BPP_CASE(2)
-        BPP_CASE(3)
-        BPP_CASE(4)
-        BPP_CASE(6)
-        BPP_CASE(8)
-        BPP_CASE(12)
-        BPP_CASE(16)
-#undef BPP_CASE
-    default:
-        ASSERT_MSG(false, "Invalid bytes_per_pixel={}", bytes_per_pixel);
-        break;
-    }
+    GetSwizzleKernels().unswizzle_subrect(output, input, bytes_per_pixel, width, height, depth,
+                                          origin_x, origin_y, extent_x, extent_y, block_height,
+                                          block_depth, pitch_linear);
 }
 
 std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
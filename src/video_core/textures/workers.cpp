@@ -1,15 +1,194 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
 #include "video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 
-Common::ThreadWorker& GetThreadWorkers() {
-    static Common::ThreadWorker workers{std::max(std::thread::hardware_concurrency(), 2U) / 2,
-                                        "ImageTranscode"};
+struct DecodeJob {
+    DecodePriority priority;
+    Common::UniqueFunction<void> func;
+};
+
+struct DecodeState {
+    /// Stages not queued yet, the front one is queued when the pending jobs are done
+    std::deque<std::vector<DecodeJob>> stages;
+    std::atomic<size_t> pending_jobs{};
+    Common::UniqueFunction<void> on_complete;
+    DecodePriority completion_priority{};
+    std::atomic_bool complete{};
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+namespace {
+
+/// Worker pool draining one queue per priority, always from the most urgent non empty queue
+class DecodeScheduler {
+public:
+    struct QueuedJob {
+        std::shared_ptr<DecodeState> state;
+        Common::UniqueFunction<void> func;
+    };
+
+    explicit DecodeScheduler(size_t num_workers) {
+        threads.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            threads.emplace_back([this](std::stop_token stop_token) { WorkerLoop(stop_token); });
+        }
+    }
+
+    /// Queues the jobs of the first stage left in the batch
+    void QueueStage(const std::shared_ptr<DecodeState>& state) {
+        std::vector<DecodeJob> stage = std::move(state->stages.front());
+        state->stages.pop_front();
+        state->pending_jobs.store(stage.size(), std::memory_order_relaxed);
+        {
+            std::scoped_lock lock{queue_mutex};
+            for (DecodeJob& job : stage) {
+                queues[static_cast<size_t>(job.priority)].push_back({state, std::move(job.func)});
+            }
+        }
+        condition.notify_all();
+    }
+
+private:
+    bool HasWork() const {
+        for (const auto& queue : queues) {
+            if (!queue.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    QueuedJob PopJob() {
+        for (auto& queue : queues) {
+            if (!queue.empty()) {
+                QueuedJob job = std::move(queue.front());
+                queue.pop_front();
+                return job;
+            }
+        }
+        return {};
+    }
+
+    void WorkerLoop(std::stop_token stop_token) {
+        Common::SetCurrentThreadName("TextureDecode");
+        while (!stop_token.stop_requested()) {
+            QueuedJob job;
+            {
+                std::unique_lock lock{queue_mutex};
+                Common::CondvarWait(condition, lock, stop_token, [this] { return HasWork(); });
+                if (stop_token.stop_requested()) {
+                    break;
+                }
+                job = PopJob();
+            }
+            job.func();
+            Finish(job.state);
+        }
+    }
+
+    void Finish(const std::shared_ptr<DecodeState>& state) {
+        if (state->pending_jobs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (!state->stages.empty()) {
+            QueueStage(state);
+            return;
+        }
+        if (state->on_complete) {
+            state->on_complete();
+        }
+        {
+            std::scoped_lock lock{state->mutex};
+            state->complete.store(true, std::memory_order_release);
+        }
+        state->condition.notify_all();
+    }
+
+    std::mutex queue_mutex;
+    std::condition_variable_any condition;
+    std::array<std::deque<QueuedJob>, NUM_DECODE_PRIORITIES> queues;
+    std::vector<std::jthread> threads;
+};
+
+size_t NumWorkers() {
+    return std::max(std::thread::hardware_concurrency(), 2U) / 2;
+}
+
+DecodeScheduler& GetDecodeScheduler() {
+    static DecodeScheduler scheduler{NumWorkers()};
+    return scheduler;
+}
+
+} // Anonymous namespace
+
+DecodeToken::DecodeToken(std::shared_ptr<DecodeState> state_) noexcept
+    : state{std::move(state_)} {}
+
+bool DecodeToken::IsComplete() const noexcept {
+    return !state || state->complete.load(std::memory_order_acquire);
+}
+
+void DecodeToken::Wait() const {
+    if (!state) {
+        return;
+    }
+    std::unique_lock lock{state->mutex};
+    state->condition.wait(lock, [this] { return state->complete.load(); });
+}
+
+DecodeBatch::DecodeBatch() : state{std::make_shared<DecodeState>()} {
+    state->stages.emplace_back();
+}
+
+DecodeBatch::~DecodeBatch() = default;
+
+void DecodeBatch::AddJob(DecodePriority priority, Common::UniqueFunction<void> job) {
+    state->stages.back().push_back(DecodeJob{priority, std::move(job)});
+}
+
+void DecodeBatch::AddStage() {
+    if (!state->stages.back().empty()) {
+        state->stages.emplace_back();
+    }
+}
+
+void DecodeBatch::SetCompletion(DecodePriority priority, Common::UniqueFunction<void> func) {
+    state->completion_priority = priority;
+    state->on_complete = std::move(func);
+}
+
+DecodeToken DecodeBatch::Submit() {
+    std::shared_ptr<DecodeState> submitted = std::exchange(state, std::make_shared<DecodeState>());
+    state->stages.emplace_back();
 
-    return workers;
+    std::erase_if(submitted->stages, [](const auto& stage) { return stage.empty(); });
+    if (submitted->stages.empty()) {
+        if (!submitted->on_complete) {
+            submitted->complete = true;
+            return DecodeToken{std::move(submitted)};
+        }
+        // Run the completion from a worker, it may be as expensive as any other job
+        submitted->stages.emplace_back().push_back(
+            DecodeJob{submitted->completion_priority, std::move(submitted->on_complete)});
+    }
+    GetDecodeScheduler().QueueStage(submitted);
+    return DecodeToken{std::move(submitted)};
 }
 
 } // namespace Tegra::Texture
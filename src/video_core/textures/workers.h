@@ -3,10 +3,68 @@
 
 #pragma once
 
-#include "common/thread_worker.h"
+#include <memory>
+
+#include "common/common_types.h"
+#include "common/unique_function.h"
 
 namespace Tegra::Texture {
 
-Common::ThreadWorker& GetThreadWorkers();
+/// Order in which the decode workers pick queued jobs, lower values are picked first
+enum class DecodePriority : u32 {
+    RenderTarget, ///< Something is blocked on the result, e.g. a render target or a sync upload
+    Sampled,      ///< Base level of an image used by the current frame
+    Prefetch,     ///< Mip levels past the base level, not needed right away
+};
+constexpr size_t NUM_DECODE_PRIORITIES = 3;
+
+struct DecodeState;
+
+/// Completion token of a decode batch, polled by the texture cache instead of blocking on it
+class DecodeToken {
+public:
+    DecodeToken() = default;
+    explicit DecodeToken(std::shared_ptr<DecodeState> state_) noexcept;
+
+    /// Returns true once every job and the completion callback of the batch have run
+    [[nodiscard]] bool IsComplete() const noexcept;
+
+    /// Blocks until the batch is complete, must not be called from a decode worker
+    void Wait() const;
+
+private:
+    std::shared_ptr<DecodeState> state;
+};
+
+/**
+ * Set of decode jobs tracked by a single token, jobs run in any order on any decode worker.
+ * Jobs can be split in stages, the jobs of a stage are only queued once all the jobs of the
+ * previous stages are done.
+ */
+class DecodeBatch {
+public:
+    DecodeBatch();
+    ~DecodeBatch();
+
+    DecodeBatch(const DecodeBatch&) = delete;
+    DecodeBatch& operator=(const DecodeBatch&) = delete;
+
+    void AddJob(DecodePriority priority, Common::UniqueFunction<void> job);
+
+    /// Starts a new stage, jobs added from now on wait for the ones added before
+    void AddStage();
+
+    /**
+     * Sets a callback run once after all jobs, from the worker that finishes the last one.
+     * The priority is only used to queue the callback itself when the batch has no jobs.
+     */
+    void SetCompletion(DecodePriority priority, Common::UniqueFunction<void> func);
+
+    /// Queues the jobs on the decode workers, the batch is empty afterwards
+    [[nodiscard]] DecodeToken Submit();
+
+private:
+    std::shared_ptr<DecodeState> state;
+};
 
-}
+} // namespace Tegra::Texture
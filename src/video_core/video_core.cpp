@@ -19,15 +19,15 @@ namespace {
 std::unique_ptr<VideoCore::RendererBase> CreateRenderer(
     Core::System& system, Core::Frontend::EmuWindow& emu_window, Tegra::GPU& gpu,
     std::unique_ptr<Core::Frontend::GraphicsContext> context) {
-    auto& telemetry_session = system.TelemetrySession();
     auto& device_memory = system.Host1x().MemoryManager();
 
+    // The null renderer doesn't report telemetry, GPU replays run it without a session
     switch (Settings::values.renderer_backend.GetValue()) {
     case Settings::RendererBackend::OpenGL:
-        return std::make_unique<OpenGL::RendererOpenGL>(telemetry_session, emu_window,
+        return std::make_unique<OpenGL::RendererOpenGL>(system.TelemetrySession(), emu_window,
                                                         device_memory, gpu, std::move(context));
     case Settings::RendererBackend::Vulkan:
-        return std::make_unique<Vulkan::RendererVulkan>(telemetry_session, emu_window,
+        return std::make_unique<Vulkan::RendererVulkan>(system.TelemetrySession(), emu_window,
                                                         device_memory, gpu, std::move(context));
     case Settings::RendererBackend::Null:
         return std::make_unique<Null::RendererNull>(emu_window, gpu, std::move(context));